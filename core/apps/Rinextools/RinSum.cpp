@@ -43,7 +43,10 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <memory>
+#include <exception>
 
 // GPSTK
 #include "Exception.hpp"
@@ -69,6 +72,7 @@
 #include "RinexUtilities.hpp"
 
 #include "msecHandler.hpp"
+#include "ThreadPool.hpp"
 
 //-----------------------------------------------------------------------------
 using namespace std;
@@ -115,6 +119,7 @@ private:
       debug = -1;
       dt = -1.0;
       vres = 0;
+      nThreads = 1;
    }  // end Configuration::SetDefaults()
 
 public:
@@ -127,7 +132,7 @@ public:
       // start command line input
    bool help, verbose, brief, nohead, notab, gpstime, sorttime, dogaps, doms,
       vistab, ycode, quiet;
-   int debug, vres;
+   int debug, vres, nThreads;
    double dt;
    string cfgfile, userfmt;
 
@@ -144,14 +149,10 @@ public:
 
       // end of command line input
 
-   vector<int> gapcount;               // for counting gaps
    string msg;
    static const string calfmt,gpsfmt,longfmt;
    ofstream logstrm;
 
-      // for milliseconds
-   msecHandler msh;
-
 }; // end class Configuration
 
 //-----------------------------------------------------------------------------
@@ -199,10 +200,21 @@ public:
    { return d1.begin < d2.begin; }
 };
 
+//-----------------------------------------------------------------------------
+// a block of data records that are out of time order; only the count and the
+// time span are kept, for the warning printed at the end of the summary
+struct OutOfOrderBlock
+{
+   CommonTime prevTime;                // epoch preceding the block
+   CommonTime firstTime, lastTime;     // first and last epochs in the block
+   int count;                          // number of records in the block
+};
+
 //-----------------------------------------------------------------------------
 // prototypes
 int Initialize(string& errors) throw(Exception);
 int ProcessFiles(void) throw(Exception);
+int SummarizeFile(const size_t nfile) throw(Exception);
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -299,10 +311,6 @@ int Initialize(string& errors) throw(Exception)
             LOG(ERROR) << C.msg;
       }
 
-         // initialize millisecond handler
-      if(C.doms)
-         C.msh.setDT(C.dt);
-
          // -------- save errors and output
          //errors = oss.str();
          //stripTrailing(errors,'\n');
@@ -482,6 +490,8 @@ string Configuration::BuildCommandLine(void) throw()
 
    opts.Add(0, "ycode", "", false, false, &ycode, "# Other:",
             "Assume v2.11 P mean Y");
+   opts.Add(0, "threads", "n", false, false, &nThreads, "",
+            "Number of files to summarize at once [0 for one per core]");
    opts.Add(0, "verbose", "", false, false, &verbose, "",
             "Print extra output information");
    opts.Add(0, "debug", "", false, false, &debug, "",
@@ -637,6 +647,8 @@ int Configuration::ExtraProcessing(string& errors, string& extras) throw()
       ossx << "Warning - Option --vtab requires that --vis <n> be given\n";
       vistab = false;
    }
+   if(nThreads < 0)
+      oss << "Error : --threads must not be negative: " << nThreads << endl;
 
       // add new errors to the list
    msg = oss.str();
@@ -657,1036 +669,1100 @@ int ProcessFiles(void) throw(Exception)
    try
    {
       Configuration& C(Configuration::Instance());
+      size_t i,nfile,nfiles(0);
+      const size_t nin(C.InputObsFiles.size());
+
+         // with --threads, a pool to summarize several files at once; leave it
+         // null to process serially
+      unique_ptr<ThreadPool> pool;
+      if(C.nThreads != 1 && nin > 1)
+      {
+         pool.reset(new ThreadPool(C.nThreads));
+         if(pool->size() < 2)
+            pool.reset();
+         else
+            LOG(VERBOSE) << "Summarize files using " << pool->size() << " threads";
+      }
+
+      if(!pool)
+      {
+         for(nfile=0; nfile<nin; nfile++)
+            if(SummarizeFile(nfile) == 0)
+               nfiles++;
+         return nfiles;
+      }
+
+         // Files are summarized in batches of one per thread. The log output
+         // for each file is collected and written in file order, so output is
+         // the same as without --threads, and only one batch is held in memory.
+      const size_t nbatch(pool->size());
+      vector<string> logs(nbatch);
+      vector<int> irets(nbatch);
+      vector<exception_ptr> errors(nbatch);
+      for(nfile=0; nfile<nin; nfile += nbatch)
+      {
+         const size_t n(min(nbatch, nin-nfile));
+         for(i=0; i<n; i++)
+         {
+            logs[i].clear();
+            errors[i] = exception_ptr();
+         }
+
+         pool->run(n, [&](size_t k) {
+            LogCapture capture(logs[k]);
+            try { irets[k] = SummarizeFile(nfile+k); }
+            catch(...) { errors[k] = current_exception(); }
+         });
+
+         for(i=0; i<n; i++)
+         {
+            ConfigureLOGstream::Output(logs[i]);
+            if(errors[i])
+               rethrow_exception(errors[i]);
+            if(irets[i] == 0)
+               nfiles++;
+         }
+      }
+
+      return nfiles;
+   }
+   catch(Exception& e)
+   {
+      GPSTK_RETHROW(e);
+   }
+}  // end ProcessFiles()
+
+//-----------------------------------------------------------------------------
+// Read file C.InputObsFiles[nfile] and write its summary to the log.
+// Return 0 ok, or >0 if the file could not be summarized: 1 could not open file,
+// 2 failed to read header, 3 failed to read data, 4 invalid header, 5 no data.
+// Everything this reads or writes, other than the (const) configuration, is
+// local, so files may be summarized concurrently (see ProcessFiles()).
+int SummarizeFile(const size_t nfile) throw(Exception)
+{
+   try
+   {
+      const Configuration& C(Configuration::Instance());
       int iret,ii,k;
-      size_t i,j,nfile,nfiles;
+      size_t i,j;
       string tag;
       CommonTime lastObsTime, prevObsTime, firstObsTime;
-      RinexSatID sat;
-      Rinex3ObsStream ostrm;
       ostringstream oss;
          // estimate time step
       const size_t ndtmax=15;
       double dt, bestdt[ndtmax];
       int ndt[ndtmax];
-         // cache the out-of-time-order records
-      bool cacheon;
-      vector<CommonTime> cachetime;
-      vector<vector<Rinex3ObsData> > cache;
-
-      for(nfiles=0,nfile=0; nfile<C.InputObsFiles.size(); nfile++)
+         // count the out-of-time-order records
+      bool cacheon(false);
+      vector<OutOfOrderBlock> cache;
+         // for counting gaps
+      vector<int> gapcount;
+         // for milliseconds
+      msecHandler msh;
+      msh.setDT(C.dt);
+
+      Rinex3ObsStream istrm;
+      Rinex3ObsHeader Rhead, Rheadout;
+      Rinex3ObsData Rdata;
+
+         // If command line specified P1/P2 are to be considered
+         // as Y-code, set the Rinex3ObsHeader flag to indicate such.
+      if (C.ycode)
       {
-         Rinex3ObsStream istrm;
-         Rinex3ObsHeader Rhead, Rheadout;
-         Rinex3ObsData Rdata;
+         Rhead.PisY = true;
+         Rheadout.PisY = true;
+      }
 
-            // If command line specified P1/P2 are to be considered
-            // as Y-code, set the Rinex3ObsHeader flag to indicate such.
-         if (C.ycode)
-         {
-            Rhead.PisY = true;
-            Rheadout.PisY = true;
-         }
-      
-         cacheon = false;
-         cache.clear();
-         cachetime.clear();
+      string filename(C.InputObsFiles[nfile]);
+
+      // iret is set to 0 ok, or could not: 1 open file, 2 read header, 3 read data
+      iret = 0;
+      for(i=0; i<ndtmax; i++)
+         ndt[i] = -1;
 
-         string filename(C.InputObsFiles[nfile]);
+         // open the file ------------------------------------------------
+      istrm.open(filename.c_str(),ios::in);
+      if(!istrm.is_open())
+      {
+         LOG(WARNING) << "Warning : could not open file " << filename;
+         return 1;
+      }
+      istrm.exceptions(ios::failbit);
 
-         // iret is set to 0 ok, or could not: 1 open file, 2 read header, 3 read data
-         iret = 0;
-         for(i=0; i<ndtmax; i++)
-            ndt[i] = -1;
+      // get file size - on windows its different b/c of CRs
+      //char ch;
+      //istrm.seekg(0,ios::end);
+      //streampos filesize(istrm.tellg());
+      //istrm.seekg(0,ios::beg);
 
-            // open the file ------------------------------------------------
-         istrm.open(filename.c_str(),ios::in);
-         if(!istrm.is_open())
-         {
-            LOG(WARNING) << "Warning : could not open file " << filename;
-            iret = 1;
-            continue;
-         }
-         istrm.exceptions(ios::failbit);
+         // output file name
+      if(C.quiet)
+      {
+         std::string choppedFN(filename);
+         choppedFN.erase(0,1+filename.find_last_of("/\\"));
+         LOG(INFO) << "+++++++++++++ " << C.PrgmName
+                   << " summary of Rinex obs file " << choppedFN
+                   << " +++++++++++++";
+      }
+      else if(!C.brief)
+      {
+         LOG(INFO) << "+++++++++++++ " << C.PrgmName
+                   << " summary of Rinex obs file " << filename
+                   << " +++++++++++++";
+      }
+
+         // read the header ----------------------------------------------
+      try
+      {
+         istrm >> Rhead;
+      }
+      catch(Exception& e)
+      {
+         LOG(WARNING) << "Warning : Failed to read header: " << e.what()
+                      << "\n Header dump follows.";
+         Rhead.dump(LOGstrm);
+         istrm.close();
+         return 2;
+      }
+      if(Rhead.lastObs.getTimeSystem() != Rhead.firstObs.getTimeSystem())
+         Rhead.lastObs.setTimeSystem(Rhead.firstObs.getTimeSystem());
 
-         // get file size - on windows its different b/c of CRs
-         //char ch;
-         //istrm.seekg(0,ios::end);
-         //streampos filesize(istrm.tellg());
-         //istrm.seekg(0,ios::beg);
+         // output file name and header
+      if(C.brief)
+      {
+         if(nfile > 0)
+            LOG(INFO) << "";
+         LOG(INFO) << "File name: " << filename
+                   << " (RINEX ver. " << Rhead.version << ")";
+         LOG(INFO) << "Marker name: " << Rhead.markerName;
+         LOG(INFO) << "Antenna type: " << Rhead.antType;
+         LOG(INFO) << "Position (XYZ,m) : " << fixed << setprecision(4)
+                   << Rhead.antennaPosition << ".";
+         LOG(INFO) << "Antenna offset (UEN,m) : " << fixed << setprecision(4)
+                   << Rhead.antennaDeltaHEN << ".";
+      }
+      else if(!C.nohead)
+      {
+         LOG(DEBUG) << "RINEX header:";
+         Rhead.dump(LOGstrm);
+      }
 
-            // output file name
+      if(!Rhead.isValid())
+      {
+         LOG(INFO) << "Abort: header is invalid.";
          if(C.quiet)
          {
             std::string choppedFN(filename);
             choppedFN.erase(0,1+filename.find_last_of("/\\"));
-            LOG(INFO) << "+++++++++++++ " << C.PrgmName
-                      << " summary of Rinex obs file " << choppedFN
-                      << " +++++++++++++";
+            LOG(INFO) << "\n+++++++++++++ End of RinSum summary of "
+                      << choppedFN << " +++++++++++++";
          }
          else if(!C.brief)
          {
-            LOG(INFO) << "+++++++++++++ " << C.PrgmName
-                      << " summary of Rinex obs file " << filename
-                      << " +++++++++++++";
+            LOG(INFO) << "\n+++++++++++++ End of RinSum summary of "
+                      << filename << " +++++++++++++";
+         }
+         return 4;
+      }
+
+         // initialize counting -------------------------------------------
+      int nepochs(0), ncommentblocks(0), nmaxobs(0);
+      vector<TableData> table;            // table of counts per sat,obs
+      map<RinexSatID, size_t> tableIndex; // index of each sat in table
+      map<char, vector<int> > totals;     // totals per system,obs
+
+      prevObsTime = CommonTime::BEGINNING_OF_TIME;
+      firstObsTime = CommonTime::BEGINNING_OF_TIME;
+
+         // initialize for all systems in the header
+      map<std::string,vector<RinexObsID> >::const_iterator sit;   // used below often
+      for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+      {
+            // Initialize the vectors contained in the map
+         totals[(sit->first)[0]] = vector<int>((sit->second).size());
+
+         LOG(DEBUG) << "GNSS " << (sit->first) << " is present with "
+                    << (sit->second).size() << " observations...";
+
+            // find the max size of obs list
+         if(int((sit->second).size()) > nmaxobs)
+            nmaxobs = (sit->second).size();
+      }
+
+         // initialize millisecond handler with obstypes and wavelengths
+      vector<string> msots;
+      if(C.doms)
+      {
+         vector<double> waves;
+            // get obs types from header
+         for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+         {
+               // get the system
+            RinexSatID rsid;
+            rsid.fromString(sit->first);
+            SatID sid(rsid);
+               // TD support only GPS currently
+            if(rsid.systemChar() != 'G') continue;
+               // excluded satellites/systems
+            if(find(C.exSats.begin(), C.exSats.end(), rsid) != C.exSats.end())
+               continue;
+               // get the obstypes, prepend the system character
+            for(i=0; i<sit->second.size(); i++)
+            {
+               tag = sit->second[i].asString();       // 3-char obs type
+               if(tag[0] == 'C' || tag[0] == 'L')
+               {
+                     // code and phase only
+                  msots.push_back(string(1,rsid.systemChar())+tag);
+                     // get wavelength ... NB TD Glonass frequency channel not supported
+                  if(tag[0] == 'L')
+                  {
+                     ii = asInt(string(1,tag[1]));
+                     waves.push_back(getWavelength(sid, ii));
+                  }
+                  else 
+                     waves.push_back(0.0);
+               }
+            }
          }
 
-            // read the header ----------------------------------------------
+         msh.setObstypes(msots,waves);
+         LOG(DEBUG) << "Initialize millisecond handler with obs type, wavelength:";
+         for(i=0; i<msots.size(); i++) LOG(DEBUG) << " " << msots[i]
+                                                  << fixed << setprecision(6) << " " << waves[i];
+      }
+
+      if(pLOGstrm == &cout && !C.brief)
+         LOG(INFO) << "\nReading the observation data...";
+
+         // loop over epochs ---------------------------------------------
+      while(1)
+      {
          try
          {
-            istrm >> Rhead;
+            istrm >> Rdata;
          }
          catch(Exception& e)
          {
-            LOG(WARNING) << "Warning : Failed to read header: " << e.what()
-                         << "\n Header dump follows.";
-            Rhead.dump(LOGstrm);
+            LOG(WARNING) << " Warning : Failed to read obs data (Exception "
+                         << e.getText(0) << "); dump follows.";
+            Rdata.dump(LOGstrm,Rhead);
             istrm.close();
-            iret = 2;
-            continue;
+            iret = 3;
+            break;
          }
-         if(Rhead.lastObs.getTimeSystem() != Rhead.firstObs.getTimeSystem())
-            Rhead.lastObs.setTimeSystem(Rhead.firstObs.getTimeSystem());
-
-            // output file name and header
-         if(C.brief)
+         catch(std::exception& e)
          {
-            if(nfile > 0)
-               LOG(INFO) << "";
-            LOG(INFO) << "File name: " << filename
-                      << " (RINEX ver. " << Rhead.version << ")";
-            LOG(INFO) << "Marker name: " << Rhead.markerName;
-            LOG(INFO) << "Antenna type: " << Rhead.antType;
-            LOG(INFO) << "Position (XYZ,m) : " << fixed << setprecision(4)
-                      << Rhead.antennaPosition << ".";
-            LOG(INFO) << "Antenna offset (UEN,m) : " << fixed << setprecision(4)
-                      << Rhead.antennaDeltaHEN << ".";
+            Exception ge(string("Std excep: ") + e.what());
+            GPSTK_THROW(ge);
          }
-         else if(!C.nohead)
+         catch(...)
          {
-            LOG(DEBUG) << "RINEX header:";
-            Rhead.dump(LOGstrm);
+            Exception ue("Unknown exception while reading RINEX data.");
+            GPSTK_THROW(ue);
          }
 
-         if(!Rhead.isValid())
+            // normal EOF
+         if(!istrm.good() || istrm.eof())
          {
-            LOG(INFO) << "Abort: header is invalid.";
-            if(C.quiet)
-            {
-               std::string choppedFN(filename);
-               choppedFN.erase(0,1+filename.find_last_of("/\\"));
-               LOG(INFO) << "\n+++++++++++++ End of RinSum summary of "
-                         << choppedFN << " +++++++++++++";
-            }
-            else if(!C.brief)
-            {
-               LOG(INFO) << "\n+++++++++++++ End of RinSum summary of "
-                         << filename << " +++++++++++++";
-            }
-            continue;
+            iret = 0;
+            break;
          }
 
-            // initialize counting -------------------------------------------
-         int nepochs(0), ncommentblocks(0), nmaxobs(0);
-         vector<TableData> table;            // table of counts per sat,obs
-         map<char, vector<int> > totals;     // totals per system,obs
-
-         prevObsTime = CommonTime::BEGINNING_OF_TIME;
-         firstObsTime = CommonTime::BEGINNING_OF_TIME;
+            // stay within time limits
+         if(Rdata.time < C.beginTime)
+         {
+            LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
+                       << " is before begin time.";
+            continue;
+         }
+         if(Rdata.time > C.endTime)
+         {
+            LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
+                       << " is after end time.";
+            break;
+         }
 
-            // initialize for all systems in the header
-         map<std::string,vector<RinexObsID> >::const_iterator sit;   // used below often
-         for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+            // fix time systems
+         if(nepochs == 0 &&
+            Rdata.time.getTimeSystem() != Rhead.lastObs.getTimeSystem())
+         {
+            Rhead.lastObs.setTimeSystem(Rdata.time.getTimeSystem());
+            Rhead.firstObs.setTimeSystem(Rdata.time.getTimeSystem());
+         }
+         lastObsTime = Rdata.time;
+         lastObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
+         firstObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
+         prevObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
+         if(firstObsTime == CommonTime::BEGINNING_OF_TIME)
+            firstObsTime = lastObsTime;
+
+            //LOG(INFO) << "";
+         LOG(DEBUG) << " Read RINEX data: flag " << Rdata.epochFlag
+                    << ", timetag " << printTime(Rdata.time,C.longfmt);
+
+            // if aux header data, either output or skip
+         if(Rdata.epochFlag > 1)
          {
-               // Initialize the vectors contained in the map
-            totals[(sit->first)[0]] = vector<int>((sit->second).size());
+            if(C.debug > -1)
+               for(j=0; j<Rdata.auxHeader.commentList.size(); j++)
+                  LOG(DEBUG) << "Comment: " << Rdata.auxHeader.commentList[j];
+            ncommentblocks++;
+            continue;
+         }
 
-            LOG(DEBUG) << "GNSS " << (sit->first) << " is present with "
-                       << (sit->second).size() << " observations...";
+            // debug: dump the RINEX data object
+         if(C.debug > -1)
+            Rdata.dump(LOGstrm,Rhead);
 
-               // find the max size of obs list
-            if(int((sit->second).size()) > nmaxobs)
-               nmaxobs = (sit->second).size();
-         }
+            // count this epoch
+         nepochs++;
 
-            // initialize millisecond handler with obstypes and wavelengths
-         vector<string> msots;
-         if(C.doms)
+            // check for data out of time order
+            // use < 1.e-3 not < 0 b/c inline header info (epochFlag > 1) excluded
+         if(prevObsTime != CommonTime::BEGINNING_OF_TIME
+            && Rdata.time-prevObsTime < 1.e-3)
          {
-            vector<double> waves;
-               // get obs types from header
-            for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+               // save it
+            if(!cacheon)
             {
-                  // get the system
-               RinexSatID rsid;
-               rsid.fromString(sit->first);
-               SatID sid(rsid);
-                  // TD support only GPS currently
-               if(rsid.systemChar() != 'G') continue;
-                  // excluded satellites/systems
-               if(find(C.exSats.begin(), C.exSats.end(), rsid) != C.exSats.end())
-                  continue;
-                  // get the obstypes, prepend the system character
-               for(i=0; i<sit->second.size(); i++)
-               {
-                  tag = sit->second[i].asString();       // 3-char obs type
-                  if(tag[0] == 'C' || tag[0] == 'L')
-                  {
-                        // code and phase only
-                     msots.push_back(string(1,rsid.systemChar())+tag);
-                        // get wavelength ... NB TD Glonass frequency channel not supported
-                     if(tag[0] == 'L')
-                     {
-                        ii = asInt(string(1,tag[1]));
-                        waves.push_back(getWavelength(sid, ii));
-                     }
-                     else 
-                        waves.push_back(0.0);
-                  }
-               }
+                  // new block
+               OutOfOrderBlock block;
+               block.prevTime = prevObsTime;
+               block.firstTime = Rdata.time;
+               block.count = 0;
+               cache.push_back(block);
+               cacheon = true;
             }
-
-            C.msh.setObstypes(msots,waves);
-            LOG(DEBUG) << "Initialize millisecond handler with obs type, wavelength:";
-            for(i=0; i<msots.size(); i++) LOG(DEBUG) << " " << msots[i]
-                                                     << fixed << setprecision(6) << " " << waves[i];
+            cache.back().lastTime = Rdata.time;
+            cache.back().count++;
+            continue;
          }
+         cacheon = false;
 
-         if(pLOGstrm == &cout && !C.brief)
-            LOG(INFO) << "\nReading the observation data...";
-
-            // loop over epochs ---------------------------------------------
-         while(1)
+            // look for gaps in the timetags
+         int ncount;
+         if(C.dt > 0.0)
          {
-            try
-            {
-               istrm >> Rdata;
-            }
-            catch(Exception& e)
-            {
-               LOG(WARNING) << " Warning : Failed to read obs data (Exception "
-                            << e.getText(0) << "); dump follows.";
-               Rdata.dump(LOGstrm,Rhead);
-               istrm.close();
-               iret = 3;
-               break;
-            }
-            catch(std::exception& e)
+            ncount = int(0.5+(lastObsTime-firstObsTime)/C.dt);
+               // update gap count
+            if(gapcount.size() == 0)
             {
-               Exception ge(string("Std excep: ") + e.what());
-               GPSTK_THROW(ge);
+                  // create the list
+               gapcount.push_back(ncount);   // start time
+               gapcount.push_back(ncount-1); // end time
             }
-            catch(...)
+            i = gapcount.size() - 1;
+            if(ncount == gapcount[i] + 1)    // no gap
+               gapcount[i] = ncount;
+            else
             {
-               Exception ue("Unknown exception while reading RINEX data.");
-               GPSTK_THROW(ue);
+                  // found a gap
+               gapcount.push_back(ncount);   // start time
+               gapcount.push_back(ncount);   // end time
             }
 
-               // normal EOF
-            if(!istrm.good() || istrm.eof())
-            {
-               iret = 0;
-               break;
-            }
+               // TD test after 50 epochs - wrong dt is disasterous
+         }
 
-               // stay within time limits
-            if(Rdata.time < C.beginTime)
-            {
-               LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
-                          << " is before begin time.";
-               continue;
-            }
-            if(Rdata.time > C.endTime)
-            {
-               LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
-                          << " is after end time.";
-               break;
-            }
+            // loop over satellites -------------------------------------
+         Rinex3ObsData::DataMap::const_iterator it;
+         for(it=Rdata.obs.begin(); it != Rdata.obs.end(); ++it)
+         {
+            const RinexSatID& sat(it->first);
 
-               // fix time systems
-            if(nepochs == 0 &&
-               Rdata.time.getTimeSystem() != Rhead.lastObs.getTimeSystem())
-            {
-               Rhead.lastObs.setTimeSystem(Rdata.time.getTimeSystem());
-               Rhead.firstObs.setTimeSystem(Rdata.time.getTimeSystem());
-            }
-            lastObsTime = Rdata.time;
-            lastObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
-            firstObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
-            prevObsTime.setTimeSystem(Rhead.lastObs.getTimeSystem());
-            if(firstObsTime == CommonTime::BEGINNING_OF_TIME)
-               firstObsTime = lastObsTime;
-
-               //LOG(INFO) << "";
-            LOG(DEBUG) << " Read RINEX data: flag " << Rdata.epochFlag
-                       << ", timetag " << printTime(Rdata.time,C.longfmt);
-
-               // if aux header data, either output or skip
-            if(Rdata.epochFlag > 1)
-            {
-               if(C.debug > -1)
-                  for(j=0; j<Rdata.auxHeader.commentList.size(); j++)
-                     LOG(DEBUG) << "Comment: " << Rdata.auxHeader.commentList[j];
-               ncommentblocks++;
+               // is sat included?
+            if(C.onlySats.size() > 0 &&
+               find(C.onlySats.begin(), C.onlySats.end(), sat) == C.onlySats.end()
+               && find(C.onlySats.begin(), C.onlySats.end(),
+                       RinexSatID(-1,sat.system)) == C.onlySats.end())
                continue;
-            }
 
-               // debug: dump the RINEX data object
-            if(C.debug > -1)
-               Rdata.dump(LOGstrm,Rhead);
+               // is sat excluded?
+            if(find(C.exSats.begin(), C.exSats.end(), sat) != C.exSats.end())
+               continue;
+               // check for all sats of this system
+            else if(find(C.exSats.begin(), C.exSats.end(),
+                         RinexSatID(-1,sat.system)) != C.exSats.end())
+               continue;
 
-               // count this epoch
-            nepochs++;
+            const vector<RinexDatum>& vecData(it->second);
 
-               // check for data out of time order
-               // use < 1.e-3 not < 0 b/c inline header info (epochFlag > 1) excluded
-            if(prevObsTime != CommonTime::BEGINNING_OF_TIME
-               && Rdata.time-prevObsTime < 1.e-3)
+               // find this sat in the table; add it if necessary
+            vector<TableData>::iterator ptab;
+            map<RinexSatID, size_t>::iterator pind(tableIndex.find(sat));
+            if(pind != tableIndex.end())
+               ptab = table.begin() + pind->second;
+            else
             {
-                  // save it
-               if(!cacheon)
+                  // add it
+               tableIndex[sat] = table.size();
+               table.push_back(TableData(sat,nmaxobs));
+               ptab = table.end() - 1;
+               ptab->begin = lastObsTime;
+               if(C.dt > 0.0)
                {
-                     // new block
-                  cachetime.push_back(prevObsTime);
-                  cacheon = true;
-                  vector<Rinex3ObsData> v;
-                  cache.push_back(v);
+                  ptab->gapcount.push_back(ncount);      // start time
+                  ptab->gapcount.push_back(ncount-1);    // end time
                }
-               cache[cache.size()-1].push_back(Rdata);
-               continue;
             }
-            cacheon = false;
 
-               // look for gaps in the timetags
-            int ncount;
+               // update list of gap times
             if(C.dt > 0.0)
             {
-               ncount = int(0.5+(lastObsTime-firstObsTime)/C.dt);
-                  // update gap count
-               if(C.gapcount.size() == 0)
-               {
-                     // create the list
-                  C.gapcount.push_back(ncount);   // start time
-                  C.gapcount.push_back(ncount-1); // end time
-               }
-               i = C.gapcount.size() - 1;
-               if(ncount == C.gapcount[i] + 1)    // no gap
-                  C.gapcount[i] = ncount;
+               i = ptab->gapcount.size() - 1;         // index of curr end time
+               if(ncount == ptab->gapcount[i] + 1)    // no gap
+                  ptab->gapcount[i] = ncount;
                else
                {
                      // found a gap
-                  C.gapcount.push_back(ncount);   // start time
-                  C.gapcount.push_back(ncount);   // end time
+                  ptab->gapcount.push_back(ncount);   // start time
+                  ptab->gapcount.push_back(ncount);   // end time
                }
-
-                  // TD test after 50 epochs - wrong dt is disasterous
             }
 
-               // loop over satellites -------------------------------------
-            Rinex3ObsData::DataMap::const_iterator it;
-            for(it=Rdata.obs.begin(); it != Rdata.obs.end(); ++it)
+               // set the end time for this satellite to the current epoch
+            ptab->end = lastObsTime;
+            if(C.debug > -1)
             {
-               const RinexSatID& sat(it->first);
-
-                  // is sat included?
-               if(C.onlySats.size() > 0 &&
-                  find(C.onlySats.begin(), C.onlySats.end(), sat) == C.onlySats.end()
-                  && find(C.onlySats.begin(), C.onlySats.end(),
-                          RinexSatID(-1,sat.system)) == C.onlySats.end())
-                  continue;
+               oss.str("");
+               oss << "Sat " << setw(2) << sat;
+            }
 
-                  // is sat excluded?
-               if(find(C.exSats.begin(), C.exSats.end(), sat) != C.exSats.end())
-                  continue;
-                  // check for all sats of this system
-               else if(find(C.exSats.begin(), C.exSats.end(),
-                            RinexSatID(-1,sat.system)) != C.exSats.end())
-                  continue;
+               // first, find the current system...
+            char sysCode = sat.systemChar();
+            string sysStr(string(1,sysCode));
+            vector<int>& systotals(totals[sysCode]);
 
-               const vector<RinexDatum>& vecData(it->second);
+               // update Obs data totals
+            for(size_t index=0; index != vecData.size(); index++)
+            {
+               if(C.debug > -1)
+                  oss << " (" << index << ")";
 
-                  // find this sat in the table; add it if necessary
-               vector<TableData>::iterator ptab;
-               ptab = find(table.begin(),table.end(),TableData(sat,nmaxobs));
-               if(ptab == table.end())
+                  // if this observation is not zero, update it's total count
+               if(vecData[index].data != 0)
                {
-                     // add it
-                  table.push_back(TableData(sat,nmaxobs));
-                  ptab = find(table.begin(),table.end(),TableData(sat,nmaxobs));
-                  ptab->begin = lastObsTime;
-                  if(C.dt > 0.0)
-                  {
-                     ptab->gapcount.push_back(ncount);      // start time
-                     ptab->gapcount.push_back(ncount-1);    // end time
-                  }
+                  (ptab->nobs)[index]++;                 // per obs
+                  if(systotals.size() == 0)
+                     systotals = vector<int>(vecData.size());
+                  systotals[index]++;                    // per system
                }
 
-                  // update list of gap times
-               if(C.dt > 0.0)
+                  // if looking for milliseconds, update handler
+               if(C.doms && vecData[index].data != 0)
                {
-                  i = ptab->gapcount.size() - 1;         // index of curr end time
-                  if(ncount == ptab->gapcount[i] + 1)    // no gap
-                     ptab->gapcount[i] = ncount;
-                  else
+                  tag = sysStr + Rhead.mapObsTypes[sysStr][index].asString();
+                  if(vectorindex(msots,tag) != -1)
                   {
-                        // found a gap
-                     ptab->gapcount.push_back(ncount);   // start time
-                     ptab->gapcount.push_back(ncount);   // end time
+                     msh.add(lastObsTime, sat, tag, vecData[index].data);
                   }
                }
 
-                  // set the end time for this satellite to the current epoch
-               ptab->end = lastObsTime;
                if(C.debug > -1)
-               {
-                  oss.str("");
-                  oss << "Sat " << setw(2) << sat;
-               }
+                  oss << fixed << setprecision(3)
+                      << " " << asString(Rhead.mapObsTypes[sysStr][index])
+                      << " " << setw(13) << vecData[index].data
+                      << " " << vecData[index].lli
+                      << " " << vecData[index].ssi;
 
-                  // first, find the current system...
-               char sysCode = sat.systemChar();
-               string sysStr(string(1,sysCode));
+            } // end loop over observations
 
-                  // update Obs data totals
-               for(size_t index=0; index != vecData.size(); index++)
-               {
-                  if(C.debug > -1)
-                     oss << " (" << index << ")";
+            if(C.debug > -1)
+               LOG(DEBUG) << oss.str();
+
+         }  // end loop over satellites
 
-                     // if this observation is not zero, update it's total count
-                  if(vecData[index].data != 0)
+         if(prevObsTime != CommonTime::BEGINNING_OF_TIME)
+         {
+            dt = lastObsTime-prevObsTime;
+            if(dt > 0.0)
+            {
+               for(i=0; i<ndtmax; i++)
+               {
+                  if(ndt[i] <= 0)
                   {
-                     (ptab->nobs)[index]++;                 // per obs
-                     if(totals[sysCode].size() == 0)
-                        totals[sysCode] = vector<int>(vecData.size());
-                     totals[sysCode][index]++;              // per system
+                     bestdt[i]=dt;
+                     ndt[i]=1;
+                     break;
                   }
-
-                     // if looking for milliseconds, update handler
-                  if(C.doms && vecData[index].data != 0)
+                  if(fabs(dt-bestdt[i]) < 0.0001)
                   {
-                     tag = sysStr + Rhead.mapObsTypes[sysStr][index].asString();
-                     if(vectorindex(msots,tag) != -1)
-                     {
-                        C.msh.add(lastObsTime, sat, tag, vecData[index].data);
-                     }
+                     ndt[i]++;
+                     break;
                   }
-
-                  if(C.debug > -1)
-                     oss << fixed << setprecision(3)
-                         << " " << asString(Rhead.mapObsTypes[sysStr][index])
-                         << " " << setw(13) << vecData[index].data
-                         << " " << vecData[index].lli
-                         << " " << vecData[index].ssi;
-
-               } // end loop over observations
-
-               if(C.debug > -1)
-                  LOG(DEBUG) << oss.str();
-
-            }  // end loop over satellites
-
-            if(prevObsTime != CommonTime::BEGINNING_OF_TIME)
-            {
-               dt = lastObsTime-prevObsTime;
-               if(dt > 0.0)
-               {
-                  for(i=0; i<ndtmax; i++)
+                  if(i == ndtmax-1)
                   {
-                     if(ndt[i] <= 0)
-                     {
-                        bestdt[i]=dt;
-                        ndt[i]=1;
-                        break;
-                     }
-                     if(fabs(dt-bestdt[i]) < 0.0001)
-                     {
-                        ndt[i]++;
-                        break;
-                     }
-                     if(i == ndtmax-1)
+                     k = 0;
+                     int nleast = ndt[k];
+                     for(j=1; j<ndtmax; j++)
                      {
-                        k = 0;
-                        int nleast = ndt[k];
-                        for(j=1; j<ndtmax; j++)
+                        if(ndt[j] <= nleast)
                         {
-                           if(ndt[j] <= nleast)
-                           {
-                              k = j;
-                              nleast = ndt[j];
-                           }
+                           k = j;
+                           nleast = ndt[j];
                         }
-                        ndt[k] = 1;
-                        bestdt[k] = dt;
                      }
+                     ndt[k] = 1;
+                     bestdt[k] = dt;
                   }
                }
-               else if(dt == 0)
-               {
-                  LOG(WARNING) << "Warning - repeated time tag at "
-                               << printTime(lastObsTime,C.longfmt);
-               }
-               else
-               {
-                  LOG(WARNING) << "Warning - time tags out of order: "
-                               << printTime(prevObsTime,C.longfmt) << " > "
-                               << printTime(lastObsTime,C.longfmt);
-                     //<< " " << scientific << setprecision(4) << dt;
-               }
             }
-            prevObsTime = lastObsTime;
+            else if(dt == 0)
+            {
+               LOG(WARNING) << "Warning - repeated time tag at "
+                            << printTime(lastObsTime,C.longfmt);
+            }
+            else
+            {
+               LOG(WARNING) << "Warning - time tags out of order: "
+                            << printTime(prevObsTime,C.longfmt) << " > "
+                            << printTime(lastObsTime,C.longfmt);
+                  //<< " " << scientific << setprecision(4) << dt;
+            }
+         }
+         prevObsTime = lastObsTime;
 
-         }  // end while loop over epochs
+      }  // end while loop over epochs
 
-         istrm.close();
+      istrm.close();
 
-            // check that we found some data
-         if(nepochs <= 0)
-         {
-            LOG(INFO) << "File " << filename
-                      << " : no data found. Are time limits wrong?";
-            continue;
-         }
+         // check that we found some data
+      if(nepochs <= 0)
+      {
+         LOG(INFO) << "File " << filename
+                   << " : no data found. Are time limits wrong?";
+         return 5;
+      }
 
-            // Compute interval -------------------------------------------------
-         for(i=1,j=0; i < ndtmax; i++)
-         {
-            if(ndt[i] > ndt[j])
-               j = i;
-            dt = bestdt[j];
-         }
+         // Compute interval -------------------------------------------------
+      for(i=1,j=0; i < ndtmax; i++)
+      {
+         if(ndt[i] > ndt[j])
+            j = i;
+         dt = bestdt[j];
+      }
 
-            // Summary info -----------------------------------------------------
-         LOG(INFO) << "Computed interval " << fixed << setw(5) << setprecision(2)
-                   << dt << " seconds.";
-         LOG(INFO) << "Computed first epoch: " << printTime(firstObsTime,C.longfmt);
-         LOG(INFO) << "Computed last  epoch: " << printTime(lastObsTime,C.longfmt);
-      
-            // compute time span of dataset in days/hours/minutes/seconds
-         oss.str("");
-         oss << "Computed time span: ";
-         double secs = lastObsTime - firstObsTime;
-         int remainder = int(secs);
-         CivilTime delta(firstObsTime);
-         delta.day    = remainder / 86400; remainder %= 86400;
-         delta.hour   = remainder / 3600;  remainder %= 3600;
-         delta.minute = remainder / 60;    remainder %= 60;
-         delta.second = remainder;
-         if(delta.day > 0)
-            oss << delta.day << "d ";
-
-         LOG(INFO) << oss.str() << delta.hour << "h " << delta.minute << "m "
-                   << delta.second << "s = " << secs << " seconds.";
-
-         //LOG(INFO) << "Computed file size: " << filesize << " bytes.";
-
-            // Reusing secs, as it is equivalent to the original expression
-            // i = 1+int(0.5+(lastObsTime-firstObsTime)/dt);
-         i = 1+int(0.5 + secs / dt);
-
-         LOG(INFO) << "There were " << nepochs << " epochs ("
-                   << fixed << setprecision(2) << double(nepochs*100)/i
-                   << "% of " << i << " possible epochs in this timespan) and "
-                   << ncommentblocks << " inline header blocks.";
-
-            // Sort table
-         if(C.sorttime)
-            sort(table.begin(),table.end(),TableBegLessThan());
-         else
-            sort(table.begin(),table.end(),TableSATLessThan());
+         // Summary info -----------------------------------------------------
+      LOG(INFO) << "Computed interval " << fixed << setw(5) << setprecision(2)
+                << dt << " seconds.";
+      LOG(INFO) << "Computed first epoch: " << printTime(firstObsTime,C.longfmt);
+      LOG(INFO) << "Computed last  epoch: " << printTime(lastObsTime,C.longfmt);
+
+         // compute time span of dataset in days/hours/minutes/seconds
+      oss.str("");
+      oss << "Computed time span: ";
+      double secs = lastObsTime - firstObsTime;
+      int remainder = int(secs);
+      CivilTime delta(firstObsTime);
+      delta.day    = remainder / 86400; remainder %= 86400;
+      delta.hour   = remainder / 3600;  remainder %= 3600;
+      delta.minute = remainder / 60;    remainder %= 60;
+      delta.second = remainder;
+      if(delta.day > 0)
+         oss << delta.day << "d ";
+
+      LOG(INFO) << oss.str() << delta.hour << "h " << delta.minute << "m "
+                << delta.second << "s = " << secs << " seconds.";
+
+      //LOG(INFO) << "Computed file size: " << filesize << " bytes.";
+
+         // Reusing secs, as it is equivalent to the original expression
+         // i = 1+int(0.5+(lastObsTime-firstObsTime)/dt);
+      i = 1+int(0.5 + secs / dt);
+
+      LOG(INFO) << "There were " << nepochs << " epochs ("
+                << fixed << setprecision(2) << double(nepochs*100)/i
+                << "% of " << i << " possible epochs in this timespan) and "
+                << ncommentblocks << " inline header blocks.";
+
+         // Sort table
+      if(C.sorttime)
+         sort(table.begin(),table.end(),TableBegLessThan());
+      else
+         sort(table.begin(),table.end(),TableSATLessThan());
 
-            // output table
-            // header
-         vector<TableData>::iterator tabIt;
-         if(table.size() > 0)
-            table.begin()->sat.setfill('0');
+         // output table
+         // header
+      vector<TableData>::iterator tabIt;
+      if(table.size() > 0)
+         table.begin()->sat.setfill('0');
 
-         if(!C.brief && !C.notab)
+      if(!C.brief && !C.notab)
+      {
+            // non-brief output ------------
+         LOG(INFO) << "\n      Summary of data available in this file: "
+                   << "(Spans are based on times and interval)";
+         string fmt(C.gpstime ? C.gpsfmt : C.calfmt);
+         j = 0;
+         for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
          {
-               // non-brief output ------------
-            LOG(INFO) << "\n      Summary of data available in this file: "
-                      << "(Spans are based on times and interval)";
-            string fmt(C.gpstime ? C.gpsfmt : C.calfmt);
-            j = 0;
-            for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
-            {
-               RinexSatID sat(sit->first);
-
-               map<char, vector<int> >::const_iterator totalsIter;
-                  // compute grand total first
-               totalsIter = totals.find((sit->first)[0]);
-               const vector<int>& vec = totalsIter->second;
-               for(i=0,k=0; k<vec.size(); k++) i += vec[k];
-               if(i == 0)
-                  continue;
+            RinexSatID sat(sit->first);
 
-                  // print the table
-               if(++j > 1)
-                  LOG(INFO) << "";
-               LOG(INFO) << "System " << sit->first <<" = "<< sat.systemString() << ":";
-               oss.str("");
-               oss << " Sat\\OT:";
+            map<char, vector<int> >::const_iterator totalsIter;
+               // compute grand total first
+            totalsIter = totals.find((sit->first)[0]);
+            const vector<int>& vec = totalsIter->second;
+            for(i=0,k=0; k<vec.size(); k++) i += vec[k];
+            if(i == 0)
+               continue;
+
+               // print the table
+            if(++j > 1)
+               LOG(INFO) << "";
+            LOG(INFO) << "System " << sit->first <<" = "<< sat.systemString() << ":";
+            oss.str("");
+            oss << " Sat\\OT:";
 
-                  // print line of RINEX 3 codes
-               for(k=0; k < (sit->second).size(); k++)
-                     //oss << setw(k==0?4:7) << asString((sit->second)[k]);
-                  oss << setw(k==0?4:7) << (sit->second)[k].asString();
-               LOG(INFO) << oss.str() << "   Span             Begin time - End time";
+               // print line of RINEX 3 codes
+            for(k=0; k < (sit->second).size(); k++)
+                  //oss << setw(k==0?4:7) << asString((sit->second)[k]);
+               oss << setw(k==0?4:7) << (sit->second)[k].asString();
+            LOG(INFO) << oss.str() << "   Span             Begin time - End time";
 
-                  // print the table
-               for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+               // print the table
+            for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+            {
+               std::string sysChar;
+               sysChar += (tabIt->sat).systemChar();
+               if((sit->first) == sysChar)
                {
-                  std::string sysChar;
-                  sysChar += (tabIt->sat).systemChar();
-                  if((sit->first) == sysChar)
-                  {
-                     oss.str("");
-                     oss << " " << tabIt->sat << " ";
-                     size_t obsSize = (Rhead.mapObsTypes.find(sysChar)->second).size();
-                     for(k = 0; k < obsSize; k++)
-                        oss << setw(7) << tabIt->nobs[k];
+                  oss.str("");
+                  oss << " " << tabIt->sat << " ";
+                  size_t obsSize = (Rhead.mapObsTypes.find(sysChar)->second).size();
+                  for(k = 0; k < obsSize; k++)
+                     oss << setw(7) << tabIt->nobs[k];
 
-                     oss << setw(7) << 1+int(0.5+(tabIt->end-tabIt->begin)/dt);
+                  oss << setw(7) << 1+int(0.5+(tabIt->end-tabIt->begin)/dt);
 
-                     LOG(INFO) << oss.str() << "  " << printTime(tabIt->begin,fmt)
-                               << " - " << printTime(tabIt->end,fmt);
-                  }
+                  LOG(INFO) << oss.str() << "  " << printTime(tabIt->begin,fmt)
+                            << " - " << printTime(tabIt->end,fmt);
                }
-
-               oss.str("");
-               oss << "TOTAL";
-               for(k=0; k<vec.size(); k++) oss << setw(7) << vec[k];
-               LOG(INFO) << oss.str();
             }
-            LOG(INFO) << "";
+
+            oss.str("");
+            oss << "TOTAL";
+            for(k=0; k<vec.size(); k++) oss << setw(7) << vec[k];
+            LOG(INFO) << oss.str();
          }
-         else
+         LOG(INFO) << "";
+      }
+      else
+      {
+            // brief output ---------------
+            // output satellites
+         oss.str(""); oss << "SATs(" << table.size() << "):";
+         i = 0;
+         for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
          {
-               // brief output ---------------
-               // output satellites
-            oss.str(""); oss << "SATs(" << table.size() << "):";
-            i = 0;
-            for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+            oss << " " << tabIt->sat;
+            if((++i % 20) == 0)
             {
-               oss << " " << tabIt->sat;
-               if((++i % 20) == 0)
-               {
-                  LOG(INFO) << oss.str();
-                  oss.str(""); i=0;
-                  oss << "SATs ...:";
-               }
+               LOG(INFO) << oss.str();
+               oss.str(""); i=0;
+               oss << "SATs ...:";
             }
-            LOG(INFO) << oss.str();
+         }
+         LOG(INFO) << oss.str();
 
-               // output obs types
-            sit = Rhead.mapObsTypes.begin();
-            for( ; sit != Rhead.mapObsTypes.end(); ++sit)
-            {
-               string sysCode = (sit->first);
-               vector<RinexObsID>& vec = Rhead.mapObsTypes[sysCode];
+            // output obs types
+         sit = Rhead.mapObsTypes.begin();
+         for( ; sit != Rhead.mapObsTypes.end(); ++sit)
+         {
+            string sysCode = (sit->first);
+            vector<RinexObsID>& vec = Rhead.mapObsTypes[sysCode];
 
-                  // is this system found in the list of sats?
-               map<char, vector<int> >::const_iterator totalsIter;
-               totalsIter = totals.find(sysCode[0]);
-               const vector<int>& vectot = totalsIter->second;
-               for(i=0,k=0; k<vectot.size(); k++) i += vectot[k];
-               if(i == 0)
-                  continue;    // no, skip it
+               // is this system found in the list of sats?
+            map<char, vector<int> >::const_iterator totalsIter;
+            totalsIter = totals.find(sysCode[0]);
+            const vector<int>& vectot = totalsIter->second;
+            for(i=0,k=0; k<vectot.size(); k++) i += vectot[k];
+            if(i == 0)
+               continue;    // no, skip it
 
-               oss.str("");
-               oss << "System " << RinexSatID(sysCode).systemString3()
-                   << " Obs types(" << vec.size() << "): ";
+            oss.str("");
+            oss << "System " << RinexSatID(sysCode).systemString3()
+                << " Obs types(" << vec.size() << "): ";
 
-               for(i=0; i<vec.size(); i++) oss << " " << vec[i].asString();
+            for(i=0; i<vec.size(); i++) oss << " " << vec[i].asString();
 
-                  // if RINEX ver. 2, then add ver 2 obstypes in parentheses
-                  //map<string, map<string, RinexObsID> > Rinex3ObsHeader::mapSysR2toR3ObsID
-                  //Rhead.mapSysR2toR3ObsID[sys][ot2] = OT3;
-               if(Rhead.version < 3)
+               // if RINEX ver. 2, then add ver 2 obstypes in parentheses
+               //map<string, map<string, RinexObsID> > Rinex3ObsHeader::mapSysR2toR3ObsID
+               //Rhead.mapSysR2toR3ObsID[sys][ot2] = OT3;
+            if(Rhead.version < 3)
+            {
+               oss << " [v2:";
+               for(i=0; i<vec.size(); i++)
                {
-                  oss << " [v2:";
-                  for(i=0; i<vec.size(); i++)
+                  map<string,RinexObsID>::iterator it;
+                  for(it = Rhead.mapSysR2toR3ObsID[sysCode].begin();
+                      it != Rhead.mapSysR2toR3ObsID[sysCode].end(); ++it)
                   {
-                     map<string,RinexObsID>::iterator it;
-                     for(it = Rhead.mapSysR2toR3ObsID[sysCode].begin();
-                         it != Rhead.mapSysR2toR3ObsID[sysCode].end(); ++it)
+                     if(it->second == vec[i])
                      {
-                        if(it->second == vec[i])
-                        {
-                           oss << " " << it->first;
-                           break;
-                        }
+                        oss << " " << it->first;
+                        break;
                      }
                   }
-                  oss << "]";
                }
-
-               LOG(INFO) << oss.str();
+               oss << "]";
             }
+
+            LOG(INFO) << oss.str();
          }
+      }
 
-            // gaps
-         if(C.dogaps)
+         // gaps
+      if(C.dogaps)
+      {
+            // summary of gaps using count
+         oss.str("");
+         oss << "Summary of gaps (vs count) in the data in this file, "
+             << "assuming dt = " << C.dt << " sec.\n";
+         if(C.dt != dt)
+            oss << " Warning - computed dt does not match input dt\n";
+         oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
+             << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
+         oss << "    Sat    beg - end (count,size) ... "
+             << "[count = # of dt's from first epoch]\n";
+            // print for timetags = all sats
+         k = gapcount.size()-1;               // size() is at least 2
+         oss << "GAP ALL " << setw(5) << gapcount[0]
+             << " - " << setw(5) << gapcount[k];
+
+            // NB DO NOT make ii size_t
+         for(ii=1; ii<=k-2; ii+=2)
+            oss << " (" << gapcount[ii]+1                          // begin of gap
+                << "," << gapcount[ii+1]-gapcount[ii]-1 << ")";   // size
+         oss << endl;
+
+            // loop over sats
+         for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
          {
-               // summary of gaps using count
-            oss.str("");
-            oss << "Summary of gaps (vs count) in the data in this file, "
-                << "assuming dt = " << C.dt << " sec.\n";
-            if(C.dt != dt)
-               oss << " Warning - computed dt does not match input dt\n";
-            oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
-                << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
-            oss << "    Sat    beg - end (count,size) ... "
-                << "[count = # of dt's from first epoch]\n";
-               // print for timetags = all sats
-            k = C.gapcount.size()-1;               // size() is at least 2
-            oss << "GAP ALL " << setw(5) << C.gapcount[0]
-                << " - " << setw(5) << C.gapcount[k];
-
+            k = tabIt->gapcount.size() - 1;
+            oss << "GAP " << tabIt->sat << " " << setw(5) << tabIt->gapcount[0]
+                << " - " << setw(5) << tabIt->gapcount[k];
                // NB DO NOT make ii size_t
             for(ii=1; ii<=k-2; ii+=2)
-               oss << " (" << C.gapcount[ii]+1                          // begin of gap
-                   << "," << C.gapcount[ii+1]-C.gapcount[ii]-1 << ")";   // size
+               oss << " (" << tabIt->gapcount[ii]+1 << ","      // begin count of gap
+                   << tabIt->gapcount[ii+1]-tabIt->gapcount[ii]-1 << ")";   // size
             oss << endl;
+         }
 
-               // loop over sats
-            for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
-            {
-               k = tabIt->gapcount.size() - 1;
-               oss << "GAP " << tabIt->sat << " " << setw(5) << tabIt->gapcount[0]
-                   << " - " << setw(5) << tabIt->gapcount[k];
-                  // NB DO NOT make ii size_t
-               for(ii=1; ii<=k-2; ii+=2)
-                  oss << " (" << tabIt->gapcount[ii]+1 << ","      // begin count of gap
-                      << tabIt->gapcount[ii+1]-tabIt->gapcount[ii]-1 << ")";   // size
-               oss << endl;
-            }
-
-            tag = oss.str(); stripTrailing(tag,"\n");
-            LOG(INFO) << tag;
-
-               // summary of gaps using sow
-            oss.str("");
-            double t(static_cast<GPSWeekSecond>(firstObsTime).sow), d(C.dt);
-            oss << "\nSummary of gaps (vs SOW) in the data in this file, assuming dt = "
-                << C.dt << " sec.\n";
-            if(C.dt != dt)
-               oss << " Warning - computed dt does not match input dt\n";
-            oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
-                << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
-            oss << "    Sat      beg -      end (sow,number of missing points)\n";
+         tag = oss.str(); stripTrailing(tag,"\n");
+         LOG(INFO) << tag;
 
-               // print for timetags = all sats
-            k = C.gapcount.size()-1;               // size() is at least 2
-            oss << "GAP ALL " << fixed << setprecision(1) << setw(8) << t+d*C.gapcount[0]
-                << " - " << setw(8) << t+d*C.gapcount[k];
+            // summary of gaps using sow
+         oss.str("");
+         double t(static_cast<GPSWeekSecond>(firstObsTime).sow), d(C.dt);
+         oss << "\nSummary of gaps (vs SOW) in the data in this file, assuming dt = "
+             << C.dt << " sec.\n";
+         if(C.dt != dt)
+            oss << " Warning - computed dt does not match input dt\n";
+         oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
+             << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
+         oss << "    Sat      beg -      end (sow,number of missing points)\n";
+
+            // print for timetags = all sats
+         k = gapcount.size()-1;               // size() is at least 2
+         oss << "GAP ALL " << fixed << setprecision(1) << setw(8) << t+d*gapcount[0]
+             << " - " << setw(8) << t+d*gapcount[k];
+            // NB DO NOT make ii size_t
+         for(ii=1; ii<=k-2; ii+=2)
+            oss << " (" << t+d*(gapcount[ii]+1)                    // begin of gap
+                << "," << gapcount[ii+1]-gapcount[ii]-1 << ")";   // size
+         oss << endl;
+
+            // loop over sats
+         for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+         {
+            k = tabIt->gapcount.size() - 1;
+            oss << "GAP " << tabIt->sat << " " << fixed << setprecision(1)
+                << setw(8) << t+d*tabIt->gapcount[0]
+                << " - " << setw(8) << t+d*tabIt->gapcount[k];
                // NB DO NOT make ii size_t
             for(ii=1; ii<=k-2; ii+=2)
-               oss << " (" << t+d*(C.gapcount[ii]+1)                    // begin of gap
-                   << "," << C.gapcount[ii+1]-C.gapcount[ii]-1 << ")";   // size
+               oss << " (" << t+d*(tabIt->gapcount[ii]+1) << ","  // begin sow of gap
+                   << tabIt->gapcount[ii+1]-tabIt->gapcount[ii]-1 << ")";   // size
             oss << endl;
+         }
 
-               // loop over sats
-            for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+         tag = oss.str(); stripTrailing(tag,"\n");
+         LOG(INFO) << tag;
+
+            // visibility
+         if(C.vres > 0)
+         {
+               // print visibility graphically, resolution C.vres = counts/character
+            double dn(static_cast<double>(C.vres));
+            oss.str("");
+            oss << "\nVisibility - resolution is " << dn << " epochs = " << dn*C.dt
+                << " seconds.\n";
+            oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
+                << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
+            oss << "VIS ALL ";
+            bool isOn(false);
+            for(k=0,i=0; i<gapcount.size()-1; i+=2)
             {
-               k = tabIt->gapcount.size() - 1;
-               oss << "GAP " << tabIt->sat << " " << fixed << setprecision(1)
-                   << setw(8) << t+d*tabIt->gapcount[0]
-                   << " - " << setw(8) << t+d*tabIt->gapcount[k];
-                  // NB DO NOT make ii size_t
-               for(ii=1; ii<=k-2; ii+=2)
-                  oss << " (" << t+d*(tabIt->gapcount[ii]+1) << ","  // begin sow of gap
-                      << tabIt->gapcount[ii+1]-tabIt->gapcount[ii]-1 << ")";   // size
-               oss << endl;
+               ii = int(double(gapcount[i]/dn));
+               if(ii-k > 0)
+               {
+                  oss << string(ii-k,' ');
+                  k = ii;
+                  isOn = false;
+               }
+               ii = int(double(gapcount[i+1]/dn));
+               if(ii-k > 0)
+               {
+                  if(isOn)
+                  {
+                     oss << "x";
+                     ii--;
+                  }
+                  oss << string(ii-k,'X');
+                  k = ii;
+                  isOn = true;
+               }
             }
+            LOG(INFO) << oss.str();
 
-            tag = oss.str(); stripTrailing(tag,"\n");
-            LOG(INFO) << tag;
+               // timetable of visibility, resolution dn epochs
+               // to get resolution = 1 epoch, remove isOn, kk and //RES=1
+            multimap<int,string> vtab;
 
-               // visibility
-            if(C.vres > 0)
+               // loop over sats
+               //ostringstream ossvt;
+            for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
             {
-                  // print visibility graphically, resolution C.vres = counts/character
-               double dn(static_cast<double>(C.vres));
                oss.str("");
-               oss << "\nVisibility - resolution is " << dn << " epochs = " << dn*C.dt
-                   << " seconds.\n";
-               oss << " First epoch = " << printTime(firstObsTime,C.longfmt)
-                   << " and last epoch = " << printTime(lastObsTime,C.longfmt) << endl;
-               oss << "VIS ALL ";
-               bool isOn(false);
-               for(k=0,i=0; i<C.gapcount.size()-1; i+=2)
+               oss << "VIS " << tabIt->sat << " ";
+
+               isOn = false;
+               bool first(true);
+               int jj,kk(static_cast<int>(tabIt->gapcount[0]/dn)); // + 0.5);
+               for(k=0,i=0; i<tabIt->gapcount.size()-1; i+=2)
                {
-                  ii = int(double(C.gapcount[i]/dn));
-                  if(ii-k > 0)
+                     // satellite 'off'
+                  j = int(double(tabIt->gapcount[i]/dn));
+                  if(!first)
+                  {
+                     vtab.insert(multimap<int, string>::value_type(
+                                    kk, string("-")+asString(tabIt->sat)));
+                     kk = j;
+                  }
+                  first = false;
+                  jj = j-k;
+                  if(jj > 0)
                   {
-                     oss << string(ii-k,' ');
-                     k = ii;
                      isOn = false;
+                     oss << string(jj,' ');
+                     k = j;
                   }
-                  ii = int(double(C.gapcount[i+1]/dn));
-                  if(ii-k > 0)
+                     // satellite 'on'
+                  j = int(double(tabIt->gapcount[i+1]/dn));
+                  vtab.insert(multimap<int, string>::value_type(
+                                 kk, string("+")+asString(tabIt->sat)));
+                  kk = j;
+                  jj = j-k;
+                  if(jj > 0)
                   {
-                     if(isOn)
+                     if(!isOn)
+                     {
+                        isOn = true;
+                     }
+                     else
                      {
                         oss << "x";
-                        ii--;
+                        jj--;
                      }
-                     oss << string(ii-k,'X');
-                     k = ii;
-                     isOn = true;
+                     oss << string(jj,'X');
+                     k = j;
                   }
                }
+               vtab.insert(multimap<int, string>::value_type(
+                              kk, string("-")+asString(tabIt->sat)));
                LOG(INFO) << oss.str();
+            }
 
-                  // timetable of visibility, resolution dn epochs
-                  // to get resolution = 1 epoch, remove isOn, kk and //RES=1
-               multimap<int,string> vtab;
-
-                  // loop over sats
-                  //ostringstream ossvt;
-               for(tabIt = table.begin(); tabIt != table.end(); ++tabIt)
+            if(C.vistab)
+            {
+               LOG(INFO) << "\n Visibility Timetable - resolution is "
+                         << dn << " epochs = " << dn*C.dt << " seconds.\n"
+                         << " First epoch = " << printTime(firstObsTime,C.longfmt)
+                         << " and last epoch = " << printTime(lastObsTime,C.longfmt) << "\n"
+                         << "     YYYY/MM/DD HH:MM:SS = week d secs-of-wk Xtot count  nX  "
+                         << "seconds nsats visible satellites";
+               j = k = 0;
+               CommonTime ttag(firstObsTime);
+               vector<string> sats;
+               multimap<int,string>::const_iterator vt;
+               vt = vtab.begin();
+               while(vt != vtab.end())
                {
-                  oss.str("");
-                  oss << "VIS " << tabIt->sat << " ";
-
-                  isOn = false;
-                  bool first(true);
-                  int jj,kk(static_cast<int>(tabIt->gapcount[0]/dn)); // + 0.5);
-                  for(k=0,i=0; i<tabIt->gapcount.size()-1; i+=2)
+                  while(vt != vtab.end() && vt->first == k)
                   {
-                        // satellite 'off'
-                     j = int(double(tabIt->gapcount[i]/dn));
-                     if(!first)
+                     string str(vt->second);
+                     if(str[0] == '+')
                      {
-                        vtab.insert(multimap<int, string>::value_type(
-                                       kk, string("-")+asString(tabIt->sat)));
-                        kk = j;
+                           //LOG(INFO) << "Add " << str.substr(1);
+                        sats.push_back(str.substr(1));
                      }
-                     first = false;
-                     jj = j-k;
-                     if(jj > 0)
+                     else
                      {
-                        isOn = false;
-                        oss << string(jj,' ');
-                        k = j;
-                     }
-                        // satellite 'on'
-                     j = int(double(tabIt->gapcount[i+1]/dn));
-                     vtab.insert(multimap<int, string>::value_type(
-                                    kk, string("+")+asString(tabIt->sat)));
-                     kk = j;
-                     jj = j-k;
-                     if(jj > 0)
-                     {
-                        if(!isOn)
-                        {
-                           isOn = true;
-                        }
-                        else
+                        vector<string>::iterator fsat;
+                        fsat = find(sats.begin(),sats.end(),str.substr(1));
+                        if(fsat != sats.end())
                         {
-                           oss << "x";
-                           jj--;
+                           sats.erase(fsat);
                         }
-                        oss << string(jj,'X');
-                        k = j;
                      }
+                     ++vt;
                   }
-                  vtab.insert(multimap<int, string>::value_type(
-                                 kk, string("-")+asString(tabIt->sat)));
-                  LOG(INFO) << oss.str();
-               }
 
-               if(C.vistab)
-               {
-                  LOG(INFO) << "\n Visibility Timetable - resolution is "
-                            << dn << " epochs = " << dn*C.dt << " seconds.\n"
-                            << " First epoch = " << printTime(firstObsTime,C.longfmt)
-                            << " and last epoch = " << printTime(lastObsTime,C.longfmt) << "\n"
-                            << "     YYYY/MM/DD HH:MM:SS = week d secs-of-wk Xtot count  nX  "
-                            << "seconds nsats visible satellites";
-                  j = k = 0;
-                  CommonTime ttag(firstObsTime);
-                  vector<string> sats;
-                  multimap<int,string>::const_iterator vt;
-                  vt = vtab.begin();
-                  while(vt != vtab.end())
-                  {
-                     while(vt != vtab.end() && vt->first == k)
-                     {
-                        string str(vt->second);
-                        if(str[0] == '+')
-                        {
-                              //LOG(INFO) << "Add " << str.substr(1);
-                           sats.push_back(str.substr(1));
-                        }
-                        else
-                        {
-                           vector<string>::iterator fsat;
-                           fsat = find(sats.begin(),sats.end(),str.substr(1));
-                           if(fsat != sats.end())
-                           {
-                              sats.erase(fsat);
-                           }
-                        }
-                        ++vt;
-                     }
+                  ttag += (k-j)*C.dt*dn;
 
-                     ttag += (k-j)*C.dt*dn;
+                  if(vt == vtab.end())
+                     break;
 
-                     if(vt == vtab.end())
-                        break;
+                  sort(sats.begin(),sats.end());
 
-                     sort(sats.begin(),sats.end());
+                  oss.str("");
+                  oss << "VTAB " << setw(4) << printTime(ttag,C.longfmt)
+                      << " " << setw(4) << k
+                      << " " << setw(5) << k*C.vres
+                      << " " << setw(3) << vt->first - k
+                      << fixed << setprecision(1)
+                      << " " << setw(8) << (vt->first-k)*C.dt*dn
+                      << " " << setw(5) << sats.size();
+                  for(i=0; i<sats.size(); i++) oss << " " << sats[i];
+                  LOG(INFO) << oss.str();
 
-                     oss.str("");
-                     oss << "VTAB " << setw(4) << printTime(ttag,C.longfmt)
-                         << " " << setw(4) << k
-                         << " " << setw(5) << k*C.vres
-                         << " " << setw(3) << vt->first - k
-                         << fixed << setprecision(1)
-                         << " " << setw(8) << (vt->first-k)*C.dt*dn
-                         << " " << setw(5) << sats.size();
-                     for(i=0; i<sats.size(); i++) oss << " " << sats[i];
-                     LOG(INFO) << oss.str();
-
-                     j = k;
-                     k = vt->first;
-                  }
-                  LOG(INFO) << "VTAB " << setw(4) << printTime(ttag,C.longfmt)
-                            << " " << setw(4) << k
-                            << " " << setw(5) << int(0.5+(ttag-firstObsTime)/C.dt)
-                            << " END";
+                  j = k;
+                  k = vt->first;
                }
+               LOG(INFO) << "VTAB " << setw(4) << printTime(ttag,C.longfmt)
+                         << " " << setw(4) << k
+                         << " " << setw(5) << int(0.5+(ttag-firstObsTime)/C.dt)
+                         << " END";
+            }
 
-            }  // end if C.vres > 0 (user chose vis output)
-         }
+         }  // end if C.vres > 0 (user chose vis output)
+      }
 
-            // output milliseconds
-         if(C.doms)
-         {
-            C.msh.afterAddbeforeFix();
+         // output milliseconds
+      if(C.doms)
+      {
+         msh.afterAddbeforeFix();
 
-               // true b/c no fixing, but false b/c editing commands follow
-            LOG(INFO) << C.msh.getFindMessage(false);
+            // true b/c no fixing, but false b/c editing commands follow
+         LOG(INFO) << msh.getFindMessage(false);
 
-            vector<string> cmds = C.msh.getEditCommands();
-            for(i=0; i<cmds.size(); i++)
-               LOG(INFO) << cmds[i] << " # edit cmd for millisecond clock adjust";
-            LOG(INFO) << "";
-         }
+         vector<string> cmds = msh.getEditCommands();
+         for(i=0; i<cmds.size(); i++)
+            LOG(INFO) << cmds[i] << " # edit cmd for millisecond clock adjust";
+         LOG(INFO) << "";
+      }
 
-            // Warnings ------------------------------------------------------------
-            // there were records out of time order
-         if(cache.size() > 0)
-         {
-            for(i=0; i<cache.size(); i++)
-               LOG(INFO) << " Warning: " << setw(4) << cache[i].size()
-                         << " data records following epoch "
-                         << printTime(cachetime[i],C.calfmt) << " are out of time order,"
-                         << "\n         with epochs " << printTime(cache[i][0].time,C.calfmt)
-                         << " to " << printTime(cache[i][cache[i].size()-1].time,C.calfmt)
-                         << endl;
-         }
+         // Warnings ------------------------------------------------------------
+         // there were records out of time order
+      if(cache.size() > 0)
+      {
+         for(i=0; i<cache.size(); i++)
+            LOG(INFO) << " Warning: " << setw(4) << cache[i].count
+                      << " data records following epoch "
+                      << printTime(cache[i].prevTime,C.calfmt) << " are out of time order,"
+                      << "\n         with epochs " << printTime(cache[i].firstTime,C.calfmt)
+                      << " to " << printTime(cache[i].lastTime,C.calfmt)
+                      << endl;
+      }
 
-         if((Rhead.valid & Rinex3ObsHeader::validInterval)
-            && fabs(dt-Rhead.interval) > 1.e-3)
-            LOG(INFO) << " Warning - Computed interval is " << setprecision(2)
-                      << dt << " sec, while input header has " << setprecision(2)
-                      << Rhead.interval << " sec.";
+      if((Rhead.valid & Rinex3ObsHeader::validInterval)
+         && fabs(dt-Rhead.interval) > 1.e-3)
+         LOG(INFO) << " Warning - Computed interval is " << setprecision(2)
+                   << dt << " sec, while input header has " << setprecision(2)
+                   << Rhead.interval << " sec.";
 
-         if(C.beginTime == CommonTime::BEGINNING_OF_TIME
-            && fabs(firstObsTime-Rhead.firstObs) > 1.e-8)
-            LOG(INFO) << " Warning - Computed first time does not agree with header";
+      if(C.beginTime == CommonTime::BEGINNING_OF_TIME
+         && fabs(firstObsTime-Rhead.firstObs) > 1.e-8)
+         LOG(INFO) << " Warning - Computed first time does not agree with header";
 
-         if(C.endTime == CommonTime::END_OF_TIME
-            && (Rhead.valid & Rinex3ObsHeader::validLastTime)
-            && fabs(lastObsTime-Rhead.lastObs) > 1.e-8)
-            LOG(INFO) << " Warning - Computed last time does not agree with header";
+      if(C.endTime == CommonTime::END_OF_TIME
+         && (Rhead.valid & Rinex3ObsHeader::validLastTime)
+         && fabs(lastObsTime-Rhead.lastObs) > 1.e-8)
+         LOG(INFO) << " Warning - Computed last time does not agree with header";
 
-            // look for empty systems
-         for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
-         {
-            map<char,vector<int> >::const_iterator totIt(totals.find(sit->first[0]));
-            const vector<int>& vec(totIt->second);
-            for(i=0,k=0; k<vec.size(); k++)
-               i += vec[k];
-            if(i == 0)
-            {
-               RinexSatID sat(sit->first);
-               if( (find(C.exSats.begin(), C.exSats.end(),
-                         RinexSatID(-1,sat.system)) == C.exSats.end()) // sys not excluded
-                   &&
-                   (C.onlySats.size() > 0 &&
-                    find(C.onlySats.begin(), C.onlySats.end(), // only system
-                         RinexSatID(-1,sat.system)) != C.onlySats.end()) )
-                  LOG(INFO) << " Warning - System " << sit->first << " = "
-                            << sat.systemString() << " should be removed from the header.";
-            }
-         }
-      
-            // look for obs types that are completely empty
-            // sit declared above map<std::string,vector<RinexObsID> >::const_iterator sit;
-         for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+         // look for empty systems
+      for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+      {
+         map<char,vector<int> >::const_iterator totIt(totals.find(sit->first[0]));
+         const vector<int>& vec(totIt->second);
+         for(i=0,k=0; k<vec.size(); k++)
+            i += vec[k];
+         if(i == 0)
          {
-               // loop over obs types in header - systems first
             RinexSatID sat(sit->first);
-            map<char, vector<int> >::const_iterator totalsIter;
-            totalsIter = totals.find((sit->first)[0]);
+            if( (find(C.exSats.begin(), C.exSats.end(),
+                      RinexSatID(-1,sat.system)) == C.exSats.end()) // sys not excluded
+                &&
+                (C.onlySats.size() > 0 &&
+                 find(C.onlySats.begin(), C.onlySats.end(), // only system
+                      RinexSatID(-1,sat.system)) != C.onlySats.end()) )
+               LOG(INFO) << " Warning - System " << sit->first << " = "
+                         << sat.systemString() << " should be removed from the header.";
+         }
+      }
 
-               // this vector is printed after "TOTAL" above
-            const vector<int>& totvec = totalsIter->second;
+         // look for obs types that are completely empty
+         // sit declared above map<std::string,vector<RinexObsID> >::const_iterator sit;
+      for(sit=Rhead.mapObsTypes.begin(); sit != Rhead.mapObsTypes.end(); ++sit)
+      {
+            // loop over obs types in header - systems first
+         RinexSatID sat(sit->first);
+         map<char, vector<int> >::const_iterator totalsIter;
+         totalsIter = totals.find((sit->first)[0]);
 
-               // compute grand total first - skip if this system has no data at all
-            for(i=0,k=0; k<totvec.size(); k++) i += totvec[k];
-            if(i == 0)
-               continue;
+            // this vector is printed after "TOTAL" above
+         const vector<int>& totvec = totalsIter->second;
 
-            for(k=0; k<totvec.size(); k++)
+            // compute grand total first - skip if this system has no data at all
+         for(i=0,k=0; k<totvec.size(); k++) i += totvec[k];
+         if(i == 0)
+            continue;
+
+         for(k=0; k<totvec.size(); k++)
+         {
+            if(totvec[k] == 0)
             {
-               if(totvec[k] == 0)
+               tag = string();
+               if(Rhead.version < 3)
                {
-                  tag = string();
-                  if(Rhead.version < 3)
+                  map<string,RinexObsID>::iterator it;
+                  for(it = Rhead.mapSysR2toR3ObsID[sit->first].begin();
+                      it != Rhead.mapSysR2toR3ObsID[sit->first].end(); ++it)
                   {
-                     map<string,RinexObsID>::iterator it;
-                     for(it = Rhead.mapSysR2toR3ObsID[sit->first].begin();
-                         it != Rhead.mapSysR2toR3ObsID[sit->first].end(); ++it)
+                     if(it->second == sit->second[k])
                      {
-                        if(it->second == sit->second[k])
-                        {
-                           tag = string(", ") + it->first + string(" in ver.2");
-                           break;
-                        }
+                        tag = string(", ") + it->first + string(" in ver.2");
+                        break;
                      }
                   }
-                  LOG(INFO) << " Warning - Obs type "
-                            << sit->first << asString((sit->second)[k])
-                            << " (" << sat.systemString()
-                            << " " << asString((sit->second)[k]) << tag
-                            << ") should be removed from header";
                }
+               LOG(INFO) << " Warning - Obs type "
+                         << sit->first << asString((sit->second)[k])
+                         << " (" << sat.systemString()
+                         << " " << asString((sit->second)[k]) << tag
+                         << ") should be removed from header";
             }
          }
-         
-            // failure due to critical error
-         if(iret < 0)
-            break;
-
-         if(iret == 0)
-            nfiles++;
-
-      }  // end loop over files
-
-      if(iret < 0)
-         return iret;
+      }
 
-      return nfiles;
+      return iret;
    }
    catch(Exception& e)
    {
       GPSTK_RETHROW(e);
    }
-}  // end ProcessFiles()
+}  // end SummarizeFile()
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -44,7 +44,9 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <memory>
 
 // GPSTK
 #include "Exception.hpp"
@@ -56,6 +58,7 @@
 #include "expandtilde.hpp"
 #include "logstream.hpp"
 #include "CommandLine.hpp"
+#include "ThreadPool.hpp"
 
 #include "CommonTime.hpp"
 #include "Epoch.hpp"
@@ -114,6 +117,7 @@ string Version(string("5.2 10/13/15"));
 
 // forward declarations
 class SolutionObject;
+class EpochData;
 
 //------------------------------------------------------------------------------------
 // Object for command line input and global data
@@ -201,6 +205,8 @@ public:
 
    string TropStr;            // temp used to parse --trop
 
+   int nThreads;              // number of threads used to compute solutions
+
    // end of command line input
 
    // output file streams
@@ -452,7 +458,9 @@ class SolutionObject {
 public:
 // member functions
    // Default and only constructor
-   SolutionObject(const string& desc) throw() { Initialize(desc); }
+   SolutionObject(const string& desc) throw()
+      : pTrop(Configuration::Instance().pTrop)
+   { Initialize(desc); }
 
    // Destructor
    ~SolutionObject() throw() { }
@@ -530,9 +538,16 @@ public:
    // same return value as RAIMCompute()
    int ComputeSolution(const CommonTime& t) throw(Exception);
 
-   // Write out ORDs - call after ComputeSolution
+   // Write out ORDs to os - call after ComputeSolution
    // pass it iret from ComputeSolution
-   int WriteORDs(const CommonTime& t, const int iret) throw(Exception);
+   int WriteORDs(ostream& os, const CommonTime& t, const int iret)
+      throw(Exception);
+
+   // Process one epoch of edited data, which is element index of C.SolObjs:
+   // collect the data, dump the DAT record, compute the solution, write ORDs to
+   // ordstrm and save the results for the output RINEX in ed.
+   void SolveEpoch(EpochData& ed, const size_t index, ostream& ordstrm)
+      throw(Exception);
 
    // Output final results
    void FinalOutput(void) throw(Exception);
@@ -569,6 +584,10 @@ public:
    // the PRS itself
    PRSolution prs;
 
+   // trop model passed to PRS; C.pTrop, or a copy of it when processing with
+   // --threads
+   TropModel *pTrop;
+
    // statistics on the solution residuals
    int nepochs;
    WtdAveStats statsXYZresid;                // RPF (XYZ) minus reference position
@@ -578,10 +597,67 @@ public:
 
 }; // end class SolutionObject
 
+//------------------------------------------------------------------------------------
+// One epoch of RINEX data, the satellites in it that pass the edits, and the results
+// of each solution that go into the output RINEX. When processing with --threads,
+// epochs are handled in blocks, and the log output and ORDs generated for each
+// epoch are saved here so they can be written in order once the block is done.
+class EpochData {
+public:
+   // clear everything but Rdata, and size the vectors for nsol solutions
+   void Reset(const size_t nsol) throw()
+   {
+      sats.clear();
+      elevs.clear();
+      ERs.clear();
+      solValid.assign(nsol,false);
+      comments.assign(nsol,vector<string>());
+      readLog.clear();
+      editLog.clear();
+      weatherLog.clear();
+      solLogs.assign(nsol,string());
+      ordLines.assign(nsol,string());
+   }
+
+// member data
+   Rinex3ObsData Rdata;                // RINEX data for this epoch
+
+   // output of EditEpoch()
+   vector<RinexSatID> sats;            // sats that pass the edits, in RINEX order
+   vector<double> elevs;               // elevation, parallel to sats
+   vector<double> ERs;                 // corr eph range, parallel to sats
+
+   // output of SolutionObject::SolveEpoch(), parallel to C.SolObjs
+   vector<bool> solValid;              // PRSolution::isValid() after the solution
+   vector<vector<string> > comments;   // XYZ, CLK and DIA comments for output RINEX
+
+   // weather (T,P,H) in the trop model for EditEpoch() and for the solutions
+   double editWeather[3], solveWeather[3];
+
+   // saved log output, in the order it is written (--threads only)
+   string readLog;                     // reading the RINEX data
+   string editLog;                     // EditEpoch()
+   string weatherLog;                  // updating the weather
+   vector<string> solLogs;             // SolveEpoch(), parallel to C.SolObjs
+   vector<string> ordLines;            // ORDs, parallel to C.SolObjs
+
+}; // end class EpochData
+
 //------------------------------------------------------------------------------------
 // prototypes
 int Initialize(string& errors) throw(Exception);
 int ProcessFiles(void) throw(Exception);
+bool ReadEpoch(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead,
+               Rinex3ObsData& Rdata, int& iret) throw(Exception);
+void EditEpoch(EpochData& ed, const Rinex3ObsHeader& Rhead, const bool DCBcorr,
+               const map<string,int>& mapDCBindex, const Position& PrevPos,
+               TropModel *pTrop) throw(Exception);
+void ProcessBlock(ThreadPool& pool, vector<EpochData>& block, const size_t n,
+                  Rinex3ObsHeader& Rhead, const bool DCBcorr,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  Rinex3ObsStream& ostrm) throw(Exception);
+void WriteRinexEpoch(Rinex3ObsStream& ostrm, const EpochData& ed) throw(Exception);
+TropModel *CopyTropModel(const TropModel *pTrop) throw();
 
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -1224,16 +1300,39 @@ int ProcessFiles(void) throw(Exception)
 {
 try {
    Configuration& C(Configuration::Instance());
+   static const size_t epochsPerThread(32);  // block size per thread, --threads
    bool firstepoch(true);
-   int k,iret,nfiles;
+   int iret,nfiles;
    size_t i,j,nfile;
    Position PrevPos(C.knownPos);
    Rinex3ObsStream ostrm;
 
+   // with --threads, a pool to process blocks of epochs and the trop models
+   // used by the solutions; leave the pool null to process serially
+   unique_ptr<ThreadPool> pool;
+   vector<unique_ptr<TropModel> > solTrops;
+   vector<EpochData> block(1);
+   if(C.nThreads != 1) {
+      unique_ptr<TropModel> test(CopyTropModel(C.pTrop));
+      if(!test) {
+         LOG(WARNING) << "Warning : cannot use --threads with trop model "
+            << C.TropType << "; process serially.";
+      }
+      else {
+         pool.reset(new ThreadPool(C.nThreads));
+         if(pool->size() < 2)
+            pool.reset();
+         else {
+            block.resize(epochsPerThread * pool->size());
+            LOG(VERBOSE) << "Process blocks of " << block.size()
+               << " epochs using " << pool->size() << " threads";
+         }
+      }
+   }
+
    for(nfiles=0,nfile=0; nfile<C.InputObsFiles.size(); nfile++) {
       Rinex3ObsStream istrm;
       Rinex3ObsHeader Rhead, Rheadout;
-      Rinex3ObsData Rdata;
       string filename(C.InputObsFiles[nfile]);
 
       if (C.PisY)
@@ -1357,209 +1456,63 @@ try {
       }
 
       // loop over epochs ---------------------------------------------
+      // Epochs are processed one at a time until the first solution has
+      // initialized the trop model (see ComputeSolution()); after that, with
+      // --threads, they are read and processed in blocks (see ProcessBlock()).
       while(1) {
-         try { istrm >> Rdata; }
-         catch(Exception& e) {
-            LOG(WARNING) << " Warning : Failed to read obs data (Exception "
-               << e.getText(0) << "); dump follows.";
-            Rdata.dump(LOGstrm,Rhead);
-            istrm.close();
-            iret = 3;
-            break;
-         }
-         catch(std::exception& e) {
-            Exception ge(string("Std excep: ") + e.what());
-            GPSTK_THROW(ge);
-         }
-         catch(...) {
-            Exception ue("Unknown exception while reading RINEX data.");
-            GPSTK_THROW(ue);
-         }
-
-         // normal EOF
-         if(!istrm.good() || istrm.eof()) { iret = 0; break; }
-
-         // if aux header data, or no data, skip it
-         if(Rdata.epochFlag > 1 || Rdata.obs.empty()) {
-            LOG(DEBUG) << " RINEX Data is aux header or empty.";
-            continue;
-         }
-
-         LOG(DEBUG) << "\n Read RINEX data: flag " << Rdata.epochFlag
-            << ", timetag " << printTime(Rdata.time,C.longfmt);
-
-         // stay within time limits
-         if(Rdata.time < C.beginTime) {
-            LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
-               << " is before begin time.";
-            continue;
-         }
-         if(Rdata.time > C.endTime) {
-            LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
-               << " is after end time.";
-            break;
-         }
-
-         // decimate
-         if(C.decimate > 0.0) {
-            double dt(::fabs(Rdata.time - C.decTime));
-            dt -= C.decimate * long(0.5 + dt/C.decimate);
-            if(::fabs(dt) > 0.25) {
-               LOG(DEBUG) << " Decimation rejects RINEX data timetag "
-                  << printTime(Rdata.time,C.longfmt);
-               continue;
-            }
-         }
-
-         // reset solution objects for this epoch
-         for(i=0; i<C.SolObjs.size(); ++i)
-            C.SolObjs[i].EpochReset();
-
-         // loop over satellites -----------------------------
-         RinexSatID sat;
-         Rinex3ObsData::DataMap::iterator it;
-         for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
-            sat = it->first;
-            vector<RinexDatum>& vrdata(it->second);
-            string sys(asString(sat.systemChar()));
-
-            // is this system excluded?
-            if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
-                  == C.allSystemChars.end())
-            {
-               LOG(DEBUG) << " Sat " << sat << " : system " << sys
-                  << " is not needed.";
-               continue;
-            }
-
-            // has user excluded this satellite?
-            if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
-               LOG(DEBUG) << " Sat " << sat << " is excluded.";
-               continue;
-            }
-
-            // correct for DCB
-            if(DCBcorr && mapDCBindex.find(sys) != mapDCBindex.end()) {
-               i = mapDCBindex[sys];
-               if(C.P1C1bias.find(sat) != C.P1C1bias.end()) {
-                  LOG(DEBUG) << "Correct data " << asString(Rhead.mapObsTypes[sys][i])
-                     << " = " << fixed << setprecision(2) << vrdata[i].data
-                     << " for DCB with " << C.P1C1bias[sat];
-                  vrdata[i].data += C.P1C1bias[sat];
+         if(pool && C.TropPos && C.TropTime) {
+            // give each solution its own copy of the initialized trop model
+            if(solTrops.empty()) {
+               for(i=0; i<C.SolObjs.size(); ++i) {
+                  solTrops.push_back(
+                     unique_ptr<TropModel>(CopyTropModel(C.pTrop)));
+                  C.SolObjs[i].pTrop = solTrops.back().get();
                }
             }
 
-            // elevation mask, azimuth and ephemeris range corrected with trop
-            // - pass elev to CollectData for m-cov matrix and ORDs
-            double elev(0), ER(0), tcorr;
-            if((C.elevLimit > 0 || C.weight || C.ORDout)
-                              && PrevPos.getCoordinateSystem() != Position::Unknown) {
-               CorrectedEphemerisRange CER;
-               try {
-                  CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
-                  elev = CER.elevation;
-                  // const double azim = CER.azimuth;
-                  if(C.ORDout) {
-                     tcorr = C.pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
-                     ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
-                  }
-                  if(elev < C.elevLimit) {         // TD add elev mask [azim]
-                     LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
-                        << fixed << setprecision(2) << elev << " at time "
-                        << printTime(Rdata.time,C.longfmt);
-                     continue;
-                  }
-               }
-               catch(Exception& e) {
-                  LOG(WARNING) << "WARNING : Failed to get elevation for sat "
-                     << sat << " at time " << printTime(Rdata.time,C.longfmt);
-                  continue;
+            // read a block of epochs; log output following the last is held
+            string tail;
+            size_t n(0);
+            while(n < block.size()) {
+               block[n].Reset(C.SolObjs.size());
+               bool ok;
+               {
+                  LogCapture capture(block[n].readLog);
+                  ok = ReadEpoch(istrm, Rhead, block[n].Rdata, iret);
                }
+               if(!ok) { tail = block[n].readLog; break; }
+               n++;
             }
 
-            // pick out data for each solution object
-            for(i=0; i<C.SolObjs.size(); ++i)
-               C.SolObjs[i].CollectData(sat,elev,ER,vrdata);
+            ProcessBlock(*pool, block, n, Rhead, DCBcorr, mapDCBindex, PrevPos,
+                         ostrm);
+            if(!tail.empty()) ConfigureLOGstream::Output(tail);
+            if(n < block.size()) break;
+            continue;
+         }
+
+         EpochData& ed(block[0]);
+         ed.Reset(C.SolObjs.size());
+         if(!ReadEpoch(istrm, Rhead, ed.Rdata, iret)) break;
 
-         }  // end loop over satellites
+         // edit the satellites, and find elevation and ephemeris range
+         EditEpoch(ed, Rhead, DCBcorr, mapDCBindex, PrevPos, C.pTrop);
 
          // debug: dump the RINEX data object
-         if(C.debug > -1) Rdata.dump(LOGstrm,Rhead);
+         if(C.debug > -1) ed.Rdata.dump(LOGstrm,Rhead);
 
          // update the trop model's weather ------------------
-         if(C.MetStore.size() > 0) C.setWeather(Rdata.time);
+         if(C.MetStore.size() > 0) C.setWeather(ed.Rdata.time);
 
          // put a blank line here for readability
          LOG(INFO) << "";
 
-         // compute the solution(s) --------------------------
-         // tag for DAT - required for PRSplot
-         C.msg = printTime(Rdata.time,"DAT "+C.gpsfmt);
-
          // compute and print the solution(s) ----------------
-         for(i=0; i<C.SolObjs.size(); ++i) {
-            // skip invalid descriptors
-            if(!C.SolObjs[i].isValid) continue;
-
-            // dump the "DAT" record
-            LOG(INFO) << C.SolObjs[i].dump((C.debug > -1 ? 2:1), "RPF", C.msg);
-
-            // compute the solution
-            j = C.SolObjs[i].ComputeSolution(Rdata.time);
-
-            // write ORDs, even if solution is not good
-            if(C.ORDout) C.SolObjs[i].WriteORDs(Rdata.time,j);
-         }
+         for(i=0; i<C.SolObjs.size(); ++i)
+            C.SolObjs[i].SolveEpoch(ed, i, C.ordstrm);
 
          // write to output RINEX ----------------------------
-         if(!C.OutputObsFile.empty()) {
-            Rinex3ObsData auxData;
-            auxData.time = Rdata.time;
-            auxData.clockOffset = Rdata.clockOffset;
-            auxData.epochFlag = 4;
-            ostringstream oss;
-            // loop over valid descriptors
-            for(k=0,i=0; i<C.SolObjs.size(); ++i) if(C.SolObjs[i].isValid) {
-               if(!C.SolObjs[i].prs.isValid())
-               {
-                  LOG(ERROR) << "Invalid soution!";
-                  break;
-               }
-               oss.str("");
-               oss << "XYZ" << fixed << setprecision(3)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(0)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(1)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(2);
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "CLK" << fixed << setprecision(3);
-
-               for(j=0; j<C.SolObjs[i].prs.SystemIDs.size(); j++) {
-                  RinexSatID sat(1,C.SolObjs[i].prs.SystemIDs[j]);
-                  oss << " " << sat.systemString3()
-                     << " " << setw(11) << C.SolObjs[i].prs.Solution(3+j);
-               }
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "DIA" << setw(2) << C.SolObjs[i].prs.Nsvs
-                  << fixed << setprecision(2)
-                  << " " << setw(4) << C.SolObjs[i].prs.PDOP
-                  << " " << setw(4) << C.SolObjs[i].prs.GDOP
-                  << " " << setw(8) << C.SolObjs[i].prs.RMSResidual
-                  << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-            }
-            auxData.numSVs = k;            // number of lines to write
-            auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
-            ostrm << auxData;
-
-            ostrm << Rdata;
-         }
+         if(!C.OutputObsFile.empty()) WriteRinexEpoch(ostrm, ed);
 
       }  // end while loop over epochs
 
@@ -1574,6 +1527,10 @@ try {
 
    if(!C.OutputObsFile.empty()) ostrm.close();
 
+   // the copies of the trop model are deleted on return
+   for(i=0; i<C.SolObjs.size(); ++i)
+      C.SolObjs[i].pTrop = C.pTrop;
+
    if(iret < 0) return iret;
 
    return nfiles;
@@ -1581,6 +1538,305 @@ try {
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }  // end ProcessFiles()
 
+//------------------------------------------------------------------------------------
+// Read the next epoch of RINEX data that is not aux header or empty, is within the
+// time limits and passes decimation. Return false when there is no such epoch: set
+// iret to 0 at normal EOF, or to 3 if the data could not be read.
+bool ReadEpoch(Rinex3ObsStream& istrm, Rinex3ObsHeader& Rhead,
+               Rinex3ObsData& Rdata, int& iret) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+
+   while(1) {
+      try { istrm >> Rdata; }
+      catch(Exception& e) {
+         LOG(WARNING) << " Warning : Failed to read obs data (Exception "
+            << e.getText(0) << "); dump follows.";
+         Rdata.dump(LOGstrm,Rhead);
+         istrm.close();
+         iret = 3;
+         return false;
+      }
+      catch(std::exception& e) {
+         Exception ge(string("Std excep: ") + e.what());
+         GPSTK_THROW(ge);
+      }
+      catch(...) {
+         Exception ue("Unknown exception while reading RINEX data.");
+         GPSTK_THROW(ue);
+      }
+
+      // normal EOF
+      if(!istrm.good() || istrm.eof()) { iret = 0; return false; }
+
+      // if aux header data, or no data, skip it
+      if(Rdata.epochFlag > 1 || Rdata.obs.empty()) {
+         LOG(DEBUG) << " RINEX Data is aux header or empty.";
+         continue;
+      }
+
+      LOG(DEBUG) << "\n Read RINEX data: flag " << Rdata.epochFlag
+         << ", timetag " << printTime(Rdata.time,C.longfmt);
+
+      // stay within time limits
+      if(Rdata.time < C.beginTime) {
+         LOG(DEBUG) << " RINEX data timetag " << printTime(C.beginTime,C.longfmt)
+            << " is before begin time.";
+         continue;
+      }
+      if(Rdata.time > C.endTime) {
+         LOG(DEBUG) << " RINEX data timetag " << printTime(C.endTime,C.longfmt)
+            << " is after end time.";
+         return false;
+      }
+
+      // decimate
+      if(C.decimate > 0.0) {
+         double dt(::fabs(Rdata.time - C.decTime));
+         dt -= C.decimate * long(0.5 + dt/C.decimate);
+         if(::fabs(dt) > 0.25) {
+            LOG(DEBUG) << " Decimation rejects RINEX data timetag "
+               << printTime(Rdata.time,C.longfmt);
+            continue;
+         }
+      }
+
+      return true;
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ReadEpoch()
+
+//------------------------------------------------------------------------------------
+// Loop over the satellites in ed.Rdata: apply the DCB correction, the system and
+// satellite exclusions and the elevation mask, and save in ed the satellites that
+// remain, with their elevation and ephemeris range corrected using pTrop.
+// Changes nothing but ed, so epochs may be edited concurrently given separate
+// trop models.
+void EditEpoch(EpochData& ed, const Rinex3ObsHeader& Rhead, const bool DCBcorr,
+               const map<string,int>& mapDCBindex, const Position& PrevPos,
+               TropModel *pTrop) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   Rinex3ObsData& Rdata(ed.Rdata);
+
+   RinexSatID sat;
+   Rinex3ObsData::DataMap::iterator it;
+   for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
+      sat = it->first;
+      vector<RinexDatum>& vrdata(it->second);
+      string sys(asString(sat.systemChar()));
+
+      // is this system excluded?
+      if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
+            == C.allSystemChars.end())
+      {
+         LOG(DEBUG) << " Sat " << sat << " : system " << sys
+            << " is not needed.";
+         continue;
+      }
+
+      // has user excluded this satellite?
+      if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
+         LOG(DEBUG) << " Sat " << sat << " is excluded.";
+         continue;
+      }
+
+      // correct for DCB
+      map<string,int>::const_iterator dit(mapDCBindex.find(sys));
+      if(DCBcorr && dit != mapDCBindex.end()) {
+         const int i(dit->second);
+         map<RinexSatID,double>::const_iterator bit(C.P1C1bias.find(sat));
+         if(bit != C.P1C1bias.end()) {
+            LOG(DEBUG) << "Correct data "
+               << asString(Rhead.mapObsTypes.find(sys)->second[i])
+               << " = " << fixed << setprecision(2) << vrdata[i].data
+               << " for DCB with " << bit->second;
+            vrdata[i].data += bit->second;
+         }
+      }
+
+      // elevation mask, azimuth and ephemeris range corrected with trop
+      // - pass elev to CollectData for m-cov matrix and ORDs
+      double elev(0), ER(0), tcorr;
+      if((C.elevLimit > 0 || C.weight || C.ORDout)
+                        && PrevPos.getCoordinateSystem() != Position::Unknown) {
+         CorrectedEphemerisRange CER;
+         try {
+            CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
+            elev = CER.elevation;
+            // const double azim = CER.azimuth;
+            if(C.ORDout) {
+               tcorr = pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
+               ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
+            }
+            if(elev < C.elevLimit) {         // TD add elev mask [azim]
+               LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
+                  << fixed << setprecision(2) << elev << " at time "
+                  << printTime(Rdata.time,C.longfmt);
+               continue;
+            }
+         }
+         catch(Exception& e) {
+            LOG(WARNING) << "WARNING : Failed to get elevation for sat "
+               << sat << " at time " << printTime(Rdata.time,C.longfmt);
+            continue;
+         }
+      }
+
+      // save for the solution objects
+      ed.sats.push_back(sat);
+      ed.elevs.push_back(elev);
+      ed.ERs.push_back(ER);
+
+   }  // end loop over satellites
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end EditEpoch()
+
+//------------------------------------------------------------------------------------
+// Process the first n epochs in block, which have been read, using the pool: update
+// the weather serially, edit the epochs concurrently, then compute each solution
+// concurrently (epochs within one solution must stay in order since PRSolution
+// carries an apriori solution from one epoch to the next). Finally write the saved
+// log output, ORDs and output RINEX in the same order as serial processing would.
+void ProcessBlock(ThreadPool& pool, vector<EpochData>& block, const size_t n,
+                  Rinex3ObsHeader& Rhead, const bool DCBcorr,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  Rinex3ObsStream& ostrm) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   const bool haveMet(C.MetStore.size() > 0);
+   size_t i,k;
+
+   // update the trop model's weather, noting what each step will see
+   for(k=0; k<n; k++) {
+      EpochData& ed(block[k]);
+      ed.editWeather[0] = C.defaultTemp;
+      ed.editWeather[1] = C.defaultPress;
+      ed.editWeather[2] = C.defaultHumid;
+      {
+         LogCapture capture(ed.weatherLog);
+         if(haveMet) C.setWeather(ed.Rdata.time);
+
+         // put a blank line here for readability
+         LOG(INFO) << "";
+      }
+      ed.solveWeather[0] = C.defaultTemp;
+      ed.solveWeather[1] = C.defaultPress;
+      ed.solveWeather[2] = C.defaultHumid;
+   }
+
+   // edit the epochs, each with its own copy of the trop model
+   pool.run(n, [&](size_t k) {
+      EpochData& ed(block[k]);
+      unique_ptr<TropModel> pTrop(CopyTropModel(C.pTrop));
+      if(haveMet)
+         pTrop->setWeather(ed.editWeather[0],ed.editWeather[1],ed.editWeather[2]);
+      LogCapture capture(ed.editLog);
+      EditEpoch(ed, Rhead, DCBcorr, mapDCBindex, PrevPos, pTrop.get());
+   });
+
+   // compute the solutions, each over all the epochs in order
+   pool.run(C.SolObjs.size(), [&](size_t i) {
+      SolutionObject& SO(C.SolObjs[i]);
+      for(size_t k=0; k<n; k++) {
+         EpochData& ed(block[k]);
+         if(haveMet) SO.pTrop->setWeather(ed.solveWeather[0],
+                                          ed.solveWeather[1],ed.solveWeather[2]);
+         ostringstream oss;
+         {
+            LogCapture capture(ed.solLogs[i]);
+            SO.SolveEpoch(ed, i, oss);
+         }
+         ed.ordLines[i] = oss.str();
+      }
+   });
+
+   // write everything out in order
+   for(k=0; k<n; k++) {
+      EpochData& ed(block[k]);
+      if(!ed.readLog.empty()) ConfigureLOGstream::Output(ed.readLog);
+      if(!ed.editLog.empty()) ConfigureLOGstream::Output(ed.editLog);
+
+      // debug: dump the RINEX data object
+      if(C.debug > -1) ed.Rdata.dump(LOGstrm,Rhead);
+
+      if(!ed.weatherLog.empty()) ConfigureLOGstream::Output(ed.weatherLog);
+
+      for(i=0; i<C.SolObjs.size(); ++i) {
+         if(!ed.solLogs[i].empty()) ConfigureLOGstream::Output(ed.solLogs[i]);
+         if(C.ORDout) C.ordstrm << ed.ordLines[i];
+      }
+
+      if(!C.OutputObsFile.empty()) WriteRinexEpoch(ostrm, ed);
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ProcessBlock()
+
+//------------------------------------------------------------------------------------
+// Write the solutions as comments in an aux header, followed by the data, to the
+// output RINEX file; call after SolveEpoch() for every solution.
+void WriteRinexEpoch(Rinex3ObsStream& ostrm, const EpochData& ed) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   int k;
+   size_t i,j;
+
+   Rinex3ObsData auxData;
+   auxData.time = ed.Rdata.time;
+   auxData.clockOffset = ed.Rdata.clockOffset;
+   auxData.epochFlag = 4;
+   // loop over valid descriptors
+   for(k=0,i=0; i<C.SolObjs.size(); ++i) if(C.SolObjs[i].isValid) {
+      if(!ed.solValid[i])
+      {
+         LOG(ERROR) << "Invalid soution!";
+         break;
+      }
+      for(j=0; j<ed.comments[i].size(); j++) {
+         auxData.auxHeader.commentList.push_back(ed.comments[i][j]);
+         k++;
+      }
+   }
+   auxData.numSVs = k;            // number of lines to write
+   auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
+   ostrm << auxData;
+
+   ostrm << ed.Rdata;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end WriteRinexEpoch()
+
+//------------------------------------------------------------------------------------
+// Return a new copy of the trop model, including its current state, or NULL if the
+// type of model is not known here.
+TropModel *CopyTropModel(const TropModel *pTrop) throw()
+{
+   if(const ZeroTropModel *p = dynamic_cast<const ZeroTropModel*>(pTrop))
+      return new ZeroTropModel(*p);
+   if(const SimpleTropModel *p = dynamic_cast<const SimpleTropModel*>(pTrop))
+      return new SimpleTropModel(*p);
+   if(const SaasTropModel *p = dynamic_cast<const SaasTropModel*>(pTrop))
+      return new SaasTropModel(*p);
+   if(const NBTropModel *p = dynamic_cast<const NBTropModel*>(pTrop))
+      return new NBTropModel(*p);
+   if(const GGTropModel *p = dynamic_cast<const GGTropModel*>(pTrop))
+      return new GGTropModel(*p);
+   if(const GGHeightTropModel *p = dynamic_cast<const GGHeightTropModel*>(pTrop))
+      return new GGHeightTropModel(*p);
+   if(const NeillTropModel *p = dynamic_cast<const NeillTropModel*>(pTrop))
+      return new NeillTropModel(*p);
+   if(const GlobalTropModel *p = dynamic_cast<const GlobalTropModel*>(pTrop))
+      return new GlobalTropModel(*p);
+   return NULL;
+}
+
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 int routine(void) throw(Exception)
@@ -1620,6 +1876,8 @@ void Configuration::SetDefaults(void) throw()
    TropStr = TropType + string(",") + asString(defaultTemp,1) + string(",")
       + asString(defaultPress,1) + string(",") + asString(defaultHumid,1);
 
+   nThreads = 1;
+
    // get defaults from PRSolution
    {
       PRSolution dummy;
@@ -1914,6 +2172,8 @@ string Configuration::BuildCommandLine(void) throw()
    opts.Add(0, "Trop", "m,T,P,H", false, false, &TropStr, "",
             "Trop model <m> [one of Zero,Black,Saas,NewB,Neill,GG,GGHt,Global\n"
             "                      with optional weather T(C),P(mb),RH(%)]");
+   opts.Add(0, "threads", "n", false, false, &nThreads, "",
+            "Number of threads used to process epochs [0 for one per core]");
 
    opts.Add(0, "log", "fn", false, false, &LogFile, "# Output [for formats see "
             "GPSTK::Position (--ref) and GPSTK::Epoch (--timefmt)] :",
@@ -2098,6 +2358,9 @@ int Configuration::ExtraProcessing(string& errors, string& extras) throw()
    if(InputNavFiles.size() > 0 && InputSP3Files.size() > 0)
       oss << "Error : Both --nav and --eph appear: provide only one.\n";
 
+   if(nThreads < 0)
+      oss << "Error : --threads must not be negative: " << nThreads << "\n";
+
    //
    if(LOGlevel != 2)
       ossx << "   LOG level is " << ConfigureLOG::ToString(LOGlevel) << "\n";
@@ -2413,7 +2676,7 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
             Vector<double> Resid,Slopes;
             //if(prs.hasMemory) APSol = prs.memory.getAprioriSolution(satSyss);
             iret = prs.SimplePRSolution(ttag, Satellites, SVP,
-                                        invMCov, C.pTrop,
+                                        invMCov, pTrop,
                                         prs.MaxNIterations, prs.ConvergenceLimit,
                                         satSyss, Resid, Slopes);
          }
@@ -2469,7 +2732,7 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
 
       // get the RAIM solution ------------------------------------------
       iret = prs.RAIMCompute(ttag, Satellites, satSyss, PRanges, invMCov, C.pEph,
-                             C.pTrop);
+                             pTrop);
 
       if(iret < 0) {
          LOG(VERBOSE) << "RAIMCompute failed "
@@ -2535,12 +2798,12 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
       // if trop model has not been initialized, do so
       if(!C.TropPos) {
          Position pos(prs.Solution(0), prs.Solution(1), prs.Solution(2));
-         C.pTrop->setReceiverLatitude(pos.getGeodeticLatitude());
-         C.pTrop->setReceiverHeight(pos.getHeight());
+         pTrop->setReceiverLatitude(pos.getGeodeticLatitude());
+         pTrop->setReceiverHeight(pos.getHeight());
          C.TropPos = true;
       }
       if(!C.TropTime) {
-         C.pTrop->setDayOfYear(static_cast<YDSTime>(ttag).doy);
+         pTrop->setDayOfYear(static_cast<YDSTime>(ttag).doy);
          C.TropTime = true;
       }
 
@@ -2553,7 +2816,8 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
 }
 
 //------------------------------------------------------------------------------------
-int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exception)
+int SolutionObject::WriteORDs(ostream& os, const CommonTime& time, const int iret)
+   throw(Exception)
 {
    try {
       Configuration& C(Configuration::Instance());
@@ -2571,7 +2835,7 @@ int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exce
          j = jt - prs.SystemIDs.begin();              // index
          clk = prs.Solution(3+j);
 
-         C.ordstrm << "ORD " << RinexSatID(Satellites[i]).toString()
+         os << "ORD " << RinexSatID(Satellites[i]).toString()
             << " " << printTime(time,C.userfmt) << fixed << setprecision(3)
             << " " << setw(6) << Elevations[i]
             << " " << setw(6) << RIono[i]
@@ -2591,6 +2855,66 @@ int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exce
    catch(Exception& e) { GPSTK_RETHROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+void SolutionObject::SolveEpoch(EpochData& ed, const size_t index, ostream& ordstrm)
+   throw(Exception)
+{
+   try {
+      Configuration& C(Configuration::Instance());
+      size_t i;
+
+      EpochReset();
+      // skip invalid descriptors
+      if(!isValid) return;
+
+      // pick out the data
+      for(i=0; i<ed.sats.size(); i++)
+         CollectData(ed.sats[i], ed.elevs[i], ed.ERs[i],
+                     ed.Rdata.obs.find(ed.sats[i])->second);
+
+      // dump the "DAT" record - tag required for PRSplot
+      LOG(INFO) << dump((C.debug > -1 ? 2:1), "RPF",
+                        printTime(ed.Rdata.time,"DAT "+C.gpsfmt));
+
+      // compute the solution
+      int iret = ComputeSolution(ed.Rdata.time);
+
+      // write ORDs, even if solution is not good
+      if(C.ORDout) WriteORDs(ordstrm, ed.Rdata.time, iret);
+
+      // save results for the output RINEX
+      ed.solValid[index] = prs.isValid();
+      if(!ed.solValid[index]) return;
+
+      vector<string>& comments(ed.comments[index]);
+      ostringstream oss;
+      oss << "XYZ" << fixed << setprecision(3)
+         << " " << setw(12) << prs.Solution(0)
+         << " " << setw(12) << prs.Solution(1)
+         << " " << setw(12) << prs.Solution(2);
+      oss << " " << Descriptor;     // may get truncated
+      comments.push_back(oss.str());
+      oss.str("");
+      oss << "CLK" << fixed << setprecision(3);
+      for(i=0; i<prs.SystemIDs.size(); i++) {
+         RinexSatID sat(1,prs.SystemIDs[i]);
+         oss << " " << sat.systemString3()
+            << " " << setw(11) << prs.Solution(3+i);
+      }
+      oss << " " << Descriptor;     // may get truncated
+      comments.push_back(oss.str());
+      oss.str("");
+      oss << "DIA" << setw(2) << prs.Nsvs
+         << fixed << setprecision(2)
+         << " " << setw(4) << prs.PDOP
+         << " " << setw(4) << prs.GDOP
+         << " " << setw(8) << prs.RMSResidual
+         << " " << Descriptor;     // may get truncated
+      comments.push_back(oss.str());
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
 //------------------------------------------------------------------------------------
 void SolutionObject::FinalOutput(void) throw(Exception)
 {
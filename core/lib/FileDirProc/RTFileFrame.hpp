@@ -44,9 +44,23 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <cmath>
+#include <cstring>
+#include <list>
 #include <iterator>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
 #include "FileSpec.hpp"
 #include "FileFilter.hpp"
+#include "MJD.hpp"
+#include "SystemTime.hpp"
+#include "TimeConstants.hpp"
+#include "Stats.hpp"
 
 namespace gpstk
 {
@@ -73,6 +87,27 @@ namespace gpstk
          AppendedData = 0,     ///< read only appended data.
          FromTheBeginning = 1  ///< reread from the beginning every time.
       };
+
+         /// How waitForData() waits for more data.
+      enum WaitMode
+      {
+         Sleep  = 0, ///< sleep for the given time, then reopen
+         Notify = 1  ///< wake as soon as the file is written (inotify)
+      };
+
+         /// Seconds from the modification time in \a s to now.
+      static double secondsSinceModified(const struct stat& s)
+      {
+         struct timespec now;
+         clock_gettime(CLOCK_REALTIME, &now);
+#if defined(__APPLE__)
+         const struct timespec& mt = s.st_mtimespec;
+#else
+         const struct timespec& mt = s.st_mtim;
+#endif
+         return double(now.tv_sec - mt.tv_sec) +
+            1.e-9 * double(now.tv_nsec - mt.tv_nsec);
+      }
    };
 
       // forward declaration of the RTFileFrame class
@@ -220,6 +255,18 @@ namespace gpstk
        * file of the previous day.  
        * @warning DO NOT MIX THE TWO ITERATOR SEMANTICS. Doing so, you will
        * definately miss data.
+       *
+       * In the Notify WaitMode, waitForData() returns as soon as the
+       * current file is appended to, or the next day's file is
+       * created, rather than after sleeping the whole wait; on Linux
+       * this uses inotify on the file's directory, elsewhere the file
+       * size is polled.  A record that ends at the end of the file
+       * may still be being written, so it is not returned until more
+       * data follows it; the next read starts again at that record.
+       * Each record read adds to latency statistics, the delay from
+       * the last write to the file before it was (re)opened to the
+       * time the record was parsed.  Records written before that last
+       * write have a longer true delay than the one recorded.
        * 
        *
        */
@@ -252,13 +299,25 @@ namespace gpstk
          /// Allows changing of the GetRecordMode
       RTFileFrame& setGetRecordMode(const GetRecordMode g);
 
+         /// Allows changing of the WaitMode
+      RTFileFrame& setWaitMode(const WaitMode w);
+
          /**
           * Waits \a wait number of seconds, then reopens the file
           * and sets the next read as appropriate for the FileReadingMode.
+          * In Notify mode, the wait ends as soon as data are written.
           * @param wait number of seconds to sleep.
           */
       void waitForData(unsigned wait = 0);
 
+         /**
+          * Blocks until the current file is written or the next day's
+          * file is created, or \a waitms milliseconds pass. Does not
+          * reopen the file; waitForData() does that.
+          * @return true if the file changed, false on timeout.
+          */
+      bool waitForChange(unsigned waitms);
+
          /// returns true if the file currently being read from has
          /// changed since its last read
       bool hasFileChanged();
@@ -304,6 +363,15 @@ namespace gpstk
          /// returns the current time used for finding files
       gpstk::CommonTime getCurrentTime() const {return currentTime;}
 
+         /// statistics, in seconds, of the delay from write to parse
+      const gpstk::Stats<double>& getLatencyStats() const {return latency;}
+
+         /// the write to parse delay, in seconds, of the last record read
+      double getLastLatency() const {return lastLatency;}
+
+         /// clear the latency statistics
+      void resetLatencyStats() {latency.Reset(); lastLatency = 0.0;}
+
          /// let the iterator see this class's insides
       friend class RTFileFrameIterator<FileStream, FileData>;
 
@@ -314,6 +382,10 @@ namespace gpstk
       void closeCurrentFile();
 
    protected:
+         /// true if \a currentFileName is the file for the system's
+         /// today, the one that may still be written to
+      bool isTodaysFile() const;
+
          /// the internal file stream for the internal iterator
       FileStream* fileStream;
 
@@ -338,25 +410,36 @@ namespace gpstk
          /// to continue reading - by calling waitForData(),
          /// openNextDay(), or openCurrentFile()
       bool isOK;
+         /// the WaitMode for waitForData()
+      WaitMode waitMode;
+         /// inotify instance and the watch on \a watchedDir, or -1
+      int notifyFd, watchFd;
+         /// the directory being watched for changes
+      std::string watchedDir;
+         /// delay in seconds from write to parse of each record read
+      gpstk::Stats<double> latency;
+         /// delay in seconds of the last record read
+      double lastLatency;
    };
 
       //@}
 
    template <class FileStream, class FileData>
    RTFileFrame<FileStream, FileData>::
-   RTFileFrame<FileStream, FileData>(const gpstk::FileSpec& fnFormat,
+   RTFileFrame(const gpstk::FileSpec& fnFormat,
                                      const gpstk::CommonTime& beginning,
                                      const gpstk::CommonTime& ending, 
                                      const RTFileFrameHelper::FileReadingMode frm,
                                      const RTFileFrameHelper::GetRecordMode grm)
    throw(gpstk::Exception)
       : fileStream(NULL), fs(fnFormat), startTime(beginning), 
-      currentTime(beginning), endTime(ending), readMode(frm), getMode(grm)
+      currentTime(beginning), endTime(ending), readMode(frm), getMode(grm),
+      waitMode(Sleep), notifyFd(-1), watchFd(-1), lastLatency(0.0)
    {
          // zero out seconds
       startTime = MJD(floor(MJD(startTime).mjd));
       endTime = MJD(floor(MJD(endTime).mjd));
-      currentTime = MJD(floor(MJD(curretnTime).mjd));
+      currentTime = MJD(floor(MJD(currentTime).mjd));
 
          // set up the stream
       openCurrentFile();
@@ -370,6 +453,8 @@ namespace gpstk
          fileStream->close();
          delete fileStream;
       }
+      if (notifyFd >= 0)
+         close(notifyFd);
    }
 
    template <class FileStream, class FileData>
@@ -391,11 +476,24 @@ namespace gpstk
       return *this;
    }
 
+      /// Allows changing of the WaitMode
+   template <class FileStream, class FileData>
+   RTFileFrame<FileStream, FileData>& 
+   RTFileFrame<FileStream, FileData> :: 
+   setWaitMode(const RTFileFrameHelper::WaitMode w)
+   { 
+      waitMode = w; 
+      return *this;
+   }
+
    template <class FileStream, class FileData>
    void
    RTFileFrame<FileStream, FileData>::waitForData(unsigned wait)
    {
-      sleep(wait);
+      if (waitMode == Notify)
+         waitForChange(1000 * wait);
+      else
+         sleep(wait);
       if(readMode == AppendedData)
       {  
             // reopen the file and skip to where we left off - openCurrentFile
@@ -412,6 +510,99 @@ namespace gpstk
       }
    }
 
+   template <class FileStream, class FileData>
+   bool
+   RTFileFrame<FileStream, FileData>::waitForChange(unsigned waitms)
+   {
+      std::string dir("."), base(currentFileName), nextBase;
+      std::string::size_type slash = currentFileName.rfind('/');
+      if (slash != std::string::npos)
+      {
+         dir = (slash == 0 ? std::string("/") : currentFileName.substr(0, slash));
+         base = currentFileName.substr(slash + 1);
+      }
+      nextBase = fs.toString(currentTime + gpstk::SEC_PER_DAY);
+      slash = nextBase.rfind('/');
+      if (slash != std::string::npos)
+         nextBase = nextBase.substr(slash + 1);
+
+      struct timespec start, now;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+
+#ifdef __linux__
+         // watch the directory, so that creation of the file (or of the
+         // next day's file) is seen as well as appends to it
+      if (notifyFd < 0)
+         notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (notifyFd >= 0 && dir != watchedDir)
+      {
+         if (watchFd >= 0)
+            inotify_rm_watch(notifyFd, watchFd);
+         watchFd = inotify_add_watch(notifyFd, dir.c_str(),
+                                     IN_MODIFY | IN_CLOSE_WRITE |
+                                     IN_CREATE | IN_MOVED_TO);
+         watchedDir = (watchFd >= 0 ? dir : std::string());
+      }
+#endif
+
+      while (true)
+      {
+            // data written since the file was opened need no wait
+         struct stat tempStat;
+         if (stat(currentFileName.c_str(), &tempStat) == 0 &&
+             (tempStat.st_size != fileInfo.st_size ||
+              tempStat.st_mtime != fileInfo.st_mtime))
+            return true;
+
+         clock_gettime(CLOCK_MONOTONIC, &now);
+         long elapsed = 1000L * (now.tv_sec - start.tv_sec) +
+            (now.tv_nsec - start.tv_nsec) / 1000000L;
+         if (elapsed >= long(waitms))
+            return false;
+         int remaining = int(waitms - elapsed);
+
+#ifdef __linux__
+         if (watchFd >= 0)
+         {
+            struct pollfd pfd;
+            pfd.fd = notifyFd;
+            pfd.events = POLLIN;
+            int rc = poll(&pfd, 1, remaining);
+            if (rc < 0 && errno != EINTR)
+               return false;
+            if (rc <= 0)
+               continue;
+
+            char buf[4096]
+               __attribute__ ((aligned(__alignof__(struct inotify_event))));
+            ssize_t len;
+            while ((len = read(notifyFd, buf, sizeof(buf))) > 0)
+            {
+               for (char *ptr = buf; ptr < buf + len; )
+               {
+                  const struct inotify_event *ev =
+                     reinterpret_cast<const struct inotify_event *>(ptr);
+                  if (ev->mask & IN_Q_OVERFLOW)
+                     return true;
+                  if (ev->len)
+                  {
+                     std::string name(ev->name);
+                     if (name == base ||
+                         ((ev->mask & (IN_CREATE | IN_MOVED_TO)) &&
+                          name == nextBase))
+                        return true;
+                  }
+                  ptr += sizeof(struct inotify_event) + ev->len;
+               }
+            }
+            continue;
+         }
+#endif
+            // no inotify; check again in 10 ms
+         usleep(1000 * (remaining < 10 ? remaining : 10));
+      }
+   }
+
    template <class FileStream, class FileData>
    bool
    RTFileFrame<FileStream, FileData>::hasFileChanged()
@@ -470,7 +661,17 @@ namespace gpstk
          // is the stream still good to read?
       if (*fileStream >> lastData)
       {
+            // a record ending at end of today's file may be incomplete;
+            // leave it to be read again after waitForData().  Files for
+            // past days are complete, so their last record is kept.
+         if (fileStream->eof() && isTodaysFile())
+         {
+            isOK = false;
+            return false;
+         }
          lastPosition = fileStream->tellg();
+         lastLatency = secondsSinceModified(fileInfo);
+         latency.Add(lastLatency);
          return true;
       }
          // the last read failed - try opening the next file until
@@ -483,8 +684,8 @@ namespace gpstk
             if (!endOfDataSet())
             {
                   // still before today?
-               gpstk::CommonTime today;
-               today.setYDoySod(today.year(), today.DOY(), 0);
+               gpstk::CommonTime today = MJD(floor(MJD(SystemTime()).mjd));
+               today.setTimeSystem(currentTime.getTimeSystem());
                
                if (currentTime < today)
                {
@@ -513,12 +714,21 @@ namespace gpstk
       return isOK;
    }
 
+   template <class FileStream, class FileData>
+   bool
+   RTFileFrame<FileStream, FileData>::isTodaysFile() const
+   {
+      gpstk::CommonTime today = MJD(floor(MJD(SystemTime()).mjd));
+      today.setTimeSystem(currentTime.getTimeSystem());
+      return (currentFileName == fs.toString(today));
+   }
+
    template <class FileStream, class FileData>
    void
    RTFileFrame<FileStream, FileData>::openNextDay()
    {
          // open a new file for another day, if any.
-      currentTime += gpstk::CommonTime::SEC_DAY;
+      currentTime += gpstk::SEC_PER_DAY;
       if (!endOfDataSet())
          openCurrentFile();
    }
@@ -557,7 +767,8 @@ namespace gpstk
    {
       isOK = false;
       currentFileName = fs.toString(currentTime);
-      stat(currentFileName.c_str(), &fileInfo);
+      if (stat(currentFileName.c_str(), &fileInfo))
+         std::memset(&fileInfo, 0, sizeof(fileInfo));
       lastPosition = 0;
 
       if(fileStream)
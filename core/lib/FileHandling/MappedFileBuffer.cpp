@@ -0,0 +1,137 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MappedFileBuffer.cpp
+ * Read-only view of a whole file mapped into memory.
+ */
+
+#include <fstream>
+#include "MappedFileBuffer.hpp"
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gpstk
+{
+   MappedFileBuffer ::
+   MappedFileBuffer()
+         : base(0), length(0), opened(false), isMmap(false)
+   {
+   }
+
+
+   MappedFileBuffer ::
+   ~MappedFileBuffer()
+   {
+      close();
+   }
+
+
+   bool MappedFileBuffer ::
+   open(const std::string& fn)
+   {
+      close();
+#ifndef _WIN32
+      int fd = ::open(fn.c_str(), O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat st;
+      if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+      {
+         ::close(fd);
+         return false;
+      }
+      length = static_cast<std::size_t>(st.st_size);
+      if (length > 0)
+      {
+         void *addr = ::mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (addr == MAP_FAILED)
+         {
+            ::close(fd);
+            length = 0;
+            return false;
+         }
+            // The readers walk the file front to back exactly once.
+         ::madvise(addr, length, MADV_SEQUENTIAL);
+         base = static_cast<const char*>(addr);
+         isMmap = true;
+      }
+         // the mapping keeps its own reference to the file
+      ::close(fd);
+#else
+      std::ifstream in(fn.c_str(), std::ios::in | std::ios::binary);
+      if (!in)
+         return false;
+      in.seekg(0, std::ios::end);
+      std::streamoff end = in.tellg();
+      if (end < 0)
+         return false;
+      in.seekg(0, std::ios::beg);
+      fallback.resize(static_cast<std::size_t>(end));
+      if (!fallback.empty() && !in.read(&fallback[0], fallback.size()))
+      {
+         fallback.clear();
+         return false;
+      }
+      length = fallback.size();
+      base = fallback.empty() ? 0 : &fallback[0];
+#endif
+      opened = true;
+      return true;
+   }
+
+
+   void MappedFileBuffer ::
+   close()
+   {
+#ifndef _WIN32
+      if (isMmap)
+         ::munmap(const_cast<char*>(base), length);
+#endif
+      std::vector<char>().swap(fallback);
+      base = 0;
+      length = 0;
+      opened = false;
+      isMmap = false;
+   }
+
+} // namespace gpstk
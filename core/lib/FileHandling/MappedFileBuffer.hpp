@@ -0,0 +1,109 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MappedFileBuffer.hpp
+ * Read-only view of a whole file mapped into memory.
+ */
+
+#ifndef GPSTK_MAPPEDFILEBUFFER_HPP
+#define GPSTK_MAPPEDFILEBUFFER_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Map an entire file read-only into the address space so that
+       * parsers can work directly on the file contents.  On POSIX
+       * systems this uses mmap(); elsewhere the file is read into a
+       * heap buffer, so callers never need to care which one they
+       * got.  The contents stay valid until close() is called, the
+       * object is destroyed or another file is opened.
+       */
+   class MappedFileBuffer
+   {
+   public:
+         /// Create an empty (closed) buffer.
+      MappedFileBuffer();
+
+         /// Unmap the file, if any.
+      ~MappedFileBuffer();
+
+         /** Map the named file.  Any previously mapped file is
+          * released first.
+          * @param[in] fn name of the file to map.
+          * @return true if the file was mapped, false if it could not
+          *   be opened or mapped (in which case isOpen() is false). */
+      bool open(const std::string& fn);
+
+         /// Release the mapping.
+      void close();
+
+         /// Return true if a file is currently mapped.
+      bool isOpen() const
+      { return opened; }
+
+         /// First byte of the file (0 for an empty or closed file).
+      const char* data() const
+      { return base; }
+
+         /// Size of the file in bytes.
+      std::size_t size() const
+      { return length; }
+
+   private:
+         // Mappings are not copyable.
+      MappedFileBuffer(const MappedFileBuffer&);
+      MappedFileBuffer& operator=(const MappedFileBuffer&);
+
+      const char *base;    ///< start of the mapped contents
+      std::size_t length;  ///< number of bytes in base
+      bool opened;         ///< true if open() succeeded
+      bool isMmap;         ///< true if base must be munmap()ed
+      std::vector<char> fallback; ///< contents when mmap isn't available
+   }; // class MappedFileBuffer
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_MAPPEDFILEBUFFER_HPP
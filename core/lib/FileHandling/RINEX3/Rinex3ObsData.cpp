@@ -45,6 +45,7 @@
 #include "RinexObsID.hpp"
 #include "Rinex3ObsStream.hpp"
 #include "Rinex3ObsData.hpp"
+#include "TextSpan.hpp"
 
 using namespace gpstk::StringUtils;
 using namespace std;
@@ -362,8 +363,6 @@ namespace gpstk
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
       throw(Exception)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -399,7 +398,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -460,7 +459,7 @@ namespace gpstk
             // end rod.time = parseTime(line, strm.header);
 
             // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
@@ -573,6 +572,183 @@ namespace gpstk
    }  // end void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
 
 
+      /// Decode one 16-column observation field at column \a pos.
+   static void parseMappedDatum(const TextSpan& line, size_t pos,
+                                RinexDatum& datum)
+   {
+      TextSpan field(line.sub(pos, 14));
+      datum.dataBlank = field.isBlank();
+      datum.data = datum.dataBlank ? 0. : field.asDouble();
+      datum.lliBlank = (line.at(pos+14) == ' ');
+      datum.lli = datum.lliBlank ? 0 : line.sub(pos+14, 1).asInt();
+      datum.ssiBlank = (line.at(pos+15) == ' ');
+      datum.ssi = datum.ssiBlank ? 0 : line.sub(pos+15, 1).asInt();
+   }
+
+
+      /// TextSpan version of Rinex3ObsData::parseTime().
+   static CommonTime parseMappedTime(const TextSpan& line,
+                                     const TimeSystem& ts)
+      throw(FFStreamError)
+   {
+      try
+      {
+            // check if the spaces are in the right place - an easy
+            // way to check if there's corruption in the file
+         if( (line.at( 1) != ' ') || (line.at( 6) != ' ') ||
+             (line.at( 9) != ' ') || (line.at(12) != ' ') ||
+             (line.at(15) != ' ') || (line.at(18) != ' ') ||
+             (line.at(29) != ' ') || (line.at(30) != ' '))
+         {
+            FFStreamError e("Invalid time format");
+            GPSTK_THROW(e);
+         }
+
+            // if there's no time, just return a bad time
+         if(line.sub(2,27).isBlank())
+            return CommonTime::BEGINNING_OF_TIME;
+
+         int year  = line.sub( 2,  4).asInt();
+         int month = line.sub( 7,  2).asInt();
+         int day   = line.sub(10,  2).asInt();
+         int hour  = line.sub(13,  2).asInt();
+         int min   = line.sub(16,  2).asInt();
+         double sec = line.sub(19, 11).asDouble();
+
+            // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often.
+         double ds = 0;
+         if(sec >= 60.)
+         {
+            ds = sec;
+            sec = 0.0;
+         }
+
+         CommonTime rv = CivilTime(year,month,day,hour,min,sec).convertToCommonTime();
+         if(ds != 0) rv += ds;
+
+         rv.setTimeSystem(ts);
+
+         return rv;
+      }
+      catch (FFStreamError& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      catch (gpstk::Exception& e)
+      {
+         FFStreamError err(e);
+         GPSTK_THROW(err);
+      }
+   }  // end parseMappedTime
+
+
+      /** Read a RINEX 3 record from the memory-mapped file attached
+       * to \a strm.  This follows Rinex3ObsData::reallyGetRecord()
+       * field for field, but works on spans of the mapped file
+       * instead of copies of each line and field. */
+   static void reallyGetRecordMapped(Rinex3ObsStream& strm, Rinex3ObsData& rod)
+      throw(FFStreamError, StringException)
+   {
+      TextSpan line;
+
+         // clear out this ObsData
+      rod = Rinex3ObsData();
+
+         // the header (and any earlier records) may have been read
+         // through the stream, so pick up where it left off
+      strm.syncMappedPosition();
+
+         // read the first (epoch) line
+      strm.mappedGetLine(line, true);
+      line.stripTrailing();
+
+         // Check and parse the epoch line -----------------------------------
+         // Check for epoch marker ('>') and following space.
+      if(line.at(0) != '>' || line.at(1) != ' ' || line.size() < 31)
+      {
+         FFStreamError e("Bad epoch line: >" + line.toString() + "<");
+         GPSTK_THROW(e);
+      }
+
+      rod.epochFlag = line.sub(31,1).asInt();
+      if(rod.epochFlag < 0 || rod.epochFlag > 6)
+      {
+         FFStreamError e("Invalid epoch flag: " + asString(rod.epochFlag));
+         GPSTK_THROW(e);
+      }
+
+      rod.time = parseMappedTime(line, strm.timesystem);
+
+      rod.numSVs = line.sub(32,3).asInt();
+
+      if(line.size() > 41)
+         rod.clockOffset = line.sub(41,15).asDouble();
+      else
+         rod.clockOffset = 0.0;
+
+         // Read the observations: SV ID and data ----------------------------
+      if(rod.epochFlag == 0 || rod.epochFlag == 1 || rod.epochFlag == 6)
+      {
+         for(int isv = 0; isv < rod.numSVs; isv++)
+         {
+            strm.mappedGetLine(line);
+            line.stripTrailing();
+
+               // get the SV ID
+            RinexSatID sat;
+            try
+            {
+               sat = RinexSatID(line.sub(0,3).toString());
+            }
+            catch (Exception& e)
+            {
+               FFStreamError ffse(e);
+               GPSTK_THROW(ffse);
+            }
+
+               // get the # data items (# entries in ObsType map of
+               // maps from header).  Missing trailing fields read as
+               // blanks, see TextSpan::at().
+            string gnss(1, sat.systemChar());
+            int size = strm.header.mapObsTypes[gnss].size();
+
+               // decode directly into the record's own storage
+            vector<RinexDatum>& data = rod.obs[sat];
+            data.resize(size);
+            for(int i = 0; i < size; i++)
+               parseMappedDatum(line, 3 + 16*i, data[i]);
+         }
+      }
+
+         // ... or the auxiliary header information
+      else if(rod.numSVs > 0)
+      {
+         rod.auxHeader.clear();
+         for(int i = 0; i < rod.numSVs; i++)
+         {
+            strm.mappedGetLine(line);
+            line.stripTrailing();
+            string hline(line.toString());
+            try
+            {
+               rod.auxHeader.parseHeaderRecord(hline);
+            }
+            catch(FFStreamError& e)
+            {
+               GPSTK_RETHROW(e);
+            }
+            catch(StringException& e)
+            {
+               GPSTK_RETHROW(e);
+            }
+         }
+      }
+
+         // keep the stream where a normal read would have left it
+      strm.syncStreamPosition();
+   }  // end reallyGetRecordMapped()
+
+
    void Rinex3ObsData::reallyGetRecord(FFStream& ffs)
       throw(std::exception, FFStreamError, gpstk::StringUtils::StringException)
    {
@@ -595,6 +771,19 @@ namespace gpstk
          return;
       }
 
+      if(strm.isMappedRead())
+      {
+         try
+         {
+            reallyGetRecordMapped(strm, *this);
+         }
+         catch(Exception& e)
+         {
+            GPSTK_RETHROW(e);
+         }
+         return;
+      }
+
       string line;
       Rinex3ObsData rod;
 
@@ -39,6 +39,8 @@
  * File stream for RINEX 3 observation file data.
  */
 
+#include <cstring>
+#include <cctype>
 #include "Rinex3ObsStream.hpp"
 
 namespace gpstk
@@ -79,6 +81,8 @@ namespace gpstk
          std::ios::openmode mode )
    {
       FFTextStream::open(fn, mode);
+      disableMappedRead();
+      previousTime = CommonTime::BEGINNING_OF_TIME;
    }
 
 
@@ -88,6 +92,8 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
+      mappedPos = 0;
    }
 
 
@@ -114,4 +120,80 @@ namespace gpstk
       return true;
    }
 
+
+   bool Rinex3ObsStream ::
+   enableMappedRead()
+   {
+      if (!is_open() || filename.empty())
+         return false;
+      if (!mapped.open(filename))
+         return false;
+      syncMappedPosition();
+      return true;
+   }
+
+
+   void Rinex3ObsStream ::
+   disableMappedRead()
+   {
+      mapped.close();
+      mappedPos = 0;
+   }
+
+
+   void Rinex3ObsStream ::
+   syncMappedPosition()
+   {
+      std::streampos pos = tellg();
+      mappedPos = (pos < 0) ? 0 : static_cast<std::size_t>(pos);
+   }
+
+
+   void Rinex3ObsStream ::
+   syncStreamPosition()
+   {
+      seekg(static_cast<std::streamoff>(mappedPos), std::ios::beg);
+   }
+
+
+   void Rinex3ObsStream ::
+   mappedGetLine(TextSpan& line, const bool expectEOF)
+      throw(EndOfFile, FFStreamError)
+   {
+      const char *buf = mapped.data();
+      std::size_t size = mapped.size();
+      if (mappedPos >= size)
+      {
+            // Same stream state std::getline leaves behind at EOF.
+         setstate(std::ios::eofbit | std::ios::failbit);
+         if (expectEOF)
+         {
+            EndOfFile err("EOF encountered");
+            GPSTK_THROW(err);
+         }
+         FFStreamError err("Unexpected EOF encountered");
+         GPSTK_THROW(err);
+      }
+
+      const char *begin = buf + mappedPos;
+      const char *nl = static_cast<const char*>(
+         std::memchr(begin, '\n', size - mappedPos));
+      std::size_t len = nl ? (nl - begin) : (size - mappedPos);
+      mappedPos += nl ? len + 1 : len;
+
+         // Remove CR characters left over from windows files
+      while (len > 0 && begin[len-1] == '\r')
+         len--;
+      for (std::size_t i = 0; i < len; i++)
+      {
+         if (!isprint(static_cast<unsigned char>(begin[i])))
+         {
+            FFStreamError err("Non-text data in file.");
+            GPSTK_THROW(err);
+         }
+      }
+      lineNumber++;
+      line = TextSpan(begin, len);
+   }
+
 } // namespace gpstk
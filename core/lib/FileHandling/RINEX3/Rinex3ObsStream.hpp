@@ -48,6 +48,8 @@
 #include <string>
 
 #include "FFTextStream.hpp"
+#include "MappedFileBuffer.hpp"
+#include "TextSpan.hpp"
 #include "Rinex3ObsHeader.hpp"
 
 namespace gpstk
@@ -58,6 +60,13 @@ namespace gpstk
       /**
        * This class reads RINEX 3 Obs files.
        *
+       * For input streams the observation records can optionally be
+       * parsed straight out of a memory-mapped copy of the file (see
+       * enableMappedRead()).  The header is always read through the
+       * normal stream interface and the stream position is kept in
+       * step with the mapped reader, so error recovery, tellg() and
+       * seekg() behave the same way in either mode.
+       *
        * @sa Rinex3ObsData and Rinex3ObsHeader.
        */
    class Rinex3ObsStream : public FFTextStream
@@ -110,12 +119,59 @@ namespace gpstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time tag of the last RINEX 2 epoch read with a time;
+          * used for epochs (inline header blocks) that omit it. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+         /** Map the file currently open on this stream into memory and
+          * parse RINEX 3 observation records from the mapping instead
+          * of through std::getline.  The resulting Rinex3ObsData
+          * records are identical to those read in the normal mode;
+          * the difference is that lines and fields are never copied
+          * into temporary strings.  RINEX 2 files are unaffected.
+          * The mapping is dropped when the stream is re-opened.
+          * @return true if the file was mapped, false if mapping is
+          *   not possible (the stream then keeps working normally). */
+      bool enableMappedRead();
+
+         /// Stop using the memory-mapped reader.
+      void disableMappedRead();
+
+         /// Return true if records are read from a memory-mapped file.
+      bool isMappedRead() const
+      { return mapped.isOpen(); }
+
+         /** Mapped-mode equivalent of formattedGetLine(): set \a line
+          * to the next line of the mapped file (without line
+          * terminators) and advance the mapped read position.
+          * @param[out] line refers into the mapped file.
+          * @param[in] expectEOF set true if finding EOF on this read
+          *   is acceptable.
+          * @throw EndOfFile if \a expectEOF is true and an EOF is
+          *   encountered.
+          * @throw FFStreamError if EOF is found and \a expectEOF is
+          *   false, or the line contains non-text data. */
+      void mappedGetLine(TextSpan& line, const bool expectEOF = false)
+         throw(EndOfFile, FFStreamError);
+
+         /// Move the mapped read position to the stream's get position.
+      void syncMappedPosition();
+
+         /// Move the stream's get position to the mapped read position.
+      void syncStreamPosition();
+
    private:
          /// Initialize internal data structures.
       void init();
+
+         /// The file contents when reading in mapped mode.
+      MappedFileBuffer mapped;
+
+         /// Offset of the next unread byte of \a mapped.
+      std::size_t mappedPos;
    }; // class 'Rinex3ObsStream'
 
       //@}
@@ -0,0 +1,328 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file SnapshotFile.cpp
+ * Versioned, checksummed binary snapshots of in-memory stores.
+ */
+
+#include <cstring>
+#include <fstream>
+
+#include "SnapshotFile.hpp"
+#include "StringUtils.hpp"
+
+namespace gpstk
+{
+   namespace
+   {
+      const char snapshotMagic[8] = {'G','P','S','T','K','S','N','P'};
+      const uint32_t byteOrderMark = 0x01020304;
+      const size_t kindSize = 16;
+
+         /// Table for the reflected CRC-32 polynomial 0xEDB88320.
+      struct CRCTable
+      {
+         uint32_t entry[256];
+         CRCTable()
+         {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+               uint32_t c = i;
+               for (int k = 0; k < 8; k++)
+                  c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+               entry[i] = c;
+            }
+         }
+      };
+      const CRCTable crcTable;
+
+      inline size_t padded(size_t n)
+      { return (n + 7) & ~size_t(7); }
+   }
+
+
+   uint32_t snapshotCRC(const unsigned char *data, size_t len)
+   {
+      uint32_t c = 0xFFFFFFFFu;
+      for (size_t i = 0; i < len; i++)
+         c = crcTable.entry[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+      return c ^ 0xFFFFFFFFu;
+   }
+
+
+   SnapshotWriter ::
+   SnapshotWriter(const std::string& k)
+         : kind(k)
+   {
+      if (kind.size() > kindSize)
+         kind.resize(kindSize);
+   }
+
+
+   void SnapshotWriter ::
+   append(const void *p, size_t n)
+   {
+      size_t start = payload.size();
+      payload.resize(start + padded(n), 0);
+      if (n)
+         std::memcpy(&payload[start], p, n);
+   }
+
+
+   void SnapshotWriter ::
+   putInt(int64_t i)
+   {
+      append(&i, sizeof(i));
+   }
+
+
+   void SnapshotWriter ::
+   putDouble(double d)
+   {
+      append(&d, sizeof(d));
+   }
+
+
+   void SnapshotWriter ::
+   putString(const std::string& s)
+   {
+      putInt(s.size());
+      append(s.data(), s.size());
+   }
+
+
+   void SnapshotWriter ::
+   putTime(const CommonTime& t)
+   {
+      long day, msod;
+      double fsod;
+      TimeSystem ts;
+      t.getInternal(day, msod, fsod, ts);
+      putInt(day);
+      putInt(msod);
+      putDouble(fsod);
+      putInt(static_cast<int>(ts.getTimeSystem()));
+   }
+
+
+   void SnapshotWriter ::
+   putSatID(const SatID& sat)
+   {
+      putInt(static_cast<int>(sat.system));
+      putInt(sat.id);
+   }
+
+
+   void SnapshotWriter ::
+   write(const std::string& filename) const
+   {
+      char header[headerSize];
+      std::memset(header, 0, headerSize);
+      std::memcpy(header, snapshotMagic, 8);
+      uint32_t version = formatVersion;
+      std::memcpy(header + 8, &version, 4);
+      std::memcpy(header + 12, &byteOrderMark, 4);
+      std::memcpy(header + 16, kind.data(), kind.size());
+      uint64_t len = payload.size();
+      std::memcpy(header + 32, &len, 8);
+      uint32_t crc = snapshotCRC(
+         reinterpret_cast<const unsigned char*>(payload.data()), payload.size());
+      std::memcpy(header + 40, &crc, 4);
+      crc = snapshotCRC(reinterpret_cast<const unsigned char*>(header), 44);
+      std::memcpy(header + 44, &crc, 4);
+
+      std::ofstream strm(filename.c_str(), std::ios::out | std::ios::binary);
+      if (!strm)
+      {
+         SnapshotException e("Failed to open output file " + filename);
+         GPSTK_THROW(e);
+      }
+      strm.write(header, headerSize);
+      if (!payload.empty())
+         strm.write(&payload[0], payload.size());
+      strm.close();
+      if (!strm)
+      {
+         SnapshotException e("Failed to write output file " + filename);
+         GPSTK_THROW(e);
+      }
+   }
+
+
+   void SnapshotReader ::
+   open(const std::string& fn, const std::string& kind)
+   {
+      mapped.close();
+      payload = NULL;
+      length = pos = 0;
+      filename = fn;
+
+      if (!mapped.open(fn))
+      {
+         SnapshotException e("Failed to open snapshot file " + fn);
+         GPSTK_THROW(e);
+      }
+      const char *head = mapped.data();
+      if (mapped.size() < SnapshotWriter::headerSize ||
+          std::memcmp(head, snapshotMagic, 8) != 0)
+      {
+         SnapshotException e(fn + " is not a snapshot file");
+         GPSTK_THROW(e);
+      }
+
+      uint32_t version, bom, crc;
+      uint64_t len;
+      std::memcpy(&version, head + 8, 4);
+      std::memcpy(&bom, head + 12, 4);
+      std::memcpy(&len, head + 32, 8);
+      std::memcpy(&crc, head + 44, 4);
+      if (bom != byteOrderMark)
+      {
+         SnapshotException e(fn + " was written on a host of different"
+                             " byte order");
+         GPSTK_THROW(e);
+      }
+      if (crc != snapshotCRC(reinterpret_cast<const unsigned char*>(head), 44))
+      {
+         SnapshotException e(fn + " has a corrupt header");
+         GPSTK_THROW(e);
+      }
+      if (version != SnapshotWriter::formatVersion)
+      {
+         SnapshotException e(fn + " has unsupported snapshot version "
+                             + StringUtils::asString(version));
+         GPSTK_THROW(e);
+      }
+
+      std::string fileKind(head + 16, kindSize);
+      fileKind = fileKind.substr(0, fileKind.find('\0'));
+      if (fileKind != kind.substr(0, kindSize))
+      {
+         SnapshotException e(fn + " is a " + fileKind + " snapshot, not "
+                             + kind);
+         GPSTK_THROW(e);
+      }
+
+      if (len != mapped.size() - SnapshotWriter::headerSize)
+      {
+         SnapshotException e(fn + " is truncated or has trailing data");
+         GPSTK_THROW(e);
+      }
+      std::memcpy(&crc, head + 40, 4);
+      if (crc != snapshotCRC(reinterpret_cast<const unsigned char*>(head) +
+                             SnapshotWriter::headerSize, len))
+      {
+         SnapshotException e(fn + " failed its checksum");
+         GPSTK_THROW(e);
+      }
+
+      payload = head + SnapshotWriter::headerSize;
+      length = len;
+   }
+
+
+   const char *SnapshotReader ::
+   take(size_t n)
+   {
+      if (length - pos < n)
+      {
+         SnapshotException e("Read past the end of snapshot " + filename);
+         GPSTK_THROW(e);
+      }
+      const char *p = payload + pos;
+      pos += padded(n);
+      if (pos > length)
+         pos = length;
+      return p;
+   }
+
+
+   int64_t SnapshotReader ::
+   getInt()
+   {
+      int64_t i;
+      std::memcpy(&i, take(sizeof(i)), sizeof(i));
+      return i;
+   }
+
+
+   double SnapshotReader ::
+   getDouble()
+   {
+      double d;
+      std::memcpy(&d, take(sizeof(d)), sizeof(d));
+      return d;
+   }
+
+
+   std::string SnapshotReader ::
+   getString()
+   {
+      int64_t n = getInt();
+      if (n < 0)
+      {
+         SnapshotException e("Bad string length in snapshot " + filename);
+         GPSTK_THROW(e);
+      }
+      const char *p = take(n);
+      return std::string(p, n);
+   }
+
+
+   CommonTime SnapshotReader ::
+   getTime()
+   {
+      long day = getInt();
+      long msod = getInt();
+      double fsod = getDouble();
+      TimeSystem ts(static_cast<int>(getInt()));
+      CommonTime t;
+      t.setInternal(day, msod, fsod, ts);
+      return t;
+   }
+
+
+   SatID SnapshotReader ::
+   getSatID()
+   {
+      SatID::SatelliteSystem sys =
+         static_cast<SatID::SatelliteSystem>(getInt());
+      int id = getInt();
+      return SatID(id, sys);
+   }
+
+} // namespace gpstk
@@ -0,0 +1,198 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file SnapshotFile.hpp
+ * Versioned, checksummed binary snapshots of in-memory stores.
+ */
+
+#ifndef GPSTK_SNAPSHOTFILE_HPP
+#define GPSTK_SNAPSHOTFILE_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "SatID.hpp"
+#include "MappedFileBuffer.hpp"
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /// Thrown when a snapshot file is missing, truncated or corrupt
+      /// @ingroup exceptiongroup
+   NEW_EXCEPTION_CLASS(SnapshotException, Exception);
+
+      /** Compute the standard CRC-32 (the same as
+       * BinUtils::computeCRC() with BinUtils::CRC32) using a lookup
+       * table, fast enough for checking snapshot files of hundreds
+       * of megabytes.
+       * @param[in] data bytes to check
+       * @param[in] len number of bytes
+       * @return the CRC value */
+   uint32_t snapshotCRC(const unsigned char *data, size_t len);
+
+      /**
+       * Accumulate a binary snapshot of a store in memory and write
+       * it to a file.  A snapshot file is a fixed 48-byte header
+       * followed by a payload of 8-byte fields:
+       *
+       *    bytes  0- 7  magic "GPSTKSNP"
+       *    bytes  8-11  format version (formatVersion)
+       *    bytes 12-15  byte order mark 0x01020304, in writer byte order
+       *    bytes 16-31  store kind, NUL padded (e.g. "ClockSatStore")
+       *    bytes 32-39  payload length in bytes
+       *    bytes 40-43  CRC-32 of the payload
+       *    bytes 44-47  CRC-32 of bytes 0-43
+       *
+       * Integers are written as 64-bit signed values and floating
+       * point values as IEEE doubles, in host byte order; the byte
+       * order mark lets SnapshotReader reject files from a host of
+       * the other endianness.  The layout of the payload is defined
+       * by the store that writes it.
+       */
+   class SnapshotWriter
+   {
+   public:
+         /// Size of the file header in bytes
+      static const size_t headerSize = 48;
+         /// Current format version
+      static const uint32_t formatVersion = 1;
+
+         /** Start an empty snapshot.
+          * @param[in] kind identifies the store type, at most 16
+          *   characters; SnapshotReader::open() checks it. */
+      explicit SnapshotWriter(const std::string& kind);
+
+         /// Append a signed integer.
+      void putInt(int64_t i);
+         /// Append a double.
+      void putDouble(double d);
+         /// Append a boolean, as an integer 0 or 1.
+      void putBool(bool b)
+      { putInt(b ? 1 : 0); }
+         /// Append a string, as its length followed by its bytes padded to 8.
+      void putString(const std::string& s);
+         /// Append a CommonTime exactly, as day, msod, fsod and time system.
+      void putTime(const CommonTime& t);
+         /// Append a SatID, as system and id.
+      void putSatID(const SatID& sat);
+
+         /// Number of payload bytes so far.
+      size_t size() const
+      { return payload.size(); }
+
+         /** Write the header and payload to a file, replacing any
+          * existing file of that name.
+          * @throw SnapshotException if the file cannot be written. */
+      void write(const std::string& filename) const;
+
+   private:
+         /// Append n bytes, padded with zeros to a multiple of 8.
+      void append(const void *p, size_t n);
+
+      std::string kind;
+      std::vector<char> payload;
+   }; // end class SnapshotWriter
+
+      /**
+       * Open a snapshot written by SnapshotWriter and read its
+       * payload fields back in the order they were written.  The
+       * file is memory mapped (see MappedFileBuffer) and the fields
+       * are decoded directly from the mapping, so reading a snapshot
+       * costs little more than paging the file in.  The header and
+       * both checksums are verified by open(), before any field is
+       * returned.
+       */
+   class SnapshotReader
+   {
+   public:
+      SnapshotReader()
+            : payload(NULL), length(0), pos(0)
+      {}
+
+         /** Map a snapshot file and verify it.
+          * @param[in] filename the file to open
+          * @param[in] kind the store kind the file must have been
+          *   written with
+          * @throw SnapshotException if the file cannot be read, is
+          *   not a snapshot, has an unsupported version or byte
+          *   order, is of a different kind, or fails a checksum. */
+      void open(const std::string& filename, const std::string& kind);
+
+         /// Read a signed integer. @throw SnapshotException past the end.
+      int64_t getInt();
+         /// Read a double. @throw SnapshotException past the end.
+      double getDouble();
+         /// Read a boolean. @throw SnapshotException past the end.
+      bool getBool()
+      { return getInt() != 0; }
+         /// Read a string. @throw SnapshotException past the end.
+      std::string getString();
+         /// Read a CommonTime. @throw SnapshotException past the end.
+      CommonTime getTime();
+         /// Read a SatID. @throw SnapshotException past the end.
+      SatID getSatID();
+
+         /// True when every payload field has been read.
+      bool atEnd() const
+      { return pos >= length; }
+
+         /// Name of the open file.
+      const std::string& getFilename() const
+      { return filename; }
+
+   private:
+         /** Return a pointer to the next n bytes of payload and
+          * advance past them (and their padding). */
+      const char *take(size_t n);
+
+      MappedFileBuffer mapped;
+      std::string filename;
+      const char *payload;  ///< start of the payload in the mapping
+      size_t length;        ///< payload length
+      size_t pos;           ///< read position within the payload
+   }; // end class SnapshotReader
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_SNAPSHOTFILE_HPP
@@ -84,12 +84,15 @@ namespace gpstk
       char cb = strID[i+1];
       char tc = strID[i+2];
  
-      if (!char2ot.count(ot) || !char2cb.count(cb) || !char2tc.count(tc))
-         idCreator(strID.substr(i,3));
+      {
+         std::lock_guard<std::mutex> lock(registryMutex());
+         if (!char2ot.count(ot) || !char2cb.count(cb) || !char2tc.count(tc))
+            idCreator(strID.substr(i,3));
 
-      type = char2ot[ ot ];
-      band = char2cb[ cb ];
-      code = char2tc[ tc ];
+         type = char2ot[ ot ];
+         band = char2cb[ cb ];
+         code = char2tc[ tc ];
+      }
 
       /// This next block takes care of fixing up the codes that are reused
       /// between the various signals
@@ -247,6 +250,7 @@ namespace gpstk
    // Convenience output method
    std::ostream& ObsID::dump(std::ostream& s) const
    {
+      std::lock_guard<std::mutex> lock(registryMutex());
       s << ObsID::cbDesc[band] << " "
         << ObsID::tcDesc[code] << " "
         << ObsID::otDesc[type];
@@ -262,6 +266,7 @@ namespace gpstk
    ObsID ObsID::newID(const std::string& strID, const std::string& desc)
       throw(InvalidParameter)
    {
+      std::lock_guard<std::mutex> lock(registryMutex());
       if (char2ot.count(strID[0]) && 
           char2cb.count(strID[1]) && 
           char2tc.count(strID[2]))
@@ -271,6 +276,13 @@ namespace gpstk
    }
 
 
+   std::mutex& ObsID::registryMutex()
+   {
+      static std::mutex registry;
+      return registry;
+   }
+
+
    ObsID ObsID::idCreator(const std::string& strID, const std::string& desc)
    {
       char ot = strID[0];
@@ -50,6 +50,7 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <mutex>
 
 #include "Exception.hpp"
 #include "SatID.hpp"
@@ -322,7 +323,16 @@ namespace gpstk
       static std::map< CarrierBand, char > cb2char;
       static std::map< TrackingCode, char> tc2char;
 
+         /** Lock on the maps above, which are extended whenever a
+          * new identifier is seen.  The members of ObsID and
+          * RinexObsID hold it while they use the maps, so that ids
+          * may be created and printed from several threads at once;
+          * other code using the maps at such times should hold it
+          * too. */
+      static std::mutex& registryMutex();
+
    private:
+         /// Create the definitions of id; the caller holds registryMutex().
       static ObsID idCreator(const std::string& id, const std::string& desc="");
 
    }; // class ObsID
@@ -48,6 +48,7 @@
 #include "GNSSconstants.hpp"    // for TWO_PI, etc
 #include "GNSSconstants.hpp"             // for RAD_TO_DEG, etc
 #include "MiscMath.hpp"             // for RSS, SQRT
+#include "FixedVector.hpp"
 
 namespace gpstk
 {
@@ -1317,6 +1318,20 @@ namespace gpstk
       return (A * SQRT(f));
    }
 
+      // Get the cartesian coordinates of P; this copies P only when it must be
+      // transformed, which is not the case for the usual ECEF positions.
+   static void cartesian(const Position& P, FixedVector<double,3>& xyz)
+      throw()
+   {
+      if(P.getCoordinateSystem() == Position::Cartesian) {
+         for(int i=0; i<3; i++) xyz[i] = P.theArray[i];
+         return;
+      }
+      Position T(P);
+      T.transformTo(Position::Cartesian);
+      for(int i=0; i<3; i++) xyz[i] = T.theArray[i];
+   }
+
       // A member function that computes the elevation of the input
       // (Target) position as seen from this Position.
       // @param Target the Position which is observed to have the
@@ -1325,19 +1340,22 @@ namespace gpstk
    double Position::elevation(const Position& Target) const
       throw(GeometryException)
    {
-      Position R(*this),S(Target);
-      R.transformTo(Cartesian);
-      S.transformTo(Cartesian);
-      // use Triple:: functions in cartesian coordinates (only)
-      double elevation;
-      try {
-         elevation = R.elvAngle(S);
-      }
-      catch(GeometryException& ge)
+      FixedVector<double,3> R, S;
+      cartesian(*this, R);
+      cartesian(Target, S);
+
+      // as Triple::elvAngle(), in cartesian coordinates (only)
+      FixedVector<double,3> z(S - R);
+      double rx(gpstk::dot(z,z)), ry(gpstk::dot(R,R));
+      if(rx <= 1e-14 || ry <= 1e-14)
       {
-         GPSTK_RETHROW(ge);
+         GeometryException ge("Divide by Zero Error");
+         GPSTK_THROW(ge);
       }
-      return elevation;
+      double c(gpstk::dot(z,R) / ::sqrt(rx * ry));
+      if(fabs(c) > 1.0e0) c = fabs(c) / c;   // round off error
+
+      return 90.0 - ::acos(c) * RAD_TO_DEG;
    }
 
       // A member function that computes the elevation of the input
@@ -1349,29 +1367,29 @@ namespace gpstk
    double Position::elevationGeodetic(const Position& Target) const
       throw(GeometryException)
    {
-      Position R(*this),S(Target);
-      double latGeodetic = R.getGeodeticLatitude()*DEG_TO_RAD;
-      double longGeodetic = R.getLongitude()*DEG_TO_RAD;
+      double latGeodetic = getGeodeticLatitude()*DEG_TO_RAD;
+      double longGeodetic = getLongitude()*DEG_TO_RAD;
       double localUp;
       double cosUp;
-      R.transformTo(Cartesian);
-      S.transformTo(Cartesian);
-      Triple z;
+      FixedVector<double,3> R, S;
+      cartesian(*this, R);
+      cartesian(Target, S);
       // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      FixedVector<double,3> z(S - R);
+      double zmag(::sqrt(gpstk::dot(z,z)));
 
-      if (z.mag()<=1e-4) // if the positions are within .1 millimeter
+      if (zmag<=1e-4) // if the positions are within .1 millimeter
       {
          GeometryException ge("Positions are within .1 millimeter");
          GPSTK_THROW(ge);
       }
 
       // Compute k vector in local North-East-Up (NEU) system
-      Triple kVector(::cos(latGeodetic)*::cos(longGeodetic), ::cos(latGeodetic)*::sin(longGeodetic), ::sin(latGeodetic));
+      FixedVector<double,3> kVector(::cos(latGeodetic)*::cos(longGeodetic), ::cos(latGeodetic)*::sin(longGeodetic), ::sin(latGeodetic));
       // Take advantage of dot method to get Up coordinate in local NEU system
-      localUp = z.dot(kVector);
+      localUp = gpstk::dot(z,kVector);
       // Let's get cos(z), being z the angle with respect to local vertical (Up);
-      cosUp = localUp/z.mag();
+      cosUp = localUp/zmag;
 
       return 90.0 - ((::acos(cosUp))*RAD_TO_DEG);
    }
@@ -1384,22 +1402,37 @@ namespace gpstk
    double Position::azimuth(const Position& Target) const
       throw(GeometryException)
    {
-      Position R(*this),S(Target);
-      R.transformTo(Cartesian);
-      S.transformTo(Cartesian);
-      // use Triple:: functions in cartesian coordinates (only)
-      double az;
-      try
-      {
-         az = R.azAngle(S);
+      FixedVector<double,3> R, S;
+      cartesian(*this, R);
+      cartesian(Target, S);
+
+      // as Triple::azAngle(), in cartesian coordinates (only)
+      double xy(R[0]*R[0] + R[1]*R[1]);
+      double xyz(xy + R[2]*R[2]);
+      xy = ::sqrt(xy);
+      xyz = ::sqrt(xyz);
 
+      if (xy <= 1e-14 || xyz <= 1e-14)
+      {
+         GeometryException ge("Divide by Zero Error");
+         GPSTK_THROW(ge);
       }
-      catch(GeometryException& ge)
+
+      double cosl(R[0]/xy), sinl(R[1]/xy), sint(R[2]/xyz);
+      FixedVector<double,3> z(S - R);
+
+      // north and east components of z
+      double p1 = (-sint*cosl * z[0]) + (-sint*sinl * z[1]) + (xy/xyz * z[2]);
+      double p2 = (-sinl * z[0]) + (cosl * z[1]);
+
+      if (fabs(p1) + fabs(p2) < 1.0e-14)
       {
-         GPSTK_RETHROW(ge);
+         GeometryException ge("azAngle(), failed p1+p2 test.");
+         GPSTK_THROW(ge);
       }
 
-      return az;
+      double az = 90 - ::atan2(p1, p2) * RAD_TO_DEG;
+      return (az < 0 ? az + 360 : az);
    }
 
       // A member function that computes the azimuth of the input
@@ -1411,30 +1444,30 @@ namespace gpstk
    double Position::azimuthGeodetic(const Position& Target) const
       throw(GeometryException)
    {
-      Position R(*this),S(Target);
-      double latGeodetic = R.getGeodeticLatitude()*DEG_TO_RAD;
-      double longGeodetic = R.getLongitude()*DEG_TO_RAD;
+      double latGeodetic = getGeodeticLatitude()*DEG_TO_RAD;
+      double longGeodetic = getLongitude()*DEG_TO_RAD;
       double localN, localE;
-      R.transformTo(Cartesian);
-      S.transformTo(Cartesian);
-      Triple z;
+      FixedVector<double,3> R, S;
+      cartesian(*this, R);
+      cartesian(Target, S);
       // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      FixedVector<double,3> z(S - R);
+      double zmag(::sqrt(gpstk::dot(z,z)));
 
-      if (z.mag()<=1e-4) // if the positions are within .1 millimeter
+      if (zmag<=1e-4) // if the positions are within .1 millimeter
       {
          GeometryException ge("Positions are within .1 millimeter");
          GPSTK_THROW(ge);
       }
 
       // Compute i vector in local North-East-Up (NEU) system
-      Triple iVector(-::sin(latGeodetic)*::cos(longGeodetic), -::sin(latGeodetic)*::sin(longGeodetic), ::cos(latGeodetic));
+      FixedVector<double,3> iVector(-::sin(latGeodetic)*::cos(longGeodetic), -::sin(latGeodetic)*::sin(longGeodetic), ::cos(latGeodetic));
       // Compute j vector in local North-East-Up (NEU) system
-      Triple jVector(-::sin(longGeodetic), ::cos(longGeodetic), 0);
+      FixedVector<double,3> jVector(-::sin(longGeodetic), ::cos(longGeodetic), 0);
 
       // Now, let's use dot product to get localN and localE unitary vectors
-      localN = (z.dot(iVector))/z.mag();
-      localE = (z.dot(jVector))/z.mag();
+      localN = gpstk::dot(z,iVector)/zmag;
+      localE = gpstk::dot(z,jVector)/zmag;
 
       // Let's test if computing azimuth has any sense
       double test = fabs(localN) + fabs(localE);
@@ -0,0 +1,138 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file XvtArray.hpp
+ * Structure-of-arrays container for many Xvt results.
+ */
+
+#ifndef GPSTK_XVTARRAY_INCLUDE
+#define GPSTK_XVTARRAY_INCLUDE
+
+#include <vector>
+#include "Xvt.hpp"
+
+namespace gpstk
+{
+   /** @addtogroup geodeticgroup */
+   //@{
+
+      /** Position, velocity and clock terms for many epochs and/or
+       * satellites, stored one component per contiguous array so that
+       * batch computations (e.g. OrbitEph::svXvtBatch()) can write
+       * each component with unit stride.  Element i of every array
+       * corresponds to the i'th Xvt. */
+   class XvtArray
+   {
+   public:
+         /// Construct an empty array.
+      XvtArray()
+      {}
+
+         /// Construct an array holding n default (zero) elements.
+      explicit XvtArray(size_t n)
+      { resize(n); }
+
+         /// Number of elements held.
+      size_t size() const
+      { return x.size(); }
+
+         /// Change the number of elements held.
+      void resize(size_t n)
+      {
+         x.resize(n, 0.);
+         y.resize(n, 0.);
+         z.resize(n, 0.);
+         vx.resize(n, 0.);
+         vy.resize(n, 0.);
+         vz.resize(n, 0.);
+         clkbias.resize(n, 0.);
+         clkdrift.resize(n, 0.);
+         relcorr.resize(n, 0.);
+         frame.resize(n, ReferenceFrame(ReferenceFrame::Unknown));
+      }
+
+         /// Assemble element i into an Xvt.
+      Xvt getXvt(size_t i) const
+      {
+         Xvt rv;
+         rv.x[0] = x[i];
+         rv.x[1] = y[i];
+         rv.x[2] = z[i];
+         rv.v[0] = vx[i];
+         rv.v[1] = vy[i];
+         rv.v[2] = vz[i];
+         rv.clkbias = clkbias[i];
+         rv.clkdrift = clkdrift[i];
+         rv.relcorr = relcorr[i];
+         rv.frame = frame[i];
+         return rv;
+      }
+
+         /// Store xvt as element i.
+      void setXvt(size_t i, const Xvt& xvt)
+      {
+         x[i] = xvt.x[0];
+         y[i] = xvt.x[1];
+         z[i] = xvt.x[2];
+         vx[i] = xvt.v[0];
+         vy[i] = xvt.v[1];
+         vz[i] = xvt.v[2];
+         clkbias[i] = xvt.clkbias;
+         clkdrift[i] = xvt.clkdrift;
+         relcorr[i] = xvt.relcorr;
+         frame[i] = xvt.frame;
+      }
+
+         /// ECEF position components in meters.
+      std::vector<double> x, y, z;
+         /// ECEF velocity components in m/s.
+      std::vector<double> vx, vy, vz;
+         /// Clock bias in seconds.
+      std::vector<double> clkbias;
+         /// Clock drift in s/s.
+      std::vector<double> clkdrift;
+         /// Relativity correction in seconds.
+      std::vector<double> relcorr;
+         /// Reference frame of each position/velocity.
+      std::vector<ReferenceFrame> frame;
+   }; // end class XvtArray
+
+   //@}
+
+}  // end namespace gpstk
+
+#endif // GPSTK_XVTARRAY_INCLUDE
@@ -404,4 +404,34 @@ namespace gpstk
       return sv;
    }
 
+   // Append the data members to a binary snapshot.
+   void BDSEphemeris::writeSnapshot(SnapshotWriter& snap) const
+   {
+      OrbitEph::writeSnapshot(snap);
+      snap.putTime(transmitTime);
+      snap.putInt(HOWtime);
+      snap.putInt(IODE);
+      snap.putInt(IODC);
+      snap.putInt(health);
+      snap.putDouble(accuracy);
+      snap.putDouble(Tgd13);
+      snap.putDouble(Tgd23);
+      snap.putInt(fitDuration);
+   }
+
+   // Restore the data members from a binary snapshot.
+   void BDSEphemeris::readSnapshot(SnapshotReader& snap)
+   {
+      OrbitEph::readSnapshot(snap);
+      transmitTime = snap.getTime();
+      HOWtime = static_cast<long>(snap.getInt());
+      IODE = static_cast<short>(snap.getInt());
+      IODC = static_cast<short>(snap.getInt());
+      health = static_cast<short>(snap.getInt());
+      accuracy = snap.getDouble();
+      Tgd13 = snap.getDouble();
+      Tgd23 = snap.getDouble();
+      fitDuration = static_cast<short>(snap.getInt());
+   }
+
 } // end namespace
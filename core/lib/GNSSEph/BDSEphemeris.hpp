@@ -106,6 +106,12 @@ namespace gpstk
       virtual void dumpBody(std::ostream& os = std::cout) const;
       virtual void dumpTerse(std::ostream& os=std::cout) const;
 
+         /// Append the data members to a binary snapshot.
+      virtual void writeSnapshot(SnapshotWriter& snap) const;
+
+         /// Restore the data members from a binary snapshot.
+      virtual void readSnapshot(SnapshotReader& snap);
+
          // member data
       CommonTime transmitTime; ///< Time of transmission
       long HOWtime;            ///< Time (seconds-of-week) of handover word (txmit)
@@ -73,121 +73,149 @@ namespace gpstk
       try {
          checkTimeSystem(ttag.getTimeSystem());
 
-         bool isExact;
-         ClockRecord rec;
-         DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
-
-         isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveClockDrift);
-         if(isExact && haveClockDrift) {
-            rec = it1->second;
-            return rec;
-         }
+         DataTableIterator it1, it2;            // cf. TabularSatStore.hpp
+         bool isExact(getTableInterval(sat, ttag, Nhalf, it1, it2, haveClockDrift));
+         return interpolateRecord(ttag, isExact, it1, it2);
+      }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
 
-         // pull data out of the data table
-         size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
-         CommonTime ttag0(it1->first);
-         vector<double> times,biases,drifts,accels,sig_biases,sig_drifts,sig_accels;
+   // Non-throwing form of getValue()
+   // @param[in] sat the SatID of the satellite of interest
+   // @param[in] ttag the time (CommonTime) of interest
+   // @param[out] rec the value, when true is returned
+   // @return true if the value was computed, false where getValue() would throw
+   bool ClockSatStore::computeValue(const SatID& sat, const CommonTime& ttag,
+                                    ClockRecord& rec) const
+   {
+      if(!compatibleTimeSystem(ttag.getTimeSystem()))
+         return false;
 
-         kt=it1; n=0;
-         while(1) {
-            // find index of matching time tag
-            if(isExact && ABS(kt->first-ttag) < 1.e-8) Nmatch = n;
-            times.push_back(kt->first - ttag0);    // sec
-            biases.push_back(kt->second.bias);     // sec
-            drifts.push_back(kt->second.drift);    // sec/sec
-            accels.push_back(kt->second.accel);    // sec/sec^2
-            sig_biases.push_back(kt->second.sig_bias);     // sec
-            sig_drifts.push_back(kt->second.sig_drift);    // sec/sec
-            sig_accels.push_back(kt->second.sig_accel);    // sec/sec^2
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
+      bool isExact;
+      DataTableIterator it1, it2;
+      if(findTableInterval(sat, ttag, Nhalf, it1, it2, haveClockDrift, isExact)
+            != intervalFound)
+         return false;
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+      rec = interpolateRecord(ttag, isExact, it1, it2);
+      return true;
+   }
 
-         // interpolate
-         rec.accel = rec.sig_accel = 0.0;              // defaults
-         double dt(ttag-ttag0), err, slope;
-         if(haveClockDrift) {
-            if(interpType == 2) {
-               // Lagrange interpolation
-               rec.bias = LagrangeInterpolation(times,biases,dt,err);      // sec
-               rec.drift = LagrangeInterpolation(times,drifts,dt,err);     // sec/sec
-            }
-            else {
-               // linear interpolation
-               slope = (biases[Nhi]-biases[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);               // sec/sec
-               rec.bias = biases[Nlow] + slope*(dt-times[Nlow]);           // sec
-               slope = (drifts[Nhi]-drifts[Nlow])/(times[Nhi]-times[Nlow]);
-               rec.drift = drifts[Nlow] + slope*(dt-times[Nlow]);          // sec/sec
-            }
+   // Interpolate the records (it1..it2) found by getTableInterval() to time ttag
+   ClockRecord ClockSatStore::interpolateRecord(const CommonTime& ttag, bool isExact,
+                                                DataTableIterator it1,
+                                                DataTableIterator it2) const
+   {
+      ClockRecord rec;
+      DataTableIterator kt;
+      if(isExact && haveClockDrift) {
+         rec = it1->second;
+         return rec;
+      }
 
-            // sigmas
-            if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
-            else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
-            rec.sig_drift = RSS(sig_drifts[Nhi],sig_drifts[Nlow]);
+      // pull data out of the data table
+      size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+      CommonTime ttag0(it1->first);
+      vector<double> times,biases,drifts,accels,sig_biases,sig_drifts,sig_accels;
+
+      kt=it1; n=0;
+      while(1) {
+         // find index of matching time tag
+         if(isExact && ABS(kt->first-ttag) < 1.e-8) Nmatch = n;
+         times.push_back(kt->first - ttag0);    // sec
+         biases.push_back(kt->second.bias);     // sec
+         drifts.push_back(kt->second.drift);    // sec/sec
+         accels.push_back(kt->second.accel);    // sec/sec^2
+         sig_biases.push_back(kt->second.sig_bias);     // sec
+         sig_drifts.push_back(kt->second.sig_drift);    // sec/sec
+         sig_accels.push_back(kt->second.sig_accel);    // sec/sec^2
+         if(kt == it2) break;
+         ++kt;
+         ++n;
+      };
+
+      if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+
+      // interpolate
+      rec.accel = rec.sig_accel = 0.0;              // defaults
+      double dt(ttag-ttag0), err, slope;
+      if(haveClockDrift) {
+         if(interpType == 2) {
+            // Lagrange interpolation
+            rec.bias = LagrangeInterpolation(times,biases,dt,err);      // sec
+            rec.drift = LagrangeInterpolation(times,drifts,dt,err);     // sec/sec
+         }
+         else {
+            // linear interpolation
+            slope = (biases[Nhi]-biases[Nlow]) /
+                                (times[Nhi]-times[Nlow]);               // sec/sec
+            rec.bias = biases[Nlow] + slope*(dt-times[Nlow]);           // sec
+            slope = (drifts[Nhi]-drifts[Nlow])/(times[Nhi]-times[Nlow]);
+            rec.drift = drifts[Nlow] + slope*(dt-times[Nlow]);          // sec/sec
          }
-         else {                              // must interpolate biases to get drift
-            if(interpType == 2) {
-               // Lagrange interpolation
-               LagrangeInterpolation(times,biases,dt,rec.bias,rec.drift);
-            }
-            else {
-               // linear interpolation
-               rec.drift = (biases[Nhi]-biases[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);            // sec/sec^2
-               rec.bias = biases[Nlow] + (dt-times[Nlow])*rec.drift;    // sec/sec
-            }
 
-            // sigmas
-            if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
-            else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
-            // TD ?
-            rec.sig_drift = rec.sig_bias/(times[Nhi]-times[Nlow]);
+         // sigmas
+         if(isExact)
+            rec.sig_bias = sig_biases[Nmatch];
+         else
+            rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
+         rec.sig_drift = RSS(sig_drifts[Nhi],sig_drifts[Nlow]);
+      }
+      else {                              // must interpolate biases to get drift
+         if(interpType == 2) {
+            // Lagrange interpolation
+            LagrangeInterpolation(times,biases,dt,rec.bias,rec.drift);
+         }
+         else {
+            // linear interpolation
+            rec.drift = (biases[Nhi]-biases[Nlow]) /
+                                (times[Nhi]-times[Nlow]);            // sec/sec^2
+            rec.bias = biases[Nlow] + (dt-times[Nlow])*rec.drift;    // sec/sec
          }
 
-         if(haveClockAccel) {
-            if(interpType == 2) {
-               // Lagrange interpolation
-               rec.accel = LagrangeInterpolation(times,accels,dt,err);  // sec/sec^2
-            }
-            else {
-               // linear interpolation
-               slope = (drifts[Nhi]-drifts[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);            // sec/sec^2
-               rec.accel = accels[Nlow] + slope*(dt-times[Nlow]);       // sec/sec^2
-            }
+         // sigmas
+         if(isExact)
+            rec.sig_bias = sig_biases[Nmatch];
+         else
+            rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
+         // TD ?
+         rec.sig_drift = rec.sig_bias/(times[Nhi]-times[Nlow]);
+      }
 
-            // sigma
-            if(isExact)
-               rec.sig_accel = sig_accels[Nmatch];
-            else
-               rec.sig_accel = RSS(sig_accels[Nhi],sig_accels[Nlow]);
+      if(haveClockAccel) {
+         if(interpType == 2) {
+            // Lagrange interpolation
+            rec.accel = LagrangeInterpolation(times,accels,dt,err);  // sec/sec^2
+         }
+         else {
+            // linear interpolation
+            slope = (drifts[Nhi]-drifts[Nlow]) /
+                                (times[Nhi]-times[Nlow]);            // sec/sec^2
+            rec.accel = accels[Nlow] + slope*(dt-times[Nlow]);       // sec/sec^2
          }
-         else if(haveClockDrift) {              // must interpolate drift to get accel
-            if(interpType == 2) {
-               // Lagrange interpolation  (err is a dummy here)
-               LagrangeInterpolation(times,drifts,dt,err,rec.accel);
-            }
-            else {
-               // linear interpolation                                  // sec/sec^2
-               rec.accel = (drifts[Nhi]-drifts[Nlow]) / (times[Nhi]-times[Nlow]);
-            }
 
-            // sigmas  TD is there a better way?
-            rec.sig_accel = rec.sig_drift/(times[Nhi]-times[Nlow]);
+         // sigma
+         if(isExact)
+            rec.sig_accel = sig_accels[Nmatch];
+         else
+            rec.sig_accel = RSS(sig_accels[Nhi],sig_accels[Nlow]);
+      }
+      else if(haveClockDrift) {              // must interpolate drift to get accel
+         if(interpType == 2) {
+            // Lagrange interpolation  (err is a dummy here)
+            LagrangeInterpolation(times,drifts,dt,err,rec.accel);
+         }
+         else {
+            // linear interpolation                                  // sec/sec^2
+            rec.accel = (drifts[Nhi]-drifts[Nlow]) / (times[Nhi]-times[Nlow]);
          }
-         // else zero
 
-         return rec;
+         // sigmas  TD is there a better way?
+         rec.sig_accel = rec.sig_drift/(times[Nhi]-times[Nlow]);
       }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      // else zero
+
+      return rec;
    }
 
    // Return the clock bias for the given satellite at the given time
@@ -431,4 +459,51 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   namespace
+   {
+      void putClockRecord(SnapshotWriter& snap, const ClockRecord& rec)
+      {
+         snap.putDouble(rec.bias);
+         snap.putDouble(rec.sig_bias);
+         snap.putDouble(rec.drift);
+         snap.putDouble(rec.sig_drift);
+         snap.putDouble(rec.accel);
+         snap.putDouble(rec.sig_accel);
+      }
+
+      void getClockRecord(SnapshotReader& snap, ClockRecord& rec)
+      {
+         rec.bias = snap.getDouble();
+         rec.sig_bias = snap.getDouble();
+         rec.drift = snap.getDouble();
+         rec.sig_drift = snap.getDouble();
+         rec.accel = snap.getDouble();
+         rec.sig_accel = snap.getDouble();
+      }
+   }
+
+   // Write the contents of the store to a binary snapshot file.
+   void ClockSatStore::writeBinaryFile(const string& filename) const
+   {
+      try {
+         SnapshotWriter snap("ClockSatStore");
+         snap.putBool(haveClockAccel);
+         writeTableSnapshot(snap, putClockRecord);
+         snap.write(filename);
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
+   // Replace the contents of the store with a binary snapshot file.
+   void ClockSatStore::readBinaryFile(const string& filename)
+   {
+      try {
+         SnapshotReader snap;
+         snap.open(filename, "ClockSatStore");
+         haveClockAccel = snap.getBool();
+         readTableSnapshot(snap, getClockRecord);
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
 }  // End of namespace gpstk
@@ -0,0 +1,312 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EpochTable.hpp
+ * Time-ordered table of records kept in one contiguous array. */
+
+#ifndef GPSTK_EPOCH_TABLE_INCLUDE
+#define GPSTK_EPOCH_TABLE_INCLUDE
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+
+      /// @ingroup GNSSEph
+      //@{
+
+      /** A table of DataRecords sorted by time, for use as the per
+       * satellite table in TabularSatStore.  It supports the subset
+       * of the std::map<CommonTime, DataRecord> interface used by the
+       * stores (find, lower_bound, upper_bound, operator[], erase of
+       * a range, and iteration), but keeps all entries in a single
+       * sorted std::vector, so the interpolation window around a time
+       * is a contiguous block of memory and the iterators are
+       * random-access.
+       *
+       * Tabular ephemeris and clock data almost always come at a
+       * fixed cadence.  The table notices when that is the case and
+       * then locates a time with one subtraction and division rather
+       * than a binary search; otherwise the search is a binary search
+       * over the contiguous array.  Either way, the result is checked
+       * against the actual neighbouring times, so lookups always give
+       * exactly the same answer std::map would have.
+       *
+       * Appending records in time order (the normal case when reading
+       * files) costs amortized constant time; inserting before the end
+       * moves the later records up.  The spacing is kept up to date
+       * from the steps next to each change, by counting the steps
+       * that differ from a reference step. */
+   template <class DataRecord>
+   class EpochTable
+   {
+   public:
+         /// Entries are stored as (time, record) pairs, like std::map.
+      typedef std::pair<CommonTime, DataRecord> value_type;
+      typedef std::vector<value_type> Storage;
+      typedef typename Storage::iterator iterator;
+      typedef typename Storage::const_iterator const_iterator;
+      typedef typename Storage::size_type size_type;
+
+         /// Create an empty table.
+      EpochTable()
+            : step(0.0), irregular(0), uniform(false)
+      {}
+
+      const_iterator begin() const
+      { return data.begin(); }
+      const_iterator end() const
+      { return data.end(); }
+      iterator begin()
+      { return data.begin(); }
+      iterator end()
+      { return data.end(); }
+
+         /// Number of records in the table.
+      size_type size() const
+      { return data.size(); }
+
+         /// Return true if the table holds no records.
+      bool empty() const
+      { return data.empty(); }
+
+         /// Remove all records.
+      void clear()
+      {
+         data.clear();
+         step = 0.0;
+         irregular = 0;
+         uniform = false;
+      }
+
+         /// Reserve space for n records.
+      void reserve(size_type n)
+      { data.reserve(n); }
+
+         /// Return true if the times in the table are evenly spaced.
+      bool isUniform() const
+      { return uniform; }
+
+         /// Time step (seconds) between records if isUniform().
+      double getStep() const
+      { return step; }
+
+         /// First record with time not less than t, or end().
+      const_iterator lower_bound(const CommonTime& t) const
+      { return data.begin() + lowerIndex(t); }
+      iterator lower_bound(const CommonTime& t)
+      { return data.begin() + lowerIndex(t); }
+
+         /// First record with time greater than t, or end().
+      const_iterator upper_bound(const CommonTime& t) const
+      { return data.begin() + upperIndex(t); }
+      iterator upper_bound(const CommonTime& t)
+      { return data.begin() + upperIndex(t); }
+
+         /// Record with time equal to t, or end().
+      const_iterator find(const CommonTime& t) const
+      { return data.begin() + findIndex(t); }
+      iterator find(const CommonTime& t)
+      { return data.begin() + findIndex(t); }
+
+         /** Return the record at time t, inserting a default
+          * constructed record there if there is none. */
+      DataRecord& operator[](const CommonTime& t)
+      {
+            // the common case: adding the next record in time order
+         if(data.empty() || data.back().first < t)
+         {
+            if(!data.empty())
+               noteAppend(t);
+            data.push_back(value_type(t, DataRecord()));
+            return data.back().second;
+         }
+         size_type i(lowerIndex(t));
+         if(i < data.size() && !(t < data[i].first))
+            return data[i].second;
+         data.insert(data.begin() + i, value_type(t, DataRecord()));
+         if(data.size() == 2)
+            findStep();
+         else
+         {
+               // the step i (or none, at the front) is split in two
+            if(i > 0)
+               irregular -= !sameStep(data[i+1].first - data[i-1].first);
+            if(i > 0)
+               irregular += !sameStep(data[i].first - data[i-1].first);
+            irregular += !sameStep(data[i+1].first - data[i].first);
+            checkStep();
+         }
+         return data[i].second;
+      }
+
+         /// Remove the records in [first,last).
+      void erase(iterator first, iterator last)
+      {
+         size_type a(first - data.begin()), b(last - data.begin());
+         if(a >= b)
+            return;
+            // the steps into and out of the erased records go, and
+            // the records either side are joined by a single step
+         size_type n(data.size());
+         for(size_type k = std::max(a, size_type(1)); k <= b && k < n; k++)
+            irregular -= !sameStep(data[k].first - data[k-1].first);
+         if(a > 0 && b < n)
+            irregular += !sameStep(data[b].first - data[a-1].first);
+         data.erase(first, last);
+         if(data.size() < 2)
+            findStep();
+         else
+            checkStep();
+      }
+
+   private:
+         /** Index of the first record with time not less than t.  For
+          * evenly spaced tables the index is computed directly, then
+          * confirmed (and if necessary nudged) by comparing times. */
+      size_type lowerIndex(const CommonTime& t) const
+      {
+         size_type n(data.size());
+         if(n == 0)
+            return 0;
+         if(!uniform)
+            return std::lower_bound(data.begin(), data.end(), t,
+                                    LessTime()) - data.begin();
+         double g(std::ceil((t - data[0].first) / step));
+         size_type i;
+         if(g <= 0.0)
+            i = 0;
+         else if(g >= double(n))
+            i = n;
+         else
+            i = size_type(g);
+         while(i > 0 && !(data[i-1].first < t))
+            i--;
+         while(i < n && data[i].first < t)
+            i++;
+         return i;
+      }
+
+         /// Index of the first record with time greater than t.
+      size_type upperIndex(const CommonTime& t) const
+      {
+         size_type i(lowerIndex(t));
+         if(i < data.size() && !(t < data[i].first))
+            i++;
+         return i;
+      }
+
+         /// Index of the record with time equal to t, or size().
+      size_type findIndex(const CommonTime& t) const
+      {
+         size_type i(lowerIndex(t));
+         if(i < data.size() && !(t < data[i].first))
+            return i;
+         return data.size();
+      }
+
+         /// Update the step bookkeeping for a record about to be appended.
+      void noteAppend(const CommonTime& t)
+      {
+         double dt(t - data.back().first);
+         if(data.size() == 1)
+         {
+            step = dt;
+            irregular = 0;
+            uniform = (dt > 0.0);
+         }
+         else
+         {
+            irregular += !sameStep(dt);
+            uniform = (irregular == 0);
+         }
+      }
+
+         /** Set uniform from the count of irregular steps.  If every
+          * step differs from the reference step the steps might now
+          * all be equal to each other, which only a rescan can tell;
+          * otherwise at least one step matches the reference and any
+          * other step is a real irregularity. */
+      void checkStep()
+      {
+         if(irregular > 0 && irregular == data.size() - 1)
+            findStep();
+         else
+            uniform = (irregular == 0 && step > 0.0);
+      }
+
+         /** Work out the step bookkeeping from scratch, taking the
+          * first step as the reference. */
+      void findStep()
+      {
+         uniform = false;
+         step = 0.0;
+         irregular = 0;
+         if(data.size() < 2)
+            return;
+         step = data[1].first - data[0].first;
+         for(size_type i=2; i<data.size(); i++)
+            irregular += !sameStep(data[i].first - data[i-1].first);
+         uniform = (irregular == 0 && step > 0.0);
+      }
+
+         /// Return true if dt matches the table step.
+      bool sameStep(double dt) const
+      { return std::fabs(dt - step) <= 1.0e-9 * step; }
+
+         /// Compare a table entry with a time.
+      struct LessTime
+      {
+         bool operator()(const value_type& v, const CommonTime& t) const
+         { return v.first < t; }
+      };
+
+      Storage data;    ///< the records, sorted by time
+      double step;     ///< time step (seconds) when uniform
+      size_type irregular; ///< number of steps not equal to step
+      bool uniform;    ///< true if all steps equal step
+   }; // end class EpochTable
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_EPOCH_TABLE_INCLUDE
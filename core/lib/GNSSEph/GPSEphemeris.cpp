@@ -261,4 +261,40 @@ namespace gpstk
       return 0; // never reached
    }
 
+   // Append the data members to a binary snapshot.
+   void GPSEphemeris::writeSnapshot(SnapshotWriter& snap) const
+   {
+      OrbitEph::writeSnapshot(snap);
+      snap.putTime(transmitTime);
+      snap.putInt(HOWtime);
+      snap.putInt(IODE);
+      snap.putInt(IODC);
+      snap.putInt(health);
+      snap.putInt(accuracyFlag);
+      snap.putDouble(accuracy);
+      snap.putDouble(Tgd);
+      snap.putInt(codeflags);
+      snap.putInt(L2Pdata);
+      snap.putInt(fitDuration);
+      snap.putInt(fitint);
+   }
+
+   // Restore the data members from a binary snapshot.
+   void GPSEphemeris::readSnapshot(SnapshotReader& snap)
+   {
+      OrbitEph::readSnapshot(snap);
+      transmitTime = snap.getTime();
+      HOWtime = static_cast<long>(snap.getInt());
+      IODE = static_cast<short>(snap.getInt());
+      IODC = static_cast<short>(snap.getInt());
+      health = static_cast<short>(snap.getInt());
+      accuracyFlag = static_cast<short>(snap.getInt());
+      accuracy = snap.getDouble();
+      Tgd = snap.getDouble();
+      codeflags = static_cast<short>(snap.getInt());
+      L2Pdata = static_cast<short>(snap.getInt());
+      fitDuration = static_cast<short>(snap.getInt());
+      fitint = static_cast<short>(snap.getInt());
+   }
+
 } // end namespace
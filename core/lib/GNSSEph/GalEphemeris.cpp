@@ -174,4 +174,34 @@ namespace gpstk
       }
    }
 
+   // Append the data members to a binary snapshot.
+   void GalEphemeris::writeSnapshot(SnapshotWriter& snap) const
+   {
+      OrbitEph::writeSnapshot(snap);
+      snap.putTime(transmitTime);
+      snap.putInt(HOWtime);
+      snap.putInt(IODnav);
+      snap.putInt(health);
+      snap.putDouble(accuracy);
+      snap.putDouble(Tgda);
+      snap.putDouble(Tgdb);
+      snap.putInt(datasources);
+      snap.putInt(fitDuration);
+   }
+
+   // Restore the data members from a binary snapshot.
+   void GalEphemeris::readSnapshot(SnapshotReader& snap)
+   {
+      OrbitEph::readSnapshot(snap);
+      transmitTime = snap.getTime();
+      HOWtime = static_cast<long>(snap.getInt());
+      IODnav = static_cast<short>(snap.getInt());
+      health = static_cast<short>(snap.getInt());
+      accuracy = snap.getDouble();
+      Tgda = snap.getDouble();
+      Tgdb = snap.getDouble();
+      datasources = static_cast<short>(snap.getInt());
+      fitDuration = static_cast<short>(snap.getInt());
+   }
+
 } // end namespace
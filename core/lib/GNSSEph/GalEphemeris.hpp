@@ -101,6 +101,12 @@ namespace gpstk
          /// @throw Invalid Request if the required data has not been stored.
       virtual void dumpBody(std::ostream& os = std::cout) const;
 
+         /// Append the data members to a binary snapshot.
+      virtual void writeSnapshot(SnapshotWriter& snap) const;
+
+         /// Restore the data members from a binary snapshot.
+      virtual void readSnapshot(SnapshotReader& snap);
+
          // member data
       CommonTime transmitTime;   ///< Time of transmission
       long HOWtime;              ///< Time (seconds-of-week) of handover word (txmit)
@@ -96,51 +96,17 @@ namespace gpstk
 
       }
 
-         // Get the data out of the GloRecord structure
-      double px( x[0] );   // X coordinate (km)
-      double vx( v[0] );   // X velocity   (km/s)
-      double ax( a[0] );   // X acceleration (km/s^2)
-      double py( x[1] );   // Y coordinate
-      double vy( v[1] );   // Y velocity
-      double ay( a[1] );   // Y acceleration
-      double pz( x[2] );   // Z coordinate
-      double vz( v[2] );   // Z velocity
-      double az( a[2] );   // Z acceleration
+         // Get the reference state in the absolute coordinate system
+      double state[6], accel[3], s0, numSeconds;
+      initialState( state, s0, numSeconds );
 
          // We will need some PZ-90 ellipsoid parameters
       PZ90Ellipsoid pz90;
       double we( pz90.angVelocity() );
-
-         // Get sidereal time at Greenwich at 0 hours UT
-      double gst( getSidTime( ephTime ) );
-      double s0( gst*PI/12.0 );
-      YDSTime ytime( ephTime );
-      double numSeconds( ytime.sod );
       double s( s0 + we*numSeconds );
       double cs( std::cos(s) );
       double ss( std::sin(s) );
 
-         // Initial state matrix
-      Vector<double> initialState(6), accel(3), dxt1(6), dxt2(6), dxt3(6),
-                     dxt4(6), tempRes(6);
-
-         // Get the reference state out of GloEphemeris object data. Values
-         // must be rotated from PZ-90 to an absolute coordinate system
-         // Initial x coordinate (m)
-      initialState(0)  = (px*cs - py*ss);
-         // Initial y coordinate
-      initialState(2)  = (px*ss + py*cs);
-         // Initial z coordinate
-      initialState(4)  = pz;
-
-         // Initial x velocity   (m/s)
-      initialState(1)  = (vx*cs - vy*ss - we*initialState(2) );
-         // Initial y velocity
-      initialState(3)  = (vx*ss + vy*cs + we*initialState(0) );
-         // Initial z velocity
-      initialState(5)  = vz;
-
-
          // Integrate satellite state to desired epoch using the given step
       double rkStep( step );
 
@@ -171,62 +137,202 @@ namespace gpstk
          ss = std::sin(s);
 
             // Accelerations are computed once per iteration
-         accel(0) = ax*cs - ay*ss;
-         accel(1) = ax*ss + ay*cs;
-         accel(2) = az;
+         absAccel( cs, ss, accel );
+         rungeKuttaStep( state, accel, rkStep );
 
-         dxt1 = derivative( initialState, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt1(j)/2.0;
+            // If we are within tolerance of the target time, we are done.
+         workEpoch += rkStep;
+         if ( std::fabs(epoch - workEpoch ) < tolerance )
+            done = true;
 
-         dxt2 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt2(j)/2.0;
+      }  // End of 'while (!done)...'
+
+         // We are done, let's return
+      return absoluteToXvt( state, cs, ss, epoch );
+
+
+   }  // End of method 'GloEphemeris::svXvt(const CommonTime& t)'
+
+
+      // Evaluate the quintic Hermite polynomial through the nodes n0 and n1
+      // (see GloEphemeris::Trajectory), h seconds apart, at fraction u of the
+      // way from n0 to n1, giving position and velocity in state.
+   static void hermite( const double *n0, const double *n1, double h,
+                        double u, double state[6] )
+   {
+      const double u2(u*u), u3(u2*u), u4(u3*u), u5(u4*u);
+
+         // basis functions for p0, v0, a0, a1, v1, p1 ...
+      const double h5(10.0*u3 - 15.0*u4 + 6.0*u5);
+      const double h0(1.0 - h5);
+      const double h1(u - 6.0*u3 + 8.0*u4 - 3.0*u5);
+      const double h2(0.5*u2 - 1.5*u3 + 1.5*u4 - 0.5*u5);
+      const double h3(0.5*u3 - u4 + 0.5*u5);
+      const double h4(-4.0*u3 + 7.0*u4 - 3.0*u5);
+         // ... and their derivatives with respect to u
+      const double d5(30.0*u2 - 60.0*u3 + 30.0*u4);
+      const double d0(-d5);
+      const double d1(1.0 - 18.0*u2 + 32.0*u3 - 15.0*u4);
+      const double d2(u - 4.5*u2 + 6.0*u3 - 2.5*u4);
+      const double d3(1.5*u2 - 4.0*u3 + 2.5*u4);
+      const double d4(-12.0*u2 + 28.0*u3 - 15.0*u4);
+
+      const double hh(h*h);
+      for( int k = 0; k < 3; ++k )
+      {
+         const double p0(n0[2*k]), v0(n0[2*k+1]), a0(n0[6+k]);
+         const double p1(n1[2*k]), v1(n1[2*k+1]), a1(n1[6+k]);
+         state[2*k]   = h0*p0 + h*(h1*v0 + h4*v1) + hh*(h2*a0 + h3*a1)
+                        + h5*p1;
+         state[2*k+1] = (d0*p0 + h*(d1*v0 + d4*v1) + hh*(d2*a0 + d3*a1)
+                        + d5*p1)/h;
+      }
+   }
 
-         dxt3 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt3(j);
 
-         dxt4 = derivative( tempRes, accel );
+      /* Integrate the orbit once over the whole fit interval and return
+       * its dense output.
+       */
+   GloEphemeris::Trajectory GloEphemeris::integrateFitInterval(
+      double tolerance ) const
+   {
+      const int nv( Trajectory::nodeSize );
+      Trajectory traj;
+      if ( !valid || step <= 0.0 || tolerance <= 0.0 )
+         return traj;
+
+         // Half the fit interval, and the widest node spacing tried (s)
+      const double fitHalf( 900.0 ), maxNodeStep( 300.0 );
+
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+      double state0[6], accel[3], dxt[6], s0, sod;
+      initialState( state0, s0, sod );
+      traj.s0 = s0;
+      traj.sod = sod;
+
+         // m is the number of integration steps between nodes. It is kept
+         // even, so that the integrator also passes through the middle of
+         // each segment, where the interpolation error is largest; if the
+         // error there is too large, try again with the nodes closer.
+      for( int m = 2*int(maxNodeStep/(2.0*step)); m >= 2; m = 2*(m/4) )
+      {
+            // number of segments on each side of the ephemeris epoch
+         const int nseg( int(std::ceil(fitHalf/(m*step))) );
+         traj.nodeStep = m*step;
+         traj.start = -nseg*traj.nodeStep;
+         traj.nodes.assign( (2*nseg+1)*nv, 0.0 );
+            // integrated state at the middle of each segment
+         std::vector<double> mid( 2*nseg*6 );
+
+            // node at the ephemeris epoch
+         double s( s0 + we*sod );
+         absAccel( std::cos(s), std::sin(s), accel );
+         derivative( state0, accel, dxt );
+         double *node( &traj.nodes[nseg*nv] );
          for( int j = 0; j < 6; ++j )
-            initialState(j) = initialState(j) + rkStep * ( dxt1(j)
-                            + 2.0 * ( dxt2(j) + dxt3(j) ) + dxt4(j) ) / 6.0;
+            node[j] = state0[j];
+         for( int j = 0; j < 3; ++j )
+            node[6+j] = dxt[2*j+1];
 
+            // integrate forward, then backward, as svXvt() does
+         for( int dir = 1; dir >= -1; dir -= 2 )
+         {
+            double state[6];
+            for( int j = 0; j < 6; ++j )
+               state[j] = state0[j];
+            double rkStep( dir > 0 ? step : step*(-1.0) ), numSeconds( sod );
+
+            for( int k = 1; k <= nseg*m; ++k )
+            {
+               numSeconds += rkStep;
+               s = s0 + we*( numSeconds );
+               absAccel( std::cos(s), std::sin(s), accel );
+               rungeKuttaStep( state, accel, rkStep );
+
+               if ( k % m == 0 )
+               {
+                  derivative( state, accel, dxt );
+                  node = &traj.nodes[(nseg + dir*(k/m))*nv];
+                  for( int j = 0; j < 6; ++j )
+                     node[j] = state[j];
+                  for( int j = 0; j < 3; ++j )
+                     node[6+j] = dxt[2*j+1];
+               }
+               else if ( k % m == m/2 )
+               {
+                  int seg( dir > 0 ? nseg + k/m : nseg - 1 - k/m );
+                  for( int j = 0; j < 6; ++j )
+                     mid[seg*6+j] = state[j];
+               }
+            }
+         }
 
-            // If we are within tolerance of the target time, we are done.
-         workEpoch += rkStep;
-         if ( std::fabs(epoch - workEpoch ) < tolerance )
-            done = true;
+            // compare the interpolated positions with the integrated ones
+         double maxErr( 0.0 ), interp[6];
+         for( int seg = 0; seg < 2*nseg; ++seg )
+         {
+            hermite( &traj.nodes[seg*nv], &traj.nodes[(seg+1)*nv],
+                     traj.nodeStep, 0.5, interp );
+            double dx( interp[0] - mid[seg*6] );
+            double dy( interp[2] - mid[seg*6+2] );
+            double dz( interp[4] - mid[seg*6+4] );
+            double err( 1000.0*std::sqrt(dx*dx + dy*dy + dz*dz) );
+            if ( err > maxErr )
+               maxErr = err;
+         }
 
-      }  // End of 'while (!done)...'
+         if ( maxErr <= tolerance )
+            return traj;
 
+      }  // End of loop over node spacing
 
-      px = initialState(0);
-      py = initialState(2);
-      pz = initialState(4);
-      vx = initialState(1);
-      vy = initialState(3);
-      vz = initialState(5);
+      return Trajectory();
 
-      sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
-      sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
-      sv.x[2] = 1000.0*pz;                        // Z coordinate
-      sv.v[0] = 1000.0*( vx*cs + vy*ss + we*(sv.x[1]/1000.0) ); // X velocity
-      sv.v[1] = 1000.0*(-vx*ss + vy*cs - we*(sv.x[0]/1000.0) ); // Y velocity
-      sv.v[2] = 1000.0*vz;                        // Z velocity
+   }  // End of method 'GloEphemeris::integrateFitInterval()'
 
-         // In the GLONASS system, 'clkbias' already includes the relativistic
-         // correction, therefore we must substract the late from the former.
-      sv.relcorr = sv.computeRelativityCorrection();
-      sv.clkbias = clkbias + clkdrift * (epoch - ephTime) - sv.relcorr;
-      sv.clkdrift = clkdrift;
-      sv.frame = ReferenceFrame::PZ90;
 
-         // We are done, let's return
-      return sv;
+      /* Compute satellite position & velocity at the given time by
+       * interpolating a trajectory from integrateFitInterval().
+       */
+   Xvt GloEphemeris::svXvt( const CommonTime& epoch,
+                            const Trajectory& traj ) const
+      throw( gpstk::InvalidRequest )
+   {
 
+         // Same limits as svXvt(epoch)
+      if ( epoch <  (ephTime - 900.0) ||
+           epoch >= (ephTime + 900.0)   )
+      {
+         InvalidRequest e( "Requested time is out of ephemeris data" );
+         GPSTK_THROW(e);
+      }
 
-   }  // End of method 'GloEphemeris::svXvt(const CommonTime& t)'
+      if ( epoch == ephTime || traj.empty() )
+         return svXvtOverrideFit(epoch);
+
+      const int nv( Trajectory::nodeSize );
+      const int nseg( traj.nodes.size()/nv - 1 );
+      const double dt( epoch - ephTime ), h( traj.nodeStep );
+
+         // find the segment containing dt
+      int i( int(std::floor((dt - traj.start)/h)) );
+      if ( i < 0 )
+         i = 0;
+      else if ( i >= nseg )
+         i = nseg - 1;
+
+      double state[6];
+      hermite( &traj.nodes[i*nv], &traj.nodes[(i+1)*nv], h,
+               (dt - traj.start - i*h)/h, state );
+
+      PZ90Ellipsoid pz90;
+      double s( traj.s0 + pz90.angVelocity()*( traj.sod + dt ) );
+
+      return absoluteToXvt( state, std::cos(s), std::sin(s), epoch );
+
+   }  // End of method 'GloEphemeris::svXvt(epoch, traj)'
 
 
       // Get the epoch time for this ephemeris
@@ -437,10 +543,122 @@ namespace gpstk
    }; // End of method 'GloEphemeris::getSidTime()'
 
 
+      // Rotate the reference state of this ephemeris into the absolute frame.
+   void GloEphemeris::initialState( double state[6], double& s0,
+                                    double& sod ) const
+   {
+
+         // Get the data out of the GloRecord structure
+      double px( x[0] );   // X coordinate (km)
+      double vx( v[0] );   // X velocity   (km/s)
+      double py( x[1] );   // Y coordinate
+      double vy( v[1] );   // Y velocity
+      double pz( x[2] );   // Z coordinate
+      double vz( v[2] );   // Z velocity
+
+         // We will need some PZ-90 ellipsoid parameters
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+         // Get sidereal time at Greenwich at 0 hours UT
+      double gst( getSidTime( ephTime ) );
+      s0 = gst*PI/12.0;
+      YDSTime ytime( ephTime );
+      sod = ytime.sod;
+      double s( s0 + we*sod );
+      double cs( std::cos(s) );
+      double ss( std::sin(s) );
+
+         // Values must be rotated from PZ-90 to an absolute coordinate system
+         // Initial x coordinate (m)
+      state[0]  = (px*cs - py*ss);
+         // Initial y coordinate
+      state[2]  = (px*ss + py*cs);
+         // Initial z coordinate
+      state[4]  = pz;
+
+         // Initial x velocity   (m/s)
+      state[1]  = (vx*cs - vy*ss - we*state[2] );
+         // Initial y velocity
+      state[3]  = (vx*ss + vy*cs + we*state[0] );
+         // Initial z velocity
+      state[5]  = vz;
+
+   }  // End of method 'GloEphemeris::initialState()'
+
+
+      // Luni-solar acceleration in the absolute frame.
+   void GloEphemeris::absAccel( double cs, double ss, double accel[3] ) const
+   {
+      accel[0] = a[0]*cs - a[1]*ss;
+      accel[1] = a[0]*ss + a[1]*cs;
+      accel[2] = a[2];
+   }
+
+
+      // Advance state by one fixed Runge-Kutta step of h seconds.
+   void GloEphemeris::rungeKuttaStep( double state[6], const double accel[3],
+                                      double h ) const
+   {
+      double dxt1[6], dxt2[6], dxt3[6], dxt4[6], tempRes[6];
+
+      derivative( state, accel, dxt1 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt1[j]/2.0;
+
+      derivative( tempRes, accel, dxt2 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt2[j]/2.0;
+
+      derivative( tempRes, accel, dxt3 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt3[j];
+
+      derivative( tempRes, accel, dxt4 );
+      for( int j = 0; j < 6; ++j )
+         state[j] = state[j] + h * ( dxt1[j]
+                  + 2.0 * ( dxt2[j] + dxt3[j] ) + dxt4[j] ) / 6.0;
+   }
+
+
+      // Convert a state in the absolute frame to the returned (PZ-90) Xvt.
+   Xvt GloEphemeris::absoluteToXvt( const double state[6], double cs,
+                                    double ss, const CommonTime& epoch ) const
+   {
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+      double px( state[0] );
+      double py( state[2] );
+      double pz( state[4] );
+      double vx( state[1] );
+      double vy( state[3] );
+      double vz( state[5] );
+
+      Xvt sv;
+      sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
+      sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
+      sv.x[2] = 1000.0*pz;                        // Z coordinate
+      sv.v[0] = 1000.0*( vx*cs + vy*ss + we*(sv.x[1]/1000.0) ); // X velocity
+      sv.v[1] = 1000.0*(-vx*ss + vy*cs - we*(sv.x[0]/1000.0) ); // Y velocity
+      sv.v[2] = 1000.0*vz;                        // Z velocity
+
+         // In the GLONASS system, 'clkbias' already includes the relativistic
+         // correction, therefore we must substract the late from the former.
+      sv.relcorr = sv.computeRelativityCorrection();
+      sv.clkbias = clkbias + clkdrift * (epoch - ephTime) - sv.relcorr;
+      sv.clkdrift = clkdrift;
+      sv.frame = ReferenceFrame::PZ90;
+
+      return sv;
+
+   }  // End of method 'GloEphemeris::absoluteToXvt()'
+
+
       // Function implementing the derivative of GLONASS orbital model.
-   Vector<double> GloEphemeris::derivative( const Vector<double>& inState,
-                                            const Vector<double>& accel )
-      const
+   void GloEphemeris::derivative( const double inState[6],
+                                  const double accel[3],
+                                  double dxt[6] ) const
    {
 
          // We will need some important PZ90 ellipsoid values
@@ -450,12 +668,9 @@ namespace gpstk
       const double ae( pz90.a_km() );
 
          // Let's start getting the current satellite position and velocity
-      double  x( inState(0) );          // X coordinate
-      //double vx( inState(1) );          // X velocity
-      double  y( inState(2) );          // Y coordinate
-      //double vy( inState(3) );          // Y velocity
-      double  z( inState(4) );          // Z coordinate
-      //double vz( inState(5) );          // Z velocity
+      double  x( inState[0] );          // X coordinate
+      double  y( inState[2] );          // Y coordinate
+      double  z( inState[4] );          // Z coordinate
 
       double r2( x*x + y*y + z*z );
       double r( std::sqrt(r2) );
@@ -470,25 +685,21 @@ namespace gpstk
       double cmz( k1*(3.0-5.0*zr2) );
       double k2(cm-xmu);
 
-      double gloAx( k2*xr + accel(0) );
-      double gloAy( k2*yr + accel(1) );
-      double gloAz( (cmz-xmu)*zr + accel(2) );
-
-      Vector<double> dxt(6, 0.0);
+      double gloAx( k2*xr + accel[0] );
+      double gloAy( k2*yr + accel[1] );
+      double gloAz( (cmz-xmu)*zr + accel[2] );
 
          // Let's insert data related to X coordinates
-      dxt(0) = inState(1);       // Set X'  = Vx
-      dxt(1) = gloAx;            // Set Vx' = gloAx
+      dxt[0] = inState[1];       // Set X'  = Vx
+      dxt[1] = gloAx;            // Set Vx' = gloAx
 
          // Let's insert data related to Y coordinates
-      dxt(2) = inState(3);       // Set Y'  = Vy
-      dxt(3) = gloAy;            // Set Vy' = gloAy
+      dxt[2] = inState[3];       // Set Y'  = Vy
+      dxt[3] = gloAy;            // Set Vy' = gloAy
 
          // Let's insert data related to Z coordinates
-      dxt(4) = inState(5);       // Set Z'  = Vz
-      dxt(5) = gloAz;            // Set Vz' = gloAz
-
-      return dxt;
+      dxt[4] = inState[5];       // Set Z'  = Vz
+      dxt[5] = gloAz;            // Set Vz' = gloAz
 
    }  // End of method 'GloEphemeris::derivative()'
 
@@ -41,6 +41,7 @@
 #define GPSTK_GLOEPHEMERIS_HPP
 
 #include <iostream>
+#include <vector>
 #include "Triple.hpp"
 #include "Xvt.hpp"
 #include "CommonTime.hpp"
@@ -63,6 +64,42 @@ namespace gpstk
    {
    public:
 
+         /** Dense output of the orbit integration over the fit interval.
+          * The state (x,vx,y,vy,z,vz in km and km/s) and acceleration
+          * (ax,ay,az in km/s^2) of the satellite in the absolute frame
+          * used by the integrator are kept at evenly spaced nodes, and
+          * interpolated between them with quintic Hermite polynomials.
+          * @see integrateFitInterval(), svXvt(const CommonTime&,
+          *   const Trajectory&) */
+      class Trajectory
+      {
+      public:
+            /// Number of values kept at each node
+         static const int nodeSize = 9;
+
+            /// Construct an empty trajectory
+         Trajectory()
+               : nodeStep(0.0), start(0.0), s0(0.0), sod(0.0)
+         {}
+
+            /// Return true if there are no nodes
+         bool empty() const
+         { return nodes.empty(); }
+
+            /// Seconds between nodes (a multiple of the integration step)
+         double nodeStep;
+
+            /// Time of the first node, relative to the ephemeris epoch (s)
+         double start;
+
+            /// Sidereal angle at Greenwich at 0h UT (rad), and seconds of
+            /// day, of the ephemeris epoch
+         double s0, sod;
+
+            /// nodeSize values for each node, node after node
+         std::vector<double> nodes;
+      };
+
          /// Default constructor
       GloEphemeris()
             : valid(false), step(1.0)
@@ -100,6 +137,34 @@ namespace gpstk
           */
       Xvt svXvtOverrideFit(const CommonTime& epoch) const;
 
+         /** Integrate the orbit once over the whole fit interval
+          *  (ephemeris epoch +/- 900 seconds) and return its dense output,
+          *  for use with svXvt(const CommonTime&, const Trajectory&).
+          *  The nodes are spaced as widely as possible (up to 300 s) while
+          *  the interpolated position stays within \a tolerance of the
+          *  position computed by svXvt(const CommonTime&).
+          *
+          * @param tolerance  Maximum position error (meters).
+          *
+          * @return the trajectory, or an empty one if the tolerance cannot
+          *  be met.
+          */
+      Trajectory integrateFitInterval(double tolerance) const;
+
+         /** Compute satellite position & velocity at the given time by
+          *  interpolating a trajectory from integrateFitInterval(), rather
+          *  than integrating the orbit.  The clock terms are computed
+          *  exactly as by svXvt(const CommonTime&).
+          *
+          * @param epoch   Epoch to compute position and velocity.
+          * @param traj    Trajectory of this ephemeris; if it is empty,
+          *   the orbit is integrated as by svXvt(const CommonTime&).
+          *
+          * @throw InvalidRequest if epoch is outside the fit interval.
+          */
+      Xvt svXvt(const CommonTime& epoch, const Trajectory& traj) const
+         throw( gpstk::InvalidRequest );
+
          /// Get the epoch time for this ephemeris
       CommonTime getEphemerisEpoch() const
          throw( gpstk::InvalidRequest );
@@ -249,9 +314,29 @@ namespace gpstk
       double getSidTime( const CommonTime& time ) const;
 
 
+         /** Rotate the reference state of this ephemeris into the absolute
+          * frame used by the integrator.
+          * @param[out] state  x,vx,y,vy,z,vz (km, km/s) at ephTime
+          * @param[out] s0     sidereal angle at Greenwich at 0h UT (rad)
+          * @param[out] sod    seconds of day of ephTime */
+      void initialState( double state[6], double& s0, double& sod ) const;
+
+         /// Luni-solar acceleration in the absolute frame, given the cosine
+         /// and sine of the sidereal angle.
+      void absAccel( double cs, double ss, double accel[3] ) const;
+
+         /// Advance state by one fixed Runge-Kutta step of h seconds.
+      void rungeKuttaStep( double state[6], const double accel[3],
+                           double h ) const;
+
+         /// Convert a state in the absolute frame at epoch, given the cosine
+         /// and sine of the sidereal angle, to the returned (PZ-90) Xvt.
+      Xvt absoluteToXvt( const double state[6], double cs, double ss,
+                         const CommonTime& epoch ) const;
+
          /// Function implementing the derivative of GLONASS orbital model.
-      Vector<double> derivative( const Vector<double>& inState,
-                                 const Vector<double>& accel ) const;
+      void derivative( const double inState[6], const double accel[3],
+                       double dxt[6] ) const;
 
 
 
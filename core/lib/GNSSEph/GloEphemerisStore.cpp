@@ -62,6 +62,7 @@ namespace gpstk
 
          SatID sat( data.sat );
          pe[sat][t] = gloEphem; // find or add entry
+         cache.clear();
 
          if (t < initialTime)
             initialTime = t;
@@ -93,11 +94,75 @@ namespace gpstk
    Xvt GloEphemerisStore::getXvt( const SatID& sat,
                                   const CommonTime& epoch ) const
    {
-      // TD is this too strict?
+      LocateStatus status;
+      const GloEphemeris *data( locateRecord(sat, epoch, status) );
+
+      if ( data == NULL )
+      {
+         switch ( status )
+         {
+            // TD is this too strict?
+            case locateWrongTimeSystem:
+            {
+               InvalidRequest e(string("Requested time system is not GLONASS time"));
+               GPSTK_THROW(e);
+            }
+            case locateNoSatellite:
+            {
+               InvalidRequest e( "Ephemeris for satellite  "
+                                 + StringUtils::asString(sat) + " not found." );
+               GPSTK_THROW(e);
+            }
+            default:
+            {
+               InvalidRequest e( "Requested time is out of boundaries for satellite "
+                                + StringUtils::asString(sat) );
+               GPSTK_THROW(e);
+            }
+         }
+      }
+
+      return evaluate( *data, epoch );
+
+   }; // End of method 'GloEphemerisStore::getXvt()'
+
+
+      /* Non-throwing form of getXvt().
+       *
+       *  @param[in] sat   Satellite's identifier
+       *  @param[in] epoch Time to look up
+       *  @param[out] xvt  The Xvt of the object, when true is returned
+       *
+       *  @return true if the Xvt was computed, false where getXvt() would
+       *  have thrown.
+       */
+   bool GloEphemerisStore::computeXvt( const SatID& sat,
+                                       const CommonTime& epoch,
+                                       Xvt& xvt ) const
+   {
+      LocateStatus status;
+      const GloEphemeris *data( locateRecord(sat, epoch, status) );
+      if ( data == NULL )
+         return false;
+
+      xvt = evaluate( *data, epoch );
+      return true;
+
+   }; // End of method 'GloEphemerisStore::computeXvt()'
+
+
+      /* Find the record used by getXvt() and computeXvt(), without
+       * throwing; 'status' says why no record was found.
+       */
+   const GloEphemeris*
+   GloEphemerisStore::locateRecord( const SatID& sat,
+                                    const CommonTime& epoch,
+                                    LocateStatus& status ) const
+   {
       if(epoch.getTimeSystem() != initialTime.getTimeSystem())
       {
-         InvalidRequest e(string("Requested time system is not GLONASS time"));
-         GPSTK_THROW(e);
+         status = locateWrongTimeSystem;
+         return NULL;
       }
       
          // Check that the given epoch is within the available time limits.
@@ -105,20 +170,17 @@ namespace gpstk
       if ( epoch <  (initialTime - 900.0) ||
            epoch >  (finalTime   + 900.0)   )
       {
-         InvalidRequest e( "Requested time is out of boundaries for satellite "
-                          + StringUtils::asString(sat) );
-         GPSTK_THROW(e);
+         status = locateOutOfBounds;
+         return NULL;
       }
 
          // Look for the satellite in the 'pe' (EphMap) data structure.
       GloEphMap::const_iterator svmap = pe.find(sat);
 
-         // If satellite was not found, issue an exception
       if (svmap == pe.end())
       {
-         InvalidRequest e( "Ephemeris for satellite  "
-                           + StringUtils::asString(sat) + " not found." );
-         GPSTK_THROW(e);
+         status = locateNoSatellite;
+         return NULL;
       }
 
          // Let's take the second part of the EphMap
@@ -127,9 +189,6 @@ namespace gpstk
          // Look for 'i': the first element whose key >= epoch.
       TimeGloMap::const_iterator i = sem.lower_bound(epoch);;
 
-         // Values to be returned will be stored here
-      Xvt sv;
-
          // If we reached the end, the requested time is beyond the last
          // ephemeris record, but it may still be within the allowable time
          // span, so we can use the last record.
@@ -149,21 +208,41 @@ namespace gpstk
       if ( epoch <  (i->first - 900.0) ||
            epoch >= (i->first   + 900.0)   )
       {
-         InvalidRequest e( "Requested time is out of boundaries for satellite "
-                          + StringUtils::asString(sat) );
-         GPSTK_THROW(e);
+         status = locateOutOfBounds;
+         return NULL;
       }
 
-         // We now have the proper reference data record. Let's use it
-      GloEphemeris data( i->second );
+      status = locateOK;
+      return &i->second;
 
-         // Compute the satellite position, velocity and clock offset
-      sv = data.svXvt( epoch );
+   }; // End of method 'GloEphemerisStore::locateRecord()'
 
-         // We are done, let's return
-      return sv;
 
-   }; // End of method 'GloEphemerisStore::getXvt()'
+      // Evaluate a record from 'pe' at epoch, via the trajectory cache
+   Xvt GloEphemerisStore::evaluate( const GloEphemeris& data,
+                                    const CommonTime& epoch ) const
+   {
+      if ( trajTolerance <= 0.0 )
+         return data.svXvt( epoch );
+
+         // Integrate the record over its fit interval the first time it is
+         // used, then interpolate. The trajectory is not modified once in
+         // the map, so it may be read after the lock is released.
+      const GloEphemeris::Trajectory *traj;
+      {
+         std::lock_guard<std::mutex> lock(cache.mtx);
+         std::map<const GloEphemeris*, GloEphemeris::Trajectory>::iterator
+            it( cache.trajs.find(&data) );
+         if ( it == cache.trajs.end() )
+            it = cache.trajs.insert( std::make_pair( &data,
+                     data.integrateFitInterval(trajTolerance) ) ).first;
+         traj = &it->second;
+      }
+
+         // Compute the satellite position, velocity and clock offset
+      return data.svXvt( epoch, *traj );
+
+   }; // End of method 'GloEphemerisStore::evaluate()'
 
 
       /* A debugging function that outputs in human readable form,
@@ -304,6 +383,7 @@ namespace gpstk
 
          // Update the data map before returning
       pe = bak;
+      cache.clear();
 
       return;
       
@@ -42,6 +42,7 @@
 
 #include <iostream>
 #include <set>
+#include <mutex>
 
 #include "XvtStore.hpp"
 #include "GloEphemeris.hpp"
@@ -73,7 +74,7 @@ namespace gpstk
       GloEphemerisStore()
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              step(1.0)
+              step(1.0), trajTolerance(1.0e-4)
       {
             setCheckHealthFlag(false);
       }
@@ -87,7 +88,7 @@ namespace gpstk
                          bool checkHealth )
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              step(rkStep)
+              step(rkStep), trajTolerance(1.0e-4)
       {
             setCheckHealthFlag(false);
       }
@@ -115,6 +116,20 @@ namespace gpstk
       Xvt getXvt( const SatID& sat,
                   const CommonTime& epoch ) const;
 
+         /** Non-throwing form of getXvt(); the record is located exactly
+          *  as getXvt() does, but a miss is reported as false.
+          * 
+          *  @param[in] sat   Satellite's identifier
+          *  @param[in] epoch Time to look up
+          *  @param[out] xvt  The Xvt of the object, when true is returned
+          * 
+          *  @return true if the Xvt was computed, false where getXvt()
+          *  would have thrown.
+          */
+      bool computeXvt( const SatID& sat,
+                       const CommonTime& epoch,
+                       Xvt& xvt ) const;
+
          /// Get integration step for Runge-Kutta algorithm.
       double getIntegrationStep() const
       { return step; };
@@ -137,6 +152,25 @@ namespace gpstk
       GloEphemerisStore& setCheckHealthFlag( bool checkHealth )
       { onlyHealthy = checkHealth; return (*this); };
 
+         /// Get the accuracy, in meters, required of the cached trajectories.
+      double getTrajectoryTolerance() const
+      { return trajTolerance; };
+
+         /** Set the accuracy required of the cached trajectories.
+          *
+          * The first getXvt() within the fit interval of a record integrates
+          * the orbit once over the whole interval and keeps the result;
+          * later calls interpolate it instead of integrating again. The
+          * interpolated positions agree with GloEphemeris::svXvt() to within
+          * the given tolerance; a record that can not meet it is integrated
+          * on every call, as is every record if the tolerance is not
+          * positive.
+          *
+          * @param meters  Tolerance in meters (default 1.0e-4).
+          */
+      GloEphemerisStore& setTrajectoryTolerance( double meters )
+      { trajTolerance = meters; cache.clear(); return (*this); };
+
          /** A debugging function that outputs in human readable form,
           *  all data stored in this object.
           * 
@@ -162,6 +196,7 @@ namespace gpstk
       virtual void clear(void)
       {
          pe.clear();
+         cache.clear();
          initialTime = CommonTime::END_OF_TIME;
          finalTime = CommonTime::BEGINNING_OF_TIME;
          return;
@@ -258,6 +293,32 @@ namespace gpstk
 
    private:
 
+         /// Reasons locateRecord() can fail, used to word the exception
+      enum LocateStatus
+      {
+         locateOK,
+         locateWrongTimeSystem,
+         locateOutOfBounds,
+         locateNoSatellite
+      };
+
+         /** Find the record used by getXvt() and computeXvt() for the given
+          *  satellite and epoch, without throwing.
+          *
+          *  @param[in] sat   Satellite's identifier
+          *  @param[in] epoch Time to look up
+          *  @param[out] status why the search failed, locateOK on success
+          *
+          *  @return the record, or NULL if there is none.
+          */
+      const GloEphemeris* locateRecord( const SatID& sat,
+                                        const CommonTime& epoch,
+                                        LocateStatus& status ) const;
+
+         /// Evaluate a record from 'pe' at epoch, via the trajectory cache
+      Xvt evaluate( const GloEphemeris& data,
+                    const CommonTime& epoch ) const;
+
          /// The map of SVs and Xvt's
       GloEphMap pe;
 
@@ -270,6 +331,31 @@ namespace gpstk
          /// Integration step for Runge-Kutta algorithm (1 second by default)
       double step;
 
+         /// Required accuracy of the cached trajectories (meters)
+      double trajTolerance;
+
+         /** Trajectories already integrated by getXvt(), keyed by the
+          *  record in 'pe' they were computed from. getXvt() is const and
+          *  may be called from several threads, hence the lock. Copies of
+          *  a store start with an empty cache.
+          */
+      class TrajectoryCache
+      {
+      public:
+         TrajectoryCache() {}
+         TrajectoryCache(const TrajectoryCache&) {}
+         TrajectoryCache& operator=(const TrajectoryCache&)
+         { clear(); return *this; }
+
+         void clear()
+         { std::lock_guard<std::mutex> lock(mtx); trajs.clear(); }
+
+         std::mutex mtx;
+         std::map<const GloEphemeris*, GloEphemeris::Trajectory> trajs;
+      };
+
+      mutable TrajectoryCache cache;
+
    };  // End of class 'GloEphemerisStore'
 
       //@}
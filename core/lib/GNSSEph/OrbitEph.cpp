@@ -240,6 +240,177 @@ namespace gpstk {
       return sv;
    }
 
+   // Compute satellite position, velocity and clock terms at many times.
+   // The arithmetic here must stay in step with svXvt() and svRelativity()
+   // so that the results are bit-for-bit identical.
+   // throw Invalid Request if the required data has not been stored.
+   void OrbitEph::svXvtBatch(const std::vector<CommonTime>& times,
+                             XvtArray& xvt) const
+   {
+      if(!dataLoadedFlag)
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
+
+      const size_t n = times.size();
+      xvt.resize(n);
+      if(n == 0)
+         return;
+
+         // Quantities independent of time, computed once per call
+      GPSEllipsoid ell;
+      const double sqrtgm = SQRT(ell.gm());
+      const double twoPI = 2.0e0 * PI;
+      const double lecc = ecc;
+      const double tdrinc = idot;
+      const double Ahalf = SQRT(A);
+      const double ToeSOW = GPSWeekSecond(ctToe).sow;
+      const double amm0 = sqrtgm / (A*Ahalf);
+      const double ammRel = amm0 + dn;
+      const double q = SQRT(1.0e0 - lecc*lecc);
+      const double domk = OMEGAdot - ell.angVelocity();
+      const double ANLON0 = ell.angVelocity() * ToeSOW;
+         // with dndot==0 svRelativity() solves the same Kepler equation
+      const bool sameKepler = (dndot == 0.0);
+
+         // Epochs are processed in blocks of this many lanes, with
+         // every intermediate held in a stack array so each stage is
+         // a simple loop over the block.
+      static const size_t BLOCK = 64;
+      double elapte[BLOCK], elaptc[BLOCK], Ak[BLOCK], amm[BLOCK];
+      double meana[BLOCK], ea[BLOCK], mrel[BLOCK], erel[BLOCK];
+      bool active[BLOCK];
+
+      for(size_t base = 0; base < n; base += BLOCK)
+      {
+         const size_t m = (n - base < BLOCK ? n - base : BLOCK);
+         size_t i;
+
+            // Elapsed times; CommonTime subtraction is not vectorizable
+         for(i = 0; i < m; i++)
+         {
+            elapte[i] = times[base+i] - ctToe;
+            elaptc[i] = times[base+i] - ctToc;
+         }
+
+            // Mean anomaly and initial eccentric anomaly
+         for(i = 0; i < m; i++)
+         {
+            Ak[i] = A + Adot * elapte[i];
+            double dnA = dn + 0.5*dndot*elapte[i];
+            amm[i] = amm0 + dnA;
+            meana[i] = fmod(M0 + elapte[i] * amm[i], twoPI);
+            ea[i] = meana[i] + lecc * ::sin(meana[i]);
+            active[i] = true;
+         }
+
+            // Kepler's equation, iterated in lockstep; a lane stops
+            // updating under exactly the same test as svXvt().
+         solveKeplerBlock(meana, ea, active, m, lecc);
+
+            // Relativity correction
+         if(sameKepler)
+         {
+            for(i = 0; i < m; i++)
+               xvt.relcorr[base+i] = REL_CONST * lecc * SQRT(Ak[i]) * ::sin(ea[i]);
+         }
+         else
+         {
+            for(i = 0; i < m; i++)
+            {
+               mrel[i] = fmod(M0 + elapte[i] * ammRel, twoPI);
+               erel[i] = mrel[i] + lecc * ::sin(mrel[i]);
+               active[i] = true;
+            }
+            solveKeplerBlock(mrel, erel, active, m, lecc);
+            for(i = 0; i < m; i++)
+               xvt.relcorr[base+i] = REL_CONST * lecc * SQRT(Ak[i]) * ::sin(erel[i]);
+         }
+
+            // Clock bias and drift
+         for(i = 0; i < m; i++)
+         {
+            xvt.clkbias[base+i] = af0 + elaptc[i] * (af1 + elaptc[i] * af2);
+            xvt.clkdrift[base+i] = af1 + elaptc[i] * af2;
+            xvt.frame[base+i] = ReferenceFrame::WGS84;
+         }
+
+            // Position and velocity
+         for(i = 0; i < m; i++)
+         {
+            double sinea = ::sin(ea[i]);
+            double cosea = ::cos(ea[i]);
+            double G     = 1.0e0 - lecc * cosea;
+            double GSTA  = q * sinea;
+            double GCTA  = cosea - lecc;
+            double truea = atan2(GSTA, GCTA);
+
+            double alat  = truea + w;
+            double talat = 2.0e0 * alat;
+            double c2al  = ::cos(talat);
+            double s2al  = ::sin(talat);
+
+            double du  = c2al * Cuc +  s2al * Cus;
+            double dr  = c2al * Crc +  s2al * Crs;
+            double di  = c2al * Cic +  s2al * Cis;
+
+            double U    = alat + du;
+            double R    = Ak[i]*G  + dr;
+            double AINC = i0 + tdrinc * elapte[i]  +  di;
+            double ANLON = OMEGA0 + domk * elapte[i] - ANLON0;
+
+            double cosu = ::cos(U);
+            double sinu = ::sin(U);
+            double xip  = R * cosu;
+            double yip  = R * sinu;
+
+            double can  = ::cos(ANLON);
+            double san  = ::sin(ANLON);
+            double cinc = ::cos(AINC);
+            double sinc = ::sin(AINC);
+
+            xvt.x[base+i] =  xip*can  -  yip*cinc*san;
+            xvt.y[base+i] =  xip*san  +  yip*cinc*can;
+            xvt.z[base+i] =              yip*sinc;
+
+            double dek = amm[i] * Ak[i] / R;
+            double dlk = Ahalf * q * sqrtgm / (R*R);
+            double div = tdrinc - 2.0e0 * dlk * (Cic  * s2al - Cis * c2al);
+            double duv = dlk*(1.e0+ 2.e0 * (Cus*c2al - Cuc*s2al));
+            double drv = Ak[i] * lecc * dek * sinea
+                         - 2.e0 * dlk * (Crc * s2al - Crs * c2al);
+            double dxp = drv*cosu - R*sinu*duv;
+            double dyp = drv*sinu + R*cosu*duv;
+
+            xvt.vx[base+i] = dxp*can - xip*san*domk - dyp*cinc*san
+                             + yip*(sinc*san*div - cinc*can*domk);
+            xvt.vy[base+i] = dxp*san + xip*can*domk + dyp*cinc*can
+                             - yip*(sinc*can*div + cinc*san*domk);
+            xvt.vz[base+i] = dyp*sinc + yip*cinc*div;
+         }
+      }
+   }
+
+   // Iterate Kepler's equation for the m lanes of a block, at most 20
+   // times, matching the convergence test used by svXvt().
+   void OrbitEph::solveKeplerBlock(const double *meana, double *ea,
+                                   bool *active, size_t m, double lecc)
+   {
+      for(int loop_cnt = 1; loop_cnt <= 20; loop_cnt++)
+      {
+         bool any = false;
+         for(size_t i = 0; i < m; i++)
+         {
+            if(!active[i]) continue;
+            double F = meana[i] - (ea[i] - lecc * ::sin(ea[i]));
+            double G = 1.0 - lecc * ::cos(ea[i]);
+            double delea = F/G;
+            ea[i] = ea[i] + delea;
+            active[i] = (fabs(delea) > 1.0e-11);
+            any = any || active[i];
+         }
+         if(!any) break;
+      }
+   }
+
    // Compute satellite relativity correction (sec) at the given time
    // throw Invalid Request if the required data has not been stored.
    double OrbitEph::svRelativity(const CommonTime& t) const
@@ -275,6 +446,44 @@ namespace gpstk {
       return (REL_CONST * ecc * SQRT(Ak) * ::sin(ea));
    }
 
+   // Append the data members to a binary snapshot.
+   void OrbitEph::writeSnapshot(SnapshotWriter& snap) const
+   {
+      snap.putBool(dataLoadedFlag);
+      snap.putSatID(satID);
+      snap.putInt(static_cast<int>(obsID.type));
+      snap.putInt(static_cast<int>(obsID.band));
+      snap.putInt(static_cast<int>(obsID.code));
+      snap.putTime(ctToe);
+      snap.putTime(ctToc);
+      const double *v[] = { &af0, &af1, &af2, &M0, &dn, &ecc, &A, &OMEGA0, &i0,
+                            &w, &OMEGAdot, &idot, &dndot, &Adot,
+                            &Cuc, &Cus, &Crc, &Crs, &Cic, &Cis };
+      for(size_t i=0; i<sizeof(v)/sizeof(v[0]); i++)
+         snap.putDouble(*v[i]);
+      snap.putTime(beginValid);
+      snap.putTime(endValid);
+   }
+
+   // Restore the data members from a binary snapshot.
+   void OrbitEph::readSnapshot(SnapshotReader& snap)
+   {
+      dataLoadedFlag = snap.getBool();
+      satID = snap.getSatID();
+      obsID.type = static_cast<ObsID::ObservationType>(snap.getInt());
+      obsID.band = static_cast<ObsID::CarrierBand>(snap.getInt());
+      obsID.code = static_cast<ObsID::TrackingCode>(snap.getInt());
+      ctToe = snap.getTime();
+      ctToc = snap.getTime();
+      double *v[] = { &af0, &af1, &af2, &M0, &dn, &ecc, &A, &OMEGA0, &i0,
+                      &w, &OMEGAdot, &idot, &dndot, &Adot,
+                      &Cuc, &Cus, &Crc, &Crs, &Cic, &Cis };
+      for(size_t i=0; i<sizeof(v)/sizeof(v[0]); i++)
+         *v[i] = snap.getDouble();
+      beginValid = snap.getTime();
+      endValid = snap.getTime();
+   }
+
    // Dump the overhead information as a string containing a single line.
    // @throw Invalid Request if the required data has not been stored.
    string OrbitEph::asString(void) const
@@ -49,11 +49,14 @@
 #define GPSTK_ORBITEPH_HPP
 
 #include <string>
+#include <vector>
 #include "Exception.hpp"
 #include "CommonTime.hpp"
 #include "ObsID.hpp"
 #include "SatID.hpp"
 #include "Xvt.hpp"
+#include "XvtArray.hpp"
+#include "SnapshotFile.hpp"
 //#include "Rinex3NavData.hpp"
 
 namespace gpstk
@@ -128,6 +131,20 @@ namespace gpstk
           * @throw Invalid Request if the required data has not been stored. */
       Xvt svXvt(const CommonTime& t) const;
 
+         /** Compute satellite position, velocity and clock terms at
+          * many times with a single call.  The results are identical
+          * to calling svXvt() at each time, but quantities that depend
+          * only on the orbit elements are computed once, and the
+          * epochs are processed in fixed-size blocks in
+          * structure-of-arrays form (the Kepler iteration is run in
+          * lockstep across the block) so that the compiler can
+          * vectorize the arithmetic.
+          * @param[in] times the times of interest.
+          * @param[out] xvt resized to times.size() and filled with
+          *   the results, element i corresponding to times[i].
+          * @throw Invalid Request if the required data has not been stored. */
+      void svXvtBatch(const std::vector<CommonTime>& times, XvtArray& xvt) const;
+
          /** Compute satellite relativity correction (sec) at the given time
           * @throw Invalid Request if the required data has not been stored. */
       double svRelativity(const CommonTime& t) const;
@@ -183,6 +200,17 @@ namespace gpstk
           * @return true if OrbitEph was defined, false otherwise */
          //virtual bool load(const Rinex3NavData& rnd);
 
+         /** Append the data members to a binary snapshot (see
+          * OrbitEphStore::writeBinaryFile()).  Classes derived from
+          * OrbitEph that add data members must override this and
+          * readSnapshot(), calling the base class version first. */
+      virtual void writeSnapshot(SnapshotWriter& snap) const;
+
+         /** Restore the data members from a binary snapshot written
+          * by writeSnapshot().
+          * @throw SnapshotException if the snapshot is truncated */
+      virtual void readSnapshot(SnapshotReader& snap);
+
          // member data
      
          // overhead
@@ -222,6 +250,18 @@ namespace gpstk
       CommonTime beginValid;  ///< Time at beginning of validity
       CommonTime endValid;    ///< Time at end of fit validity
 
+   protected:
+         /** Iterate Kepler's equation for m lanes in lockstep, using
+          * the same convergence test and iteration limit as svXvt().
+          * @param[in] meana mean anomaly of each lane.
+          * @param[in,out] ea initial, then converged, eccentric anomaly.
+          * @param[in,out] active lanes still iterating; all should be
+          *   true on input.
+          * @param[in] m number of lanes.
+          * @param[in] lecc eccentricity. */
+      static void solveKeplerBlock(const double *meana, double *ea,
+                                   bool *active, size_t m, double lecc);
+
    }; // end class OrbitEph
 
       //@}
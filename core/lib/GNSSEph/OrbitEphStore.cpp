@@ -45,6 +45,8 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
 
 #include "StringUtils.hpp"
 #include "MathBase.hpp"
@@ -53,31 +55,171 @@
 #include "RinexSatID.hpp"  // for dump
 
 #include "OrbitEphStore.hpp"
+#include "GPSEphemeris.hpp"
+#include "GalEphemeris.hpp"
+#include "BDSEphemeris.hpp"
+#include "QZSEphemeris.hpp"
 
 using namespace std;
 using namespace gpstk::StringUtils;
 
 namespace gpstk
 {
+   //---------------------------------------------------------------------------------
+   OrbitEphStore::OrbitEphStore(const OrbitEphStore& right)
+         : XvtStore<SatID>(right),
+           message(right.message),
+           initialTime(right.initialTime),
+           finalTime(right.finalTime),
+           timeSystem(right.timeSystem),
+           strictMethod(right.strictMethod),
+           frozenIds(0), frozenId(0)
+   {
+      copyTables(right);
+   }
+
+   //---------------------------------------------------------------------------------
+   OrbitEphStore& OrbitEphStore::operator=(const OrbitEphStore& right)
+   {
+      if(this == &right) return *this;
+
+      clear();
+      XvtStore<SatID>::operator=(right);
+      message = right.message;
+      initialTime = right.initialTime;
+      finalTime = right.finalTime;
+      timeSystem = right.timeSystem;
+      strictMethod = right.strictMethod;
+      copyTables(right);
+      return *this;
+   }
+
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::copyTables(const OrbitEphStore& right)
+   {
+      SatTableMap::const_iterator it;
+      for(it = right.satTables.begin(); it != right.satTables.end(); it++) {
+         TimeOrbitEphTable& table = satTables[it->first];
+         TimeOrbitEphTable::const_iterator ei;
+         for(ei = it->second.begin(); ei != it->second.end(); ei++)
+            table[ei->first] = ei->second->clone();
+      }
+      if(right.isFrozen())
+         freeze();
+   }
+
    //---------------------------------------------------------------------------------
    Xvt OrbitEphStore::getXvt(const SatID& sat, const CommonTime& t) const
    {
-      try {
-         // get the appropriate OrbitEph
-         const OrbitEph *eph = findOrbitEph(sat,t);
-         if(!eph)
-            GPSTK_THROW(InvalidRequest("No OrbitEph for satellite " + asString(sat)));
-
-         // no consideration is given to health here (OrbitEph does not have health);
-         // derived classes should override isHealthy()
-         if(onlyHealthy && !eph->isHealthy())
-            GPSTK_THROW(InvalidRequest("Not healthy"));
-
-         // compute the position, velocity and time
-         Xvt sv = eph->svXvt(t);
+      Xvt sv;
+      if(computeXvt(sat,t,sv))
          return sv;
+
+      // only a miss pays for the message; repeat the lookup to explain it
+      if(!findOrbitEph(sat,t))
+         GPSTK_THROW(InvalidRequest("No OrbitEph for satellite " + asString(sat)));
+      GPSTK_THROW(InvalidRequest("Not healthy"));
+   }
+
+   //---------------------------------------------------------------------------------
+   bool OrbitEphStore::computeXvt(const SatID& sat, const CommonTime& t,
+                                  Xvt& xvt) const
+   {
+      // the table search would throw on a conflict of time systems
+      if(!compatibleTimeSystem(sat,t))
+         return false;
+
+      // get the appropriate OrbitEph
+      const OrbitEph *eph = findOrbitEph(sat,t);
+      if(!eph)
+         return false;
+
+      // no consideration is given to health here (OrbitEph does not have health);
+      // derived classes should override isHealthy()
+      if(onlyHealthy && !eph->isHealthy())
+         return false;
+
+      // compute the position, velocity and time
+      xvt = eph->svXvt(t);
+      return true;
+   }
+
+   //---------------------------------------------------------------------------------
+   bool OrbitEphStore::compatibleTimeSystem(const SatID& sat,
+                                            const CommonTime& t) const
+   {
+      const TimeSystem ts(t.getTimeSystem());
+      if(ts == TimeSystem::Any)
+         return true;
+
+      SatTableMap::const_iterator it = satTables.find(sat);
+      if(it == satTables.end() || it->second.empty())
+         return true;                  // there is nothing to compare with
+
+      // the keys of a table share a time system, or are Any
+      const TimeSystem first(it->second.begin()->first.getTimeSystem());
+      const TimeSystem last(it->second.rbegin()->first.getTimeSystem());
+      return ((first == TimeSystem::Any || first == ts) &&
+              (last == TimeSystem::Any || last == ts));
+   }
+
+   //---------------------------------------------------------------------------------
+   unsigned OrbitEphStore::getXvtBatch(const std::vector<SatID>& sats,
+                                       const std::vector<CommonTime>& times,
+                                       XvtArray& xvt,
+                                       std::vector<bool>& valid) const
+   {
+      if(sats.size() != times.size())
+         GPSTK_THROW(InvalidRequest("Satellite and time lists differ in length"));
+
+      const size_t n = sats.size();
+      xvt.resize(n);
+      valid.assign(n, false);
+
+      // resolve each request to its OrbitEph, then order the requests by
+      // OrbitEph so that each one is evaluated in a single batch
+      vector< pair<const OrbitEph*, size_t> > work;
+      work.reserve(n);
+      for(size_t i=0; i<n; i++) {
+         const OrbitEph *eph = findOrbitEph(sats[i], times[i]);
+         if(!eph) continue;
+         if(onlyHealthy && !eph->isHealthy()) continue;
+         work.push_back(make_pair(eph, i));
+      }
+      sort(work.begin(), work.end());
+
+      vector<CommonTime> groupTimes;
+      XvtArray groupXvt;
+      size_t first = 0;
+      while(first < work.size()) {
+         const OrbitEph *eph = work[first].first;
+         size_t last = first;
+         groupTimes.clear();
+         while(last < work.size() && work[last].first == eph) {
+            groupTimes.push_back(times[work[last].second]);
+            last++;
+         }
+
+         eph->svXvtBatch(groupTimes, groupXvt);
+
+         for(size_t j=first; j<last; j++) {
+            size_t i = work[j].second, k = j-first;
+            xvt.x[i] = groupXvt.x[k];
+            xvt.y[i] = groupXvt.y[k];
+            xvt.z[i] = groupXvt.z[k];
+            xvt.vx[i] = groupXvt.vx[k];
+            xvt.vy[i] = groupXvt.vy[k];
+            xvt.vz[i] = groupXvt.vz[k];
+            xvt.clkbias[i] = groupXvt.clkbias[k];
+            xvt.clkdrift[i] = groupXvt.clkdrift[k];
+            xvt.relcorr[i] = groupXvt.relcorr[k];
+            xvt.frame[i] = groupXvt.frame[k];
+            valid[i] = true;
+         }
+         first = last;
       }
-      catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
+
+      return work.size();
    }
 
    //---------------------------------------------------------------------------------
@@ -193,6 +335,7 @@ namespace gpstk
    OrbitEph* OrbitEphStore::addEphemeris(const OrbitEph* eph)
    {
       OrbitEph *ret(0);
+      unfreeze();
       try {
          // is the satellite found in the table? If not, create one
          if(satTables.find(eph->satID) == satTables.end()) {
@@ -299,6 +442,7 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::edit(const CommonTime& tmin, const CommonTime& tmax)
    {
+      unfreeze();
       for(SatTableMap::iterator i = satTables.begin(); i != satTables.end(); i++)
       {
          TimeOrbitEphTable& eMap = i->second;
@@ -327,6 +471,7 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::clear(void)
    {
+      unfreeze();
       for(SatTableMap::iterator ui=satTables.begin(); ui!=satTables.end(); ui++) {
          TimeOrbitEphTable& toet = ui->second;
          for(TimeOrbitEphTable::iterator toeti = toet.begin(); toeti != toet.end(); toeti++) {
@@ -343,6 +488,68 @@ namespace gpstk
       finalTime.setTimeSystem(timeSystem);
    }
 
+   //---------------------------------------------------------------------------------
+   // Create an empty OrbitEph of the type whose getName() is name, or NULL.
+   static OrbitEph* newOrbitEph(const string& name)
+   {
+      if(name == "GPSEphemeris") return new GPSEphemeris();
+      if(name == "GalEphemeris") return new GalEphemeris();
+      if(name == "BDSEphemeris") return new BDSEphemeris();
+      if(name == "QZSEphemeris") return new QZSEphemeris();
+      if(name == "OrbitEph") return new OrbitEph();
+      return NULL;
+   }
+
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::writeBinaryFile(const string& filename) const
+   {
+      try {
+         SnapshotWriter snap("OrbitEphStore");
+         snap.putInt(size());
+         SatTableMap::const_iterator it;
+         for(it = satTables.begin(); it != satTables.end(); it++) {
+            TimeOrbitEphTable::const_iterator jt;
+            for(jt = it->second.begin(); jt != it->second.end(); jt++) {
+               snap.putString(jt->second->getName());
+               jt->second->writeSnapshot(snap);
+            }
+         }
+         snap.write(filename);
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::readBinaryFile(const string& filename)
+   {
+      try {
+         SnapshotReader snap;
+         snap.open(filename, "OrbitEphStore");
+         clear();
+
+         int64_t n = snap.getInt();
+         for(int64_t i = 0; i < n; i++) {
+            string name = snap.getString();
+            OrbitEph *eph = newOrbitEph(name);
+            if(!eph) {
+               SnapshotException e("Unknown OrbitEph type " + name
+                                   + " in snapshot " + filename);
+               GPSTK_THROW(e);
+            }
+            try {
+               eph->readSnapshot(snap);
+               addEphemeris(eph);
+            }
+            catch(...) {
+               delete eph;
+               throw;
+            }
+            delete eph;
+         }
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
    //---------------------------------------------------------------------------------
    unsigned OrbitEphStore::size(void) const
    {
@@ -373,6 +580,143 @@ namespace gpstk
       return n;
    }
 
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::freeze()
+   {
+      static std::atomic<unsigned long> lastId(0);
+
+      unfreeze();
+
+      // The index is addressed by system and id; a store holding a satellite
+      // without a proper id is left without one.
+      int maxSys(-1), maxId(-1);
+      SatTableMap::const_iterator it;
+      for(it = satTables.begin(); it != satTables.end(); it++) {
+         if(it->first.id < 0) return;
+         maxSys = std::max(maxSys, static_cast<int>(it->first.system));
+         maxId = std::max(maxId, it->first.id);
+      }
+
+      frozenIds = maxId+1;
+      frozenSlot.assign((maxSys+1)*frozenIds, -1);
+      for(it = satTables.begin(); it != satTables.end(); it++) {
+         const TimeOrbitEphTable& table = it->second;
+         if(table.empty()) continue;
+
+         frozenSlot[it->first.system*frozenIds + it->first.id] =
+            frozenTables.size();
+         frozenTables.push_back(FrozenTable());
+         FrozenTable& ft = frozenTables.back();
+         ft.msec.reserve(table.size());
+         ft.fsod.reserve(table.size());
+         ft.eph.reserve(table.size());
+         ft.timeSystem = TimeSystem::Any;
+         TimeOrbitEphTable::const_iterator ei;
+         for(ei = table.begin(); ei != table.end(); ei++) {
+            long day, msod;
+            double fsod;
+            ei->first.get(day, msod, fsod);
+            if(ft.timeSystem == TimeSystem::Any)
+               ft.timeSystem = ei->first.getTimeSystem();
+            ft.msec.push_back(static_cast<int64_t>(day)*MS_PER_DAY + msod);
+            ft.fsod.push_back(fsod);
+            ft.eph.push_back(ei->second);
+         }
+      }
+
+      frozenId = ++lastId;
+   }
+
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::unfreeze()
+   {
+      frozenId = 0;
+      frozenTables.clear();
+      frozenSlot.clear();
+   }
+
+   //---------------------------------------------------------------------------------
+   // Each thread remembers, for the last few frozen stores it searched, where
+   // its last search for each satellite ended.
+   namespace
+   {
+      struct LastFrozenHits
+      {
+         static const int nStores = 4;
+         unsigned long id[nStores];
+         std::vector<size_t> pos[nStores];
+         int next;
+
+         LastFrozenHits() : next(0)
+         { for(int i=0; i<nStores; i++) id[i] = 0; }
+
+            // positions for the index frozenId with nsat satellites
+         std::vector<size_t>& get(unsigned long frozenId, size_t nsat)
+         {
+            for(int i=0; i<nStores; i++)
+               if(id[i] == frozenId) return pos[i];
+            int i = next;
+            next = (next+1) % nStores;
+            id[i] = frozenId;
+            pos[i].assign(nsat, 0);
+            return pos[i];
+         }
+      };
+   }
+
+   const OrbitEphStore::FrozenTable* OrbitEphStore::frozenFind(const SatID& sat,
+                                                               const CommonTime& t,
+                                                               size_t& pos) const
+   {
+      if(sat.id < 0 || sat.id >= frozenIds) return NULL;
+      size_t k = sat.system*frozenIds + sat.id;
+      if(k >= frozenSlot.size() || frozenSlot[k] < 0) return NULL;
+      const FrozenTable& ft = frozenTables[frozenSlot[k]];
+
+      // the keys are compared without their time system below, so reject a
+      // conflict here as CommonTime::operator<() does for the unfrozen table
+      const TimeSystem ts(t.getTimeSystem());
+      if(ts != TimeSystem::Any && ft.timeSystem != TimeSystem::Any &&
+         ts != ft.timeSystem)
+      {
+         InvalidRequest ir("CommonTime objects not in same time system,"
+                           " cannot be compared: " + ft.timeSystem.asString()
+                           + " != " + ts.asString());
+         GPSTK_THROW(ir);
+      }
+
+      long day, msod;
+      double fsod;
+      t.get(day, msod, fsod);
+      const int64_t msec = static_cast<int64_t>(day)*MS_PER_DAY + msod;
+      const int64_t *km = &ft.msec[0];
+      const double *kf = &ft.fsod[0];
+      const size_t n = ft.msec.size();
+
+      // key i is before t, compared as CommonTime::operator<()
+#define KEY_BEFORE_T(i) ((km[i] < msec) | ((km[i] == msec) & (kf[i] < fsod)))
+
+      // try where this thread's last search for sat ended
+      static thread_local LastFrozenHits hits;
+      size_t& last = hits.get(frozenId, frozenTables.size())[frozenSlot[k]];
+      pos = last;
+      if((pos == 0 || KEY_BEFORE_T(pos-1)) && (pos == n || !KEY_BEFORE_T(pos)))
+         return &ft;
+
+      // binary search for the first key not before t
+      size_t lo(0), len(n);
+      while(len > 0) {
+         size_t half = len/2;
+         bool before = KEY_BEFORE_T(lo+half);
+         lo = before ? lo+half+1 : lo;
+         len = before ? len-half-1 : half;
+      }
+#undef KEY_BEFORE_T
+
+      pos = last = lo;
+      return &ft;
+   }
+
    //---------------------------------------------------------------------------------
    // The goal of this routine is to find the set of orbital elements that would have
    // been used by a receiver in real-time. That is to say, the most recently
@@ -381,6 +725,22 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findUserOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      // With the index the same choice is made, as explained below, from
+      // the first key not before t.
+      if(frozenId) {
+         size_t pos;
+         const FrozenTable *ft = frozenFind(sat, t, pos);
+         if(!ft) return NULL;
+         const size_t n = ft->eph.size();
+         if(pos == n)
+            return ft->eph[n-1]->isValid(t) ? ft->eph[n-1] : NULL;
+         if(ft->eph[pos]->isValid(t))
+            return ft->eph[pos];
+         if(pos > 0 && ft->eph[pos-1]->isValid(t))
+            return ft->eph[pos-1];
+         return NULL;
+      }
+
       // Is this satellite found in the table?
       if(satTables.find(sat) == satTables.end())
          return NULL;
@@ -466,88 +826,113 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findNearOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      // the OrbitEph with the first key after t, and the one before it, or
+      // NULL where there is none
+      const OrbitEph *next, *prior;
+
+      if(frozenId) {
+         size_t pos;
+         const FrozenTable *ft = frozenFind(sat, t, pos);
+         if(!ft) return NULL;
+         const size_t n = ft->eph.size();
+         if(pos < n) {                           // exact match?
+            long day, msod;
+            double fsod;
+            t.get(day, msod, fsod);
+            if(ft->msec[pos] == static_cast<int64_t>(day)*MS_PER_DAY + msod
+               && ft->fsod[pos] == fsod)
+               return ft->eph[pos];
+         }
+         next = (pos < n ? ft->eph[pos] : NULL);
+         prior = (pos > 0 ? ft->eph[pos-1] : NULL);
+      }
+      else {
+           // Check for any OrbitEph for this SV
+         if(satTables.find(sat) == satTables.end())
+            return NULL;
 
-        // Check for any OrbitEph for this SV
-      if(satTables.find(sat) == satTables.end())
-         return NULL;
+         // No OrbitEph in store for requested sat time
+         // Define reference to the relevant map of orbital elements
+         const TimeOrbitEphTable& table = getTimeOrbitEphMap(sat);
 
-      // No OrbitEph in store for requested sat time
-      // Define reference to the relevant map of orbital elements
-      const TimeOrbitEphTable& table = getTimeOrbitEphMap(sat);
+         if (table.empty())
+            return NULL;
 
-      if (table.empty())
-         return NULL;
+         TimeOrbitEphTable::const_iterator itNext = table.find(t);
+         if(itNext != table.end())               // exact match
+            return itNext->second;
 
-      TimeOrbitEphTable::const_iterator itNext = table.find(t);
-      if(itNext != table.end())               // exact match
-         return itNext->second;
+         // lower_bound returns the first element with key >= t
+         itNext = table.lower_bound(t);
+         next = (itNext == table.end() ? NULL : itNext->second);
+         prior = NULL;
+         if(itNext != table.begin()) {
+            TimeOrbitEphTable::const_iterator itPrior = itNext;
+            itPrior--;
+            prior = itPrior->second;
+         }
+      }
 
       // Three cases:
       // 1. t is within a gap within the store
       // 2. t is before all OrbitEph in the store
       // 3. t is after all OrbitEph in the store
 
-      // lower_bound returns the first element with key >= t
-      itNext = table.lower_bound(t);
-      if(itNext == table.begin())             // Test for case 2
+      if(prior == NULL)                       // Test for case 2
       {
             // Verify the first item in the table has a fit interval that
             // covers the time of interest.   If not, then there are no
             // data sets available that cover the time of interest, so return
             // NULL. 
-         if (itNext->second->isValid(t))
-            return itNext->second;
+         if (next->isValid(t))
+            return next;
          else 
             return NULL;
       }
 
        // Test for case 3
-      if(itNext == table.end()) 
+      if(next == NULL) 
       {
-         TimeOrbitEphTable::const_reverse_iterator rit = table.rbegin();
             // Verify the last item in the table has a fit interval that
             // covers the time of interest.   If not, then there are no
             // data sets available that cover the time of interest, so return
             // NULL. 
-         if (rit->second->isValid(t))
-            return rit->second;
+         if (prior->isValid(t))
+            return prior;
          else
             return NULL; 
       }
 
-      // case 1: it is not the beginning, so safe to decrement
-      CommonTime nextTOE = itNext->second->ctToe;
-      TimeOrbitEphTable::const_iterator itPrior = itNext;
-      itPrior--;
-      CommonTime lastTOE = itPrior->second->ctToe;
+      // case 1: t is between two OrbitEph
+      CommonTime nextTOE = next->ctToe;
+      CommonTime lastTOE = prior->ctToe;
       double diffToNext = nextTOE - t;
       double diffFromLast = t - lastTOE;
 
          // Determine which is closer to Toe and assign temporary
          // pointers accordingly.  
-      TimeOrbitEphTable::const_iterator itSelect;
-      TimeOrbitEphTable::const_iterator itUnSelect;
+      const OrbitEph *select, *unSelect;
       if(diffToNext > diffFromLast)
       {
-         itSelect = itPrior;
-         itUnSelect = itNext;
+         select = prior;
+         unSelect = next;
       }
       else
       {
-         itSelect = itNext;
-         itUnSelect = itPrior;
+         select = next;
+         unSelect = prior;
       }
 
          // If the selected item is valid return it.
          // If not, check to see if the unselected item is valid; if so return that one. 
          // Otherwise, there is no data set with a valid fit interval. 
-      if (itSelect->second->isValid(t))
+      if (select->isValid(t))
       {
-         return itSelect->second;
+         return select;
       }
-      else if (itUnSelect->second->isValid(t))
+      else if (unSelect->isValid(t))
       {
-         return itUnSelect->second;
+         return unSelect;
       }
       return NULL;
    }
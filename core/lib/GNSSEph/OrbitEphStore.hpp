@@ -49,12 +49,15 @@
 #include <iostream>
 #include <list>
 #include <set>
+#include <vector>
+#include <stdint.h>
 
 #include "OrbitEph.hpp"
 #include "Exception.hpp"
 #include "SatID.hpp"
 #include "CommonTime.hpp"
 #include "XvtStore.hpp"
+#include "XvtArray.hpp"
 //#include "Rinex3NavData.hpp"
 
 namespace gpstk
@@ -78,7 +81,7 @@ namespace gpstk
       OrbitEphStore()
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              strictMethod(true)
+              strictMethod(true), frozenIds(0), frozenId(0)
       {
          timeSystem = TimeSystem::Any;
          initialTime.setTimeSystem(timeSystem);
@@ -86,6 +89,13 @@ namespace gpstk
          setOnlyHealthyFlag(false);
       }
 
+         /** Copy constructor. The copy holds its own copies of the
+          * OrbitEph, and its own index if the original is frozen. */
+      OrbitEphStore(const OrbitEphStore& right);
+
+         /// Assignment, copying the OrbitEph as the copy constructor does.
+      OrbitEphStore& operator=(const OrbitEphStore& right);
+
          /// Destructor
       virtual ~OrbitEphStore() { clear(); }
 
@@ -103,6 +113,38 @@ namespace gpstk
           *   there are no orbit elements at time t. */
       virtual Xvt getXvt(const SatID& id, const CommonTime& t) const;
 
+         /** Non-throwing form of getXvt(): the OrbitEph lookup already
+          * reports a miss as NULL, so no exception is built for a
+          * satellite that is absent, has no elements at t, or is
+          * unhealthy when onlyHealthy is set.
+          * @param[in] id satellite SatID
+          * @param[in] t the time to look up
+          * @param[out] xvt the Xvt of the satellite, when true is returned
+          * @return true if the Xvt was computed, false where getXvt()
+          *   would have thrown. */
+      virtual bool computeXvt(const SatID& id, const CommonTime& t,
+                              Xvt& xvt) const;
+
+         /** Compute position, velocity and clock offset for many
+          * (satellite, time) pairs at once.  Each pair is resolved to
+          * an OrbitEph exactly as getXvt() does; the pairs sharing an
+          * OrbitEph are then evaluated together with
+          * OrbitEph::svXvtBatch().  Results are identical to calling
+          * getXvt() for each pair.
+          * @param[in] sats satellite of each request
+          * @param[in] times time of each request, same length as sats
+          * @param[out] xvt resized to sats.size(); element i holds the
+          *   result for (sats[i],times[i]) when valid[i] is true
+          * @param[out] valid resized to sats.size(); false where
+          *   getXvt() would have thrown (no OrbitEph, or unhealthy
+          *   when onlyHealthy is set)
+          * @return the number of valid results
+          * @throw InvalidRequest if sats and times differ in length. */
+      unsigned getXvtBatch(const std::vector<SatID>& sats,
+                           const std::vector<CommonTime>& times,
+                           XvtArray& xvt,
+                           std::vector<bool>& valid) const;
+
          /** Output summary of store data in human readable form, with detail:
           *  0: Time limits and number of entries for entire store
           *  1: Level 0 plus for each satellite: one line giving
@@ -130,6 +172,26 @@ namespace gpstk
          /// Clear the dataset, meaning remove all data
       virtual void clear(void);
 
+         /** Write every OrbitEph in the store to a binary snapshot
+          * file, which readBinaryFile() can reload without parsing
+          * the original navigation files.  Each OrbitEph is written
+          * with its getName() and writeSnapshot().
+          * @param filename name of the file to write
+          * @throw SnapshotException if the file cannot be written */
+      void writeBinaryFile(const std::string& filename) const;
+
+         /** Replace the contents of the store with a snapshot written
+          * by writeBinaryFile().  The file is memory mapped and its
+          * checksums verified before the store is cleared; the
+          * ephemerides are then added with addEphemeris(), so the
+          * current search method and time limits apply as if they
+          * had been loaded from the original files.
+          * @param filename name of the file to read
+          * @throw SnapshotException if the file is missing, corrupt,
+          *   not an OrbitEphStore snapshot, or contains an OrbitEph
+          *   type this store cannot create */
+      void readBinaryFile(const std::string& filename);
+
          /** Return the earliest time in the store.
           * @return The store initial time */
       virtual CommonTime getInitialTime() const
@@ -292,6 +354,26 @@ namespace gpstk
          return (strictMethod ? findUserOrbitEph(sat,t) : findNearOrbitEph(sat, t));
       }
 
+         /** Build a read-only index of the store, used by
+          * findUserOrbitEph() and findNearOrbitEph() (and so by
+          * getXvt()) until the store is next modified.  The index
+          * holds the keys of each satellite's table in a flat sorted
+          * array, and each thread remembers where its last search
+          * for each satellite ended, so that the usual queries at
+          * steadily increasing times seldom search at all.  The
+          * results are the same as without the index.  Call this
+          * after all the data have been loaded (and rationalized);
+          * addEphemeris(), edit(), clear() and rationalize() discard
+          * the index. */
+      void freeze();
+
+         /// Discard the index built by freeze().
+      void unfreeze();
+
+         /// Return true if the store has an index built by freeze().
+      bool isFrozen() const
+      { return frozenId != 0; }
+
          /** Add all ephemerides to an existing list<OrbitEph>.  If
           * SatID sat is given, limit selections to sat's satellite
           * system, plus if sat's id is not -1, limit to sat's id as
@@ -376,6 +458,43 @@ namespace gpstk
           *  getSatXvt and getSatHealth */
       bool strictMethod;
 
+         /** One satellite's table, as kept by freeze(): the keys in
+          * order, split as CommonTime keeps them, and the matching
+          * OrbitEph. */
+      struct FrozenTable
+      {
+         std::vector<int64_t> msec;   ///< day*MS_PER_DAY + msod of each key
+         std::vector<double> fsod;    ///< fractional seconds of each key
+         std::vector<const OrbitEph*> eph;
+         TimeSystem timeSystem;       ///< system of the keys, Any if unset
+      };
+
+         /** Index built by freeze(): frozenTables[frozenSlot[k]] is the
+          * table of the satellite with k = system*frozenIds + id, or
+          * frozenSlot[k] is -1 if there is none. */
+      std::vector<FrozenTable> frozenTables;
+      std::vector<int> frozenSlot;
+      int frozenIds;
+
+         /// Unique (never reused) number of the index, 0 if not frozen
+      unsigned long frozenId;
+
+         /** Find the table of sat in the index, and where t falls in
+          * it, i.e. the first key not before t.
+          * @return the table, or NULL if sat has none
+          * @throw InvalidRequest if t and the keys are in different
+          *   time systems, as searching the unfrozen table would */
+      const FrozenTable* frozenFind(const SatID& sat, const CommonTime& t,
+                                    size_t& pos) const;
+
+         /** Return false if t can not be compared with the keys of
+          * the table of sat, i.e. if searching the table would throw
+          * because the time systems differ (neither being Any). */
+      bool compatibleTimeSystem(const SatID& sat, const CommonTime& t) const;
+
+         /// Add copies of all the OrbitEph in right to the (empty) tables.
+      void copyTables(const OrbitEphStore& right);
+
          /// Convenience routines
       void updateTimeLimits(const OrbitEph* eph)
       {
@@ -49,12 +49,34 @@
 //#include "YDSTime.hpp"
 #include "GNSSconstants.hpp"
 
+namespace
+{
+      /// Number of bits in each element of PackedNavBits::words
+   const size_t wordBits = 64;
+
+      /// Number of bits allocated by the PackedNavBits constructors
+   const size_t defaultNumBits = 900;
+
+      /// Number of words needed to hold numBits bits
+   inline size_t wordsFor(const size_t numBits)
+   {
+      return (numBits + wordBits - 1) / wordBits;
+   }
+
+      /// Mask of the low numBits bits of a word, 0 <= numBits <= 64
+   inline uint64_t lowMask(const int numBits)
+   {
+      return numBits >= 64 ? ~uint64_t(0) : (uint64_t(1) << numBits) - 1;
+   }
+}
+
 namespace gpstk
 {
    using namespace std;
    PackedNavBits::PackedNavBits()
                  : transmitTime(CommonTime::BEGINNING_OF_TIME),
-                   bits(900),
+                   words(wordsFor(defaultNumBits), 0),
+                   bits_size(defaultNumBits),
                    bits_used(0),
                    rxID(""),
                    xMitCoerced(false)
@@ -64,7 +86,8 @@ namespace gpstk
    PackedNavBits::PackedNavBits(const SatID& satSysArg, 
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : words(wordsFor(defaultNumBits), 0),
+                                  bits_size(defaultNumBits),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
@@ -79,7 +102,8 @@ namespace gpstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : words(wordsFor(defaultNumBits), 0),
+                                  bits_size(defaultNumBits),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
@@ -96,7 +120,8 @@ namespace gpstk
                                 const NavID& navIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : words(wordsFor(defaultNumBits), 0),
+                                  bits_size(defaultNumBits),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
@@ -118,11 +143,9 @@ namespace gpstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
+      words = right.words;
+      bits_size = right.bits_size;
+      resizeBits(bits_used);
       xMitCoerced = right.xMitCoerced;
    }
  
@@ -180,7 +203,8 @@ namespace gpstk
    
    void PackedNavBits::clearBits()
    {
-      bits.clear();
+      words.clear();
+      bits_size = 0;
       bits_used = 0;
    }
 
@@ -219,20 +243,31 @@ namespace gpstk
                                       const int numBits ) const
       throw(InvalidParameter)                                    
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (stop>bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GPSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
-      {
-         temp <<= 1;
-         if (bits[i]) temp++;
-      }
-      return( temp ); 
+      if (numBits <= 0)
+         return 0;
+         // Only the last 64 bits of a longer field fit in the result
+      if (numBits > 64)
+         return getBits(stop-64, 64);
+      return getBits(startBit, numBits);
+   }
+
+   uint64_t PackedNavBits::getBits(const size_t startBit,
+                                   const int numBits) const
+   {
+         // Left justify the field in hi, taking the tail from the
+         // following word when the field spans a word boundary.
+      size_t ndx = startBit / wordBits;
+      unsigned offset = startBit % wordBits;
+      uint64_t hi = words[ndx] << offset;
+      if (offset + numBits > wordBits)
+         hi |= words[ndx+1] >> (wordBits - offset);
+      return hi >> (wordBits - numBits);
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit, 
@@ -259,7 +294,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) uint;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -270,7 +305,7 @@ namespace gpstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -309,7 +344,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) smag;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
                              
@@ -410,7 +445,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) ulong;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -435,7 +470,7 @@ namespace gpstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -451,7 +486,8 @@ namespace gpstk
 
    bool PackedNavBits::asBool( const unsigned bitNum) const
    {
-      return bits[bitNum]; 
+      return (words[bitNum / wordBits] >> 
+              (wordBits - 1 - bitNum % wordBits)) & 1; 
    }
 
 
@@ -464,7 +500,7 @@ namespace gpstk
       uint64_t out = (uint64_t) value;
       out /= scale;
 
-      uint64_t test = pow(static_cast<double>(2),numBits) - 1; 
+      uint64_t test = lowMask(numBits); 
       if ( out > test )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -484,7 +520,7 @@ namespace gpstk
       out = (int64_t) value;
       out /= scale;
 
-      int64_t test = pow(static_cast<double>(2),numBits-1) - 1; 
+      int64_t test = lowMask(numBits-1); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -498,7 +534,7 @@ namespace gpstk
       throw(InvalidParameter)
    {
       uint64_t out = (uint64_t) ScaleValue(value, power2);
-      uint64_t test = pow(static_cast<double>(2),numBits) - 1;
+      uint64_t test = lowMask(numBits);
       if ( out > test )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -518,7 +554,7 @@ namespace gpstk
          int64_t out;
       };
       out = (int64_t) ScaleValue(value, power2);
-      int64_t test = pow(static_cast<double>(2),numBits-1) - 1; 
+      int64_t test = lowMask(numBits-1); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -538,7 +574,7 @@ namespace gpstk
       };
       double temp = Radians/PI;
       out = (int64_t) ScaleValue(temp, power2);
-      int64_t test = pow(static_cast<double>(2), numBits-1) - 1; 
+      int64_t test = lowMask(numBits-1); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -593,32 +629,68 @@ namespace gpstk
    {
       int old_bits_used = bits_used;
       bits_used += right.bits_used;
-      bits.resize(bits_used);
-      
-      for (int i=0;i<right.bits_used;i++)
-      {
-         bits[i+old_bits_used] = right.bits[i];
-      }
+      resizeBits(bits_used);
+      copyBitRange(right, 0, old_bits_used, right.bits_used);
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
+      if (bits_used + numBits > bits_size)
+         resizeBits(bits_used + numBits);
+      setBits(bits_used, numBits, value);
+      bits_used += numBits;
+   }
 
-      for (int i=0; i<numBits; ++i)
+   void PackedNavBits::setBits( const size_t startBit, const int numBits,
+                                const uint64_t value )
+   {
+      if (numBits <= 0)
+         return;
+      uint64_t field = value & lowMask(numBits);
+      size_t ndx = startBit / wordBits;
+      unsigned offset = startBit % wordBits;
+      if (offset + numBits <= wordBits)
       {
-         bits[ndx] = false;
-         if (value & mask) 
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
+         unsigned shift = wordBits - offset - numBits;
+         words[ndx] = (words[ndx] & ~(lowMask(numBits) << shift)) |
+            (field << shift);
+      }
+      else
+      {
+            // The field spans two words; n1 bits go in the first,
+            // the remaining n2 at the top of the second.
+         int n1 = wordBits - offset;
+         int n2 = numBits - n1;
+         words[ndx] = (words[ndx] & ~lowMask(n1)) | (field >> n2);
+         words[ndx+1] = (words[ndx+1] & lowMask(wordBits - n2)) |
+            (field << (wordBits - n2));
       }
-      bits_used += numBits;
+   }
+
+   void PackedNavBits::copyBitRange( const PackedNavBits& from,
+                                     const size_t fromBit,
+                                     const size_t toBit,
+                                     const size_t numBits )
+   {
+      size_t done = 0;
+      while (done < numBits)
+      {
+         int n = numBits - done;
+         if (n > 64) n = 64;
+         setBits(toBit + done, n, from.getBits(fromBit + done, n));
+         done += n;
+      }
+   }
+
+   void PackedNavBits::resizeBits( const size_t numBits )
+   {
+      words.resize(wordsFor(numBits), 0);
+      bits_size = numBits;
+         // keep the unused tail of the last word clear so that
+         // whole words may be compared and hashed
+      unsigned tail = numBits % wordBits;
+      if (tail)
+         words.back() &= ~lowMask(wordBits - tail);
    }
 
    //--------------------------------------------------------------------------
@@ -628,9 +700,9 @@ namespace gpstk
    // in which left has a FALSE whereas right has a TRUE starting at the 
    // lowest index and scanning to the maximum index.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation 
-   // is probably not the fastest.  Since we are scanning a bit array rather 
-   // than testing a series of unsigned ints.
+   //
+   // Since the first bit is the most significant bit of the first word,
+   // the first differing word decides the order.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -638,27 +710,38 @@ namespace gpstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should 
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         if (bits[i]==false && right.bits[i]==true)
-         //if (bits[i]<right.bits[i])
-         {
-            return true;
-         }
-         if (bits[i]==true && right.bits[i]==false)
+         if (words[i]!=right.words[i])
          {
-            return false;
+            return words[i]<right.words[i];
          }
       }
       return false;
    }
 
+   std::size_t PackedNavBits::hashBits() const
+   {
+         // FNV-1a over the 64-bit words, finished with a mixing step
+         // so that all bits of the result depend on every word.
+      uint64_t h = 14695981039346656037ULL ^ bits_size;
+      for (size_t i=0;i<words.size();i++)
+      {
+         h ^= words[i];
+         h *= 1099511628211ULL;
+      }
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<std::size_t>(h);
+   }
+
    void PackedNavBits::invert( )
    {
          // Each bit is either 1 or 0.
@@ -671,10 +754,11 @@ namespace gpstk
          //
          // This accomplishes the purpose without incurring
          // the cost of a conditional statement.
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         bits[i] = 1 - bits[i];
+         words[i] = ~words[i];
       }
+      resizeBits(bits_size);
    } 
 
       /**
@@ -699,10 +783,8 @@ namespace gpstk
       short finalBit = endBit;
       if (finalBit==-1) finalBit = bits_used - 1;
 
-      for (short i=startBit; i<=finalBit; i++)
-      {
-         bits[i] = from.bits[i];
-      }
+      if (finalBit >= startBit)
+         copyBitRange(from, startBit, startBit, finalBit - startBit + 1);
    }
 
 
@@ -725,27 +807,14 @@ namespace gpstk
       uint64_t out = (uint64_t) value;
       out /= scale;
 
-      uint64_t test = pow(static_cast<double>(2),numBits) - 1; 
+      uint64_t test = lowMask(numBits); 
       if ( out > test )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
          GPSTK_THROW(exc);
       }
 
-      size_t ndx = startBit;
-      uint64_t mask = 0x0000000000000001L; 
-
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; i++)
-      {
-         bits[ndx] = false;
-         if (out & mask)
-         {
-            bits[ndx] = true;
-         }
-         mask >>= 1;
-         ndx++;
-      }
+      setBits(startBit, numBits, out);
    }
 
 
@@ -760,7 +829,7 @@ namespace gpstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -780,7 +849,7 @@ namespace gpstk
    double PackedNavBits::ScaleValue( const double value, const int power2) const
    {
       double temp = value;
-      temp /= pow(static_cast<double>(2), power2);
+      temp = ldexp(temp, -power2);
       if (temp >= 0) temp += 0.5; // Takes care of rounding
       else temp -= 0.5;
       return ( temp );
@@ -820,25 +889,19 @@ namespace gpstk
       s << endl;     
 
       s << endl << "Packed Bits, Left Justified, 32 Bits Long:\n";
-      int numBitInWord = 0;
+      int numBitInWord = bits_size % 32;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i + 32 <= bits_size; i += 32)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= 32)
-         {
-            s << "  0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
-            numBitInWord = 0;
-            word_count++;
+         word = getBits(i, 32);
+         s << "  0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
+         word_count++;
             //Print four words per line 
-            if (word_count %5 == 0) s << endl;        
-         }
+         if (word_count %5 == 0) s << endl;        
       }
-      word <<= 32 - numBitInWord;
+      if (numBitInWord > 0)
+         word = getBits(bits_size - numBitInWord, numBitInWord) << (32 - numBitInWord);
       if (numBitInWord > 0 ) s << "  0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       s.setf(ios::fixed, ios::floatfield);
       s.precision(3);
@@ -858,38 +921,30 @@ namespace gpstk
       s.setf(ios::uppercase); 
       int rollover = numPerLine;
       
-      int numBitInWord = 0;
-      int bit_count    = 0; 
+      int numBitInWord = bits_size % numBitsPerWord;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i + numBitsPerWord <= bits_size; i += numBitsPerWord)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= numBitsPerWord)
-         {
-            s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
-            word = 0;
-            numBitInWord = 0;
-            word_count++;
+         word = getBits(i, numBitsPerWord);
+         s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
+         word_count++;
             
             //Print "numPerLine" words per line,
             //but ONLY if there are more bits left to put on the next line.
-            if (word_count>0 && 
-                word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;        
-         }
+         if (word_count>0 && 
+             word_count % rollover == 0 &&
+             (i+numBitsPerWord) < bits_size) s << endl;        
       }
          // Need to check if there is a partial word in the buffer
-      word <<= 32 - numBitInWord;
+      if (numBitInWord > 0)
+         word = getBits(bits_size - numBitInWord, numBitInWord) << (32 - numBitInWord);
       if (numBitInWord>0)
       {
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size()); 
+      return(bits_size); 
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -942,19 +997,26 @@ namespace gpstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them. 
-      if (bits.size()!=right.bits.size()) return false; 
+      if (bits_size!=right.bits_size) return false; 
+      if (bits_size==0) return true;
 
       short startBit = startBitA;
       short endBit = endBitA; 
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
+
+         // Whole-object compares can skip straight to the words
+      if (startBit==0 && endBit==int(bits_size)-1)
+         return words==right.words;
 
-      for (int i=startBit;i<=endBit;i++)
+      for (int i=startBit;i<=endBit;i+=64)
       {
-         if (bits[i]!=right.bits[i])
+         int n = endBit - i + 1;
+         if (n > 64) n = 64;
+         if (getBits(i,n)!=right.getBits(i,n))
          {
             return false;
          }
@@ -346,6 +346,15 @@ namespace gpstk
           */
       bool operator<(const PackedNavBits& right) const; 
 
+         /**
+          * Return a hash of the packed bits (not the metadata).
+          * Objects for which matchBits(right) is true always have
+          * the same hash, so this may be used to bucket messages
+          * before a full comparison, e.g. when voting across
+          * sources.
+          */
+      std::size_t hashBits() const;
+
          /**
           *  Bitwise invert contents of this object.
           */
@@ -419,7 +428,11 @@ namespace gpstk
       NavID navID;             /**< Defines the navigation message tracked */ 
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, 64 bits per word, first bit in
+          * the most significant bit of words[0].  Bits past
+          * bits_size are always zero. */
+      std::vector<uint64_t> words;
+      size_t bits_size;        /**< Number of bits held in words */
       int bits_used;
       
       bool xMitCoerced;        /**< Used to indicate that the transmit
@@ -433,6 +446,21 @@ namespace gpstk
          /** Pack the bits */
       void addUint64_t( const uint64_t value, const int numBits );
 
+         /** Unpack up to 64 bits without checking the range */
+      uint64_t getBits( const size_t startBit, const int numBits ) const;
+
+         /** Overwrite up to 64 bits with the low bits of value */
+      void setBits( const size_t startBit, const int numBits,
+                    const uint64_t value );
+
+         /** Copy numBits bits from "from" starting at fromBit to
+          * this object starting at toBit */
+      void copyBitRange( const PackedNavBits& from, const size_t fromBit,
+                         const size_t toBit, const size_t numBits );
+
+         /** Change the number of bits held, zero filling new bits */
+      void resizeBits( const size_t numBits );
+
          /** Extend the sign bit for signed values */
       int64_t SignExtend( const int startBit, const int numBits ) const;
    
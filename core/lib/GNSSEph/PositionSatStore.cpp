@@ -94,95 +94,124 @@ namespace gpstk
       const throw(InvalidRequest)
    {
       try {
-         bool isExact;
-         int i;
-         PositionRecord rec;
-         DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
+         DataTableIterator it1, it2;            // cf. TabularSatStore.hpp
+         bool isExact(getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity));
+         return interpolateRecord(ttag, isExact, it1, it2);
+      }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
 
-         isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity);
-         if(isExact && haveVelocity) {
-            rec = it1->second;
-            return rec;
+   // Non-throwing form of getValue()
+   // @param[in] sat the SatID of the satellite of interest
+   // @param[in] ttag the time (CommonTime) of interest
+   // @param[out] rec the value, when true is returned
+   // @return true if the value was computed, false where getValue() would throw
+   bool PositionSatStore::computeValue(const SatID& sat, const CommonTime& ttag,
+                                       PositionRecord& rec) const
+   {
+      // CommonTime comparisons in the table search throw on a conflict
+      if(!compatibleTimeSystem(ttag.getTimeSystem()))
+         return false;
+
+      bool isExact;
+      DataTableIterator it1, it2;
+      if(findTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity, isExact)
+            != intervalFound)
+         return false;
+
+      rec = interpolateRecord(ttag, isExact, it1, it2);
+      return true;
+   }
+
+   // Interpolate the records (it1..it2) found by getTableInterval() to time ttag
+   PositionRecord PositionSatStore::interpolateRecord(const CommonTime& ttag, bool isExact,
+                                                      DataTableIterator it1,
+                                                      DataTableIterator it2) const
+   {
+      int i;
+      PositionRecord rec;
+      DataTableIterator kt;
+      if(isExact && haveVelocity) {
+         rec = it1->second;
+         return rec;
+      }
+
+      // pull data out of the data table
+      size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
+      CommonTime ttag0(it1->first);
+      vector<double> times,P[3],V[3],A[3],sigP[3],sigV[3],sigA[3];
+
+      kt = it1; n=0;
+      while(1) {
+         // find index matching ttag
+         if(isExact && ABS(kt->first - ttag) < 1.e-8)
+            Nmatch = n;
+         times.push_back(kt->first - ttag0);          // sec
+         for(i=0; i<3; i++) {
+            P[i].push_back(kt->second.Pos[i]);
+            V[i].push_back(kt->second.Vel[i]);
+            A[i].push_back(kt->second.Acc[i]);
+            sigP[i].push_back(kt->second.sigPos[i]);
+            sigV[i].push_back(kt->second.sigVel[i]);
+            sigA[i].push_back(kt->second.sigAcc[i]);
          }
+         if(kt == it2) break;
+         ++kt;
+         ++n;
+      };
 
-         // pull data out of the data table
-         size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
-         CommonTime ttag0(it1->first);
-         vector<double> times,P[3],V[3],A[3],sigP[3],sigV[3],sigA[3];
+      if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
 
-         kt = it1; n=0;
-         while(1) {
-            // find index matching ttag
-            if(isExact && ABS(kt->first - ttag) < 1.e-8)
-               Nmatch = n;
-            times.push_back(kt->first - ttag0);          // sec
-            for(i=0; i<3; i++) {
-               P[i].push_back(kt->second.Pos[i]);
-               V[i].push_back(kt->second.Vel[i]);
-               A[i].push_back(kt->second.Acc[i]);
-               sigP[i].push_back(kt->second.sigPos[i]);
-               sigV[i].push_back(kt->second.sigVel[i]);
-               sigA[i].push_back(kt->second.sigAcc[i]);
+      // Lagrange interpolation
+      rec.sigAcc = rec.Acc = Triple(0,0,0);        // default
+      double dt(ttag-ttag0), err;           // dt in seconds
+      if(haveVelocity) {
+         for(i=0; i<3; i++) {
+            // interpolate the positions
+            rec.Pos[i] = LagrangeInterpolation(times,P[i],dt,err);
+            if(haveAcceleration) {
+               // interpolate velocities and acclerations
+               rec.Vel[i] = LagrangeInterpolation(times,V[i],dt,err);
+               rec.Acc[i] = LagrangeInterpolation(times,A[i],dt,err);
+            }
+            else {
+               // interpolate velocities(dm/s) to get V and A
+               LagrangeInterpolation(times,V[i],dt,rec.Vel[i],rec.Acc[i]);
+               rec.Acc[i] *= 0.1;      // dm/s/s -> m/s/s
             }
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
-
-         // Lagrange interpolation
-         rec.sigAcc = rec.Acc = Triple(0,0,0);        // default
-         double dt(ttag-ttag0), err;           // dt in seconds
-         if(haveVelocity) {
-            for(i=0; i<3; i++) {
-               // interpolate the positions
-               rec.Pos[i] = LagrangeInterpolation(times,P[i],dt,err);
-               if(haveAcceleration) {
-                  // interpolate velocities and acclerations
-                  rec.Vel[i] = LagrangeInterpolation(times,V[i],dt,err);
-                  rec.Acc[i] = LagrangeInterpolation(times,A[i],dt,err);
-               }
-               else {
-                  // interpolate velocities(dm/s) to get V and A
-                  LagrangeInterpolation(times,V[i],dt,rec.Vel[i],rec.Acc[i]);
-                  rec.Acc[i] *= 0.1;      // dm/s/s -> m/s/s
-               }
-
-               if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
-                  rec.sigVel[i] = sigV[i][Nmatch];
-                  if(haveAcceleration) rec.sigAcc[i] = sigA[i][Nmatch];
-               }
-               else {
-                  // TD is this sigma related to 'err' in the Lagrange call?
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
-                  rec.sigVel[i] = RSS(sigV[i][Nhi],sigV[i][Nlow]);
-                  if(haveAcceleration)
-                     rec.sigAcc[i] = RSS(sigA[i][Nhi],sigA[i][Nlow]);
-               }
-               // else Acc=sig_Acc=0   // TD can we do better?
+            if(isExact) {
+               rec.sigPos[i] = sigP[i][Nmatch];
+               rec.sigVel[i] = sigV[i][Nmatch];
+               if(haveAcceleration) rec.sigAcc[i] = sigA[i][Nmatch];
+            }
+            else {
+               // TD is this sigma related to 'err' in the Lagrange call?
+               rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
+               rec.sigVel[i] = RSS(sigV[i][Nhi],sigV[i][Nlow]);
+               if(haveAcceleration)
+                  rec.sigAcc[i] = RSS(sigA[i][Nhi],sigA[i][Nlow]);
             }
+            // else Acc=sig_Acc=0   // TD can we do better?
          }
-         else {               // no V data - must interpolate position to get velocity
-            for(i=0; i<3; i++) {
-               // interpolate positions(km) to get P and V
-               LagrangeInterpolation(times,P[i],dt,rec.Pos[i],rec.Vel[i]);
-               rec.Vel[i] *= 10000.;         // km/sec -> dm/sec
-
-               if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
-               }
-               else {
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
-               }
-               // TD
-               rec.sigVel[i] = 0.0;
+      }
+      else {               // no V data - must interpolate position to get velocity
+         for(i=0; i<3; i++) {
+            // interpolate positions(km) to get P and V
+            LagrangeInterpolation(times,P[i],dt,rec.Pos[i],rec.Vel[i]);
+            rec.Vel[i] *= 10000.;         // km/sec -> dm/sec
+
+            if(isExact) {
+               rec.sigPos[i] = sigP[i][Nmatch];
             }
+            else {
+               rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
+            }
+            // TD
+            rec.sigVel[i] = 0.0;
          }
-         return rec;
       }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      return rec;
    }
 
    // Return the position for the given satellite at the given time
@@ -459,6 +488,67 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   namespace
+   {
+      void putTriple(SnapshotWriter& snap, const Triple& t)
+      {
+         snap.putDouble(t[0]);
+         snap.putDouble(t[1]);
+         snap.putDouble(t[2]);
+      }
+
+      void getTriple(SnapshotReader& snap, Triple& t)
+      {
+         t[0] = snap.getDouble();
+         t[1] = snap.getDouble();
+         t[2] = snap.getDouble();
+      }
+
+      void putPositionRecord(SnapshotWriter& snap, const PositionRecord& rec)
+      {
+         putTriple(snap, rec.Pos);
+         putTriple(snap, rec.sigPos);
+         putTriple(snap, rec.Vel);
+         putTriple(snap, rec.sigVel);
+         putTriple(snap, rec.Acc);
+         putTriple(snap, rec.sigAcc);
+      }
+
+      void getPositionRecord(SnapshotReader& snap, PositionRecord& rec)
+      {
+         getTriple(snap, rec.Pos);
+         getTriple(snap, rec.sigPos);
+         getTriple(snap, rec.Vel);
+         getTriple(snap, rec.sigVel);
+         getTriple(snap, rec.Acc);
+         getTriple(snap, rec.sigAcc);
+      }
+   }
+
+   // Write the contents of the store to a binary snapshot file.
+   void PositionSatStore::writeBinaryFile(const string& filename) const
+   {
+      try {
+         SnapshotWriter snap("PositionSatStore");
+         snap.putBool(haveAcceleration);
+         writeTableSnapshot(snap, putPositionRecord);
+         snap.write(filename);
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
+   // Replace the contents of the store with a binary snapshot file.
+   void PositionSatStore::readBinaryFile(const string& filename)
+   {
+      try {
+         SnapshotReader snap;
+         snap.open(filename, "PositionSatStore");
+         haveAcceleration = snap.getBool();
+         readTableSnapshot(snap, getPositionRecord);
+      }
+      catch(SnapshotException& e) { GPSTK_RETHROW(e); }
+   }
+
    //@}
 
 }  // End of namespace gpstk
@@ -117,6 +117,14 @@ namespace gpstk
          /// Store half the interpolation order, for convenience
       unsigned int Nhalf;
 
+         /** Interpolate the records (it1..it2) found by
+          * getTableInterval() or findTableInterval() to time ttag;
+          * shared by getValue() and computeValue().  If isExact, the
+          * interval contains ttag itself. */
+      PositionRecord interpolateRecord(const CommonTime& ttag, bool isExact,
+                                       DataTableIterator it1,
+                                       DataTableIterator it2) const;
+
          // member functions
    public:
 
@@ -153,6 +161,17 @@ namespace gpstk
       PositionRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** Non-throwing form of getValue(): a satellite or time that
+          * can not be interpolated is reported by returning false, so
+          * that callers expecting misses need not catch exceptions.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttag the time (CommonTime) of interest
+          * @param[out] rec the value, when true is returned
+          * @return true if the value was computed, false where
+          *   getValue() would have thrown. */
+      bool computeValue(const SatID& sat, const CommonTime& ttag,
+                        PositionRecord& rec) const;
+
          /** Return the position for the given satellite at the given time
           * @param[in] sat the SatID of the satellite of interest
           * @param[in] ttag the time (CommonTime) of interest
@@ -216,6 +235,21 @@ namespace gpstk
          os << "End dump of PositionSatStore.\n";
       }
 
+         /** Write the contents of the store to a binary snapshot
+          * file, which readBinaryFile() can reload without parsing.
+          * Interpolation and gap/interval settings are not saved.
+          * @param filename name of the file to write
+          * @throw SnapshotException if the file cannot be written */
+      void writeBinaryFile(const std::string& filename) const;
+
+         /** Replace the contents of the store with a snapshot
+          * written by writeBinaryFile().  The file is memory mapped
+          * and its checksums verified before anything is changed.
+          * @param filename name of the file to read
+          * @throw SnapshotException if the file is missing, corrupt,
+          *   or not a PositionSatStore snapshot */
+      void readBinaryFile(const std::string& filename);
+
          /** Add a complete PositionRecord to the store; this is the
           * preferred method of adding data to the tables.
           * @note If these addXXX() routines are used more than once
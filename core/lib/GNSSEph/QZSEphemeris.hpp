@@ -112,6 +112,12 @@ namespace gpstk
          adjustValidity();
       }
 
+         /// Append the data members to a binary snapshot.
+      virtual void writeSnapshot(SnapshotWriter& snap) const;
+
+         /// Restore the data members from a binary snapshot.
+      virtual void readSnapshot(SnapshotReader& snap);
+
          // member data
       CommonTime transmitTime;   ///< Time of transmission
       long HOWtime;              ///< Time (seconds-of-week) of handover word (txmit)
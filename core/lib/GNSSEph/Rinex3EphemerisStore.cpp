@@ -46,6 +46,7 @@
 #include "GalEphemeris.hpp"
 #include "BDSEphemeris.hpp"
 #include "QZSEphemeris.hpp"
+#include "ThreadPool.hpp"
 
 using namespace std;
 
@@ -183,6 +184,111 @@ namespace gpstk
 
    } // end Rinex3EphemerisStore::loadFile
 
+   // Read a navigation file into a staging area, without touching the store.
+   // status follows the loadFile() return codes.
+   void Rinex3EphemerisStore::stageNavFile(const string& filename,
+                                           StagedNavFile& staged)
+   {
+      staged.status = 0;
+      Rinex3NavStream strm;
+
+      strm.open(filename.c_str(), ios::in);
+      if(!strm.is_open()) {
+         staged.what = string("File ") + filename + string(" could not be opened.");
+         staged.status = -1;
+         return;
+      }
+      strm.exceptions(ios::failbit);
+
+      try { strm >> staged.head; }
+      catch(Exception& e) {
+         staged.what = string("Failed to read header of file ") + filename
+            + string(" : ") + e.getText();
+         staged.status = -2;
+         return;
+      }
+
+      Rinex3NavData rec;
+      while(1) {
+         try { strm >> rec; }
+         catch(Exception& e) {
+            staged.what = string("Failed to read data in file ") + filename
+               + string(" : ") + e.getText();
+            staged.status = -3;
+            return;
+         }
+         catch(std::exception& e) {
+            staged.what = string("std excep: ") + e.what();
+            staged.status = -3;
+            return;
+         }
+         catch(...) {
+            staged.what = string("Unknown exception while reading data of file ")
+               + filename;
+            staged.status = -3;
+            return;
+         }
+
+         if(!strm.good() || strm.eof()) break;
+
+         staged.data.push_back(rec);
+      }
+   }
+
+   // load several Rinex navigation files, parsing them concurrently and
+   // adding them to the store in the order given.
+   int Rinex3EphemerisStore::loadFiles(const vector<string>& filenames,
+                                       unsigned nThreads)
+   {
+      try {
+         int nread(0);
+         what = string();
+
+         // parse every file into its own staging area
+         vector<StagedNavFile> staged(filenames.size());
+         ThreadPool pool(nThreads);
+         pool.run(filenames.size(),
+                  [&](size_t i) { stageNavFile(filenames[i], staged[i]); });
+
+         // merge in file order, exactly as a sequence of loadFile() calls would
+         for(size_t i=0; i<staged.size(); i++) {
+            StagedNavFile& sf(staged[i]);
+            if(sf.status == -1 || sf.status == -2) {
+               what = sf.what;
+               return sf.status;
+            }
+
+            Rhead = sf.head;
+            NavFiles.addFile(filenames[i], Rhead);
+
+            if(Rhead.mapTimeCorr.size() > 0) {
+               map<string, TimeSystemCorrection>::const_iterator it;
+               for(it=Rhead.mapTimeCorr.begin(); it!=Rhead.mapTimeCorr.end(); ++it)
+                  addTimeCorr(it->second);
+            }
+
+            for(size_t j=0; j<sf.data.size(); j++) {
+               Rdata = sf.data[j];
+               nread++;
+               addEphemeris(Rdata);
+            }
+
+            // release the staged records as soon as they are in the store
+            vector<Rinex3NavData>().swap(sf.data);
+
+            if(sf.status < 0) {
+               what = sf.what;
+               return sf.status;
+            }
+         }
+
+         return nread;
+      }
+      catch(Exception& e) {
+         GPSTK_RETHROW(e);
+      }
+   } // end Rinex3EphemerisStore::loadFiles
+
    // Find the appropriate time system correction object in the collection for the
    // given time systems, and dump it to a string and return that string.
    string Rinex3EphemerisStore::dumpTimeSystemCorrection(
@@ -263,6 +369,11 @@ namespace gpstk
    {
       try {
          Xvt xvt;
+         if(computeXvt(sat, inttag, xvt))
+            return xvt;
+
+         // a miss; repeat the query through the throwing interface of the
+         // sub-store so that the exception explains the failure
          CommonTime ttag;
          TimeSystem ts;
 
@@ -297,6 +408,36 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   // Non-throwing form of getXvt().
+   // @param[in] sat the satellite of interest
+   // @param[in] inttag the time to look up
+   // @param[out] xvt the Xvt of the object at the indicated time
+   // @return true if the Xvt was computed, false where getXvt() would throw
+   bool Rinex3EphemerisStore::computeXvt(const SatID& sat,
+                                         const CommonTime& inttag,
+                                         Xvt& xvt) const
+   {
+      switch(sat.system) {
+         case SatID::systemGPS:
+            return ORBstore.computeXvt(sat,
+                        correctTimeSystem(inttag, TimeSystem::GPS), xvt);
+         case SatID::systemGalileo:
+            return ORBstore.computeXvt(sat,
+                        correctTimeSystem(inttag, TimeSystem::GAL), xvt);
+         case SatID::systemBeiDou:
+            return ORBstore.computeXvt(sat,
+                        correctTimeSystem(inttag, TimeSystem::BDT), xvt);
+         case SatID::systemQZSS:
+            return ORBstore.computeXvt(sat,
+                        correctTimeSystem(inttag, TimeSystem::QZS), xvt);
+         case SatID::systemGlonass:
+            return GLOstore.computeXvt(sat,
+                        correctTimeSystem(inttag, TimeSystem::GLO), xvt);
+         default:
+            return false;
+      }
+   }
+
    // Dump information about the store to an ostream.
    // @param[in] os ostream to receive the output; defaults to cout
    // @param[in] detail integer level of detail to provide; allowed values are
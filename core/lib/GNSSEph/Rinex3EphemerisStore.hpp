@@ -46,6 +46,7 @@
 #include <list>
 #include <map>
 #include <set>
+#include <vector>
 #include <algorithm>
 
 #include "Exception.hpp"
@@ -88,6 +89,20 @@ namespace gpstk
          /// Ephemeris store for Geosync nav messages (stored as GeoRecord)
          //GeoEphemerisStore GEOstore;
 
+         /// Contents of one navigation file staged by loadFiles()
+      struct StagedNavFile
+      {
+         int status;                      ///< loadFile()-style return code
+         std::string what;                ///< error text when status < 0
+         Rinex3NavHeader head;            ///< the file header
+         std::vector<Rinex3NavData> data; ///< records, in file order
+      };
+
+         /** Read a navigation file into staged without touching the
+          * store; safe to call concurrently for different files. */
+      static void stageNavFile(const std::string& filename,
+                               StagedNavFile& staged);
+
    public:
 
          /// Rinex file header last read by loadFile()
@@ -130,6 +145,16 @@ namespace gpstk
           *    information as to why the request failed. */
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag) const;
 
+         /** Non-throwing form of getXvt(); the query is passed to the
+          * computeXvt() of the OrbitEph or GLONASS store.
+          * @param[in] sat the satellite of interest
+          * @param[in] ttag the time to look up
+          * @param[out] xvt the Xvt of the object, when true is returned
+          * @return true if the Xvt was computed, false where getXvt()
+          *    would have thrown. */
+      virtual bool computeXvt(const SatID& sat, const CommonTime& ttag,
+                              Xvt& xvt) const;
+
          /** Dump information about the store to an ostream.
           * @param[in] os ostream to receive the output; defaults to std::cout
           * @param[in] detail integer level of detail to provide;
@@ -244,6 +269,27 @@ namespace gpstk
       int loadFile(const std::string& filename, bool dump=false,
                    std::ostream& s=std::cout);
 
+         /** load several RINEX navigation files, parsing them
+          * concurrently.  Each file is read into its own staging area
+          * on a pool of threads; the staged files are then added to
+          * the store one at a time in the order given, exactly as a
+          * sequence of loadFile() calls would add them, so time
+          * system corrections, duplicate rejection and the resulting
+          * store contents do not depend on the number of threads.
+          * Loading stops at the first file that fails, after adding
+          * the records read from it before the failure, as loadFile()
+          * does; the failing file's name and error are left in what.
+          * @param filenames names of the RINEX navigation files to read
+          * @param nThreads number of threads to use, 0 (the default)
+          *   for one per hardware thread
+          * @return -1 failed to open a file,
+          *         -2 failed to read a header (this->Rhead),
+          *         -3 failed to read data,
+          *        >=0 total number of nav records read
+          * @throw some other problem */
+      int loadFiles(const std::vector<std::string>& filenames,
+                    unsigned nThreads=0);
+
          /** use to access the data records in the store in bulk Add
           * all Rinex3NavData in this store to the given list. If sat
           * is defined, (its default is (-1,mixed)), then add only
@@ -82,6 +82,7 @@ namespace gpstk
    {
       char buff[4];
 
+      std::lock_guard<std::mutex> lock(registryMutex());
       buff[0] = ot2char[type];
       buff[1] = cb2char[band];
       buff[2] = tc2char[code];
@@ -58,6 +58,7 @@
 #include "Rinex3ClockData.hpp"
 
 #include "FileStore.hpp"
+#include "ThreadPool.hpp"
 #include "ClockSatStore.hpp"
 #include "PositionSatStore.hpp"
 
@@ -88,27 +89,49 @@ namespace gpstk
       try { crec = clkStore.getValue(sat,ttag); }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
 
-      try {
-         Xvt retXvt;
-         for(int i=0; i<3; i++) {
-            retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
-            retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
-         }
-         if(useSP3clock) {                            // SP3
-            retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
-            retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
-         }
-         else {                                       // RINEX clock
-            retXvt.clkbias = crec.bias;               // sec
-            retXvt.clkdrift = crec.drift;             // sec/sec
-         }
+      return makeXvt(prec, crec);
+   }
 
-            // compute relativity correction, in seconds
-         retXvt.computeRelativityCorrection();
+      // Non-throwing form of getXvt().
+      // param[in] sat the satellite of interest
+      // param[in] ttag the time to look up
+      // param[out] xvt the Xvt of the object, when true is returned
+      // return true if the Xvt was computed, false where getXvt() would throw
+   bool SP3EphemerisStore::computeXvt(const SatID& sat, const CommonTime& ttag,
+                                      Xvt& xvt) const
+   {
+      PositionRecord prec;
+      ClockRecord crec;
+      if(!posStore.computeValue(sat,ttag,prec) ||
+         !clkStore.computeValue(sat,ttag,crec))
+         return false;
 
-         return retXvt;
+      xvt = makeXvt(prec, crec);
+      return true;
+   }
+
+      // Build the Xvt from interpolated position and clock records.
+   Xvt SP3EphemerisStore::makeXvt(const PositionRecord& prec,
+                                  const ClockRecord& crec) const
+   {
+      Xvt retXvt;
+      for(int i=0; i<3; i++) {
+         retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
+         retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
       }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      if(useSP3clock) {                            // SP3
+         retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
+         retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
+      }
+      else {                                       // RINEX clock
+         retXvt.clkbias = crec.bias;               // sec
+         retXvt.clkdrift = crec.drift;             // sec/sec
+      }
+
+         // compute relativity correction, in seconds
+      retXvt.computeRelativityCorrection();
+
+      return retXvt;
    }
 
       // Determine the earliest time for which this object can successfully 
@@ -231,38 +254,109 @@ namespace gpstk
    }
 
 
-      // This is a private utility routine used by the loadFile and loadSP3File routines.
+
       // Store position (velocity) and clock data from SP3 files in clock and position
       // stores. Also update the FileStore with the filename and SP3 header.
    void SP3EphemerisStore::loadSP3Store(const string& filename, bool fillClockStore)
       throw(Exception)
    {
+      try
+      {
+         StagedFile staged;
+         stageSP3File(filename, staged);
+         mergeSP3File(filename, staged, fillClockStore);
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
+
+
+      // Read an SP3 file into staged, without touching the store. Errors are
+      // recorded in staged rather than thrown, so this may run on any thread.
+   void SP3EphemerisStore::stageSP3File(const string& filename, StagedFile& staged)
+   {
+      staged.isSP3 = true;
+      staged.failure = StagedFile::failNone;
       try
       {
             // open the input stream
          SP3Stream strm(filename.c_str());
          if (!strm)
          {
-            Exception e("File " + filename + " could not be opened");
-            GPSTK_THROW(e);
+            staged.error = Exception("File " + filename + " could not be opened");
+            staged.failure = StagedFile::failHeader;
+            return;
          }
          strm.exceptions(ios::failbit);
-            //cout << "Opened file " << filename << endl;
-
-            // declare header and data
-         SP3Header head;
 
             // read the SP3 ephemeris header
          try
          {
-            strm >> head;
+            strm >> staged.sp3Head;
          }
          catch(Exception& e)
          {
             e.addText("Error reading header of file " + filename + e.getText());
-            GPSTK_RETHROW(e);
+            staged.error = e;
+            staged.failure = StagedFile::failHeader;
+            return;
+         }
+
+            // read data
+         try
+         {
+            SP3Data data;
+            while(strm >> data)
+            {
+               if (strm.eof())
+                  break;
+               staged.sp3Data.push_back(data);
+            }
+         }
+         catch(Exception& e)
+         {
+            e.addText("Error reading data of file " + filename);
+            staged.error = e;
+            staged.failure = StagedFile::failData;
          }
-            //cout << "Read header" << endl; head.dump();
+
+         strm.close();
+      }
+      catch (std::exception& e)
+      {
+         staged.error = Exception("std::exception " + std::string(e.what()));
+         if(staged.failure == StagedFile::failNone)
+            staged.failure = StagedFile::failData;
+      }
+      catch (...)
+      {
+         staged.error = Exception("Unknown exception");
+         if(staged.failure == StagedFile::failNone)
+            staged.failure = StagedFile::failData;
+      }
+   }
+
+
+      // Add the contents of a staged SP3 file to the clock and position stores,
+      // and the filename and SP3 header to the FileStore. Check time system
+      // consistency, and if possible set the store time system. A staged read
+      // error is thrown after the records read before it have been stored.
+   void SP3EphemerisStore::mergeSP3File(const string& filename, StagedFile& staged,
+                                        bool fillClockStore)
+      throw(Exception)
+   {
+      try
+      {
+         if(staged.failure == StagedFile::failHeader)
+         {
+            Exception e(staged.error);
+            GPSTK_THROW(e);
+         }
+
+         SP3Header& head(staged.sp3Head);
+
 
             // check/save TimeSystem to storeTimeSystem
          if(head.timeSystem != TimeSystem::Any &&
@@ -297,7 +391,6 @@ namespace gpstk
          int i;
          CommonTime ttag;
          SatID sat;
-         SP3Data data;
          PositionRecord prec;
          ClockRecord crec;
 
@@ -314,19 +407,15 @@ namespace gpstk
             haveP = haveV = haveEP = haveEV = predP = predC = false;
             goNext = true;
 
-            while(strm >> data)
+            for(size_t n=0; n<staged.sp3Data.size(); n++)
             {
-                  //cout << "Read data " << data.RecType
-                  //<< " at " << printTime(data.time,"%Y %m %d %H %M %S") << endl;
+               const SP3Data& data(staged.sp3Data[n]);
 
                   // The SP3 doc says that records will be in order....
                   // use while to loop twice, if necessary: as soon as a RecType is
                   // repeated, the current records are output, then the loop
                   // returns to start filling the records again.
-                  //strm.dumpState();
-               if (strm.eof())
-                  break;
-               
+
                while(1)
                {
                   if(data.RecType == '*')
@@ -489,9 +578,11 @@ namespace gpstk
                   goNext = true;
 
                }  // end while loop (loop twice)
-            }  // end read loop
+            }  // end data loop
 
-            if(haveP || haveV)
+               // a read error ends the data without flushing the last record
+            if(staged.failure == StagedFile::failNone &&
+               (haveP || haveV))
             {
                if(rejectBadPosFlag &&
                   (prec.Pos[0]==0.0 ||
@@ -522,26 +613,35 @@ namespace gpstk
             GPSTK_RETHROW(e);
          }
 
-            // close
-         strm.close();
-
+         if(staged.failure != StagedFile::failNone)
+         {
+            Exception e(staged.error);
+            GPSTK_THROW(e);
+         }
       }
       catch (Exception& e)
       {
          GPSTK_RETHROW(e);
       }
-      catch (std::exception& e)
-      {
-         gpstk::Exception exc("std::exception " + std::string(e.what()));
-         GPSTK_THROW(exc);
-      }
-      catch (...)
+   }
+
+
+      // Decide whether a file is SP3 (true) or, by elimination, RINEX clock.
+   bool SP3EphemerisStore::isSP3File(const string& filename)
+   {
+      SP3Stream strm(filename.c_str(),std::ios::in);
+      if (strm)
       {
-         gpstk::Exception exc("Unknown exception");
-         GPSTK_THROW(exc);
+            // read the header
+         SP3Header header;
+         strm >> header;
       }
+      bool isSP3 = static_cast<bool>(strm);
+      strm.close();
+      return isSP3;
    }
 
+
       // Load an SP3 ephemeris file; if the clock store uses RINEX clock files,
       // this routine will also accept that file type and load the data into the
       // clock store. This routine will may set the velocity, acceleration, bias
@@ -557,25 +657,9 @@ namespace gpstk
             return;
          }
 
-            // must determine what kind of file it is
-         bool isSP3 = true;
-
-            // decide if the file is SP3
-         SP3Stream strm(filename.c_str(),std::ios::in);
-         if (strm)
-         {
-               // read the header
-            SP3Header header;
-            strm >> header;
-         }
-         if (!strm)
-         {
-            isSP3 = false;
-         }
-         strm.close();
-
+            // must determine what kind of file it is;
             // call the appropriate load routine
-         if(isSP3)
+         if(isSP3File(filename))
          {
             loadSP3File(filename);
          }
@@ -612,33 +696,93 @@ namespace gpstk
    {
       try
       {
-         if(useSP3clock) useRinexClockData();
+         StagedFile staged;
+         stageRinexClockFile(filename, staged);
+         mergeRinexClockFile(filename, staged);
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
 
+
+      // Read a RINEX clock file into staged, without touching the store. Errors
+      // are recorded in staged rather than thrown, so this may run on any thread.
+   void SP3EphemerisStore::stageRinexClockFile(const std::string& filename,
+                                               StagedFile& staged)
+   {
+      staged.isSP3 = false;
+      staged.failure = StagedFile::failNone;
+      try
+      {
             // open the input stream
          Rinex3ClockStream strm(filename.c_str());
          if(!strm.is_open())
          {
-            Exception e("File " + filename + " could not be opened");
-            GPSTK_THROW(e);
+            staged.error = Exception("File " + filename + " could not be opened");
+            staged.failure = StagedFile::failHeader;
+            return;
          }
          strm.exceptions(std::ios::failbit);
-            //cout << "Opened file " << filename << endl;
-
-            // declare header and data
-         Rinex3ClockHeader head;
-         Rinex3ClockData data;
 
             // read the RINEX clock header
          try
          {
-            strm >> head;
+            strm >> staged.clkHead;
          }
          catch(Exception& e)
          {
             e.addText("Error reading header of file " + filename);
-            GPSTK_RETHROW(e);
+            staged.error = e;
+            staged.failure = StagedFile::failHeader;
+            return;
+         }
+
+            // read data
+         try
+         {
+            Rinex3ClockData data;
+            while(strm >> data)
+               staged.clkData.push_back(data);
+         }
+         catch(Exception& e)
+         {
+            e.addText("Error reading data of file " + filename);
+            staged.error = e;
+            staged.failure = StagedFile::failData;
+         }
+
+         strm.close();
+      }
+      catch (std::exception& e)
+      {
+         staged.error = Exception("std::exception " + std::string(e.what()));
+         if(staged.failure == StagedFile::failNone)
+            staged.failure = StagedFile::failData;
+      }
+   }
+
+
+      // Add the contents of a staged RINEX clock file to the clock store, and
+      // the filename and header to the FileStore. A staged read error is
+      // thrown after the records read before it have been stored.
+   void SP3EphemerisStore::mergeRinexClockFile(const std::string& filename,
+                                               StagedFile& staged)
+      throw(Exception)
+   {
+      try
+      {
+         if(useSP3clock) useRinexClockData();
+
+         if(staged.failure == StagedFile::failHeader)
+         {
+            Exception e(staged.error);
+            GPSTK_THROW(e);
          }
-            //cout << "Read header" << endl; head.dump();
+
+         Rinex3ClockHeader& head(staged.clkHead);
+
 
             // check/save TimeSystem to storeTimeSystem
          if(head.timeSystem != TimeSystem::Any &&
@@ -677,12 +821,12 @@ namespace gpstk
             // save in FileStore
          clkFiles.addFile(filename, head);
 
-            // read data
+            // add data
          try
          {
-            while(strm >> data)
+            for(size_t n=0; n<staged.clkData.size(); n++)
             {
-                  //data.dump(cout);
+               Rinex3ClockData& data(staged.clkData[n]);
 
                if(data.datatype == std::string("AS"))
                {
@@ -702,8 +846,54 @@ namespace gpstk
             GPSTK_RETHROW(e);
          }
 
-         strm.close();
+         if(staged.failure != StagedFile::failNone)
+         {
+            Exception e(staged.error);
+            GPSTK_THROW(e);
+         }
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
 
+
+      // Load several SP3 and/or RINEX clock files, reading them concurrently
+      // and merging them into the store in the order given.
+   void SP3EphemerisStore::loadFiles(const std::vector<std::string>& filenames,
+                                     unsigned nThreads)
+      throw(Exception)
+   {
+      try
+      {
+            // useSP3clock cannot change during the merge: only merging a
+            // RINEX clock file changes it, and those are only recognized
+            // when it is already false.
+         const bool sp3Only(useSP3clock);
+
+            // read every file into its own staging area
+         std::vector<StagedFile> staged(filenames.size());
+         ThreadPool pool(nThreads);
+         pool.run(filenames.size(), [&](size_t i)
+         {
+            if(sp3Only || isSP3File(filenames[i]))
+               stageSP3File(filenames[i], staged[i]);
+            else
+               stageRinexClockFile(filenames[i], staged[i]);
+         });
+
+            // merge in file order, exactly as a sequence of loadFile() calls would
+         for(size_t i=0; i<staged.size(); i++)
+         {
+            if(staged[i].isSP3)
+               mergeSP3File(filenames[i], staged[i], useSP3clock);
+            else
+               mergeRinexClockFile(filenames[i], staged[i]);
+
+               // release the staged records as soon as they are in the store
+            staged[i] = StagedFile();
+         }
       }
       catch(Exception& e)
       {
@@ -711,6 +901,7 @@ namespace gpstk
       }
    }
 
+
       //@}
 
 }  // End of namespace gpstk
@@ -60,7 +60,9 @@
 #include "PositionSatStore.hpp"
 
 #include "SP3Header.hpp"
+#include "SP3Data.hpp"
 #include "Rinex3ClockHeader.hpp"
+#include "Rinex3ClockData.hpp"
 
 namespace gpstk
 {
@@ -132,6 +134,61 @@ namespace gpstk
       void loadSP3Store(const std::string& filename, bool fillClockStore)
          throw(Exception);
 
+         /** The contents of one SP3 or RINEX clock file, read by
+          * stageSP3File() or stageRinexClockFile() but not yet added
+          * to the store. */
+      struct StagedFile
+      {
+            /// Where reading the file stopped early, if it did
+         enum Failure
+         {
+            failNone,   ///< the whole file was read
+            failHeader, ///< the file could not be opened, or header read
+            failData    ///< a data record could not be read
+         };
+
+         StagedFile() : isSP3(true), failure(failNone), error("") {}
+
+         bool isSP3;                             ///< SP3 (true) or RINEX clock
+         Failure failure;                        ///< how reading ended
+         Exception error;                        ///< the error, if failure
+         SP3Header sp3Head;                      ///< header, if isSP3
+         std::vector<SP3Data> sp3Data;           ///< records, if isSP3
+         Rinex3ClockHeader clkHead;              ///< header, if !isSP3
+         std::vector<Rinex3ClockData> clkData;   ///< records, if !isSP3
+      };
+
+         /** Read an SP3 file into staged without touching the store.
+          * Errors are recorded in staged rather than thrown; safe to
+          * call concurrently for different files. */
+      static void stageSP3File(const std::string& filename, StagedFile& staged);
+
+         /** Read a RINEX clock file into staged without touching the
+          * store.  Errors are recorded in staged rather than thrown;
+          * safe to call concurrently for different files. */
+      static void stageRinexClockFile(const std::string& filename,
+                                      StagedFile& staged);
+
+         /** Add an SP3 file read by stageSP3File() to the stores,
+          * exactly as loadSP3Store() would, and throw any error
+          * recorded while reading it. */
+      void mergeSP3File(const std::string& filename, StagedFile& staged,
+                        bool fillClockStore)
+         throw(Exception);
+
+         /** Add a RINEX clock file read by stageRinexClockFile() to
+          * the clock store, exactly as loadRinexClockFile() would,
+          * and throw any error recorded while reading it. */
+      void mergeRinexClockFile(const std::string& filename, StagedFile& staged)
+         throw(Exception);
+
+         /// Return true if the file can be opened and has an SP3 header.
+      static bool isSP3File(const std::string& filename);
+
+         /** Build the Xvt returned by getXvt() and computeXvt() from
+          * the interpolated position and clock records. */
+      Xvt makeXvt(const PositionRecord& prec, const ClockRecord& crec) const;
+
    public:
 
          /// Default constructor
@@ -160,6 +217,17 @@ namespace gpstk
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** Non-throwing form of getXvt(); both the position and the
+          * clock are interpolated with computeValue(), so a missing
+          * satellite or an epoch outside the tables costs no exception.
+          * @param[in] sat the satellite of interest
+          * @param[in] ttag the time to look up
+          * @param[out] xvt the Xvt of the object, when true is returned
+          * @return true if the Xvt was computed, false where getXvt()
+          *    would have thrown. */
+      virtual bool computeXvt(const SatID& sat, const CommonTime& ttag,
+                              Xvt& xvt) const;
+
          /** Dump information about the store to an ostream.
           * @param[in] os ostream to receive the output; defaults to std::cout
           * @param[in] detail integer level of detail to provide;
@@ -571,6 +639,26 @@ namespace gpstk
           * @throw if time step is inconsistent with previous value */
       void loadRinexClockFile(const std::string& filename) throw(Exception);
 
+         /** Load several SP3 and/or RINEX clock files, as loadFile()
+          * would, reading them concurrently.  Each file is read into
+          * its own staging area on a pool of threads; the staged files
+          * are then added to the store one at a time in the order
+          * given, so the store contents (including the handling of
+          * overlapping and duplicate records, and time system checks)
+          * are the same as calling loadFile() for each file in turn,
+          * whatever the number of threads.  As with a sequence of
+          * loadFile() calls, the first error is thrown after the files
+          * before it, and the records read before the error, have been
+          * added.
+          * @param filenames names of files (SP3 or RINEX clock format)
+          * @param nThreads number of threads to use, 0 (the default)
+          *   for one per hardware thread
+          * @throw if a file cannot be read, or time systems are
+          *   inconsistent */
+      void loadFiles(const std::vector<std::string>& filenames,
+                     unsigned nThreads=0)
+         throw(Exception);
+
 
          /** Add a complete PositionRecord to the store; this is the
           * preferred method of adding data to the tables.
@@ -0,0 +1,181 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SharedXvtStore.hpp
+ * Publish an XvtStore to many reader threads while another thread keeps
+ * adding data to it. */
+
+#ifndef GPSTK_SHAREDXVTSTORE_HPP
+#define GPSTK_SHAREDXVTSTORE_HPP
+
+#include <memory>
+#include <mutex>
+
+#include "XvtStore.hpp"
+#include "SatID.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GNSSEph
+      //@{
+
+      /** An XvtStore<SatID> that forwards every query to the latest
+       * published copy of a store of type StoreType (for example
+       * GPSEphemerisStore or Rinex3EphemerisStore), so that the data
+       * can be extended by one thread while any number of threads
+       * compute positions from it.
+       *
+       * A published store is never modified. update() copies the
+       * current store, changes the copy, and then publishes it with a
+       * single atomic pointer swap; readers that already hold the old
+       * copy keep using it, and it is deleted when the last of them
+       * lets it go. Readers therefore never wait for the writer, nor
+       * for each other, and always see a complete store.
+       *
+       * Each call through the XvtStore interface looks up the current
+       * copy. A thread making many queries, e.g. for all the
+       * satellites of an epoch, should instead take a snapshot() once
+       * and query it directly, which needs no synchronization at all
+       * and gives answers that are consistent with each other.
+       *
+       * Since each update copies the whole store, data should be added
+       * in batches (a file, or a nav message cycle) rather than one
+       * ephemeris at a time. StoreType must be copy constructible.
+       *
+       * @code
+       * SharedXvtStore<GPSEphemerisStore> shared;
+       *    // loader thread
+       * shared.update([&](GPSEphemerisStore& store)
+       *               { store.addEphemeris(eph); store.freeze(); });
+       *    // worker threads
+       * SharedXvtStore<GPSEphemerisStore>::Snapshot eph(shared.snapshot());
+       * Xvt xvt(eph->getXvt(sat, t));
+       * @endcode */
+   template <class StoreType>
+   class SharedXvtStore : public XvtStore<SatID>
+   {
+   public:
+         /// An immutable copy of the store, kept alive while held.
+      typedef std::shared_ptr<const StoreType> Snapshot;
+
+         /// Start with an empty store.
+      SharedXvtStore()
+            : current(std::make_shared<StoreType>())
+      { onlyHealthy = false; }
+
+         /// Start with a copy of the given store.
+      explicit SharedXvtStore(const StoreType& store)
+            : current(std::make_shared<StoreType>(store))
+      { onlyHealthy = false; }
+
+         /// Return the current store; the caller may query it freely.
+      Snapshot snapshot() const
+      { return std::atomic_load(&current); }
+
+         /** Change the store: modify(StoreType&) is called with a copy
+          * of the current store, which then replaces it. Writers are
+          * serialized with each other, but readers are not blocked.
+          * If modify throws, the current store is left unchanged. */
+      template <class Function>
+      void update(Function modify)
+      {
+         std::lock_guard<std::mutex> lock(writeMutex);
+         std::shared_ptr<StoreType> next(
+            std::make_shared<StoreType>(*snapshot()));
+         modify(*next);
+         std::atomic_store(&current, Snapshot(next));
+      }
+
+         /** Replace the store with one built elsewhere, e.g. by loading
+          * a whole new set of files, without copying it. The caller
+          * must not modify the store after publishing it. */
+      void publish(const std::shared_ptr<StoreType>& store)
+      {
+         std::lock_guard<std::mutex> lock(writeMutex);
+         std::atomic_store(&current, Snapshot(store));
+      }
+
+         // XvtStore interface; queries use the current store
+
+      virtual Xvt getXvt(const SatID& id, const CommonTime& t) const
+      { return snapshot()->getXvt(id, t); }
+
+      virtual bool computeXvt(const SatID& id, const CommonTime& t,
+                              Xvt& xvt) const
+      { return snapshot()->computeXvt(id, t, xvt); }
+
+      virtual void dump(std::ostream& s = std::cout, short detail = 0) const
+      { snapshot()->dump(s, detail); }
+
+      virtual void edit(const CommonTime& tmin,
+                        const CommonTime& tmax = CommonTime::END_OF_TIME)
+      { update([&](StoreType& store) { store.edit(tmin, tmax); }); }
+
+      virtual void clear(void)
+      { update([](StoreType& store) { store.clear(); }); }
+
+      virtual TimeSystem getTimeSystem(void) const
+      { return snapshot()->getTimeSystem(); }
+
+      virtual CommonTime getInitialTime(void) const
+      { return snapshot()->getInitialTime(); }
+
+      virtual CommonTime getFinalTime(void) const
+      { return snapshot()->getFinalTime(); }
+
+      virtual bool hasVelocity(void) const
+      { return snapshot()->hasVelocity(); }
+
+      virtual bool isPresent(const SatID& id) const
+      { return snapshot()->isPresent(id); }
+
+      virtual std::set<SatID> getIndexSet() const
+      { return snapshot()->getIndexSet(); }
+
+   private:
+         /// The published store; only accessed with std::atomic_load/store
+      Snapshot current;
+
+         /// Serializes update() and publish()
+      std::mutex writeMutex;
+
+   }; // end class SharedXvtStore
+
+      //@}
+
+} // namespace
+
+#endif // GPSTK_SHAREDXVTSTORE_HPP
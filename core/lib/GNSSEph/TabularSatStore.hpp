@@ -49,6 +49,8 @@
 #include "Exception.hpp"
 #include "SatID.hpp"
 #include "CommonTime.hpp"
+#include "EpochTable.hpp"
+#include "SnapshotFile.hpp"
 #include "TimeString.hpp"
 #include "Xvt.hpp"
 #include "CivilTime.hpp"
@@ -65,6 +67,13 @@ namespace gpstk
        * satellite,time.  The getValue(sat, t) routine interpolates
        * the table for sat at time t and returns the result as a
        * DataRecord object.
+       *
+       * Each satellite's table is an EpochTable, a sorted contiguous
+       * array that is searched in constant time when the data are
+       * evenly spaced (as SP3 and clock data nearly always are) and
+       * by binary search otherwise.  It behaves like
+       * std::map<CommonTime, DataRecord> but its iterators are
+       * random-access.
        * @note this is an abstract class b/c getValue() and others are
        *   pure virtual.
        * @note this class (dump()) requires that
@@ -77,8 +86,8 @@ namespace gpstk
          // compile these were originally in the protected block.
    public:
          // the data tables
-         /// std::map with key=CommonTime, value=DataRecord
-      typedef std::map<CommonTime, DataRecord> DataTable;
+         /// time-sorted table with key=CommonTime, value=DataRecord
+      typedef EpochTable<DataRecord> DataTable;
 
          /// std::map with key=SatID, value=DataTable
       typedef std::map<SatID, DataTable> SatTable;
@@ -87,7 +96,7 @@ namespace gpstk
    protected:
 
          /** the data tables:
-          * std::map<SatID, std::map<CommonTime, DataRecord> > */
+          * std::map<SatID, EpochTable<DataRecord> > */
       SatTable tables;
 
          /** Time system of tables; default and initial value is
@@ -128,6 +137,71 @@ namespace gpstk
 
       typedef typename DataTable::const_iterator DataTableIterator;
 
+         /** Append the time system, the data-present flags and every
+          * data table to a binary snapshot, for use by the
+          * writeBinaryFile() of derived classes.  Each table is
+          * written as the SatID, the number of records, then each
+          * (time, record) pair in time order.
+          * @param snap the snapshot being built
+          * @param putRecord function that appends one DataRecord */
+      void writeTableSnapshot(SnapshotWriter& snap,
+                              void (*putRecord)(SnapshotWriter&,
+                                                const DataRecord&)) const
+      {
+         snap.putInt(static_cast<int>(storeTimeSystem.getTimeSystem()));
+         snap.putBool(havePosition);
+         snap.putBool(haveVelocity);
+         snap.putBool(haveClockBias);
+         snap.putBool(haveClockDrift);
+         snap.putInt(tables.size());
+         typename SatTable::const_iterator satit;
+         for(satit = tables.begin(); satit != tables.end(); ++satit) {
+            snap.putSatID(satit->first);
+            snap.putInt(satit->second.size());
+            DataTableIterator it;
+            for(it = satit->second.begin(); it != satit->second.end(); ++it) {
+               snap.putTime(it->first);
+               putRecord(snap, it->second);
+            }
+         }
+      }
+
+         /** Replace the contents of the store with data written by
+          * writeTableSnapshot().  Records are appended in time order,
+          * so the tables are rebuilt without searching.  The gap and
+          * interval checking settings are left as they are.
+          * @param snap the open snapshot, positioned at the table data
+          * @param getRecord function that reads one DataRecord
+          * @throw SnapshotException if the snapshot is truncated */
+      void readTableSnapshot(SnapshotReader& snap,
+                             void (*getRecord)(SnapshotReader&, DataRecord&))
+      {
+         clear();
+         storeTimeSystem = TimeSystem(static_cast<int>(snap.getInt()));
+         havePosition = snap.getBool();
+         haveVelocity = snap.getBool();
+         haveClockBias = snap.getBool();
+         haveClockDrift = snap.getBool();
+         int64_t nsat = snap.getInt();
+         for(int64_t i = 0; i < nsat; i++) {
+            SatID sat = snap.getSatID();
+            int64_t n = snap.getInt();
+            if(n < 0) {
+               SnapshotException e("Bad table size in snapshot "
+                                   + snap.getFilename());
+               GPSTK_THROW(e);
+            }
+            DataTable& table(tables[sat]);
+            table.reserve(n);
+            DataRecord rec;
+            for(int64_t j = 0; j < n; j++) {
+               CommonTime ttag = snap.getTime();
+               getRecord(snap, rec);
+               table[ttag] = rec;
+            }
+         }
+      }
+
          // member functions
    public:
          /// Default constructor
@@ -182,7 +256,7 @@ namespace gpstk
           * parameter exactReturn is true) or (it1+nhalf-1) or
           * (it1+nhalf) (if exactReturn is false).  This routine is
           * used to select data from the table for interpolation; note
-          * that DataTable is a map<CommonTime,DataRecord>.
+          * that DataTable is an EpochTable<DataRecord>.
           * @param[in] sat satellite of interest
           * @param[in] ttag time of interest, e.g. where interpolation
           *   will be conducted
@@ -215,160 +289,188 @@ namespace gpstk
                                     bool exactReturn=true)
          const throw(InvalidRequest)
       {
-         try
-         {
-            static const char *fmt=
-               " at time %F/%.3g %4Y/%02m/%02d %2H:%02M:%.3f %P";
-
-               // find the DataTable for this sat
-            typename std::map<SatID, DataTable>::const_iterator satit;
-            satit = tables.find(sat);
-            if(satit == tables.end())
-            {
-               InvalidRequest
-                  e("Satellite " + gpstk::StringUtils::asString(sat) +
-                    " not found.");
-               GPSTK_THROW(e);
-            }
-
-               // this is the data table for the sat
-            const DataTable& dtable(satit->second);
+         static const char *fmt=
+            " at time %F/%.3g %4Y/%02m/%02d %2H:%02M:%.3f %P";
 
-               // cannot interpolate with one point
-            if(dtable.size() < 2)
-            {
-               InvalidRequest e("Inadequate data (size < 2) for satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
-            }
-
-               // find the timetag in this table
-
-               /** @note throw here if time systems do not match and
-                * are not "Any" */
-            it1 = dtable.find(ttag);
-               // is it an exact match?
-            bool exactMatch(it1 != dtable.end());
-
-               // user must decide whether to return with exact value;
-               // e.g. without velocity data, user needs the interval
-               // to compute v from x data
-            if(exactMatch && exactReturn)
-               return true;
+         bool exactMatch;
+         IntervalStatus status(findTableInterval(sat, ttag, nhalf, it1, it2,
+                                                 exactReturn, exactMatch));
+         if(status == intervalFound)
+            return exactMatch;
 
-               // lower_bound points to the first element with key >= ttag
-            it1 = it2 = dtable.lower_bound(ttag);
-            if (it1 == dtable.end())
-            {
-               InvalidRequest e("No data in time range for satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
-            }
+            // only a failed search pays for building the message
+         std::string msg;
+         switch(status)
+         {
+            case intervalNoSatellite:
+               msg = "Satellite " + gpstk::StringUtils::asString(sat) +
+                  " not found.";
+               break;
+            case intervalTooFewData:
+               msg = "Inadequate data (size < 2) for satellite " +
+                  gpstk::StringUtils::asString(sat) + printTime(ttag,fmt);
+               break;
+            case intervalNoData:
+               msg = "No data in time range for satellite " +
+                  gpstk::StringUtils::asString(sat) + printTime(ttag,fmt);
+               break;
+            case intervalBefore1:
+            case intervalBefore2:
+            case intervalBefore3:
+               msg = "Inadequate data before(" +
+                  gpstk::StringUtils::asString(
+                     1 + int(status) - int(intervalBefore1)) +
+                  ") requested time for satellite " +
+                  gpstk::StringUtils::asString(sat) + printTime(ttag,fmt);
+               break;
+            case intervalAfter:
+               msg = "Inadequate data after(2) requested time for"
+                  " satellite " + gpstk::StringUtils::asString(sat) +
+                  printTime(ttag,fmt);
+               break;
+            case intervalGap:
+               msg = "Gap at interpolation time for satellite " +
+                  gpstk::StringUtils::asString(sat) + printTime(ttag,fmt);
+               break;
+            default:
+               msg = "Interpolation interval too large for satellite " +
+                  gpstk::StringUtils::asString(sat) + printTime(ttag,fmt);
+               break;
+         }
+         InvalidRequest e(msg);
+         GPSTK_THROW(e);
+      }
 
-               // ttag is <= first time in table
-            if(it1 == dtable.begin())
+         /** Outcome of findTableInterval(); anything but intervalFound
+          * is a reason getTableInterval() would throw. */
+      enum IntervalStatus
+      {
+         intervalFound,       ///< it1 and it2 are valid
+         intervalNoSatellite, ///< the satellite is not in the tables
+         intervalTooFewData,  ///< fewer than 2 records for the satellite
+         intervalNoData,      ///< ttag is after the last record
+         intervalBefore1,     ///< ttag is at or before the first record
+         intervalBefore2,     ///< too few records before ttag
+         intervalBefore3,     ///< too few records before ttag for nhalf
+         intervalAfter,       ///< too few records after ttag for nhalf
+         intervalGap,         ///< data gap at ttag (checkDataGap)
+         intervalTooLarge     ///< interval wider than maxInterval
+      };
+
+         /** Non-throwing form of getTableInterval(), for callers that
+          * treat a miss as a branch; the search is the same, but
+          * failures are reported through the return value.
+          * @param[in] sat satellite of interest
+          * @param[in] ttag time of interest
+          * @param[in] nhalf number of table points desired on each
+          *   side of ttag
+          * @param[out] it1 points to the interval begin
+          * @param[out] it2 points to the interval end
+          * @param[in] exactReturn as for getTableInterval()
+          * @param[out] exactMatch the value getTableInterval() would
+          *   return; valid only when intervalFound is returned
+          * @return intervalFound on success, else the reason for
+          *   failure */
+      IntervalStatus findTableInterval(const SatID& sat,
+                                       const CommonTime& ttag,
+                                       const int& nhalf,
+                                       typename DataTable::const_iterator& it1,
+                                       typename DataTable::const_iterator& it2,
+                                       bool exactReturn,
+                                       bool& exactMatch) const
+      {
+            // find the DataTable for this sat
+         typename std::map<SatID, DataTable>::const_iterator satit;
+         satit = tables.find(sat);
+         if(satit == tables.end())
+            return intervalNoSatellite;
+
+            // this is the data table for the sat
+         const DataTable& dtable(satit->second);
+
+            // cannot interpolate with one point
+         if(dtable.size() < 2)
+            return intervalTooFewData;
+
+            // find the timetag in this table
+
+            /** @note throw here if time systems do not match and
+             * are not "Any" */
+            // lower_bound points to the first element with key >= ttag
+         it1 = it2 = dtable.lower_bound(ttag);
+            // is it an exact match?
+         exactMatch = (it1 != dtable.end() && !(ttag < it1->first));
+
+            // user must decide whether to return with exact value;
+            // e.g. without velocity data, user needs the interval
+            // to compute v from x data
+         if(exactMatch && exactReturn)
+            return intervalFound;
+
+         if (it1 == dtable.end())
+            return intervalNoData;
+
+            // ttag is <= first time in table
+         if(it1 == dtable.begin())
+         {
+               // at table begin but its an exact match && an
+               // interval of only 2
+            if(exactMatch && nhalf==1)
             {
-                  // at table begin but its an exact match && an
-                  // interval of only 2
-               if(exactMatch && nhalf==1)
-               {
-                  ++(it2 = it1);
-                  return exactMatch;
-               }
-               InvalidRequest e("Inadequate data before(1) requested time for"
-                                " satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
+               ++(it2 = it1);
+               return intervalFound;
             }
+            return intervalBefore1;
+         }
 
-               // move it1 down by one
-            if(--it1 == dtable.begin())
+            // move it1 down by one
+         if(--it1 == dtable.begin())
+         {
+               // if an interval of only 2
+            if(nhalf==1)
             {
-                  // if an interval of only 2
-               if(nhalf==1)
-               {
-                  ++(it2 = it1);
-                  return exactMatch;
-               }
-               InvalidRequest e("Inadequate data before(2) requested time for"
-                                " satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
+               ++(it2 = it1);
+               return intervalFound;
             }
+            return intervalBefore2;
+         }
 
-               //LOG(INFO) << "OK, have interval " << printTime(it1->first,"%F/%g") <<
-               //" <= " <<printTime(ttag,"%F/%g")<< " < " <<printTime(it2->first,"%F/%g");
+            // now have it1->first <= ttag < it2->first and it2 ==
+            // it1+1 check for gap between these two table entries
+            // surrounding ttag
+         if(checkDataGap && (it2->first-it1->first) > gapInterval)
+            return intervalGap;
 
-               // now have it1->first <= ttag < it2->first and it2 ==
-               // it1+1 check for gap between these two table entries
-               // surrounding ttag
-            if(checkDataGap && (it2->first-it1->first) > gapInterval)
-            {
-               InvalidRequest e("Gap at interpolation time for satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
-            }
+            // now expand the interval to include 2*nhalf timesteps
+         for(int k=0; k<nhalf-1; k++)
+         {
+            bool last(k==nhalf-2); // true only on the last iteration
+               // move left by one; if require full interval && out
+               // of room on left, fail
+            if(--it1 == dtable.begin() && !last)
+               return intervalBefore3;
 
-               // now expand the interval to include 2*nhalf timesteps
-            for(int k=0; k<nhalf-1; k++)
+            if(++it2 == dtable.end())
             {
-               bool last(k==nhalf-2); // true only on the last iteration
-                  // move left by one; if require full interval && out
-                  // of room on left, fail
-               if(--it1 == dtable.begin() && !last)
-               {
-                  InvalidRequest
-                     e("Inadequate data before(3) requested time for"
-                       " satellite " + gpstk::StringUtils::asString(sat) +
-                       printTime(ttag,fmt));
-                  GPSTK_THROW(e);
-               }
-                  //LOG(INFO) << k << " expand left " << printTime(it1->first,"%F/%g");
-
-               if(++it2 == dtable.end())
+               if(exactMatch && last && it1 != dtable.begin())
                {
-                  if(exactMatch && last && it1 != dtable.begin())
-                  {
-                        // exact match && at end of interval && with
-                        // room to move down
+                     // exact match && at end of interval && with
+                     // room to move down
 
-                        // move interval down by one
-                     it2--;
-                     it1--;
-                  }
-                  else
-                  {
-                     InvalidRequest
-                        e("Inadequate data after(2) requested time for"
-                          " satellite " + gpstk::StringUtils::asString(sat) +
-                          printTime(ttag,fmt));
-                     GPSTK_THROW(e);
-                  }
+                     // move interval down by one
+                  it2--;
+                  it1--;
                }
-                  //LOG(INFO) << k << " expand right " << printTime(it2->first,"%F/%g");
+               else
+                  return intervalAfter;
             }
+         }
 
-               // check that the interval is not too large
-            if(checkInterval && (it2->first - it1->first) > maxInterval)
-            {
-               InvalidRequest e("Interpolation interval too large for"
-                                " satellite " +
-                                gpstk::StringUtils::asString(sat) +
-                                printTime(ttag,fmt));
-               GPSTK_THROW(e);
-            }
+            // check that the interval is not too large
+         if(checkInterval && (it2->first - it1->first) > maxInterval)
+            return intervalTooLarge;
 
-            return exactMatch;
-         }
-         catch(InvalidRequest& ir)
-         {
-            GPSTK_RETHROW(ir);
-         }
+         return intervalFound;
       }
 
          /** Version of getTableInterval() which does not require the
@@ -441,9 +543,10 @@ namespace gpstk
                // find the timetag in this table
                /** @note throw here if time systems do not match and
                 * are not "Any" */
-            it1 = dtable.find(ttag);
+               // lower_bound points to the first element with key >= ttag
+            it1 = it2 = dtable.lower_bound(ttag);
                // is it an exact match?
-            bool exactMatch(it1 != dtable.end());
+            bool exactMatch(it1 != dtable.end() && !(ttag < it1->first));
 
                // user must decide whether to return with exact value;
                // e.g. without velocity data, user needs the interval
@@ -451,9 +554,6 @@ namespace gpstk
             if(exactMatch && exactReturn)
                return true;
 
-               // lower_bound points to the first element with key >= ttag
-            it1 = it2 = dtable.lower_bound(ttag);
-
                // Should we allow to predict data?
             if(it1 == dtable.end())
             {
@@ -688,14 +788,22 @@ namespace gpstk
       virtual bool isPresent(const SatID& sat) const throw()
       { return (tables.find(sat) != tables.end()); }
 
+         /** Return false if the input TimeSystem conflicts with the
+          * stored TimeSystem; the non-throwing form of checkTimeSystem().
+          * @param[in] ts TimeSystem to compare with stored TimeSystem */
+      bool compatibleTimeSystem(const TimeSystem& ts) const throw()
+      {
+         return (ts == TimeSystem::Any || storeTimeSystem == TimeSystem::Any
+                 || ts == storeTimeSystem);
+      }
+
          /** Determine if the input TimeSystem conflicts with the
           * stored TimeSystem.
           * @param[in] ts TimeSystem to compare with stored TimeSystem
           * @throw InvalidRequest if time systems are inconsistent */
       void checkTimeSystem(const TimeSystem& ts) const throw(InvalidRequest)
       {
-         if(ts != TimeSystem::Any && storeTimeSystem != TimeSystem::Any
-            && ts != storeTimeSystem)
+         if(!compatibleTimeSystem(ts))
          {
             InvalidRequest ir("Conflicting time systems: " +
                               ts.asString() + " - " +
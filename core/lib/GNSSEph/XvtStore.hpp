@@ -58,6 +58,13 @@ namespace gpstk
       /// Abstract base class for storing and accessing an object's position, 
       /// velocity, and clock data. Also defines a simple interface to remove
       /// data that had been added.
+      ///
+      /// Concurrency: the const members of the stores in this library
+      /// (getXvt() and the other queries) may be called by any number of
+      /// threads at once, provided no thread modifies the store meanwhile;
+      /// stores that cache results internally, such as GloEphemerisStore,
+      /// guard the cache themselves. To add data while other threads are
+      /// reading, wrap the store in a SharedXvtStore.
    template <class IndexType>
    class XvtStore
    {
@@ -75,6 +82,31 @@ namespace gpstk
          ///    information as to why the request failed.
       virtual Xvt getXvt(const IndexType& id, const CommonTime& t) const = 0;
 
+         /// Non-throwing form of getXvt(), for callers that expect misses
+         /// (e.g. satellites absent from the store) and want to handle
+         /// them as a branch rather than an exception.  Stores that can
+         /// detect a miss cheaply override this and build getXvt() on
+         /// top of it; the default simply wraps getXvt().
+         /// @param[in] id the object's identifier
+         /// @param[in] t the time to look up
+         /// @param[out] xvt the Xvt of the object at time t; unchanged
+         ///    when false is returned
+         /// @return true if the Xvt was computed, false if getXvt() would
+         ///    have thrown InvalidRequest
+      virtual bool computeXvt(const IndexType& id, const CommonTime& t,
+                              Xvt& xvt) const
+      {
+         try
+         {
+            xvt = getXvt(id, t);
+            return true;
+         }
+         catch(InvalidRequest&)
+         {
+            return false;
+         }
+      }
+
          /// A debugging function that outputs in human readable form,
          /// all data stored in this object.
          /// @param[in] s the stream to receive the output; defaults to cout
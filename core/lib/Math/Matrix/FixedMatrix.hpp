@@ -0,0 +1,283 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/**
+ * @file FixedMatrix.hpp
+ * Matrix with its dimensions fixed at compile time
+ */
+
+#ifndef GPSTK_FIXED_MATRIX_HPP
+#define GPSTK_FIXED_MATRIX_HPP
+
+#include "Matrix.hpp"
+#include "FixedVector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A matrix of R rows and C columns of type T, where R and C are known
+       * at compile time. The elements are stored by rows in the object
+       * itself, so FixedMatrix never allocates; it is meant for the small
+       * matrices of geometry, such as 3x3 rotations and 4x4 normal
+       * equations, where Matrix<T> spends more time in new and delete than
+       * in arithmetic.
+       *
+       * FixedMatrix is a RefMatrixBase, so the functions and operators
+       * written for ConstMatrixBase (inverse(), inverseSVD(), det(),
+       * operator<<, etc.) accept it, returning Matrix<T>, and a Matrix<T>
+       * may be constructed from it. The products, sums and transpose of
+       * FixedMatrix and FixedVector below return FixedMatrix or
+       * FixedVector; their loops have constant bounds.
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix : public RefMatrixBase<T, FixedMatrix<T, R, C> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type, in row major order
+      typedef T* iterator;
+         /// STL const iterator type, in row major order
+      typedef const T* const_iterator;
+
+         /// the number of rows, as a compile-time constant
+      static const size_t numRows = R;
+         /// the number of columns, as a compile-time constant
+      static const size_t numCols = C;
+
+         /// Default constructor; like Matrix(rows,cols), the elements are
+         /// not initialized.
+      FixedMatrix() {}
+
+         /// Constructor with a value for all elements.
+      explicit FixedMatrix(const T initialValue)
+      { for(size_t i=0; i<R*C; i++) v[i] = initialValue; }
+
+         /// Constructor from an array of R*C elements in row major order.
+      explicit FixedMatrix(const T* array)
+      { for(size_t i=0; i<R*C; i++) v[i] = array[i]; }
+
+         /// Copy constructor from a ConstMatrixBase type, which must be RxC.
+      template <class BaseClass>
+      FixedMatrix(const ConstMatrixBase<T, BaseClass>& mat)
+         throw(MatrixException)
+      {
+         if(mat.rows() != R || mat.cols() != C) {
+            MatrixException e("Invalid dimensions for FixedMatrix(ConstMatrixBase)");
+            GPSTK_THROW(e);
+         }
+         for(size_t i=0; i<R; i++)
+            for(size_t j=0; j<C; j++)
+               v[i*C+j] = mat(i,j);
+      }
+
+         /// Copy from a ConstMatrixBase type, which must be RxC.
+      template <class BaseClass>
+      FixedMatrix& operator=(const ConstMatrixBase<T, BaseClass>& mat)
+         throw(MatrixException)
+      {
+         if(mat.rows() != R || mat.cols() != C) {
+            MatrixException e("Invalid dimensions for FixedMatrix=ConstMatrixBase");
+            GPSTK_THROW(e);
+         }
+         for(size_t i=0; i<R; i++)
+            for(size_t j=0; j<C; j++)
+               v[i*C+j] = mat(i,j);
+         return *this;
+      }
+         /// Assign t to all elements.
+      FixedMatrix& operator=(const T t)
+      { for(size_t i=0; i<R*C; i++) v[i] = t; return *this; }
+
+         /// The identity matrix.
+      static FixedMatrix identity()
+      {
+         FixedMatrix I(T(0));
+         for(size_t i=0; i<R && i<C; i++) I.v[i*C+i] = T(1);
+         return I;
+      }
+
+         /// STL begin
+      iterator begin() { return v; }
+         /// STL const begin
+      const_iterator begin() const { return v; }
+         /// STL end
+      iterator end() { return v + R*C; }
+         /// STL const end
+      const_iterator end() const { return v + R*C; }
+         /// STL empty
+      bool empty() const { return R*C == 0; }
+         /// STL size
+      size_t size() const { return R*C; }
+
+         /// The number of rows in the matrix
+      size_t rows() const { return R; }
+         /// The number of columns in the matrix
+      size_t cols() const { return C; }
+
+         /// Non-const matrix operator(row,col)
+      T& operator() (size_t rowNum, size_t colNum)
+      { return v[rowNum*C + colNum]; }
+         /// Const matrix operator(row,col)
+      T operator() (size_t rowNum, size_t colNum) const
+      { return v[rowNum*C + colNum]; }
+
+         /// the elements in row major order, for C style functions
+      T *data() { return v; }
+         /// the elements in row major order, for C style functions
+      const T *data() const { return v; }
+
+   private:
+         /// the elements, by rows
+      T v[R*C == 0 ? 1 : R*C];
+   };
+
+      /// FixedMatrix * FixedMatrix
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K>& l,
+                                         const FixedMatrix<T, K, C>& r)
+   {
+      FixedMatrix<T, R, C> toReturn(T(0));
+      for(size_t i=0; i<R; i++)
+         for(size_t k=0; k<K; k++) {
+            const T lik(l(i,k));
+            for(size_t j=0; j<C; j++)
+               toReturn(i,j) += lik * r(k,j);
+         }
+      return toReturn;
+   }
+
+      /// FixedMatrix * FixedVector
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T, R> operator*(const FixedMatrix<T, R, C>& m,
+                                      const FixedVector<T, C>& v)
+   {
+      FixedVector<T, R> toReturn;
+      for(size_t i=0; i<R; i++) {
+         T sum(0);
+         for(size_t j=0; j<C; j++) sum += m(i,j) * v[j];
+         toReturn[i] = sum;
+      }
+      return toReturn;
+   }
+
+      /// FixedVector * FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T, C> operator*(const FixedVector<T, R>& v,
+                                      const FixedMatrix<T, R, C>& m)
+   {
+      FixedVector<T, C> toReturn(T(0));
+      for(size_t i=0; i<R; i++)
+         for(size_t j=0; j<C; j++)
+            toReturn[j] += v[i] * m(i,j);
+      return toReturn;
+   }
+
+      /// sum of two FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator+(const FixedMatrix<T, R, C>& l,
+                                         const FixedMatrix<T, R, C>& r)
+   {
+      FixedMatrix<T, R, C> toReturn;
+      for(size_t i=0; i<R*C; i++) toReturn.data()[i] = l.data()[i] + r.data()[i];
+      return toReturn;
+   }
+
+      /// difference of two FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator-(const FixedMatrix<T, R, C>& l,
+                                         const FixedMatrix<T, R, C>& r)
+   {
+      FixedMatrix<T, R, C> toReturn;
+      for(size_t i=0; i<R*C; i++) toReturn.data()[i] = l.data()[i] - r.data()[i];
+      return toReturn;
+   }
+
+      /// FixedMatrix times a scalar
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, C>& m,
+                                         const T d)
+   {
+      FixedMatrix<T, R, C> toReturn;
+      for(size_t i=0; i<R*C; i++) toReturn.data()[i] = m.data()[i] * d;
+      return toReturn;
+   }
+
+      /// scalar times a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator*(const T d,
+                                         const FixedMatrix<T, R, C>& m)
+   { return m * d; }
+
+      /// transpose of a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& m)
+   {
+      FixedMatrix<T, C, R> toReturn;
+      for(size_t i=0; i<R; i++)
+         for(size_t j=0; j<C; j++)
+            toReturn(j,i) = m(i,j);
+      return toReturn;
+   }
+
+      /**
+       * Inverse of a symmetric positive definite FixedMatrix, e.g. a
+       * normal matrix, using the Cholesky decomposition of invertSPD().
+       * @throw SingularMatrixException if m is not positive definite.
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T, N, N> inverseSPD(const FixedMatrix<T, N, N>& m)
+      throw(SingularMatrixException)
+   {
+      FixedMatrix<T, N, N> toReturn(m), L;
+      if(!invertSPD(toReturn.data(), L.data(), N)) {
+         SingularMatrixException e("Non-positive definite matrix in inverseSPD");
+         GPSTK_THROW(e);
+      }
+      return toReturn;
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif //GPSTK_FIXED_MATRIX_HPP
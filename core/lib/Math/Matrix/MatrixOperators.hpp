@@ -796,6 +796,56 @@ namespace gpstk
 
    }  // end inverseChol
 
+      /**
+       * Inverts in place the n x n symmetric positive definite matrix
+       * stored by rows at A, using the Cholesky decomposition; L is n*n
+       * scratch. This works on raw storage so that callers with fixed or
+       * reused buffers do not allocate, cf. inverseChol().
+       * @return false, with A undefined, if A is not numerically
+       * positive definite.
+       */
+   template <class T>
+   inline bool invertSPD(T *A, T *L, const size_t n)
+      throw()
+   {
+      size_t i, j, k;
+      T sum;
+
+         // A = L*transpose(L), L lower triangular
+      for(j=0; j<n; j++) {
+         sum = A[j*n+j];
+         for(k=0; k<j; k++) sum -= L[j*n+k]*L[j*n+k];
+         if(sum <= T(1.e-14)*A[j*n+j]) return false;
+         L[j*n+j] = SQRT(sum);
+         for(i=j+1; i<n; i++) {
+            sum = A[i*n+j];
+            for(k=0; k<j; k++) sum -= L[i*n+k]*L[j*n+k];
+            L[i*n+j] = sum/L[j*n+j];
+         }
+      }
+
+         // invert L in place (lower triangle)
+      for(j=0; j<n; j++) {
+         L[j*n+j] = T(1)/L[j*n+j];
+         for(i=j+1; i<n; i++) {
+            sum = T(0);
+            for(k=j; k<i; k++) sum -= L[i*n+k]*L[k*n+j];
+            L[i*n+j] = sum/L[i*n+i];
+         }
+      }
+
+         // inverse(A) = transpose(inverse(L))*inverse(L)
+      for(i=0; i<n; i++)
+         for(j=0; j<=i; j++) {
+            sum = T(0);
+            for(k=i; k<n; k++) sum += L[k*n+i]*L[k*n+j];
+            A[i*n+j] = A[j*n+i] = sum;
+         }
+
+      return true;
+
+   }  // end invertSPD
+
 
       /**
        *  Matrix * Matrix : row by column multiplication of two matricies.
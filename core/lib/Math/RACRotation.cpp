@@ -48,13 +48,13 @@ namespace gpstk
 
 RACRotation::RACRotation( const gpstk::Triple& SVPositionVector,
                           const gpstk::Triple& SVVelocityVector)
-                          : gpstk::Matrix<double>(3,3)
+                          : gpstk::FixedMatrix<double,3,3>()
 {
    compute( SVPositionVector, SVVelocityVector );
 }
 
 RACRotation::RACRotation(const gpstk::Xvt& xvt)
-                         : gpstk::Matrix<double>(3,3)
+                         : gpstk::FixedMatrix<double,3,3>()
 {
    compute( xvt.x, xvt.v );
 }
@@ -96,42 +96,19 @@ void RACRotation::compute( const gpstk::Triple& SVPositionVector,
 
 gpstk::Vector<double> RACRotation::convertToRAC( const gpstk::Vector<double>& inV )
 {
-   gpstk::Vector<double> outV(3);
-
-   /*
-      My goal was to use the following statement.
-   outV =  this * inV;
-      However, for some reason, gcc refuses to recognize RACRotation as a
-      Matrix subclass.  Therefore, I've incorporated the matrix multiply
-      as a temporary kludge.
-   */
    if (inV.size()!=3)
    {
       gpstk::Exception e("Incompatible dimensions for Vector");
       GPSTK_THROW(e);
    }
-   size_t i, j;
-   for (i = 0; i < 3; i++)
-   {
-      outV[i] = 0;
-      for (j = 0; j < 3; j++)
-      {
-         double temp =  (*this)(i,j) * inV[j];
-         outV[i] += temp;
-      }
-   }
-   /* end kludge */
-   return(outV);
+   gpstk::FixedVector<double,3> v( inV[0], inV[1], inV[2] );
+   return( gpstk::Vector<double>( (*this) * v ) );
 }
 
 gpstk::Triple RACRotation::convertToRAC( const gpstk::Triple& inVec )
 {
-   gpstk::Vector<double> v(3);
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-
-   gpstk::Vector<double> vOut = convertToRAC( v );
+   gpstk::FixedVector<double,3> v( inVec[0], inVec[1], inVec[2] );
+   gpstk::FixedVector<double,3> vOut = (*this) * v;
    gpstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
    return(outVec);
 }
@@ -41,7 +41,7 @@
 
 // gpstk
 #include "Triple.hpp"
-#include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 #include "Vector.hpp"
 #include "Xvt.hpp"
 
@@ -50,7 +50,9 @@ namespace gpstk
       /// @ingroup MathGroup
       //@{
 
-   class RACRotation : public gpstk::Matrix<double>
+      /// Rotation from ECEF XYZ to the Radial, Along-track, Cross-track
+      /// frame of a satellite; a 3x3 FixedMatrix, so it does not allocate.
+   class RACRotation : public gpstk::FixedMatrix<double,3,3>
    {
       public:
             // Constructors
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/**
+ * @file FixedVector.hpp
+ * Vector with its dimension fixed at compile time
+ */
+
+#ifndef GPSTK_FIXED_VECTOR_HPP
+#define GPSTK_FIXED_VECTOR_HPP
+
+#include "Vector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements of type T, where N is known at compile
+       * time. The elements are stored in the object itself, so that
+       * constructing, copying and returning a FixedVector never allocates,
+       * and loops over the elements have constant bounds the compiler can
+       * unroll and vectorize. Use it for the many small fixed-size vectors
+       * in geometry, e.g. FixedVector<double,3> for a position.
+       *
+       * FixedVector is a RefVectorBase, so all the operators and functions
+       * written for ConstVectorBase (dot(), norm(), operator<<, and the
+       * assignment operators of RefVectorBase) accept it, and a Vector<T>
+       * may be constructed from it. The arithmetic operators below are
+       * overloaded to return a FixedVector; those not overloaded here
+       * return a Vector<T>, as for any other ConstVectorBase.
+       */
+   template <class T, size_t N>
+   class FixedVector : public RefVectorBase<T, FixedVector<T, N> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// the dimension, as a compile-time constant
+      static const size_t dimension = N;
+
+         /// Default constructor; like Vector(size_t), the elements are not
+         /// initialized.
+      FixedVector() {}
+
+         /// Constructor with a value for all elements.
+      explicit FixedVector(const T defaultValue)
+      { for(size_t i=0; i<N; i++) v[i] = defaultValue; }
+
+         /// Constructor for a 3-vector.
+      FixedVector(const T x, const T y, const T z)
+      {
+         static_assert(N == 3, "FixedVector(x,y,z) requires N == 3");
+         v[0] = x; v[1] = y; v[2] = z;
+      }
+
+         /// Copy constructor from a ConstVectorBase type, which must have
+         /// size N.
+      template <class E>
+      FixedVector(const ConstVectorBase<T, E>& r)
+         throw(VectorException)
+      {
+         if(r.size() != N) {
+            VectorException e("Invalid size for FixedVector(ConstVectorBase)");
+            GPSTK_THROW(e);
+         }
+         for(size_t i=0; i<N; i++) v[i] = r[i];
+      }
+
+         /// Copy from a ConstVectorBase type, which must have size N.
+      template <class E>
+      FixedVector& operator=(const ConstVectorBase<T, E>& r)
+         throw(VectorException)
+      {
+         if(r.size() != N) {
+            VectorException e("Invalid size for FixedVector=ConstVectorBase");
+            GPSTK_THROW(e);
+         }
+         for(size_t i=0; i<N; i++) v[i] = r[i];
+         return *this;
+      }
+         /// Assign x to all elements.
+      FixedVector& operator=(const T x)
+      { for(size_t i=0; i<N; i++) v[i] = x; return *this; }
+
+         /// STL iterator begin
+      iterator begin() { return v; }
+         /// STL const iterator begin
+      const_iterator begin() const { return v; }
+         /// STL iterator end
+      iterator end() { return v + N; }
+         /// STL const iterator end
+      const_iterator end() const { return v + N; }
+         /// STL empty
+      bool empty() const { return N == 0; }
+         /// STL size
+      size_t size() const { return N; }
+
+         /// Non-const operator []
+      T& operator[] (size_t i)
+      { return v[i]; }
+         /// Const operator []
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Non-const operator ()
+      T& operator() (size_t i)
+      { return v[i]; }
+         /// Const operator ()
+      T operator() (size_t i) const
+      { return v[i]; }
+
+         /// the elements, for passing to C style functions
+      T *data() { return v; }
+         /// the elements, for passing to C style functions
+      const T *data() const { return v; }
+
+   private:
+         /// the elements
+      T v[N == 0 ? 1 : N];
+   };
+
+      /// sum of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator+(const FixedVector<T, N>& l,
+                                      const FixedVector<T, N>& r)
+   {
+      FixedVector<T, N> toReturn;
+      for(size_t i=0; i<N; i++) toReturn[i] = l[i] + r[i];
+      return toReturn;
+   }
+
+      /// difference of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator-(const FixedVector<T, N>& l,
+                                      const FixedVector<T, N>& r)
+   {
+      FixedVector<T, N> toReturn;
+      for(size_t i=0; i<N; i++) toReturn[i] = l[i] - r[i];
+      return toReturn;
+   }
+
+      /// element by element product of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator*(const FixedVector<T, N>& l,
+                                      const FixedVector<T, N>& r)
+   {
+      FixedVector<T, N> toReturn;
+      for(size_t i=0; i<N; i++) toReturn[i] = l[i] * r[i];
+      return toReturn;
+   }
+
+      /// FixedVector times a scalar
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator*(const FixedVector<T, N>& l, const T r)
+   {
+      FixedVector<T, N> toReturn;
+      for(size_t i=0; i<N; i++) toReturn[i] = l[i] * r;
+      return toReturn;
+   }
+
+      /// scalar times a FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator*(const T l, const FixedVector<T, N>& r)
+   { return r * l; }
+
+      /// FixedVector divided by a scalar
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator/(const FixedVector<T, N>& l, const T r)
+   {
+      FixedVector<T, N> toReturn;
+      for(size_t i=0; i<N; i++) toReturn[i] = l[i] / r;
+      return toReturn;
+   }
+
+      /// dot product of two FixedVectors; the sum is accumulated in order,
+      /// as in dot(ConstVectorBase,ConstVectorBase).
+   template <class T, size_t N>
+   inline T dot(const FixedVector<T, N>& l, const FixedVector<T, N>& r)
+   {
+      T sum(0);
+      for(size_t i=0; i<N; i++) sum += l[i] * r[i];
+      return sum;
+   }
+
+      /// cross product of two 3-vectors
+   template <class T>
+   inline FixedVector<T, 3> cross(const FixedVector<T, 3>& l,
+                                  const FixedVector<T, 3>& r)
+   {
+      return FixedVector<T, 3>(l[1] * r[2] - l[2] * r[1],
+                               l[2] * r[0] - l[0] * r[2],
+                               l[0] * r[1] - l[1] * r[0]);
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif //GPSTK_FIXED_VECTOR_HPP
@@ -39,6 +39,7 @@
 #include "ord.hpp"
 #include "GPSEllipsoid.hpp"
 #include "GNSSconstants.hpp"
+#include "FixedVector.hpp"
 
 using std::vector;
 using std::cout;
@@ -69,10 +70,12 @@ Xvt rotateEarth(const Position& Rx, const Xvt& svPosVel,
     return revisedXvt;
 }
 
-double IonosphereFreeRange(const std::vector<double>& frequencies,
-        const std::vector<double>& pseudoranges) {
+// Check that the frequencies and pseudoranges are suitable for the
+// ionosphere-free combination, and return gamma = (f1/f2)^2.
+static double ionosphereFreeGamma(const std::vector<double>& frequencies,
+        size_t numRanges) {
     // Check vectors are same length
-    if (frequencies.size() != pseudoranges.size()) {
+    if (frequencies.size() != numRanges) {
         gpstk::Exception exc(
             "Mismatch between frequency and pseudorange array size");
         GPSTK_THROW(exc)
@@ -94,8 +97,14 @@ double IonosphereFreeRange(const std::vector<double>& frequencies,
 
     // TODO(someone): Add proper gamma calculation for arbitrary
     //                number of frequencies.
-    const double gamma = (frequencies[0]/frequencies[1]) *
-                         (frequencies[0]/frequencies[1]);
+    return (frequencies[0]/frequencies[1]) *
+           (frequencies[0]/frequencies[1]);
+}
+
+double IonosphereFreeRange(const std::vector<double>& frequencies,
+        const std::vector<double>& pseudoranges) {
+    const double gamma = ionosphereFreeGamma(frequencies,
+                                             pseudoranges.size());
 
     // for dual frequency see IS-GPS-200, section 20.3.3.3.3.3
     double icpr = (pseudoranges[1] - gamma * pseudoranges[0])/(1-gamma);
@@ -274,5 +283,258 @@ double TroposphereCorrection(const gpstk::TropModel& tropModel,
     return trop;
 }
 
+// Receiver terms of Position::elevation() and Position::azimuth(),
+// computed once for all the satellites seen at an epoch. The satellite
+// terms are then evaluated exactly as those methods do, so the angles are
+// identical to the ones used by calculate_ord().
+class ReceiverGeometry {
+ public:
+    explicit ReceiverGeometry(const Position& rxLoc) {
+        Position trx(rxLoc);
+        trx.transformTo(Position::Cartesian);
+        for (int i = 0; i < 3; i++)
+            R[i] = trx[i];
+        ry = gpstk::dot(R, R);
+
+        xy = R[0]*R[0] + R[1]*R[1];
+        xyz = xy + R[2]*R[2];
+        xy = ::sqrt(xy);
+        xyz = ::sqrt(xyz);
+        if (xy > 1e-14 && xyz > 1e-14) {
+            cosl = R[0]/xy;
+            sinl = R[1]/xy;
+            sint = R[2]/xyz;
+        }
+    }
+
+    // Elevation and azimuth (degrees) of the satellite at svPos.
+    void angles(const Triple& svPos, double& elevation,
+                double& azimuth) const {
+        FixedVector<double, 3> z;
+        for (int i = 0; i < 3; i++)
+            z[i] = svPos[i] - R[i];
+
+        double rx(gpstk::dot(z, z));
+        if (rx <= 1e-14 || ry <= 1e-14) {
+            GeometryException ge("Divide by Zero Error");
+            GPSTK_THROW(ge);
+        }
+        double c(gpstk::dot(z, R) / ::sqrt(rx * ry));
+        if (fabs(c) > 1.0e0) c = fabs(c) / c;   // round off error
+        elevation = 90.0 - ::acos(c) * RAD_TO_DEG;
+
+        if (xy <= 1e-14 || xyz <= 1e-14) {
+            GeometryException ge("Divide by Zero Error");
+            GPSTK_THROW(ge);
+        }
+        double p1 = (-sint*cosl * z[0]) + (-sint*sinl * z[1]) +
+                    (xy/xyz * z[2]);
+        double p2 = (-sinl * z[0]) + (cosl * z[1]);
+        if (fabs(p1) + fabs(p2) < 1.0e-14) {
+            GeometryException ge("azAngle(), failed p1+p2 test.");
+            GPSTK_THROW(ge);
+        }
+        double az = 90 - ::atan2(p1, p2) * RAD_TO_DEG;
+        azimuth = (az < 0 ? az + 360 : az);
+    }
+
+ private:
+    FixedVector<double, 3> R;
+    double ry, xy, xyz;
+    double cosl = 0, sinl = 0, sint = 0;
+};
+
+// Look up the Xvt of satellite i of an epoch, marking the satellite
+// invalid if the ephemeris can not provide it.
+static bool lookupXvt(const gpstk::XvtStore<gpstk::SatID>& ephemeris,
+        const ReceiverEpoch& epoch, size_t i, const CommonTime& time,
+        EpochOrds& result) {
+    if (ephemeris.computeXvt(epoch.satIds[i], time, result.svXvts[i]))
+        return true;
+    result.valid[i] = false;
+    return false;
+}
+
+// RawRange1() for all valid satellites of the epoch, one light-time
+// iteration at a time.
+static void rawRanges1(const ReceiverEpoch& epoch,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris,
+        std::vector<double>& tof, std::vector<double>& rawrange,
+        std::vector<bool>& active, EpochOrds& result) {
+    const Position& rxLoc(epoch.rxLoc);
+    const size_t n(epoch.satIds.size());
+    GPSEllipsoid ellipsoid;
+
+    tof.assign(n, 0.07);      // Initial guess 70ms
+    active = result.valid;
+    bool more(true);
+    for (int nit = 0; more && nit < 5; nit++) {
+        more = false;
+        for (size_t i = 0; i < n; i++) {
+            if (!active[i])
+                continue;
+            // best estimate of transmit time
+            CommonTime transmit(epoch.receiveTime);
+            transmit -= tof[i];
+            double tof_old = tof[i];
+            if (!lookupXvt(ephemeris, epoch, i, transmit, result)) {
+                active[i] = false;
+                continue;
+            }
+            Xvt& svPosVel(result.svXvts[i]);
+            svPosVel = rotateEarth(rxLoc, svPosVel, ellipsoid);
+            // update raw range and time of flight
+            rawrange[i] = RSS(svPosVel.x[0] - rxLoc.X(),
+                              svPosVel.x[1] - rxLoc.Y(),
+                              svPosVel.x[2] - rxLoc.Z());
+            tof[i] = rawrange[i] / ellipsoid.c();
+            active[i] = ABS(tof[i]-tof_old) > 1.e-13;
+            more = more || active[i];
+        }
+    }
+}
+
+// RawRange2() for all valid satellites of the epoch, given the pseudorange
+// of each; both SV clock iterations are done for all satellites in turn.
+static void rawRanges2(const ReceiverEpoch& epoch,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris,
+        const std::vector<double>& pseudorange,
+        std::vector<double>& rawrange, EpochOrds& result) {
+    const Position& rxLoc(epoch.rxLoc);
+    const size_t n(epoch.satIds.size());
+    GPSEllipsoid ellipsoid;
+
+    for (int it = 0; it < 2; it++) {
+        for (size_t i = 0; i < n; i++) {
+            if (!result.valid[i])
+                continue;
+            // 0-th order estimate of transmit time = receiver - pseudorange/c
+            CommonTime transmit(epoch.receiveTime);
+            transmit -= pseudorange[i] / C_MPS;
+            CommonTime tt(transmit);
+            if (it > 0) {
+                // correct for SV clock
+                tt -= (result.svXvts[i].clkbias + result.svXvts[i].relcorr);
+            }
+            lookupXvt(ephemeris, epoch, i, tt, result);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (!result.valid[i])
+            continue;
+        Xvt& svPosVel(result.svXvts[i]);
+        svPosVel = rotateEarth(rxLoc, svPosVel, ellipsoid);
+        rawrange[i] = RSS(svPosVel.x[0] - rxLoc.X(),
+                          svPosVel.x[1] - rxLoc.Y(),
+                          svPosVel.x[2] - rxLoc.Z());
+    }
+}
+
+void calculate_ords(const std::vector<double>& frequencies,
+        const ReceiverEpoch& epoch,
+        const gpstk::IonoModelStore& iono_model,
+        const gpstk::TropModel& trop_model,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris, int range_method,
+        EpochOrds& result) {
+    const size_t n(epoch.satIds.size());
+    const size_t nfreq(frequencies.size());
+    if (epoch.pseudoranges.size() != n * nfreq) {
+        gpstk::Exception exc(
+            "Mismatch between satellite and pseudorange array size");
+        GPSTK_THROW(exc)
+    }
+    if (range_method == 3 && epoch.transmitTimes.size() != n) {
+        gpstk::Exception exc(
+            "Range method 3 requires a transmit time for each satellite");
+        GPSTK_THROW(exc)
+    }
+    if (range_method < 1 || range_method > 4) {
+        gpstk::Exception exc("Unknown range method");
+        GPSTK_THROW(exc)
+    }
+    const double gamma = ionosphereFreeGamma(frequencies, nfreq);
+
+    result.ords.assign(n, 0.0);
+    result.svXvts.resize(n);
+    result.elevations.assign(n, 0.0);
+    result.valid.assign(n, true);
+
+    // ionosphere-free pseudoranges, as IonosphereFreeRange()
+    std::vector<double> psRange(n), range(n, 0.0), work(n);
+    for (size_t i = 0; i < n; i++) {
+        const double *pr = &epoch.pseudoranges[i * nfreq];
+        psRange[i] = (pr[1] - gamma * pr[0])/(1-gamma);
+    }
+
+    // find raw ranges
+    switch (range_method) {
+    case 1: {
+        std::vector<bool> active;
+        rawRanges1(epoch, ephemeris, work, range, active, result);
+        break;
+    }
+    case 2:
+        rawRanges2(epoch, ephemeris, psRange, range, result);
+        break;
+    case 3:
+        for (size_t i = 0; i < n; i++) {
+            try {
+                range[i] = RawRange3(psRange[i], epoch.rxLoc,
+                        epoch.satIds[i], epoch.transmitTimes[i], ephemeris,
+                        result.svXvts[i]);
+            } catch (InvalidRequest& e) {
+                result.valid[i] = false;
+            }
+        }
+        break;
+    case 4: {
+        // seed RawRange2() with the range at the receive time
+        gpstk::GPSEllipsoid gm;
+        for (size_t i = 0; i < n; i++) {
+            if (lookupXvt(ephemeris, epoch, i, epoch.receiveTime, result))
+                work[i] = result.svXvts[i].preciseRho(epoch.rxLoc, gm);
+        }
+        rawRanges2(epoch, ephemeris, work, range, result);
+        break;
+    }
+    }
+
+    // apply the corrections, in the same order as calculate_ord()
+    ReceiverGeometry geometry(epoch.rxLoc);
+    for (size_t i = 0; i < n; i++) {
+        if (!result.valid[i])
+            continue;
+        Xvt& svXvt(result.svXvts[i]);
+        try {
+            double elevation, azimuth;
+            geometry.angles(svXvt.x, elevation, azimuth);
+            result.elevations[i] = elevation;
+
+            double r(range[i]);
+            r += SvRelativityCorrection(svXvt);
+            r += SvClockBiasCorrection(svXvt);
+            r += trop_model.correction(elevation);
+            r += -iono_model.getCorrection(epoch.receiveTime, epoch.rxLoc,
+                    elevation, azimuth, IonoModel::L1);
+            result.ords[i] = psRange[i] - r;
+        } catch (gpstk::Exception& e) {
+            result.valid[i] = false;
+        }
+    }
+}
+
+void calculate_ords(const std::vector<double>& frequencies,
+        const std::vector<ReceiverEpoch>& epochs,
+        const gpstk::IonoModelStore& iono_model,
+        const gpstk::TropModel& trop_model,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris, int range_method,
+        std::vector<EpochOrds>& results) {
+    results.resize(epochs.size());
+    for (size_t k = 0; k < epochs.size(); k++)
+        calculate_ords(frequencies, epochs[k], iono_model, trop_model,
+                ephemeris, range_method, results[k]);
+}
+
 }  // namespace ord
 }  // namespace gpstk
@@ -162,6 +162,70 @@ double SvRelativityCorrection(gpstk::Xvt& svXvt);
 double TroposphereCorrection(const gpstk::TropModel& trop_model,
         const gpstk::Position& rx_loc, const gpstk::Xvt& sv_xvt);
 
+/// Observations made by one receiver at one epoch, for calculate_ords().
+/// The per-satellite values are kept in parallel arrays, one entry per
+/// satellite, so that a whole epoch can be handled in one pass.
+struct ReceiverEpoch {
+    /// The location of the receiver.
+    gpstk::Position rxLoc;
+    /// The nominal receive time.
+    gpstk::CommonTime receiveTime;
+    /// Identifiers of the satellites observed.
+    std::vector<gpstk::SatID> satIds;
+    /// Pseudoranges (m), one per frequency for each satellite in turn,
+    /// i.e. the range of satellite i on frequency j is at
+    /// pseudoranges[i*nfreq+j].
+    std::vector<double> pseudoranges;
+    /// Transmit times reported by the satellites; only needed, one per
+    /// satellite, for range method 3.
+    std::vector<gpstk::CommonTime> transmitTimes;
+};
+
+/// Results of calculate_ords(), one entry per satellite in the same order
+/// as ReceiverEpoch::satIds.
+struct EpochOrds {
+    /// Observed range deviation from the ionosphere-free pseudorange (m).
+    std::vector<double> ords;
+    /// Final SV position/velocity used for each satellite.
+    std::vector<gpstk::Xvt> svXvts;
+    /// Elevation of each satellite as seen from the receiver (degrees).
+    std::vector<double> elevations;
+    /// False where no ORD could be computed, e.g. for lack of ephemeris;
+    /// the other values for that satellite are then meaningless.
+    std::vector<bool> valid;
+};
+
+/// Calculate the ORDs of all the satellites observed by a receiver at one
+/// epoch. The result for each satellite is the same as calculate_ord()
+/// would give, but the light-time solutions of all satellites are iterated
+/// together, the receiver geometry is computed once per epoch, and a
+/// satellite that can not be processed is flagged invalid rather than
+/// failing the whole epoch.
+/// @params frequencies Signal frequencies, the same for all satellites.
+/// @params epoch Receiver location, times and observations.
+/// @params iono_model Class that encapsulates ionospheric models
+/// @params trop_model Class that encapsulates troposphere models
+/// @params ephemeris The ephemeris to query against.
+/// @params range_method Raw range method (1-4), as for calculate_ord().
+/// @params result Results for each satellite; storage is reused.
+/// @throw Exception if the frequencies, observations or range method are
+///   inconsistent.
+void calculate_ords(const std::vector<double>& frequencies,
+        const ReceiverEpoch& epoch,
+        const gpstk::IonoModelStore& iono_model,
+        const gpstk::TropModel& trop_model,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris, int range_method,
+        EpochOrds& result);
+
+/// Calculate the ORDs of many receivers at one epoch, as calculate_ords()
+/// above; results[k] holds the ORDs for epochs[k].
+void calculate_ords(const std::vector<double>& frequencies,
+        const std::vector<ReceiverEpoch>& epochs,
+        const gpstk::IonoModelStore& iono_model,
+        const gpstk::TropModel& trop_model,
+        const gpstk::XvtStore<gpstk::SatID>& ephemeris, int range_method,
+        std::vector<EpochOrds>& results);
+
 /// Example method that applies _all_ corrections to generate the
 /// Observed Range Deviation.
 /// This is intended to be a sample showing how the above methods will be used.
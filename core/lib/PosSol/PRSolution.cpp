@@ -123,18 +123,17 @@ namespace gpstk
          // convert time system of tx to that of Sats[i]
 
          tx -= Pseudorange[i]/C_MPS;
+         // a missing satellite is routine; use the non-throwing query
          try {
-            LOG(DEBUG) << " go to getXvt with time " << printTime(tx,timfmt);
-            PVT = pEph->getXvt(Sats[i], tx);          // get ephemeris range, etc
-            LOG(DEBUG) << " returned from getXvt";
-         }
-         catch(InvalidRequest& e) {
-            LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris) "
-               << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt)
-               << " [" << e.getText() << "]";
-            Sats[i].id = -::abs(Sats[i].id);
-            ++noeph;
-            continue;
+            LOG(DEBUG) << " go to computeXvt with time " << printTime(tx,timfmt);
+            if(!pEph->computeXvt(Sats[i], tx, PVT)) {  // get ephemeris range, etc
+               LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris) "
+                  << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt);
+               Sats[i].id = -::abs(Sats[i].id);
+               ++noeph;
+               continue;
+            }
+            LOG(DEBUG) << " returned from computeXvt";
          }
          catch(Exception& e) {
             LOG(DEBUG) << "Oops - Exception " << e.getText();
@@ -142,13 +141,9 @@ namespace gpstk
 
          // update transmit time and get ephemeris range again
          tx -= PVT.clkbias + PVT.relcorr;
-         try {
-            PVT = pEph->getXvt(Sats[i], tx);
-         }
-         catch(InvalidRequest& e) {                   // unnecessary....you'd think!
+         if(!pEph->computeXvt(Sats[i], tx, PVT)) {    // unnecessary....you'd think!
             LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris 2) "
-               << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt)
-               << " [" << e.getText() << "]";
+               << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt);
             Sats[i].id = -::abs(Sats[i].id);
             ++noeph;
             continue;
@@ -206,114 +201,154 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      int iret(0),k,n;
-      size_t i, j;
-      double rho,wt,svxyz[3];
-      GPSEllipsoid ellip;
-
       Valid = Mixed = false;
 
+      try {
+         int iret(solveSubset(currSub, T, Sats, SVP, invMC, pTropModel,
+                              niterLimit, convLimit, Syss, false));
+
+         // require number of good satellites to be >= number unknowns (no RAIM here)
+         Nsvs = currSub.n;
+         Mixed = (currSub.dim > 4);
+         // only an unconverged (-1) solution is kept; singular (-2) and too few
+         // satellites (-3) leave the member data alone and Valid false
+         if(iret < -1) return iret;
+
+         // save to member data
+         storeSubset(currSub, T, Sats);
+         Valid = true;
+
+         Resids.resize(currSub.n);
+         Slopes.resize(currSub.n);
+         for(size_t i=0; i<currSub.n; i++) {
+            Resids(i) = currSub.Resid[i];
+            Slopes(i) = currSub.Slopes[i];
+         }
+
+         return iret;
+      
+      } catch(Exception& e) { GPSTK_RETHROW(e); }
+
+   } // end PRSolution::SimplePRSolution
+
+
+   // -------------------------------------------------------------------------
+   // The linearized least squares solution for the unmarked satellites; this is
+   // the algorithm of SimplePRSolution() using the working storage in S.
+   int PRSolution::solveSubset(SubsetSolution& S,
+                               const CommonTime& T,
+                               const vector<SatID>& Sats,
+                               const Matrix<double>& SVP,
+                               const Matrix<double>& invMC,
+                               TropModel *pTropModel,
+                               const int niterLimit,
+                               const double convLimit,
+                               const vector<SatID::SatelliteSystem>& Syss,
+                               const bool warm)
+      throw(Exception)
+   {
+      int iret(0);
+      size_t i,j,k,r,c,n,dim;
+      double rho,wt,sum,svxyz[3];
+      GPSEllipsoid ellip;
+
       try {
          // -----------------------------------------------------------
          // counts, systems and dimensions
-         vector<SatID::SatelliteSystem> mySyss;
-         {
-            // define the Syss (system IDs) vector, and count good satellites
-            vector<SatID::SatelliteSystem> tempSyss;
-            for(Nsvs=0,i=0; i<Sats.size(); i++) {
-               if(Sats[i].id <= 0)                          // reject marked sats
-                  continue;
-
-               SatID::SatelliteSystem sys(Sats[i].system);  // get this system
-               if(vectorindex(Syss, sys) == -1)             // reject disallowed sys
-                  continue;
-
-               Nsvs++;                                      // count it
-               if(vectorindex(tempSyss, sys) == -1)         // add unique system
-                  tempSyss.push_back(sys);
-            }
+         S.index.clear();
+         for(i=0; i<Sats.size(); i++) {
+            if(Sats[i].id <= 0)                                // reject marked sats
+               continue;
+            if(vectorindex(Syss, Sats[i].system) == -1)        // reject disallowed sys
+               continue;
+            S.index.push_back(i);
+         }
+         n = S.n = S.index.size();
 
-            // must sort as in Syss
-            for(i=0; i<Syss.size(); i++)
-               if(vectorindex(tempSyss, Syss[i]) != -1)
-                  mySyss.push_back(Syss[i]);
+         // systems in the solution, sorted as in Syss
+         S.syss.clear();
+         for(j=0; j<Syss.size(); j++) {
+            for(r=0; r<n; r++) if(Sats[S.index[r]].system == Syss[j]) {
+               S.syss.push_back(Syss[j]);
+               break;
+            }
          }
 
          // dimension of the solution vector (3 pos + 1 clk/sys)
-         const size_t dim(3 + mySyss.size());
-         if(dim > 4) Mixed = true;
+         dim = S.dim = 3 + S.syss.size();
 
-         // require number of good satellites to be >= number unknowns (no RAIM here)
-         if(Nsvs < dim) return -3;
+         // require number of good satellites to be >= number unknowns
+         if(n < dim) return -3;
+
+         // index of each datum's clock in the solution vector
+         S.clock.resize(n);
+         for(r=0; r<n; r++)
+            S.clock[r] = 3 + vectorindex(S.syss, Sats[S.index[r]].system);
 
          // -----------------------------------------------------------
-         // build the measurement covariance matrix
-         Matrix<double> iMC;
-         if(invMC.rows() > 0) {
-            LOG(DEBUG) << "Build inverse MCov";
-            iMC = Matrix<double>(Nsvs,Nsvs,0.0);
-            for(n=0,i=0; i<Sats.size(); i++) {
-               if(Sats[i].id <= 0) continue;
-               for(k=0,j=0; j<Sats.size(); j++) {
-                  if(Sats[j].id <= 0) continue;
-                  iMC(n,k) = invMC(i,j);
-                  ++k;
-               }
-               ++n;
-            }
-            LOG(DEBUG) << "inv MCov matrix is\n" << fixed << setprecision(4) << iMC;
+         // the weight matrix
+         const bool weighted(invMC.rows() > 0);
+         if(weighted) {
+            S.W.resize(n*n);
+            for(r=0; r<n; r++) for(c=0; c<n; c++)
+               S.W[r*n+c] = invMC(S.index[r],S.index[c]);
          }
+         else
+            S.W.clear();
 
          // -----------------------------------------------------------
-         // define for computation
-         Vector<double> CRange(Nsvs),dX(dim);
-         Matrix<double> P(Nsvs,dim,0.0),PT,G(dim,Nsvs),PG(Nsvs,Nsvs),Rotation;
-         Triple dirCos;
-         Xvt SV,RX;
-
-         Solution.resize(dim);
-         Covariance.resize(dim,dim);
-         Resids.resize(Nsvs);
-         Slopes.resize(Nsvs);
-         LOG(DEBUG) << " Solution dimension is " << dim << " and Nsvs is " << Nsvs;
+         // size the storage; assign() does not allocate if capacity is enough
+         S.P.assign(n*dim, 0.0);
+         S.PtW.resize(dim*n);
+         S.Resid.resize(n);
+         S.Cov.resize(dim*dim);
+         S.G.resize(dim*n);
+         S.dX.resize(dim);
+         S.Slopes.assign(n, 0.0);
+         S.work.resize(dim*dim);
+         S.usedSVD = false;
+
+         // start with solution = apriori, or as given
+         const bool cold(!warm || S.Sol.size() != dim);
+         if(cold) {
+            S.Sol.assign(dim, 0.0);
+            if(hasMemory) {
+               Vector<double> APSol(memory.getAprioriSolution(S.syss));
+               for(j=0; j<dim && j<APSol.size(); j++) S.Sol[j] = APSol(j);
+            }
+         }
 
          // prepare for iteration loop
          // iterate at least twice so that trop model gets evaluated
          int n_iterate(0), niter_limit(niterLimit < 2 ? 2 : niterLimit);
          double converge(0.0);
-
-         // start with solution = apriori
-         Vector<double> APSolution;
-         if(hasMemory) {
-            APSolution = Solution = memory.getAprioriSolution(mySyss);
-            LOG(DEBUG) << " apriori solution (" << Solution.size() << ") is [ "
-               << fixed << setprecision(3) << Solution << " ]";
-         }
-         else {
-            Solution = Vector<double>(dim,0.0);
-            LOG(DEBUG) << " no memory - no apriori solution";
-         }
+         Position R,SV;
 
          // -----------------------------------------------------------
          // iteration loop
          do {
-            TropFlag = false;       // true means the trop corr was NOT applied
-
-            // current estimate of position solution
-            RX.x = Triple(Solution(0),Solution(1),Solution(2));
+            S.TropFlag = false;     // true means the trop corr was NOT applied
+            const double *X(&S.Sol[0]);
+
+            // receiver position and height are the same for every satellite
+            // (but trop is not applied on the first cold iteration)
+            const bool doTrop(!cold || n_iterate > 0);
+            double ht(0.0);
+            if(doTrop) {
+               R.setECEF(X[0],X[1],X[2]);
+               ht = R.getHeight();
+            }
 
             // loop over satellites, computing partials matrix
-            for(n=0,i=0; i<Sats.size(); i++) {
-               // ignore marked satellites
-               if(Sats[i].id <= 0) continue;
+            for(r=0; r<n; r++) {
+               i = S.index[r];
 
                // ------------ ephemeris
                // rho is time of flight (sec)
-               if(n_iterate == 0)
+               if(cold && n_iterate == 0)
                   rho = 0.070;             // initial guess: 70ms
                else
-                  rho = RSS(SVP(i,0)-Solution(0),
-                           SVP(i,1)-Solution(1), SVP(i,2)-Solution(2))/ellip.c();
+                  rho = RSS(SVP(i,0)-X[0], SVP(i,1)-X[1], SVP(i,2)-X[2])/ellip.c();
 
                // correct for earth rotation
                wt = ellip.angVelocity()*rho;             // radians
@@ -322,113 +357,93 @@ namespace gpstk
                svxyz[2] = SVP(i,2);
 
                // rho is now geometric range
-               rho = RSS(svxyz[0]-Solution(0),
-                         svxyz[1]-Solution(1),
-                         svxyz[2]-Solution(2));
-
-               // direction cosines
-               dirCos[0] = (Solution(0)-svxyz[0])/rho;
-               dirCos[1] = (Solution(1)-svxyz[1])/rho;
-               dirCos[2] = (Solution(2)-svxyz[2])/rho;
+               rho = RSS(svxyz[0]-X[0], svxyz[1]-X[1], svxyz[2]-X[2]);
 
                // ------------ data
                // corrected pseudorange (m) minus geometric range
-               CRange(n) = SVP(i,3) - rho;
+               double CRange(SVP(i,3) - rho);
 
-               // correct for troposphere and PCOs (but not on the first iteration)
-               if(n_iterate > 0) {
-                  SV.x = Triple(svxyz[0],svxyz[1],svxyz[2]);
-                  Position R,S;
-                  R.setECEF(RX.x[0],RX.x[1],RX.x[2]);
-                  S.setECEF(SV.x[0],SV.x[1],SV.x[2]);
+               // correct for troposphere (but not on the first cold iteration)
+               if(doTrop) {
+                  SV.setECEF(svxyz[0],svxyz[1],svxyz[2]);
 
                   // trop
-                  double tc(R.getHeight());  // tc is a dummy here
+                  double tc(0.0);
                   // must test R for reasonableness to avoid corrupting TropModel
                   // Global model sets the upper limit
-                  if(R.elevation(S) < 0.0 || tc > 44247. || tc < -1000.0) {
+                  if(R.elevation(SV) < 0.0 || ht > 44247. || ht < -1000.0) {
                      tc = 0.0;
-                     TropFlag = true;        // true means failed to apply trop corr
+                     S.TropFlag = true;      // true means failed to apply trop corr
                   }
                   else
-                     tc = pTropModel->correction(R,S,T);    // pTropModel not const
+                     tc = pTropModel->correction(R,SV,T);   // pTropModel not const
 
-                  CRange(n) -= tc;
+                  CRange -= tc;
                   LOG(DEBUG) << "Trop " << i << " " << Sats[i] << " "
                      << fixed << setprecision(3) << tc;
-
-               }  // end if n_iterate > 0
-
-               // get the index, for this clock, in the solution vector
-               j = 3 + vectorindex(mySyss, Sats[i].system); // Solution ~ X,Y,Z,clks
-
-               // find the clock for the sat's system
-               const double clk(Solution(j));
-               LOG(DEBUG) << "Clock is (" << j << ") " << clk;
+               }
 
                // data vector: corrected range residual
-               Resids(n) = CRange(n) - clk;
+               S.Resid[r] = CRange - X[S.clock[r]];
 
                // ------------ least squares
-               // partials matrix
-               P(n,0) = dirCos[0];           // x direction cosine
-               P(n,1) = dirCos[1];           // y direction cosine
-               P(n,2) = dirCos[2];           // z direction cosine
-               P(n,j) = 1.0;                 // clock
-
-               // ------------ increment index
-               // n is index and number of good satellites - also used for Slope
-               n++;
+               // partials matrix: direction cosines and clock
+               double *Pr(&S.P[r*dim]);
+               Pr[0] = (X[0]-svxyz[0])/rho;
+               Pr[1] = (X[1]-svxyz[1])/rho;
+               Pr[2] = (X[2]-svxyz[2])/rho;
+               Pr[S.clock[r]] = 1.0;
 
             }  // end loop over satellites
 
-            if(n != Nsvs) {
-               Exception e("Counting error after satellite loop");
-               GPSTK_THROW(e);
-            }
-
-            LOG(DEBUG) << "Partials (" << P.rows() << "x" << P.cols() << ")\n"
-               << fixed << setprecision(4) << P;
-            LOG(DEBUG) << "Resids (" << Resids.size() << ") "
-               << fixed << setprecision(3) << Resids;
-
             // ------------------------------------------------------
             // compute information matrix (inverse covariance) and generalized inverse
-            PT = transpose(P);
-
-            // weight matrix = measurement covariance inverse
-            if(invMC.rows() > 0) Covariance = PT * iMC * P;
-            else                 Covariance = PT * P;
-
-            // invert using SVD
-            try {
-               Covariance = inverseSVD(Covariance);
+            // PtW = transpose(P) * weight
+            for(k=0; k<dim; k++) for(c=0; c<n; c++) {
+               if(!weighted) { S.PtW[k*n+c] = S.P[c*dim+k]; continue; }
+               for(sum=0.0,r=0; r<n; r++) sum += S.P[r*dim+k]*S.W[r*n+c];
+               S.PtW[k*n+c] = sum;
+            }
+            // Cov = PtW * P
+            for(k=0; k<dim; k++) for(j=0; j<dim; j++) {
+               for(sum=0.0,r=0; r<n; r++) sum += S.PtW[k*n+r]*S.P[r*dim+j];
+               S.Cov[k*dim+j] = sum;
             }
-            catch(SingularMatrixException& sme) { return -2; }
-            LOG(DEBUG) << "InvCov (" << Covariance.rows() << "x" << Covariance.cols()
-               << ")\n" << fixed << setprecision(4) << Covariance;
 
-            // generalized inverse
-            if(invMC.rows() > 0) G = Covariance * PT * iMC;
-            else                 G = Covariance * PT;
+            // invert; if not positive definite use the SVD, unless the problem
+            // is singular, when the SVD would only give a pseudo-inverse
+            if(!invertSPD(&S.Cov[0], &S.work[0], dim)) {
+               Matrix<double> Info(dim,dim);
+               double big,small;
+               for(k=0; k<dim; k++) for(j=0; j<dim; j++) Info(k,j) = S.Cov[k*dim+j];
+               try { Info = inverseSVD(Info,big,small); }
+               catch(MatrixException& me) { return -2; }
+               if(small < 1.e-8*big) return -2;
+               for(k=0; k<dim; k++) for(j=0; j<dim; j++) S.Cov[k*dim+j] = Info(k,j);
+               S.usedSVD = true;
+            }
 
-            // PG is used for Slope computation
-            PG = P * G;
-            LOG(DEBUG) << "PG (" << PG.rows() << "x" << PG.cols()
-               << ")\n" << fixed << setprecision(4) << PG;
+            // generalized inverse G = Cov * PtW
+            for(k=0; k<dim; k++) for(c=0; c<n; c++) {
+               for(sum=0.0,j=0; j<dim; j++) sum += S.Cov[k*dim+j]*S.PtW[j*n+c];
+               S.G[k*n+c] = sum;
+            }
 
             n_iterate++;                        // increment number iterations
 
             // ------------------------------------------------------
             // compute solution
-            dX = G * Resids;
-            LOG(DEBUG) << "Computed dX(" << dX.size() << ")";
-            Solution += dX;
+            for(converge=0.0,k=0; k<dim; k++) {
+               for(sum=0.0,r=0; r<n; r++) sum += S.G[k*n+r]*S.Resid[r];
+               S.dX[k] = sum;
+               S.Sol[k] += sum;
+               converge += sum*sum;
+            }
 
             // ------------------------------------------------------
             // test for convergence
-            converge = norm(dX);
-            if(n_iterate > 1 && converge < convLimit) {              // success: quit
+            converge = ::sqrt(converge);
+            if((!cold || n_iterate > 1) && converge < convLimit) {   // success: quit
                iret = 0;
                break;
             }
@@ -438,58 +453,171 @@ namespace gpstk
             }
 
          } while(1);    // end iteration loop
-         LOG(DEBUG) << "Out of iteration loop";
 
-         if(TropFlag) LOG(DEBUG) << "Trop correction not applied at time "
-                                 << printTime(T,timfmt);
+         if(S.TropFlag) LOG(DEBUG) << "Trop correction not applied at time "
+                                   << printTime(T,timfmt);
 
          // compute slopes and find max member
-         MaxSlope = 0.0;
-         Slopes = 0.0;
-         if(iret == 0) for(j=0,i=0; i<Sats.size(); i++) {
-            if(Sats[i].id <= 0) continue;
-
-            // NB when one (few) sats have their own clock, PG(j,j) = 1 (nearly 1)
-            // and slope is inf (large)
-            if(::fabs(1.0-PG(j,j)) < 1.e-8) continue;
-
-            for(int k=0; k<dim; k++) Slopes(j) += G(k,j)*G(k,j); // TD dim=4 here?
-            Slopes(j) = SQRT(Slopes(j)*double(n-dim)/(1.0-PG(j,j)));
-            if(Slopes(j) > MaxSlope) MaxSlope = Slopes(j);
+         // NB when one (few) sats have their own clock, PG(j,j) = 1 (nearly 1)
+         // and slope is inf (large)
+         S.MaxSlope = 0.0;
+         if(iret == 0) for(j=0,r=0; r<n; r++) {
+            double PG(0.0);
+            for(k=0; k<dim; k++) PG += S.P[j*dim+k]*S.G[k*n+j];
+            if(::fabs(1.0-PG) < 1.e-8) continue;
+
+            for(k=0; k<dim; k++) S.Slopes[j] += S.G[k*n+j]*S.G[k*n+j];
+            S.Slopes[j] = SQRT(S.Slopes[j]*double(n-dim)/(1.0-PG));
+            if(S.Slopes[j] > S.MaxSlope) S.MaxSlope = S.Slopes[j];
             j++;
          }
-         LOG(DEBUG) << "Computed slopes, found max member";
 
-         // compute pre-fit residuals
-         if(hasMemory)
-            PreFitResidual = P*(Solution-APSolution) - Resids;
-         LOG(DEBUG) << "Computed pre-fit residuals";
+         // RMS residual
+         for(sum=0.0,r=0; r<n; r++) sum += S.Resid[r]*S.Resid[r];
+         S.RMS = ::sqrt(sum/double(n));
+
+         S.NIter = n_iterate;
+         S.Conv = converge;
 
-         // Compute RMS residual (member)
-         RMSResidual = RMS(Resids);
-         LOG(DEBUG) << "Computed RMS residual";
+         return iret;
+
+      } catch(Exception& e) { GPSTK_RETHROW(e); }
 
-         // Find the maximum slope (member)
-         //MaxSlope = 0.0;
-         //for(i=0; i<Slopes.size(); i++)
-         //   if(Slopes(i) > MaxSlope)
-         //      MaxSlope = Slopes[i];
+   } // end PRSolution::solveSubset
+
+
+   // -------------------------------------------------------------------------
+   // Remove the rows in drop from the normal equations of the converged solution
+   // A, using the Woodbury identity
+   //    inv(N - Pd^T Wd Pd) = Cov + U inv(inv(Wd) - Pd U) U^T,  U = Cov Pd^T
+   // and return the solution of the linearized problem at the same point.
+   bool PRSolution::downdateSubset(const SubsetSolution& A,
+                                   const vector<int>& drop,
+                                   vector<double>& Sol)
+      throw()
+   {
+      const size_t n(A.n), dim(A.dim), m(drop.size());
+      size_t i,j,k;
+      double sum;
+
+      // the subset must keep every clock and enough data
+      if(m == 0 || n < dim + m) return false;
+      for(j=3; j<dim; j++) {
+         size_t cnt(0);
+         for(i=0; i<n; i++) if(A.clock[i] == int(j)) cnt++;
+         for(i=0; i<m; i++) if(A.clock[drop[i]] == int(j)) cnt--;
+         if(cnt == 0) return false;
+      }
+
+      ddU.resize(dim*m);
+      ddS.resize(m*m);
+      ddWork.resize(m*m);
+      ddT.resize(m);
+      ddY.resize(dim);
+
+      // U = Cov * transpose(Pd)  (dim,m)
+      for(k=0; k<dim; k++) for(i=0; i<m; i++) {
+         const double *Pd(&A.P[drop[i]*dim]);
+         for(sum=0.0,j=0; j<dim; j++) sum += A.Cov[k*dim+j]*Pd[j];
+         ddU[k*m+i] = sum;
+      }
+
+      // S = inv(Wd) - Pd U  (m,m), and its inverse
+      for(i=0; i<m; i++) for(j=0; j<m; j++) {
+         const double *Pd(&A.P[drop[i]*dim]);
+         for(sum=0.0,k=0; k<dim; k++) sum += Pd[k]*ddU[k*m+j];
+         ddS[i*m+j] = -sum;
+      }
+      for(i=0; i<m; i++) {
+         const double w(A.W.empty() ? 1.0 : A.W[drop[i]*n+drop[i]]);
+         if(w <= 0.0) return false;
+         ddS[i*m+i] += 1.0/w;
+      }
+      if(!invertSPD(&ddS[0], &ddWork[0], m)) return false;
+
+      // y = Cov * (b - Pd^T Wd rd) = dX - U (Wd rd), where b = P^T W r
+      for(i=0; i<m; i++) {
+         const double w(A.W.empty() ? 1.0 : A.W[drop[i]*n+drop[i]]);
+         ddT[i] = w * A.Resid[drop[i]];
+      }
+      for(k=0; k<dim; k++) {
+         for(sum=A.dX[k],i=0; i<m; i++) sum -= ddU[k*m+i]*ddT[i];
+         ddY[k] = sum;
+      }
+
+      // dx = y + U inv(S) Pd y
+      for(i=0; i<m; i++) {
+         const double *Pd(&A.P[drop[i]*dim]);
+         for(sum=0.0,k=0; k<dim; k++) sum += Pd[k]*ddY[k];
+         ddT[i] = sum;
+      }
+      Sol.resize(dim);
+      for(k=0; k<dim; k++) {
+         sum = ddY[k];
+         for(i=0; i<m; i++) for(j=0; j<m; j++)
+            sum += ddU[k*m+i]*ddS[i*m+j]*ddT[j];
+         // linearization point was A.Sol - A.dX
+         Sol[k] = A.Sol[k] - A.dX[k] + sum;
+      }
+
+      return true;
+
+   } // end PRSolution::downdateSubset
+
+
+   // -------------------------------------------------------------------------
+   void PRSolution::storeSubset(const SubsetSolution& S,
+                                const CommonTime& T,
+                                const vector<SatID>& Sats)
+      throw(Exception)
+   {
+      try {
+         const size_t n(S.n), dim(S.dim);
+         size_t i,j;
 
-         // save to member data
          currTime = T;
          SatelliteIDs = Sats;
-         SystemIDs = mySyss;
-         invMeasCov = iMC;
-         Partials = P;
-         NIterations = n_iterate;
-         Convergence = converge;
-         Valid = true;
+         SystemIDs = S.syss;
+         Nsvs = n;
+         Mixed = (dim > 4);
+
+         Solution.resize(dim);
+         Covariance.resize(dim,dim);
+         Partials.resize(n,dim);
+         for(i=0; i<dim; i++) {
+            Solution(i) = S.Sol[i];
+            for(j=0; j<dim; j++) Covariance(i,j) = S.Cov[i*dim+j];
+         }
+         for(i=0; i<n; i++) for(j=0; j<dim; j++) Partials(i,j) = S.P[i*dim+j];
+
+         if(S.W.empty())
+            invMeasCov = Matrix<double>();
+         else {
+            invMeasCov.resize(n,n);
+            for(i=0; i<n; i++) for(j=0; j<n; j++) invMeasCov(i,j) = S.W[i*n+j];
+         }
+
+         // compute pre-fit residuals
+         if(hasMemory) {
+            Vector<double> APSolution(memory.getAprioriSolution(S.syss));
+            PreFitResidual.resize(n);
+            for(i=0; i<n; i++) {
+               double sum(-S.Resid[i]);
+               for(j=0; j<dim && j<APSolution.size(); j++)
+                  sum += S.P[i*dim+j]*(S.Sol[j]-APSolution(j));
+               PreFitResidual(i) = sum;
+            }
+         }
+
+         RMSResidual = S.RMS;
+         MaxSlope = S.MaxSlope;
+         NIterations = S.NIter;
+         Convergence = S.Conv;
+         TropFlag = S.TropFlag;
 
-         return iret;
-      
       } catch(Exception& e) { GPSTK_RETHROW(e); }
 
-   } // end PRSolution::SimplePRSolution
+   } // end PRSolution::storeSubset
 
 
    // -------------------------------------------------------------------------
@@ -542,18 +670,16 @@ namespace gpstk
          int iret,N;
          size_t i,j;
          vector<int> GoodIndexes;
-         // use these to save the 'best' solution within the loop.
-         // BestRMS marks the 'Best' set as unused.
-         bool BestTropFlag(false);
-         int BestNIter(0),BestIret(-5);
-         double BestRMS(-1.0),BestSL(0.0),BestConv(0.0);
-         Vector<double> BestSol(3,0.0),BestPFR;
+         // use these to save the 'best' solution within the loop; the solution
+         // itself is kept in bestSub. BestRMS marks the 'Best' set as unused.
+         int BestIret(-5);
+         double BestRMS(-1.0);
          vector<SatID> BestSats,SaveSats;
-         Matrix<double> SVP,BestCov,BestInvMCov,BestPartials;
-         vector<SatID::SatelliteSystem> BestSyss;
+         Matrix<double> SVP;
 
          // initialize
          Valid = false;
+         RAIMCounters.NCalls++;
          currTime = Tr;
          TropFlag = SlopeFlag = RMSFlag = false;
 
@@ -608,14 +734,16 @@ namespace gpstk
          // now compute the solution, first with all the data. If this fails,
          // RAIM: reject 1 satellite at a time and try again, then 2, etc.
 
-         // Slopes for each satellite are computed (cf. the RAIM algorithm)
-         Vector<double> Slopes;
-         // Resids stores the post-fit data residuals.
-         Vector<double> Resids;
-
          // stage is the number of satellites to reject.
          int stage(0);
 
+         // the all-satellite solution, if it converged, is downdated to warm start
+         // the solution of each subset; this requires a diagonal weight matrix.
+         bool haveAll(false), diagonal(true);
+         for(i=0; diagonal && i<invMC.rows(); i++)
+            for(j=0; j<invMC.cols(); j++)
+               if(i != j && invMC(i,j) != 0.0) { diagonal = false; break; }
+
          do {
             // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
@@ -624,9 +752,12 @@ namespace gpstk
             do {
                // Mark the satellites for this combination
                Sats = SaveSats;
+               dropRows.clear();
                for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
+                  if(Combo.isSelected(i)) {
                      Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+                     dropRows.push_back(i);
+                  }
 
                if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
                   ostringstream oss;
@@ -641,16 +772,29 @@ namespace gpstk
                // ----------------------------------------------------------------
                // Compute a solution given the data; ignore ranges for marked
                // satellites. Fill Vector 'Slopes' with slopes for each unmarked
-               // satellite.
+               // satellite. Start from the downdated all-satellite solution
+               // when possible.
                // Return 0  ok
                //       -1  failed to converge
                //       -2  singular problem
                //       -3  not enough good data
                //       -4  no ephemeris
-               iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
-                       MaxNIterations, ConvergenceLimit, Syss, Resids, Slopes);
+               bool warm(stage > 0 && haveAll
+                              && downdateSubset(allSub, dropRows, currSub.Sol));
+               iret = solveSubset(currSub, Tr, Sats, SVP, invMC, pTropModel,
+                       MaxNIterations, ConvergenceLimit, Syss, warm);
+
+               RAIMCounters.NSubsets++;
+               if(warm) RAIMCounters.NDowndates++;
+               if(iret != -3) RAIMCounters.NIterations += currSub.NIter;
+
+               if(stage == 0 && iret == 0 && !currSub.usedSVD && diagonal) {
+                  allSub = currSub;
+                  haveAll = true;
+               }
 
-               LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
+               LOG(DEBUG) << " RAIM: SimplePRS returns " << iret
+                          << (warm ? " (downdated start)" : "");
                if(iret <= 0 && iret > BestIret) BestIret = iret;
 
                // ----------------------------------------------------------------
@@ -676,7 +820,12 @@ namespace gpstk
 
                // ----------------------------------------------------------------
                // print solution with diagnostic information
-               LOG(DEBUG) << outputString(string("RPS"),iret);
+               if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
+                  storeSubset(currSub, Tr, Sats);
+                  Valid = true;
+                  LOG(DEBUG) << outputString(string("RPS"),iret);
+                  Valid = false;
+               }
 
                // do again for residuals
                // if memory exists, output residuals
@@ -685,23 +834,15 @@ namespace gpstk
 
                // deal with the results of SimplePRSolution()
                // save 'best' solution for later
-               if(BestRMS < 0.0 || RMSResidual < BestRMS) {
-                  BestRMS = RMSResidual;
-                  BestSol = Solution;
-                  BestSats = SatelliteIDs;
-                  BestSyss = SystemIDs;
-                  BestSL = MaxSlope;
-                  BestConv = Convergence;
-                  BestNIter = NIterations;
-                  BestCov = Covariance;
-                  BestInvMCov = invMeasCov;
-                  BestPartials = Partials;
-                  BestPFR = PreFitResidual;
-                  BestTropFlag = TropFlag;
+               const double currRMS(currSub.RMS);
+               if(BestRMS < 0.0 || currRMS < BestRMS) {
+                  BestRMS = currRMS;
+                  BestSats = Sats;
                   BestIret = iret;
+                  std::swap(currSub, bestSub);
                }
 
-               if(stage==0 && RMSResidual < RMSLimit)
+               if(stage==0 && currRMS < RMSLimit)
                   break;
 
             } while(Combo.Next() != -1);  // get the next combinations and repeat
@@ -737,18 +878,8 @@ namespace gpstk
          // ----------------------------------------------------------------
          // copy out the best solution and return
          if(iret >= 0) {
-            Sats = SatelliteIDs = BestSats;
-            SystemIDs = BestSyss;
-            Solution = BestSol;
-            Covariance = BestCov;
-            invMeasCov = BestInvMCov;
-            Partials = BestPartials;
-            PreFitResidual = BestPFR;
-            Convergence = BestConv;
-            NIterations = BestNIter;
-            RMSResidual = BestRMS;
-            MaxSlope = BestSL;
-            TropFlag = BestTropFlag;
+            storeSubset(bestSub, Tr, BestSats);
+            Sats = BestSats;
             iret = BestIret;
 
             if(iret==0) {
@@ -758,7 +889,10 @@ namespace gpstk
             }
 
             // must add zeros to state, covariance and partials if these don't match
-            if(Syss.size() != BestSyss.size()) {
+            if(Syss.size() != SystemIDs.size()) {
+               const vector<SatID::SatelliteSystem> BestSyss(SystemIDs);
+               const Vector<double> BestSol(Solution);
+               const Matrix<double> BestCov(Covariance), BestPartials(Partials);
                N = 3+Syss.size();
                Solution = Vector<double>(N,0.0);
                Covariance = Matrix<double>(N,N,0.0);
@@ -802,9 +936,9 @@ namespace gpstk
          }
 
          if(iret==0) {
-            if(BestSL > SlopeLimit) { iret = 1; SlopeFlag = true; }
-            if(BestSL > SlopeLimit/2.0 && Nsvs == 5) { iret = 1; SlopeFlag = true; }
-            if(BestRMS >= RMSLimit) { iret = 1; RMSFlag = true; }
+            if(MaxSlope > SlopeLimit) { iret = 1; SlopeFlag = true; }
+            if(MaxSlope > SlopeLimit/2.0 && Nsvs == 5) { iret = 1; SlopeFlag = true; }
+            if(RMSResidual >= RMSLimit) { iret = 1; RMSFlag = true; }
             if(TropFlag) iret = 1;
             Valid = true;
          }
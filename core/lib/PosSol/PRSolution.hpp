@@ -504,6 +504,19 @@ namespace gpstk
       /// the slope is large; applies only after calls to RAIMCompute().
       bool RMSFlag, SlopeFlag;
 
+      /// Counters of the work done by RAIMCompute(); they accumulate over calls
+      /// until reset by the caller, e.g. with RAIMCounters = RAIMCounts().
+      struct RAIMCounts
+      {
+         RAIMCounts() throw()
+            : NCalls(0), NSubsets(0), NDowndates(0), NIterations(0) {}
+         unsigned long NCalls;      ///< calls to RAIMCompute()
+         unsigned long NSubsets;    ///< satellite subsets solved
+         unsigned long NDowndates;  ///< subsets warm started by a downdate
+         unsigned long NIterations; ///< linearized least squares iterations
+      };
+      RAIMCounts RAIMCounters;
+
       // member functions -------------------------------------------
 
       /// Compute the satellite position / corrected range matrix (SVP) which is used
@@ -538,7 +551,9 @@ namespace gpstk
                             Matrix<double>& SVP) const throw();
 
       /// Compute a single autonomous pseudorange solution.
-      /// On output, all the member data is filled with results.
+      /// On output, all the member data is filled with results. The information
+      /// matrix is inverted by Cholesky decomposition, or by the SVD pseudo-inverse
+      /// if it is not positive definite.
       /// Input only (first 3 should be just as returned from PreparePRSolution()):
       /// @param Tr          const. Measured time of reception of the data.
       ///                     On output member currTime set to this.
@@ -594,6 +609,19 @@ namespace gpstk
 
       /// Compute a position/time solution, given satellite PRNs and pseudoranges
       /// using a RAIM algorithm. This is the main computation done by this class.
+      /// The solution using all the satellites is computed as in SimplePRSolution().
+      /// When satellites must be rejected, the solution for each subset is warm
+      /// started from the all-satellite solution with the rejected rows removed
+      /// from its normal equations (a rank-one, or rank-k for k rejected
+      /// satellites, downdate of the inverse). This gives only the starting
+      /// point: each iteration of the subset rebuilds the partials and normal
+      /// equations at the new linearization point, as before, but the subsets
+      /// usually need fewer iterations. Since the start differs, the number of
+      /// iterations and the final convergence value of a subset solution differ
+      /// from a cold start, and the solution itself may differ within the
+      /// convergence limit. The working storage is kept in this object and
+      /// reused, so the subset search does not allocate once it has been sized
+      /// by the first call; see also RAIMCounters.
       /// @param Tr          Measured time of reception of the data.
       /// @param Satellites  std::vector<SatID> of satellites; on successful
       ///                    return, satellites that were excluded by the algorithm
@@ -669,6 +697,61 @@ namespace gpstk
 
    private:
 
+      /// Working storage for the least squares solution of one subset of the
+      /// satellites; the vectors are resized as needed but never shrink, so that
+      /// they are allocated only when a larger problem is seen. Matrices are
+      /// stored by rows.
+      struct SubsetSolution
+      {
+         std::vector<int> index;       ///< index in Sats of each datum (row)
+         std::vector<int> clock;       ///< index in Sol of the clock of each row
+         std::vector<SatID::SatelliteSystem> syss; ///< systems in the solution
+         size_t n, dim;                ///< number of data and of states
+         std::vector<double> W;        ///< weight matrix (n,n); empty if none
+         std::vector<double> P;        ///< partials (n,dim)
+         std::vector<double> PtW;      ///< transpose(P)*W (dim,n)
+         std::vector<double> Resid;    ///< post-fit residuals (n)
+         std::vector<double> Cov;      ///< covariance (dim,dim)
+         std::vector<double> G;        ///< generalized inverse Cov*PtW (dim,n)
+         std::vector<double> Sol;      ///< solution (dim)
+         std::vector<double> dX;       ///< last update to Sol (dim)
+         std::vector<double> Slopes;   ///< RAIM slope of each datum (n)
+         std::vector<double> work;     ///< scratch for the inversion (dim,dim)
+         double RMS, MaxSlope, Conv;   ///< RMS residual, max slope, convergence
+         int NIter;                    ///< number of iterations
+         bool TropFlag;                ///< true if trop was not applied to a datum
+         bool usedSVD;                 ///< true if Cov had to be computed by SVD
+      };
+
+      /// Solve for the subset of satellites not marked in Sats, filling S.
+      /// Arguments and return values are as for SimplePRSolution(); if warm is
+      /// true, S.Sol must hold the initial solution, else the apriori solution is
+      /// used (or zero).
+      int solveSubset(SubsetSolution& S, const CommonTime& Tr,
+                      const std::vector<SatID>& Sats, const Matrix<double>& SVP,
+                      const Matrix<double>& invMC, TropModel *pTropModel,
+                      const int niterLimit, const double convLimit,
+                      const std::vector<SatID::SatelliteSystem>& Syss,
+                      const bool warm)
+         throw(Exception);
+
+      /// Given the converged all-satellite solution A, compute in Sol the
+      /// linearized solution with the rows in drop removed, by downdating A.Cov;
+      /// this is the warm start for solveSubset(), which refactors as usual.
+      /// Return false if the downdate is not possible (S would be singular).
+      bool downdateSubset(const SubsetSolution& A, const std::vector<int>& drop,
+                          std::vector<double>& Sol) throw();
+
+      /// Copy the results in S into the member data.
+      void storeSubset(const SubsetSolution& S, const CommonTime& Tr,
+                       const std::vector<SatID>& Sats) throw(Exception);
+
+      /// Working storage for RAIMCompute(): the current subset, the best subset so
+      /// far, the all-satellite solution, and scratch for downdateSubset().
+      SubsetSolution currSub, bestSub, allSub;
+      std::vector<int> dropRows;
+      std::vector<double> ddU, ddS, ddWork, ddT, ddY;
+
       /// flag: output content is valid.
       bool Valid;
 
@@ -62,20 +62,6 @@ namespace gpstk
    //@}
 
 
-   CommonTime::CommonTime( const CommonTime& right )
-     : m_day( right.m_day ), m_msod( right.m_msod ), m_fsod( right.m_fsod ),
-       m_timeSystem( right.m_timeSystem )
-   {}
-
-   CommonTime& CommonTime::operator=( const CommonTime& right )
-   {
-      m_day  = right.m_day;
-      m_msod = right.m_msod;
-      m_fsod = right.m_fsod;
-      m_timeSystem = right.m_timeSystem;
-      return *this;
-   }
-
 
    //FUTURE DEPRECATION
    //ALL COMMONTIME ACCESSOR/MUTATOR METHODS ARE SET FOR FUTURE DEPRECATION (PRIVATIZATION)
@@ -348,65 +334,15 @@ namespace gpstk
       return *this;
    }
 
-   bool CommonTime::operator==( const CommonTime& right ) const
+   void CommonTime::checkTimeSystem( const CommonTime& right ) const
    {
      /// Any (wildcard) type exception allowed, otherwise must be same time systems
-      if ((m_timeSystem != TimeSystem::Any &&
-           right.m_timeSystem != TimeSystem::Any) &&
-          m_timeSystem != right.m_timeSystem)
-         return false;
-
-      return (m_day        == right.m_day     &&
-              m_msod       == right.m_msod    &&
-              fabs(m_fsod-right.m_fsod) < eps   );
-   }
-
-   bool CommonTime::operator!=( const CommonTime& right ) const
-   {
-      return !operator==(right);
-   }
-
-   bool CommonTime::operator<( const CommonTime& right ) const
-   {
-     /// Any (wildcard) type exception allowed, otherwise must be same time systems
-      if ((m_timeSystem != TimeSystem::Any &&
-           right.m_timeSystem != TimeSystem::Any) &&
-          m_timeSystem != right.m_timeSystem)
+      if( !compatibleTimeSystem( right ) )
       {
          InvalidRequest ir("CommonTime objects not in same time system, cannot be compared: " +
                            m_timeSystem.asString() + " != " + right.m_timeSystem.asString());
          GPSTK_THROW( ir );
       }
-
-      if (m_day < right.m_day)
-         return true;
-      if (m_day > right.m_day)
-         return false;
-
-      if (m_msod < right.m_msod)
-         return true;
-      if (m_msod > right.m_msod)
-         return false;
-
-      if (m_fsod < right.m_fsod)
-         return true;
-
-      return false;
-   }
-
-   bool CommonTime::operator>( const CommonTime& right ) const
-   {
-      return !operator <=(right);
-   }
-
-   bool CommonTime::operator<=( const CommonTime& right ) const
-   {
-      return (operator<(right) || operator==(right));
-   }
-
-   bool CommonTime::operator>=( const CommonTime& right ) const
-   {
-      return !operator<(right);
    }
 
    std::string CommonTime::asString() const
@@ -426,6 +362,10 @@ namespace gpstk
                          long msod,
                          double fsod )
    {
+         // fold whole days out of msod first; m_msod is only 32 bits
+      days += msod / MS_PER_DAY;
+      msod %= MS_PER_DAY;
+
       m_day  += days;
       m_msod += msod;
       m_fsod += fsod;
@@ -37,6 +37,7 @@
 #ifndef GPSTK_COMMONTIME_HPP
 #define GPSTK_COMMONTIME_HPP
 
+#include <cmath>
 #include "Exception.hpp"
 #include "TimeConstants.hpp"
 #include "TimeSystem.hpp"
@@ -69,6 +70,15 @@ namespace gpstk
        * partial milliseconds.  By keeping the value in seconds, we
        * save ourselves additional work and loss of precision through
        * conversion of fractional seconds to fractional milliseconds.
+       *
+       * CommonTime is the key of most of the maps in the library
+       * (the ephemeris and data stores), so it is kept small and its
+       * comparisons cheap.  Day and msod are each held in 32 bits and
+       * together form a single 64-bit count, packedTime(), that
+       * orders the integer part of the time in one comparison; fsod
+       * only breaks ties.  Comparisons of objects in the same time
+       * system, the common case, do no other work; only mismatched
+       * time systems go on to check for TimeSystem::Any and throw.
        */
    class CommonTime
    {
@@ -111,14 +121,24 @@ namespace gpstk
           * Copy Constructor.
           * @param right a const reference to the CommonTime object to copy.
           */
-      CommonTime( const CommonTime& right );
+      CommonTime( const CommonTime& right )
+            : m_day( right.m_day ), m_msod( right.m_msod ),
+              m_fsod( right.m_fsod ), m_timeSystem( right.m_timeSystem )
+      {}
 
          /**
           * Assignment Operator.
           * @param right a const reference to the CommonTime object to copy.
           * @return a reference to this CommonTime object.
           */
-      CommonTime& operator=( const CommonTime& right );
+      CommonTime& operator=( const CommonTime& right )
+      {
+         m_day  = right.m_day;
+         m_msod = right.m_msod;
+         m_fsod = right.m_fsod;
+         m_timeSystem = right.m_timeSystem;
+         return *this;
+      }
 
          /// Destructor.
       virtual ~CommonTime()
@@ -355,14 +375,49 @@ namespace gpstk
           *  and false on failure.
           */
          //@{
-      bool operator==( const CommonTime& right ) const;
-      bool operator!=( const CommonTime& right ) const;
-      bool operator<( const CommonTime& right ) const;
-      bool operator>( const CommonTime& right ) const;
-      bool operator<=( const CommonTime& right ) const;
-      bool operator>=( const CommonTime& right ) const;
+      bool operator==( const CommonTime& right ) const
+      {
+         if( m_timeSystem != right.m_timeSystem &&
+             !compatibleTimeSystem( right ) )
+            return false;
+
+         return ( packedTime() == right.packedTime() &&
+                  std::fabs( m_fsod - right.m_fsod ) < eps );
+      }
+
+      bool operator!=( const CommonTime& right ) const
+      { return !operator==( right ); }
+
+         /// @throws InvalidRequest if the time systems differ and
+         ///   neither is TimeSystem::Any
+      bool operator<( const CommonTime& right ) const
+      {
+         if( m_timeSystem != right.m_timeSystem )
+            checkTimeSystem( right );
+
+         const long long l( packedTime() ), r( right.packedTime() );
+         return ( (l < r) | ((l == r) & (m_fsod < right.m_fsod)) );
+      }
+
+      bool operator>( const CommonTime& right ) const
+      { return !operator<=( right ); }
+
+      bool operator<=( const CommonTime& right ) const
+      { return ( operator<( right ) || operator==( right ) ); }
+
+      bool operator>=( const CommonTime& right ) const
+      { return !operator<( right ); }
          //@}
 
+         /**
+          * Day and milliseconds of day as one integer,
+          * m_day * 2^32 + m_msod, which orders as the time does.
+          * Times that compare equal have the same packedTime() and
+          * differ at most in fsod.
+          */
+      long long packedTime() const
+      { return static_cast<long long>( m_day ) * 4294967296LL + m_msod; }
+
       void reset()
       { m_day = m_msod = 0; m_fsod = 0.0; m_timeSystem = TimeSystem::Unknown; }
 
@@ -370,6 +425,19 @@ namespace gpstk
 
    protected:
 
+         /// True if the time systems of this and right may be compared,
+         /// i.e. are the same or either is TimeSystem::Any.
+      bool compatibleTimeSystem( const CommonTime& right ) const
+      {
+         return ( m_timeSystem == right.m_timeSystem ||
+                  m_timeSystem == TimeSystem::Any ||
+                  right.m_timeSystem == TimeSystem::Any );
+      }
+
+         /// Throw InvalidRequest unless compatibleTimeSystem( right ).
+         /// Kept out of line so that the comparisons stay small.
+      void checkTimeSystem( const CommonTime& right ) const;
+
       CommonTime( long day,
                   long sod,
                   double fsod,
@@ -392,8 +460,8 @@ namespace gpstk
          /// @return true if m_day is valid, false otherwise
       bool normalize();
 
-      long m_day;     ///< days (as a Julian Day)     0 <= val < 2^31
-      long m_msod;    ///< milliseconds-of-day        0 <= val < 86400000
+      int m_day;      ///< days (as a Julian Day)     0 <= val < 2^31
+      int m_msod;     ///< milliseconds-of-day        0 <= val < 86400000
       double m_fsod;  ///< fractional seconds-of-day  0 <= val < 0.001
 
       TimeSystem m_timeSystem; ///< time frame (system representation) of the data
@@ -0,0 +1,257 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file TextSpan.hpp
+ * Non-owning view of fixed-column text with allocation-free number parsing.
+ */
+
+#ifndef GPSTK_TEXTSPAN_HPP
+#define GPSTK_TEXTSPAN_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace gpstk
+{
+      /// @ingroup stringutilsgroup
+      //@{
+
+      /**
+       * A TextSpan refers to a range of characters owned by someone
+       * else (typically a line inside a memory-mapped file) and
+       * provides the fixed-column accessors needed by the text format
+       * readers without copying the characters into std::string
+       * objects.
+       *
+       * Columns past the end of the span read as blanks, which
+       * matches the way the RINEX readers pad short lines with
+       * spaces before extracting fields.
+       *
+       * The numeric conversions return exactly what
+       * StringUtils::asInt() and StringUtils::asDouble() would return
+       * for the same characters.  Plain decimal fields with no more
+       * than 15 significant digits (every RINEX observation, for
+       * example) are converted in place; anything else (exponents,
+       * embedded garbage, very long mantissas) is handed to
+       * strtol()/strtod() through a small stack buffer.
+       */
+   class TextSpan
+   {
+   public:
+         /// Empty span.
+      TextSpan()
+            : ptr(0), len(0)
+      {}
+
+         /// Span over \a n characters starting at \a p.
+      TextSpan(const char *p, std::size_t n)
+            : ptr(p), len(n)
+      {}
+
+         /// Span over the contents of \a s (which must outlive the span).
+      explicit TextSpan(const std::string& s)
+            : ptr(s.data()), len(s.size())
+      {}
+
+         /// Pointer to the first character.
+      const char* data() const
+      { return ptr; }
+
+         /// Number of characters in the span.
+      std::size_t size() const
+      { return len; }
+
+         /// Return true if the span holds no characters.
+      bool empty() const
+      { return len == 0; }
+
+         /// Character at column \a i, or a blank if \a i is past the end.
+      char at(std::size_t i) const
+      { return (i < len) ? ptr[i] : ' '; }
+
+         /** Return the sub-span of up to \a n characters starting at
+          * column \a pos, clipped to the end of this span. */
+      TextSpan sub(std::size_t pos, std::size_t n) const
+      {
+         if (pos >= len)
+            return TextSpan(ptr+len, 0);
+         return TextSpan(ptr+pos, (n < len-pos) ? n : len-pos);
+      }
+
+         /// Return true if the span contains only blanks (or nothing).
+      bool isBlank() const
+      {
+         for (std::size_t i = 0; i < len; i++)
+            if (ptr[i] != ' ')
+               return false;
+         return true;
+      }
+
+         /// Remove trailing blanks from the span.
+      void stripTrailing()
+      {
+         while (len > 0 && ptr[len-1] == ' ')
+            len--;
+      }
+
+         /// Copy the characters into a std::string.
+      std::string toString() const
+      { return std::string(ptr, len); }
+
+         /// Equivalent to StringUtils::asInt(toString()).
+      inline long asInt() const;
+
+         /// Equivalent to StringUtils::asDouble(toString()).
+      inline double asDouble() const;
+
+   private:
+         /// Maximum field width converted through the stack buffer.
+      static const std::size_t maxStackField = 63;
+
+         /// strtol() fallback.
+      inline long slowInt() const;
+
+         /// strtod() fallback.
+      inline double slowDouble() const;
+
+      const char *ptr;
+      std::size_t len;
+   }; // class TextSpan
+
+      //@}
+
+
+   inline long TextSpan ::
+   asInt() const
+   {
+      std::size_t i = 0;
+      while (i < len && ptr[i] == ' ')
+         i++;
+      bool neg = false;
+      if (i < len && (ptr[i] == '-' || ptr[i] == '+'))
+      {
+         neg = (ptr[i] == '-');
+         i++;
+      }
+      long val = 0;
+      int ndig = 0;
+      for (; i < len && ptr[i] >= '0' && ptr[i] <= '9'; i++, ndig++)
+         val = val * 10 + (ptr[i] - '0');
+         // strtol stops at the first non-digit, so trailing text
+         // doesn't matter; only odd leading white space and overly
+         // long numbers need the library.
+      if (ndig == 0 || ndig > 18)
+         return slowInt();
+      return neg ? -val : val;
+   }
+
+
+   inline double TextSpan ::
+   asDouble() const
+   {
+         // Exact powers of ten.  A decimal string whose digits fit in
+         // a 53-bit integer M converts to the correctly rounded
+         // M/10^k, which is the same value strtod() produces.
+      static const double pow10[] =
+         { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+           1e11, 1e12, 1e13, 1e14, 1e15 };
+      std::size_t i = 0;
+      while (i < len && ptr[i] == ' ')
+         i++;
+      bool neg = false;
+      if (i < len && (ptr[i] == '-' || ptr[i] == '+'))
+      {
+         neg = (ptr[i] == '-');
+         i++;
+      }
+      unsigned long long mant = 0;
+      int ndig = 0, nfrac = 0;
+      bool dot = false;
+      for (; i < len; i++)
+      {
+         char c = ptr[i];
+         if (c >= '0' && c <= '9')
+         {
+            mant = mant * 10 + (c - '0');
+            ndig++;
+            if (dot)
+               nfrac++;
+         }
+         else if (c == '.' && !dot)
+            dot = true;
+         else
+            break;
+      }
+      for (; i < len; i++)
+         if (ptr[i] != ' ')
+            return slowDouble();
+      if (ndig == 0 || ndig > 15)
+         return slowDouble();
+      double val = static_cast<double>(mant);
+      if (nfrac)
+         val /= pow10[nfrac];
+      return neg ? -val : val;
+   }
+
+
+   inline long TextSpan ::
+   slowInt() const
+   {
+      char buf[maxStackField+1];
+      if (len > maxStackField)
+         return std::strtol(toString().c_str(), 0, 10);
+      std::memcpy(buf, ptr, len);
+      buf[len] = 0;
+      return std::strtol(buf, 0, 10);
+   }
+
+
+   inline double TextSpan ::
+   slowDouble() const
+   {
+      char buf[maxStackField+1];
+      if (len > maxStackField)
+         return std::strtod(toString().c_str(), 0);
+      std::memcpy(buf, ptr, len);
+      buf[len] = 0;
+      return std::strtod(buf, 0);
+   }
+
+} // namespace gpstk
+
+#endif // GPSTK_TEXTSPAN_HPP
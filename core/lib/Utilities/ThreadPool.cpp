@@ -0,0 +1,160 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ThreadPool.cpp
+ * A fixed set of worker threads for running index-parallel loops.
+ */
+
+#include "ThreadPool.hpp"
+
+namespace gpstk
+{
+   ThreadPool ::
+   ThreadPool(unsigned nThreads)
+         : job(NULL), jobSize(0), nextIndex(0), generation(0), busy(0),
+           stopping(false), errorIndex(0)
+   {
+      if (nThreads == 0)
+         nThreads = defaultSize();
+      for (unsigned i = 1; i < nThreads; i++)
+         workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+   }
+
+
+   ThreadPool ::
+   ~ThreadPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         stopping = true;
+      }
+      cvWork.notify_all();
+      for (unsigned i = 0; i < workers.size(); i++)
+         workers[i].join();
+   }
+
+
+   unsigned ThreadPool ::
+   defaultSize()
+   {
+      unsigned n = std::thread::hardware_concurrency();
+      return (n == 0 ? 1 : n);
+   }
+
+
+   void ThreadPool ::
+   run(size_t n, const std::function<void(size_t)>& task)
+   {
+      if (n == 0)
+         return;
+
+      std::unique_lock<std::mutex> lock(mtx);
+      job = &task;
+      jobSize = n;
+      nextIndex = 0;
+      error = std::exception_ptr();
+      errorIndex = n;
+      generation++;
+      busy++;
+      lock.unlock();
+      cvWork.notify_all();
+
+      drain(task, n);
+
+      lock.lock();
+      busy--;
+      cvDone.wait(lock, [this]{ return busy == 0; });
+      job = NULL;
+      std::exception_ptr err = error;
+      error = std::exception_ptr();
+      lock.unlock();
+
+      if (err)
+         std::rethrow_exception(err);
+   }
+
+
+   void ThreadPool ::
+   workerLoop()
+   {
+      unsigned long seen = 0;
+      std::unique_lock<std::mutex> lock(mtx);
+      while (true)
+      {
+         cvWork.wait(lock, [&]{ return stopping || generation != seen; });
+         if (stopping)
+            return;
+         seen = generation;
+            // a worker that wakes after the loop has finished finds
+            // no job and goes back to sleep
+         if (job == NULL)
+            continue;
+         const std::function<void(size_t)> *task = job;
+         size_t n = jobSize;
+         busy++;
+         lock.unlock();
+         drain(*task, n);
+         lock.lock();
+         if (--busy == 0)
+            cvDone.notify_all();
+      }
+   }
+
+
+   void ThreadPool ::
+   drain(const std::function<void(size_t)>& task, size_t n)
+   {
+      size_t i;
+      while ((i = nextIndex++) < n)
+      {
+         try
+         {
+            task(i);
+         }
+         catch (...)
+         {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (i < errorIndex)
+            {
+               errorIndex = i;
+               error = std::current_exception();
+            }
+         }
+      }
+   }
+
+} // namespace gpstk
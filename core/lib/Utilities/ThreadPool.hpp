@@ -0,0 +1,119 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file ThreadPool.hpp
+ * A fixed set of worker threads for running index-parallel loops.
+ */
+
+#ifndef GPSTK_THREADPOOL_HPP
+#define GPSTK_THREADPOOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace gpstk
+{
+      /** A fixed set of worker threads that execute task(i) for
+       * every i in [0,n).  The calling thread takes part in the work,
+       * so a pool of size 1 has no worker threads and runs every loop
+       * serially in the caller.  Indices are handed out in increasing
+       * order but may complete in any order; callers that need
+       * ordered or deterministic results should have each task write
+       * only to its own slot (e.g. element i of a pre-sized vector)
+       * and combine the slots after run() returns.
+       *
+       * run() must not be called concurrently, or from within a task,
+       * on the same pool. */
+   class ThreadPool
+   {
+   public:
+         /** Start the worker threads.
+          * @param[in] nThreads total number of threads, including the
+          *   caller, used by run(); 0 means defaultSize(). */
+      explicit ThreadPool(unsigned nThreads = 0);
+
+         /// Stop and join the worker threads.
+      ~ThreadPool();
+
+         /// Number of threads (including the caller) used by run().
+      unsigned size() const
+      { return workers.size() + 1; }
+
+         /** Call task(i) for each i in [0,n) and return when all calls
+          * have completed.  If any call throws, the remaining calls
+          * still run, and the exception thrown by the call with the
+          * lowest index is rethrown here. */
+      void run(size_t n, const std::function<void(size_t)>& task);
+
+         /** The number of hardware threads, or 1 if that cannot be
+          * determined. */
+      static unsigned defaultSize();
+
+   private:
+      ThreadPool(const ThreadPool&);
+      ThreadPool& operator=(const ThreadPool&);
+
+         /// Worker thread body.
+      void workerLoop();
+
+         /// Execute indices of the current loop until none remain.
+      void drain(const std::function<void(size_t)>& task, size_t n);
+
+      std::vector<std::thread> workers;
+      std::mutex mtx;
+      std::condition_variable cvWork;   ///< signalled when a loop starts
+      std::condition_variable cvDone;   ///< signalled when busy reaches 0
+
+      const std::function<void(size_t)> *job; ///< current loop, or NULL
+      size_t jobSize;                   ///< number of indices in job
+      std::atomic<size_t> nextIndex;    ///< next index to hand out
+      unsigned long generation;         ///< incremented per loop
+      unsigned busy;                    ///< threads inside the current loop
+      bool stopping;
+
+      std::exception_ptr error;         ///< exception from errorIndex
+      size_t errorIndex;                ///< lowest index that threw
+   }; // end class ThreadPool
+
+} // namespace gpstk
+
+#endif // GPSTK_THREADPOOL_HPP
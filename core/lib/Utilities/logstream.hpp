@@ -276,6 +276,16 @@ public:
    /// @endcode
    static std::ostream*& Stream();
 
+   /// get/set a stream that replaces Stream() for log output written by the
+   /// calling thread only; NULL (the default) means use Stream(). This lets a
+   /// worker thread collect its log output so that it may be written to the
+   /// log in a deterministic order; see class LogCapture.
+   static std::ostream*& ThreadStream();
+
+   /// the stream to which the calling thread writes: ThreadStream() if set,
+   /// else Stream()
+   static std::ostream* Current();
+
    /// used internally
    static void Output(const std::string& msg);
 };
@@ -286,15 +296,64 @@ inline std::ostream*& ConfigureLOGstream::Stream()
    return pStream;
 }
 
+inline std::ostream*& ConfigureLOGstream::ThreadStream()
+{
+   static thread_local std::ostream *pThreadStream = NULL;
+   return pThreadStream;
+}
+
+inline std::ostream* ConfigureLOGstream::Current()
+{
+   std::ostream *pStream = ThreadStream();
+   return (pStream ? pStream : Stream());
+}
+
 inline void ConfigureLOGstream::Output(const std::string& msg)
 {   
-   std::ostream *pStream = Stream();
+   std::ostream *pStream = Current();
    if(!pStream) return;
    *pStream << msg << std::flush;
 }
 
 //----- end class ConfigureLOGstream
 
+/// While in scope, send the log output of the calling thread to a string rather
+/// than to the log stream, by setting ConfigureLOGstream::ThreadStream(); the
+/// output is appended to the string when this is destroyed, for example
+/// @code
+///    std::string log;
+///    {
+///       LogCapture capture(log);
+///       // ... work that uses LOG(level) and LOGstrm ...
+///    }
+///    LOG(INFO) << log;     // later, in the main thread
+/// @endcode
+class LogCapture {
+public:
+   /// start capturing the calling thread's log output, to be appended to s
+   explicit LogCapture(std::string& s) throw()
+      : str(s), pPrevious(ConfigureLOGstream::ThreadStream())
+      { ConfigureLOGstream::ThreadStream() = &oss; }
+
+   /// restore the previous thread stream and append the captured output
+   ~LogCapture() throw()
+      { ConfigureLOGstream::ThreadStream() = pPrevious; str += oss.str(); }
+
+   /// the stream receiving the output, for code that writes to a stream directly
+   std::ostream& stream() throw()
+      { return oss; }
+
+private:
+   LogCapture(const LogCapture&);               // not copyable
+   LogCapture& operator=(const LogCapture&);
+
+   std::string& str;
+   std::ostream *pPrevious;
+   std::ostringstream oss;
+};
+
+//----- end class LogCapture
+
 /// class ConfigureLOG - inherits class Log with type ConfigureLOGstream
 class ConfigureLOG : public Log<ConfigureLOGstream> {
 public:
@@ -334,7 +393,7 @@ template<> bool Log<ConfigureLOGstream>::dumpLevels = false;
 
 // conveniences
 #define pLOGstrm ConfigureLOGstream::Stream()
-#define LOGstrm *(ConfigureLOGstream::Stream())
+#define LOGstrm *(ConfigureLOGstream::Current())
 #define LOGlevel ConfigureLOG::ReportingLevel()
 //#define showLOGlevel ConfigureLOG::ReportLevels()
 //#define showLOGtime ConfigureLOG::ReportTimeTags()
@@ -34,18 +34,150 @@
 //
 //==============================================================================
 
+#include "RTFileFrame.hpp"
+#include "build_config.h"
 #include "TestUtil.hpp"
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+
+using namespace std;
+using namespace gpstk;
+
+   /// RTFileFrame of whitespace-separated words in a text file
+typedef RTFileFrame<ifstream, string> WordFrame;
 
 class RTFileFrame_T
 {
-        public: 
-		RTFileFrame_T(){}// Default Constructor, set the precision value
-		~RTFileFrame_T() {} // Default Desructor
+public:
+   RTFileFrame_T()
+   {
+      fileName = getPathTestTemp() + getFileSep() + "test_output_rtfileframe.txt";
+   }
+
+   ~RTFileFrame_T()
+   { remove(fileName.c_str()); }
+
+   void write(const string& s, ios::openmode mode = ios::app)
+   {
+      ofstream out(fileName.c_str(), mode);
+      out << s;
+   }
+
+      /// Only complete records are returned; appended data is read
+      /// from where the last read stopped.
+   unsigned appendTest()
+   {
+      TUDEF("RTFileFrame", "getRecord");
+      write("rec1\nrec2\nrec3\npar", ios::out|ios::trunc);
+      WordFrame rtf((FileSpec(fileName)));
+      vector<string> got;
+      while (rtf.getRecord())
+         got.push_back(rtf.data());
+      TUASSERTE(size_t, 3, got.size());
+      if (got.size() == 3)
+         TUASSERTE(string, "rec3", got[2]);
+
+         // complete the partial record and add another
+      write("tial\nrec5\n");
+      rtf.waitForData(0);
+      got.clear();
+      while (rtf.getRecord())
+         got.push_back(rtf.data());
+      TUASSERTE(size_t, 2, got.size());
+      if (got.size() == 2)
+      {
+         TUASSERTE(string, "partial", got[0]);
+         TUASSERTE(string, "rec5", got[1]);
+      }
+      TUASSERTE(unsigned, 5, rtf.getLatencyStats().N());
+      TUASSERT(rtf.getLastLatency() >= 0.0);
+      TURETURN();
+   }
+
+      /// In Notify mode the wait ends when the file is written.
+   unsigned notifyTest()
+   {
+      TUDEF("RTFileFrame", "waitForChange");
+      write("rec1\n", ios::out|ios::trunc);
+      WordFrame rtf((FileSpec(fileName)));
+      rtf.setWaitMode(RTFileFrameHelper::Notify);
+      TUASSERT(rtf.getRecord());
+      TUASSERT(!rtf.getRecord());
+
+         // nothing is written: times out
+      TUASSERT(!rtf.waitForChange(50));
+
+      thread writer([this]()
+                    {
+                       this_thread::sleep_for(chrono::milliseconds(100));
+                       write("rec2\n");
+                    });
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      rtf.waitForData(20);
+      double waited = chrono::duration<double>(
+         chrono::steady_clock::now() - t0).count();
+      writer.join();
+      TUASSERT(waited < 10.0);
+      TUASSERT(rtf.getRecord());
+      TUASSERTE(string, "rec2", rtf.data());
+      TUASSERT(rtf.getLastLatency() >= 0.0 && rtf.getLastLatency() < 10.0);
+      TUASSERT(!rtf.getRecord());
+      TURETURN();
+   }
+
+      /// The last record of a past day's file is kept even without
+      /// a line end; today's file is then read in Smart mode.
+   unsigned pastDayTest()
+   {
+      TUDEF("RTFileFrame", "getRecord");
+      string spec = getPathTestTemp() + getFileSep() +
+         "test_output_rtfileframe%04Y%03j.txt";
+      CommonTime today = MJD(floor(MJD(SystemTime()).mjd));
+      CommonTime yesterday = today - SEC_PER_DAY;
+      FileSpec fs(spec);
+      string pastName = fs.toString(yesterday), todayName = fs.toString(today);
+      {
+         ofstream out(pastName.c_str());
+         out << "rec1\nrec2";
+      }
+      {
+         ofstream out(todayName.c_str());
+         out << "rec3\npar";
+      }
+      WordFrame rtf(fs, yesterday, today, RTFileFrameHelper::FromTheBeginning,
+                    RTFileFrameHelper::Smart);
+      rtf.openCurrentFile();
+      vector<string> got;
+      while (rtf.getRecord())
+         got.push_back(rtf.data());
+      TUASSERTE(size_t, 3, got.size());
+      if (got.size() == 3)
+      {
+         TUASSERTE(string, "rec2", got[1]);
+         TUASSERTE(string, "rec3", got[2]);
+      }
+      remove(pastName.c_str());
+      remove(todayName.c_str());
+      TURETURN();
+   }
+
+   string fileName;
 };
 
 
-int main() //Main function to initialize and run all tests above
+int main()
 {
-	return 0; //Return the total number of errors
+   unsigned errorTotal = 0;
+   RTFileFrame_T testClass;
+   errorTotal += testClass.appendTest();
+   errorTotal += testClass.notifyTest();
+   errorTotal += testClass.pastDayTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
 }
@@ -0,0 +1,225 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /** Check that the memory-mapped Rinex3ObsStream reader produces
+    * exactly the same records, stream states and errors as the
+    * normal std::getline based reader. */
+class Rinex3ObsMapped_T
+{
+public:
+   Rinex3ObsMapped_T()
+   {
+      dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   }
+
+      /// Read every record of fn in both modes and compare them.
+   int equivalenceTest(void);
+      /// Errors must be reported the same way in both modes.
+   int errorTest(void);
+
+private:
+      /// Read all records from fn, returning the number of records.
+   unsigned readAll(const string& fn, bool mapped,
+                    vector<Rinex3ObsData>& recs, bool& failed);
+
+   bool sameRecord(const Rinex3ObsData& a, const Rinex3ObsData& b);
+
+   string dataFilePath;
+};
+
+
+unsigned Rinex3ObsMapped_T ::
+readAll(const string& fn, bool mapped, vector<Rinex3ObsData>& recs,
+        bool& failed)
+{
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsHeader hdr;
+   Rinex3ObsData rod;
+   strm >> hdr;
+   if (mapped)
+      strm.enableMappedRead();
+   while (strm >> rod)
+      recs.push_back(rod);
+   failed = !strm.eof();
+   return recs.size();
+}
+
+
+bool Rinex3ObsMapped_T ::
+sameRecord(const Rinex3ObsData& a, const Rinex3ObsData& b)
+{
+   if (a.time != b.time || a.epochFlag != b.epochFlag ||
+       a.numSVs != b.numSVs || a.clockOffset != b.clockOffset ||
+       a.obs.size() != b.obs.size())
+      return false;
+   Rinex3ObsData::DataMap::const_iterator ai, bi;
+   for (ai = a.obs.begin(), bi = b.obs.begin(); ai != a.obs.end();
+        ai++, bi++)
+   {
+      if (ai->first != bi->first || ai->second.size() != bi->second.size())
+         return false;
+      for (size_t i = 0; i < ai->second.size(); i++)
+      {
+         const RinexDatum &ad(ai->second[i]), &bd(bi->second[i]);
+         if (ad.data != bd.data || ad.dataBlank != bd.dataBlank ||
+             ad.lli != bd.lli || ad.lliBlank != bd.lliBlank ||
+             ad.ssi != bd.ssi || ad.ssiBlank != bd.ssiBlank)
+            return false;
+      }
+   }
+   return true;
+}
+
+
+int Rinex3ObsMapped_T ::
+equivalenceTest(void)
+{
+   TUDEF("Rinex3ObsStream", "enableMappedRead");
+
+   const char *files[] =
+      { "test_input_rinex3_obs_RinexObsFile.15o",
+        "test_input_rinex3_obs_SystemMixed.15o",
+        "test_input_rinex3_obs_SystemGlonass.15o",
+        "test_input_rinex3_obs_FilterTest1.15o",
+        "test_input_rinex3_76193040.14o",
+           // RINEX 2 files ignore the mapped mode
+        "arlm200a.15o" };
+
+   for (unsigned f = 0; f < sizeof(files)/sizeof(files[0]); f++)
+   {
+      string fn(dataFilePath + files[f]);
+      vector<Rinex3ObsData> plain, mapped;
+      bool plainFailed, mappedFailed;
+      readAll(fn, false, plain, plainFailed);
+      readAll(fn, true, mapped, mappedFailed);
+      testFramework.assert(!plain.empty(), string("records in ") + files[f],
+                           __LINE__);
+      testFramework.assert(plain.size() == mapped.size(),
+                           string("record count for ") + files[f], __LINE__);
+      testFramework.assert(plainFailed == mappedFailed,
+                           string("final state for ") + files[f], __LINE__);
+      bool same = true;
+      for (size_t i = 0; same && i < plain.size() && i < mapped.size(); i++)
+         same = sameRecord(plain[i], mapped[i]);
+      testFramework.assert(same, string("record contents for ") + files[f],
+                           __LINE__);
+   }
+
+      // Switching modes in the middle of a file must not lose data.
+   TUCSM("disableMappedRead");
+   string fn(dataFilePath + files[0]);
+   vector<Rinex3ObsData> plain;
+   bool failed;
+   readAll(fn, false, plain, failed);
+
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsData rod;
+   vector<Rinex3ObsData> mixed;
+   TUASSERT(strm.enableMappedRead());
+   TUASSERT(strm.isMappedRead());
+   while (strm >> rod)
+   {
+      mixed.push_back(rod);
+      if (strm.isMappedRead())
+         strm.disableMappedRead();
+      else
+         strm.enableMappedRead();
+   }
+   TUASSERTE(size_t, plain.size(), mixed.size());
+   bool same = true;
+   for (size_t i = 0; same && i < plain.size() && i < mixed.size(); i++)
+      same = sameRecord(plain[i], mixed[i]);
+   TUASSERT(same);
+
+   TURETURN();
+}
+
+
+int Rinex3ObsMapped_T ::
+errorTest(void)
+{
+   TUDEF("Rinex3ObsStream", "mappedGetLine");
+
+   const char *files[] =
+      { "test_input_rinex3_obs_BadEpochFlag.15o",
+        "test_input_rinex3_obs_BadLineSize.15o",
+        "test_input_rinex3_obs_InvalidLineLength.15o",
+        "test_input_rinex3_obs_InvalidTimeFormat.15o" };
+
+   for (unsigned f = 0; f < sizeof(files)/sizeof(files[0]); f++)
+   {
+      string fn(dataFilePath + files[f]);
+      vector<Rinex3ObsData> plain, mapped;
+      bool plainFailed, mappedFailed;
+      readAll(fn, false, plain, plainFailed);
+      readAll(fn, true, mapped, mappedFailed);
+      testFramework.assert(plain.size() == mapped.size(),
+                           string("records before error in ") + files[f],
+                           __LINE__);
+      testFramework.assert(plainFailed == mappedFailed,
+                           string("error state for ") + files[f], __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsMapped_T testClass;
+
+   errorTotal += testClass.equivalenceTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,145 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsReadBench.cpp
+ * Compare the time taken to read RINEX 3 observation files through
+ * the normal Rinex3ObsStream path and the memory-mapped path.
+ *
+ * Usage: Rinex3ObsReadBench [-n repeat] [file ...]
+ * With no files, the RINEX 3 observation files in the test data
+ * directory are used.
+ */
+
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+
+#include "build_config.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Read every record of fn, returning the number of observations.
+static unsigned long readFile(const string& fn, bool mapped,
+                              unsigned long& epochs)
+{
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsHeader hdr;
+   Rinex3ObsData rod;
+   unsigned long count = 0;
+   strm >> hdr;
+   if (mapped && !strm.enableMappedRead())
+      cerr << "Unable to map " << fn << endl;
+   while (strm >> rod)
+   {
+      epochs++;
+      Rinex3ObsData::DataMap::const_iterator i;
+      for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+         count += i->second.size();
+   }
+   return count;
+}
+
+
+   /// Time repeat passes over all files, returning seconds.
+static double timeRead(const vector<string>& files, bool mapped,
+                       unsigned repeat, unsigned long& obs,
+                       unsigned long& epochs)
+{
+   typedef chrono::steady_clock Clock;
+   obs = epochs = 0;
+   Clock::time_point start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (size_t f = 0; f < files.size(); f++)
+         obs += readFile(files[f], mapped, epochs);
+   return chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned repeat = 20;
+   vector<string> files;
+   for (int i = 1; i < argc; i++)
+   {
+      if (!strcmp(argv[i], "-n") && i+1 < argc)
+         repeat = atoi(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+   if (files.empty())
+   {
+      string dp(getPathData() + getFileSep());
+      files.push_back(dp + "test_input_rinex3_76193040.14o");
+      files.push_back(dp + "test_input_rinex3_obs_RinexObsFile.15o");
+      files.push_back(dp + "test_input_rinex3_obs_SystemMixed.15o");
+   }
+
+   unsigned long obsStream, obsMapped, epochs;
+      // warm the page cache so both modes read from memory
+   timeRead(files, false, 1, obsStream, epochs);
+
+   double tStream = timeRead(files, false, repeat, obsStream, epochs);
+   double tMapped = timeRead(files, true, repeat, obsMapped, epochs);
+
+   cout << fixed << setprecision(4)
+        << "files: " << files.size() << "  passes: " << repeat
+        << "  epochs: " << epochs << "  observations: " << obsStream << endl
+        << "stream: " << setw(10) << tStream << " s  "
+        << setprecision(1) << setw(10) << (epochs/tStream) << " epochs/s" << endl
+        << setprecision(4)
+        << "mapped: " << setw(10) << tMapped << " s  "
+        << setprecision(1) << setw(10) << (epochs/tMapped) << " epochs/s" << endl
+        << setprecision(2)
+        << "speedup: " << (tStream/tMapped) << "x" << endl;
+
+   if (obsStream != obsMapped)
+   {
+      cerr << "Observation counts differ: " << obsStream << " vs "
+           << obsMapped << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,202 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "SnapshotFile.hpp"
+#include "BinUtils.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class SnapshotFile_T
+{
+public:
+   SnapshotFile_T()
+   {
+      fileName = gpstk::getPathTestTemp() + "/SnapshotFile_T.snap";
+   }
+
+      /// Check that snapshotCRC is the standard CRC-32
+   unsigned crcTest()
+   {
+      TUDEF("SnapshotFile", "snapshotCRC");
+      const char *msg = "123456789";
+      TUASSERTE(uint32_t, 0xCBF43926u,
+                gpstk::snapshotCRC((const unsigned char*)msg, 9));
+      vector<unsigned char> buf(1000);
+      for (unsigned i = 0; i < buf.size(); i++)
+         buf[i] = (unsigned char)(i * 37 + 11);
+      TUASSERTE(uint32_t,
+                gpstk::BinUtils::computeCRC(&buf[0], buf.size(),
+                                            gpstk::BinUtils::CRC32),
+                gpstk::snapshotCRC(&buf[0], buf.size()));
+      TURETURN();
+   }
+
+      /// Write every field type and read it back
+   unsigned roundTripTest()
+   {
+      TUDEF("SnapshotFile", "write");
+      gpstk::CommonTime t(gpstk::CommonTime::BEGINNING_OF_TIME);
+      t.setInternal(2457000, 43200123, 0.000456789, gpstk::TimeSystem::GAL);
+      gpstk::SatID sat(17, gpstk::SatID::systemBeiDou);
+      try
+      {
+         gpstk::SnapshotWriter w("TestKind");
+         w.putInt(-1234567890123LL);
+         w.putDouble(3.14159265358979);
+         w.putBool(true);
+         w.putString("seven c");
+         w.putString("");
+         w.putTime(t);
+         w.putSatID(sat);
+         TUASSERTE(size_t, 12*8, w.size());
+         w.write(fileName);
+
+         TUCSM("open");
+         gpstk::SnapshotReader r;
+         r.open(fileName, "TestKind");
+         TUASSERTE(int64_t, -1234567890123LL, r.getInt());
+         TUASSERTE(double, 3.14159265358979, r.getDouble());
+         TUASSERTE(bool, true, r.getBool());
+         TUASSERTE(string, "seven c", r.getString());
+         TUASSERTE(string, "", r.getString());
+         gpstk::CommonTime t2 = r.getTime();
+         TUASSERTE(gpstk::CommonTime, t, t2);
+         TUASSERT(t.getTimeSystem() == t2.getTimeSystem());
+         TUASSERTE(gpstk::SatID, sat, r.getSatID());
+         TUASSERT(r.atEnd());
+         try
+         {
+            r.getInt();
+            TUFAIL("Read past end did not throw");
+         }
+         catch (gpstk::SnapshotException& e)
+         {
+            TUPASS("Read past end threw");
+         }
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+      /// Check that damaged or mismatched files are rejected
+   unsigned integrityTest()
+   {
+      TUDEF("SnapshotFile", "open");
+      gpstk::SnapshotWriter w("TestKind");
+      for (int i = 0; i < 100; i++)
+         w.putDouble(i * 0.5);
+      w.write(fileName);
+
+      gpstk::SnapshotReader r;
+      TUASSERT(opens(r, fileName, "TestKind"));
+      TUASSERT(!opens(r, fileName, "OtherKind"));
+      TUASSERT(!opens(r, fileName + ".missing", "TestKind"));
+
+         // read the file, then write damaged copies of it
+      ifstream in(fileName.c_str(), ios::binary);
+      string image((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+      in.close();
+      string damaged = gpstk::getPathTestTemp() + "/SnapshotFile_T_bad.snap";
+
+      string bad(image);
+      bad[gpstk::SnapshotWriter::headerSize + 100] ^= 0x01;
+      writeImage(damaged, bad);
+      TUASSERT(!opens(r, damaged, "TestKind"));
+
+      bad = image;
+      bad[8] = 99;
+      writeImage(damaged, bad);
+      TUASSERT(!opens(r, damaged, "TestKind"));
+
+      writeImage(damaged, image.substr(0, image.size() - 8));
+      TUASSERT(!opens(r, damaged, "TestKind"));
+
+      writeImage(damaged, image.substr(0, 20));
+      TUASSERT(!opens(r, damaged, "TestKind"));
+
+      writeImage(damaged, image);
+      TUASSERT(opens(r, damaged, "TestKind"));
+
+      std::remove(damaged.c_str());
+      std::remove(fileName.c_str());
+      TURETURN();
+   }
+
+private:
+   static bool opens(gpstk::SnapshotReader& r, const string& fn,
+                     const string& kind)
+   {
+      try
+      {
+         r.open(fn, kind);
+         return true;
+      }
+      catch (gpstk::SnapshotException& e)
+      {
+         return false;
+      }
+   }
+
+   static void writeImage(const string& fn, const string& image)
+   {
+      ofstream out(fn.c_str(), ios::binary | ios::trunc);
+      out.write(image.data(), image.size());
+   }
+
+   string fileName;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   SnapshotFile_T testClass;
+   total += testClass.crcTest();
+   total += testClass.roundTripTest();
+   total += testClass.integrityTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
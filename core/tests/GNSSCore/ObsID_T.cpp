@@ -39,6 +39,9 @@
 #include "TestUtil.hpp"
 #include <iostream>
 #include <sstream>
+#include <set>
+#include <thread>
+#include <vector>
 
 class ObsID_T
 {
@@ -229,6 +232,48 @@ public:
 
       return testFramework.countFails();
    }
+
+
+      /// Create the same new ids from several threads at once.
+   int threadTest(void)
+   {
+      TUDEF("ObsID", "ObsID(string)");
+
+      std::vector<std::string> ids;
+      for (char c = 'a'; c <= 'z'; c++)
+      {
+         ids.push_back(std::string("o") + "y" + c);
+         ids.push_back(std::string("p") + "z" + c);
+      }
+
+      std::vector< std::vector<gpstk::ObsID> > got(4);
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < got.size(); t++)
+         threads.push_back(std::thread([&ids, &got, t]() {
+            for (unsigned i = 0; i < ids.size(); i++)
+               got[t].push_back(gpstk::ObsID(ids[i]));
+         }));
+      for (unsigned t = 0; t < threads.size(); t++)
+         threads[t].join();
+
+         // every thread got the same ids, and each new character has its
+         // own value
+      bool same = true;
+      for (unsigned t = 1; t < got.size(); t++)
+         for (unsigned i = 0; i < ids.size(); i++)
+            same = same && (got[t][i].type == got[0][i].type) &&
+               (got[t][i].band == got[0][i].band) &&
+               (got[t][i].code == got[0][i].code);
+      TUASSERT(same);
+      std::set<gpstk::ObsID::TrackingCode> codes;
+      for (unsigned i = 0; i < ids.size(); i += 2)
+         codes.insert(got[0][i].code);
+      TUASSERTE(size_t, 26, codes.size());
+      TUASSERT(got[0][0].type != got[0][1].type);
+      TUASSERT(got[0][0].band != got[0][1].band);
+
+      TURETURN();
+   }
 };
 
 int main()
@@ -254,6 +299,9 @@ int main()
 	check = testClass.operatorTest();
 	errorCounter += check;
 
+	check = testClass.threadTest();
+	errorCounter += check;
+
 	std::cout << "Total Failures for " << __FILE__ << ": " << errorCounter << std::endl;
 
 	return errorCounter;
@@ -0,0 +1,261 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cstdio>
+#include <sstream>
+
+#include "OrbitEphStore.hpp"
+#include "PositionSatStore.hpp"
+#include "ClockSatStore.hpp"
+#include "GPSEphemeris.hpp"
+#include "GalEphemeris.hpp"
+#include "BDSEphemeris.hpp"
+#include "QZSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class EphemerisSnapshot_T
+{
+public:
+   EphemerisSnapshot_T()
+   {
+      fileName = gpstk::getPathTestTemp() + "/EphemerisSnapshot_T.snap";
+   }
+
+      /** Fill an OrbitEphStore with every OrbitEph type, write it to
+       * a snapshot, read it back and check the contents match. */
+   unsigned orbitEphTest()
+   {
+      TUDEF("OrbitEphStore", "writeBinaryFile");
+      gpstk::OrbitEphStore store;
+      string navFile = gpstk::getPathData() +
+         "/test_input_rinex3_76193040.14n";
+      try
+      {
+         gpstk::Rinex3NavStream strm(navFile.c_str());
+         gpstk::Rinex3NavHeader head;
+         gpstk::Rinex3NavData data;
+         strm >> head;
+         while (strm >> data)
+         {
+            gpstk::GPSEphemeris gps(data);
+            store.addEphemeris(&gps);
+               // re-use the GPS records as the other orbit types,
+               // which exercises their own snapshot fields
+            gpstk::Rinex3NavData other(data);
+            other.sat = gpstk::RinexSatID(data.sat.id,
+                                          gpstk::SatID::systemGalileo);
+            other.satSys = "E";
+            gpstk::GalEphemeris gal(other);
+            store.addEphemeris(&gal);
+               // BeiDou has its own time system, so fill it by hand
+            gpstk::BDSEphemeris bds;
+            static_cast<gpstk::OrbitEph&>(bds) = gps;
+            bds.satID = gpstk::SatID(data.sat.id, gpstk::SatID::systemBeiDou);
+            bds.transmitTime = gps.transmitTime;
+            bds.HOWtime = gps.HOWtime;
+            bds.IODE = gps.IODE;
+            bds.IODC = gps.IODC;
+            bds.health = gps.health;
+            bds.accuracy = gps.accuracy;
+            bds.Tgd13 = gps.Tgd;
+            bds.Tgd23 = -gps.Tgd;
+            bds.fitDuration = gps.fitDuration;
+            store.addEphemeris(&bds);
+            other.sat = gpstk::RinexSatID(data.sat.id,
+                                          gpstk::SatID::systemQZSS);
+            other.satSys = "J";
+            gpstk::QZSEphemeris qzs(other);
+            store.addEphemeris(&qzs);
+         }
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("Unable to load " + navFile);
+         TURETURN();
+      }
+      TUASSERT(store.size() > 12);
+
+      try
+      {
+         store.writeBinaryFile(fileName);
+         TUCSM("readBinaryFile");
+         gpstk::OrbitEphStore copy;
+         copy.readBinaryFile(fileName);
+         TUASSERTE(unsigned, store.size(), copy.size());
+         ostringstream expected, got;
+         store.dump(expected, 2);
+         copy.dump(got, 2);
+         TUASSERTE(string, expected.str(), got.str());
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("Unexpected exception");
+      }
+
+         // a snapshot of another kind of store must be refused
+      gpstk::ClockSatStore clocks;
+      clocks.writeBinaryFile(fileName);
+      gpstk::OrbitEphStore copy;
+      try
+      {
+         copy.readBinaryFile(fileName);
+         TUFAIL("Read of a ClockSatStore snapshot did not throw");
+      }
+      catch (gpstk::SnapshotException& e)
+      {
+         TUPASS("Read of a ClockSatStore snapshot threw");
+      }
+      std::remove(fileName.c_str());
+      TURETURN();
+   }
+
+      /// Round trip a PositionSatStore through a snapshot
+   unsigned positionTest()
+   {
+      TUDEF("PositionSatStore", "writeBinaryFile");
+      gpstk::PositionSatStore store;
+      store.rejectBadPositions(false);
+      gpstk::CommonTime t0 = gpstk::CivilTime(2015, 7, 19, 0, 0, 0.0,
+                                              gpstk::TimeSystem::GPS);
+      for (int prn = 1; prn <= 5; prn++)
+      {
+         gpstk::SatID sat(prn, gpstk::SatID::systemGPS);
+         for (int i = 0; i < 20; i++)
+         {
+            gpstk::PositionRecord rec;
+            rec.Pos = gpstk::Triple(prn*1000.+i, -2000.5*i, 0.125*i);
+            rec.sigPos = gpstk::Triple(0.1, 0.2, 0.3);
+            rec.Vel = gpstk::Triple(i*1.5, prn*-2.5, 3.5);
+            rec.sigVel = gpstk::Triple(0.01, 0.02, 0.03);
+            rec.Acc = gpstk::Triple(1e-3, 2e-3, i*3e-3);
+            rec.sigAcc = gpstk::Triple(1e-5, 2e-5, 3e-5);
+            store.addPositionRecord(sat, t0 + 900.0*i, rec);
+         }
+      }
+      try
+      {
+         store.writeBinaryFile(fileName);
+         TUCSM("readBinaryFile");
+         gpstk::PositionSatStore copy;
+         copy.readBinaryFile(fileName);
+         TUASSERTE(int, store.nsats(), copy.nsats());
+         TUASSERTE(int, store.ndata(), copy.ndata());
+         TUASSERTE(bool, store.hasVelocity(), copy.hasVelocity());
+         TUASSERTE(bool, store.hasAccleration(), copy.hasAccleration());
+         ostringstream expected, got;
+         store.dump(expected, 2);
+         copy.dump(got, 2);
+         TUASSERTE(string, expected.str(), got.str());
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("Unexpected exception");
+      }
+      std::remove(fileName.c_str());
+      TURETURN();
+   }
+
+      /// Round trip a ClockSatStore through a snapshot
+   unsigned clockTest()
+   {
+      TUDEF("ClockSatStore", "writeBinaryFile");
+      gpstk::ClockSatStore store;
+      store.rejectBadClocks(false);
+      gpstk::CommonTime t0 = gpstk::CivilTime(2015, 7, 19, 0, 0, 0.0,
+                                              gpstk::TimeSystem::GPS);
+      for (int prn = 1; prn <= 5; prn++)
+      {
+         gpstk::SatID sat(prn, gpstk::SatID::systemGalileo);
+         for (int i = 0; i < 20; i++)
+         {
+            gpstk::ClockRecord rec;
+            rec.bias = prn*1.e-4 + i*1.e-9;
+            rec.sig_bias = 1.e-10;
+            rec.drift = i*1.e-12;
+            rec.sig_drift = 1.e-14;
+            rec.accel = 0.0;
+            rec.sig_accel = 0.0;
+            store.addClockRecord(sat, t0 + 300.0*i, rec);
+         }
+      }
+      try
+      {
+         store.writeBinaryFile(fileName);
+         TUCSM("readBinaryFile");
+         gpstk::ClockSatStore copy;
+         copy.readBinaryFile(fileName);
+         TUASSERTE(int, store.nsats(), copy.nsats());
+         TUASSERTE(int, store.ndata(), copy.ndata());
+         TUASSERTE(bool, store.hasClockAccel(), copy.hasClockAccel());
+         ostringstream expected, got;
+         store.dump(expected, 2);
+         copy.dump(got, 2);
+         TUASSERTE(string, expected.str(), got.str());
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         TUFAIL("Unexpected exception");
+      }
+      std::remove(fileName.c_str());
+      TURETURN();
+   }
+
+private:
+   string fileName;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   EphemerisSnapshot_T testClass;
+   total += testClass.orbitEphTest();
+   total += testClass.positionTest();
+   total += testClass.clockTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
@@ -0,0 +1,240 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "EpochTable.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <map>
+#include <cstdlib>
+#include <cmath>
+
+using namespace gpstk;
+
+   /** Check EpochTable against std::map, which it replaces in
+    * TabularSatStore. */
+class EpochTable_T
+{
+public:
+   EpochTable_T()
+         : t0(GPSWeekSecond(1800, 345600.0))
+   {}
+   ~EpochTable_T() {}
+
+      /// Evenly spaced data, appended in time order.
+   int uniformTest(void)
+   {
+      TUDEF("EpochTable", "lower_bound");
+
+      EpochTable<double> table;
+      std::map<CommonTime,double> ref;
+      for(int i=0; i<96; i++)
+      {
+         CommonTime t(t0 + 900.0*i);
+         table[t] = i;
+         ref[t] = i;
+      }
+      TUASSERTE(size_t, ref.size(), table.size());
+      TUASSERT(table.isUniform());
+      TUASSERTFE(900.0, table.getStep());
+
+      testFramework.assert(compare(table, ref), "lookups match std::map",
+                           __LINE__);
+
+         // replacing an existing record keeps the table uniform
+      TUCSM("operator[]");
+      table[t0 + 900.0*10] = -1.0;
+      TUASSERTE(size_t, ref.size(), table.size());
+      TUASSERT(table.isUniform());
+      TUASSERTFE(-1.0, table.find(t0 + 900.0*10)->second);
+
+      TURETURN();
+   }
+
+      /// Irregular data inserted in random order, with gaps and edits.
+   int irregularTest(void)
+   {
+      TUDEF("EpochTable", "operator[]");
+
+      EpochTable<double> table;
+      std::map<CommonTime,double> ref;
+      std::srand(1234);
+      for(int i=0; i<400; i++)
+      {
+         CommonTime t(t0 + 30.0*(std::rand() % 1000));
+         if(i % 7 == 0)
+            t += 0.25;
+         table[t] = i;
+         ref[t] = i;
+      }
+      TUASSERTE(size_t, ref.size(), table.size());
+      TUASSERT(!table.isUniform());
+      testFramework.assert(compare(table, ref), "lookups match std::map",
+                           __LINE__);
+
+      TUCSM("erase");
+      CommonTime tmin(t0 + 30.0*200), tmax(t0 + 30.0*800);
+      table.erase(table.upper_bound(tmax), table.end());
+      ref.erase(ref.upper_bound(tmax), ref.end());
+      table.erase(table.begin(), table.lower_bound(tmin));
+      ref.erase(ref.begin(), ref.lower_bound(tmin));
+      TUASSERTE(size_t, ref.size(), table.size());
+      testFramework.assert(compare(table, ref), "lookups match std::map",
+                           __LINE__);
+
+         // a gap in otherwise even data
+      TUCSM("isUniform");
+      EpochTable<double> gap;
+      for(int i=0; i<10; i++)
+         gap[t0 + 60.0*i + (i > 5 ? 600.0 : 0.0)] = i;
+      TUASSERT(!gap.isUniform());
+      gap.erase(gap.lower_bound(t0 + 60.0*6), gap.end());
+      TUASSERT(gap.isUniform());
+
+      TURETURN();
+   }
+
+      /** Inserts and erases anywhere in the table keep the spacing
+       * bookkeeping the same as working it out from scratch. */
+   int spacingTest(void)
+   {
+      TUDEF("EpochTable", "isUniform");
+
+         // filling the only gap, or erasing the only odd record, makes
+         // the table uniform again
+      EpochTable<double> table;
+      for(int i=0; i<10; i++)
+         if(i != 4)
+            table[t0 + 30.0*i] = i;
+      TUASSERT(!table.isUniform());
+      table[t0 + 30.0*4] = 4;
+      TUASSERT(table.isUniform());
+      TUASSERTFE(30.0, table.getStep());
+      table[t0 + 30.0*4 + 10.0] = -1;
+      TUASSERT(!table.isUniform());
+      table.erase(table.find(t0 + 30.0*4 + 10.0),
+                  table.upper_bound(t0 + 30.0*4 + 10.0));
+      TUASSERT(table.isUniform());
+
+         // dropping every other record doubles the step
+      for(int i=1; i<10; i+=2)
+         table.erase(table.find(t0 + 30.0*i), table.upper_bound(t0 + 30.0*i));
+      TUASSERT(table.isUniform());
+      TUASSERTFE(60.0, table.getStep());
+
+         // and random changes on a grid, at the ends and in the middle
+      std::srand(4321);
+      bool same = true;
+      for(int i=0; i<2000; i++)
+      {
+         CommonTime t(t0 + 60.0*(std::rand() % 40));
+         if(std::rand() % 3)
+            table[t] = i;
+         else
+         {
+            CommonTime t2(t + 60.0*(std::rand() % 4));
+            table.erase(table.lower_bound(t), table.upper_bound(t2));
+         }
+         same = same && (table.isUniform() == isEven(table));
+         if(table.isUniform())
+            same = same && (table.getStep() ==
+                            (table.begin()+1)->first - table.begin()->first);
+      }
+      TUASSERT(same);
+
+      TURETURN();
+   }
+
+private:
+      /// Return true if the table has at least two evenly spaced records.
+   bool isEven(const EpochTable<double>& table)
+   {
+      if(table.size() < 2)
+         return false;
+      double step((table.begin()+1)->first - table.begin()->first);
+      for(size_t i=2; i<table.size(); i++)
+      {
+         double dt((table.begin()+i)->first - (table.begin()+i-1)->first);
+         if(std::fabs(dt - step) > 1.0e-9 * step)
+            return false;
+      }
+      return true;
+   }
+
+      /// Compare every kind of lookup over a range of query times.
+   bool compare(const EpochTable<double>& table,
+                const std::map<CommonTime,double>& ref)
+   {
+      if(table.size() != ref.size())
+         return false;
+      EpochTable<double>::const_iterator ti(table.begin());
+      std::map<CommonTime,double>::const_iterator ri(ref.begin());
+      for( ; ri != ref.end(); ++ri, ++ti)
+         if(ti->first != ri->first || ti->second != ri->second)
+            return false;
+
+      for(double dt = -1000.0; dt < 100000.0; dt += 7.5)
+      {
+         CommonTime t(t0 + dt);
+         size_t tlb(table.lower_bound(t) - table.begin());
+         size_t rlb(std::distance(ref.begin(), ref.lower_bound(t)));
+         size_t tub(table.upper_bound(t) - table.begin());
+         size_t rub(std::distance(ref.begin(), ref.upper_bound(t)));
+         bool tf(table.find(t) != table.end());
+         bool rf(ref.find(t) != ref.end());
+         if(tlb != rlb || tub != rub || tf != rf)
+            return false;
+      }
+      return true;
+   }
+
+   CommonTime t0;
+};
+
+
+int main() //Main function to initialize and run all tests above
+{
+   int errorTotal = 0;
+   EpochTable_T testClass;
+
+   errorTotal += testClass.uniformTest();
+   errorTotal += testClass.irregularTest();
+   errorTotal += testClass.spacingTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal << std::endl;
+
+   return errorTotal; //Return the total number of errors
+}
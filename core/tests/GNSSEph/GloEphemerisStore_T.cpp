@@ -0,0 +1,221 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "GloEphemerisStore.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class GloEphemerisStore_T
+{
+public:
+   GloEphemerisStore_T()
+         : sat(3, gpstk::SatID::systemGlonass),
+           toe(gpstk::CivilTime(2016, 6, 18, 0, 15, 0.0,
+                                gpstk::TimeSystem::GLO))
+   {
+      eph.setRecord("R", 3, toe,
+                    gpstk::Triple(11248.90527344, -19824.31884766,
+                                  10945.61425781),
+                    gpstk::Triple(-2.791051864624, 0.7520551681519,
+                                  2.776451110840),
+                    gpstk::Triple(0.0, 1.862645149231e-9, 0.0),
+                    4.954e-5, 0.0, 0, 0, 1, 0.0);
+   }
+
+      /// Fill a store with two records of the same satellite, half an
+      /// hour apart.
+   void fillStore(gpstk::GloEphemerisStore& store)
+   {
+      store.addEphemeris(gpstk::Rinex3NavData(eph));
+      gpstk::GloEphemeris next(eph);
+      next.setRecord("R", 3, toe + 1800.0,
+                     gpstk::Triple(6303.64208984, -14908.17236328,
+                                   20280.69091797),
+                     gpstk::Triple(-2.620586395264, -2.744245529175,
+                                   -1.206010818481),
+                     gpstk::Triple(0.0, 9.313225746155e-10, 0.0),
+                     4.954e-5, 0.0, 1800, 0, 1, 0.0);
+      store.addEphemeris(gpstk::Rinex3NavData(next));
+   }
+
+      /** The interpolated trajectory must agree with direct integration
+       * to within the tolerance, anywhere in the fit interval, including
+       * at epochs that are not a whole number of steps away. */
+   unsigned getXvtTest()
+   {
+      TUDEF("GloEphemerisStore", "getXvt");
+      try
+      {
+         gpstk::GloEphemerisStore store;
+         fillStore(store);
+         TUASSERTFEPS(1.0e-4, store.getTrajectoryTolerance(), 1e-15);
+         const gpstk::GloEphemeris& rec(store.findEphemeris(sat, toe));
+         double tol(store.getTrajectoryTolerance());
+         double maxErr(0.0), maxVelErr(0.0);
+         for (double dt = -900.0; dt < 900.0; dt += 13.7)
+         {
+            gpstk::CommonTime t(toe + dt);
+            gpstk::Xvt fast(store.getXvt(sat, t));
+            gpstk::Xvt ref(rec.svXvt(t));
+            maxErr = std::max(maxErr, range(fast.x, ref.x));
+            maxVelErr = std::max(maxVelErr, range(fast.v, ref.v));
+            TUASSERTFEPS(ref.clkbias, fast.clkbias, 1e-15);
+            TUASSERTFEPS(ref.relcorr, fast.relcorr, 1e-12);
+         }
+         TUASSERT(maxErr <= tol);
+         TUASSERT(maxVelErr <= 1.0e-5);
+
+            // the ephemeris epoch itself is returned as broadcast
+         gpstk::Xvt xvt(store.getXvt(sat, toe));
+         TUASSERTFEPS(11248905.27344, xvt.x[0], 1e-5);
+         TUASSERTFEPS(-2791.051864624, xvt.v[0], 1e-8);
+
+            // disabling the cache gives the integrated result exactly
+         store.setTrajectoryTolerance(0.0);
+         gpstk::CommonTime t(toe + 417.3);
+         xvt = store.getXvt(sat, t);
+         gpstk::Xvt ref(rec.svXvt(t));
+         for (int i = 0; i < 3; i++)
+         {
+            TUASSERTE(double, ref.x[i], xvt.x[i]);
+            TUASSERTE(double, ref.v[i], xvt.v[i]);
+         }
+      }
+      catch (gpstk::Exception& exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+      /// The trajectory must honor the fit interval and be rebuilt when
+      /// the records change.
+   unsigned trajectoryTest()
+   {
+      TUDEF("GloEphemeris", "integrateFitInterval");
+      try
+      {
+         gpstk::GloEphemeris::Trajectory traj(eph.integrateFitInterval(1e-4));
+         TUASSERT(!traj.empty());
+         TUASSERT(traj.nodeStep > 0.0);
+            // nodes must cover the whole fit interval
+         TUASSERT(traj.start <= -900.0);
+         size_t nnodes(traj.nodes.size() /
+                       gpstk::GloEphemeris::Trajectory::nodeSize);
+         TUASSERT(traj.start + (nnodes-1)*traj.nodeStep >= 900.0);
+
+            // an impossible tolerance gives no trajectory
+         TUASSERT(eph.integrateFitInterval(1e-30).empty());
+
+         TUCSM("svXvt");
+         try
+         {
+            eph.svXvt(toe + 900.0, traj);
+            TUFAIL("Expected InvalidRequest");
+         }
+         catch (gpstk::InvalidRequest&)
+         {
+            TUPASS("InvalidRequest");
+         }
+         try
+         {
+            eph.svXvt(toe - 900.5, traj);
+            TUFAIL("Expected InvalidRequest");
+         }
+         catch (gpstk::InvalidRequest&)
+         {
+            TUPASS("InvalidRequest");
+         }
+
+            // an empty trajectory falls back to integration
+         gpstk::CommonTime t(toe - 321.0);
+         gpstk::Xvt a(eph.svXvt(t, gpstk::GloEphemeris::Trajectory()));
+         gpstk::Xvt b(eph.svXvt(t));
+         TUASSERTE(double, b.x[1], a.x[1]);
+
+         TUCSM("addEphemeris");
+         gpstk::GloEphemerisStore store;
+         fillStore(store);
+         gpstk::Xvt before(store.getXvt(sat, toe + 100.0));
+            // replacing a record must discard its cached trajectory
+         gpstk::GloEphemeris moved(eph);
+         moved.setRecord("R", 3, toe,
+                         gpstk::Triple(11248.90527344 + 1.0, -19824.31884766,
+                                       10945.61425781),
+                         gpstk::Triple(-2.791051864624, 0.7520551681519,
+                                       2.776451110840),
+                         gpstk::Triple(0.0, 1.862645149231e-9, 0.0),
+                         4.954e-5, 0.0, 0, 0, 1, 0.0);
+         store.addEphemeris(gpstk::Rinex3NavData(moved));
+         gpstk::Xvt after(store.getXvt(sat, toe + 100.0));
+         gpstk::Xvt ref(moved.svXvt(toe + 100.0));
+         TUASSERT(range(before.x, after.x) > 100.0);
+         TUASSERT(range(ref.x, after.x) <= store.getTrajectoryTolerance());
+      }
+      catch (gpstk::Exception& exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+private:
+   static double range(const gpstk::Triple& a, const gpstk::Triple& b)
+   {
+      return (a - b).mag();
+   }
+
+   gpstk::SatID sat;
+   gpstk::CommonTime toe;
+   gpstk::GloEphemeris eph;
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   GloEphemerisStore_T testClass;
+
+   errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.trajectoryTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
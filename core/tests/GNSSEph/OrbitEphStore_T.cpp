@@ -39,6 +39,7 @@
 #include "TimeString.hpp"
 #include "TestUtil.hpp"
 #include "GPSWeekSecond.hpp"
+#include <thread>
 
 using namespace std;
 
@@ -111,6 +112,320 @@ public:
       }
       TURETURN();
    }
+
+      /// Fill in a plausible set of GPS orbit elements.
+   static void setElements(gpstk::OrbitEph& eph, int prn, double dndot)
+   {
+      eph.dataLoadedFlag = true;
+      eph.satID = gpstk::SatID(prn, gpstk::SatID::systemGPS);
+      eph.obsID = gpstk::ObsID(gpstk::ObsID::otNavMsg,
+                               gpstk::ObsID::cbL1,
+                               gpstk::ObsID::tcCA);
+      eph.ctToe = gpstk::GPSWeekSecond(1917, 576000);
+      eph.ctToc = gpstk::GPSWeekSecond(1917, 576000);
+      eph.af0 = 7.24871344864e-05;
+      eph.af1 = 3.41060513165e-12;
+      eph.af2 = 0.;
+      eph.M0 = -2.4172396275 + prn * 0.1;
+      eph.dn = 4.70269045234e-09;
+      eph.ecc = 0.0105134742334 + prn * 1e-4;
+      eph.A = 5153.6572418 * 5153.6572418;
+      eph.OMEGA0 = 1.0368837265 + prn * 0.05;
+      eph.i0 = 0.966861158522;
+      eph.w = 0.639520025766;
+      eph.OMEGAdot = -8.30213439012e-09;
+      eph.idot = -3.82158775762e-10;
+      eph.dndot = dndot;
+      eph.Adot = (dndot == 0. ? 0. : 1.3e-3);
+      eph.Cuc = -5.9185922145e-07;
+      eph.Cus = 7.1693211794e-06;
+      eph.Crc = 247.28125;
+      eph.Crs = -10.6875;
+      eph.Cic = 9.685754776e-08;
+      eph.Cis = -1.3038516045e-07;
+      eph.beginValid = eph.ctToe - 7200;
+      eph.endValid = eph.ctToe + 7200;
+   }
+
+      /** Check that the batch evaluation gives exactly the same
+       * answers as the one-at-a-time evaluation. */
+   unsigned doBatchTests()
+   {
+      TUDEF("OrbitEph","svXvtBatch");
+      try
+      {
+         gpstk::OrbitEph lnav, cnav;
+         setElements(lnav, 5, 0.);
+         setElements(cnav, 9, 1.7e-13);
+
+            // more times than one processing block, and not a multiple
+         std::vector<gpstk::CommonTime> times;
+         for (int i = 0; i < 150; i++)
+            times.push_back(lnav.ctToe - 7000 + i * 93.5);
+
+         gpstk::XvtArray xvta;
+         for (int e = 0; e < 2; e++)
+         {
+            const gpstk::OrbitEph& eph = (e == 0 ? lnav : cnav);
+            eph.svXvtBatch(times, xvta);
+            TUASSERTE(size_t, times.size(), xvta.size());
+            bool same = true;
+            for (unsigned i = 0; i < times.size(); i++)
+            {
+               gpstk::Xvt exp = eph.svXvt(times[i]);
+               gpstk::Xvt got = xvta.getXvt(i);
+               same = same && (exp.x == got.x) && (exp.v == got.v) &&
+                  (exp.clkbias == got.clkbias) &&
+                  (exp.clkdrift == got.clkdrift) &&
+                  (exp.relcorr == got.relcorr) &&
+                  (exp.frame == got.frame);
+            }
+            TUASSERT(same);
+         }
+
+            // empty input
+         times.clear();
+         lnav.svXvtBatch(times, xvta);
+         TUASSERTE(size_t, 0, xvta.size());
+
+            // no data loaded
+         gpstk::OrbitEph empty;
+         try
+         {
+            times.push_back(lnav.ctToe);
+            empty.svXvtBatch(times, xvta);
+            TUFAIL("Expected InvalidRequest");
+         }
+         catch (gpstk::InvalidRequest& exc)
+         {
+            TUPASS("InvalidRequest");
+         }
+
+         TUCSM("getXvtBatch");
+         gpstk::OrbitEphStore store;
+         store.addEphemeris(&lnav);
+         store.addEphemeris(&cnav);
+         std::vector<gpstk::SatID> sats;
+         times.clear();
+         gpstk::SatID missing(17, gpstk::SatID::systemGPS);
+         for (int i = 0; i < 100; i++)
+         {
+               // interleave the satellites so the store has to regroup
+            sats.push_back(i % 3 == 0 ? missing :
+                           (i % 3 == 1 ? lnav.satID : cnav.satID));
+            times.push_back(lnav.ctToe - 3000 + i * 61.0);
+         }
+            // one request outside every fit interval
+         times[1] = lnav.ctToe + 86400;
+
+         std::vector<bool> valid;
+         unsigned count = store.getXvtBatch(sats, times, xvta, valid);
+         TUASSERTE(size_t, sats.size(), valid.size());
+         unsigned expCount = 0;
+         bool same = true;
+         for (unsigned i = 0; i < sats.size(); i++)
+         {
+            bool expValid = true;
+            gpstk::Xvt exp;
+            try
+            {
+               exp = store.getXvt(sats[i], times[i]);
+            }
+            catch (gpstk::InvalidRequest&)
+            {
+               expValid = false;
+            }
+            same = same && (expValid == valid[i]);
+            if (expValid)
+            {
+               expCount++;
+               gpstk::Xvt got = xvta.getXvt(i);
+               same = same && (exp.x == got.x) && (exp.v == got.v) &&
+                  (exp.clkbias == got.clkbias) &&
+                  (exp.relcorr == got.relcorr);
+            }
+         }
+         TUASSERT(same);
+         TUASSERTE(unsigned, expCount, count);
+         TUASSERT(!valid[0]);
+         TUASSERT(!valid[1]);
+         TUASSERT(valid[2]);
+
+         sats.pop_back();
+         try
+         {
+            store.getXvtBatch(sats, times, xvta, valid);
+            TUFAIL("Expected InvalidRequest");
+         }
+         catch (gpstk::InvalidRequest& exc)
+         {
+            TUPASS("InvalidRequest");
+         }
+      }
+      catch (gpstk::Exception &exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+      /** Load ephemerides two hours apart for several satellites, with
+       * a gap in the middle for some of them. */
+   static void fillStore(gpstk::OrbitEphStore& store)
+   {
+      for (int prn = 1; prn <= 8; prn++)
+      {
+         for (int k = 0; k < 13; k++)
+         {
+            if (prn % 3 == 0 && (k == 5 || k == 6))
+               continue;
+            gpstk::OrbitEph eph;
+            setElements(eph, prn, 0.);
+            eph.ctToe = gpstk::GPSWeekSecond(1917, 7200. * k);
+            eph.ctToc = eph.ctToe;
+               // begin at transmission, which differs between satellites
+            eph.beginValid = eph.ctToe - 7200 + 30 * prn;
+            eph.endValid = eph.ctToe + 7200;
+            store.addEphemeris(&eph);
+         }
+      }
+   }
+
+      /** Look up each (sat,time) in a store, returning the OrbitEph
+       * found. */
+   static void findAll(const gpstk::OrbitEphStore& store,
+                       const std::vector<gpstk::SatID>& sats,
+                       const std::vector<gpstk::CommonTime>& times,
+                       std::vector<const gpstk::OrbitEph*>& found)
+   {
+      found.clear();
+      for (unsigned i = 0; i < times.size(); i++)
+         for (unsigned j = 0; j < sats.size(); j++)
+            found.push_back(store.findOrbitEph(sats[j], times[i]));
+   }
+
+      /** Check that the frozen index finds exactly the OrbitEph that
+       * the maps do, for both search methods. */
+   unsigned doFrozenTests()
+   {
+      TUDEF("OrbitEphStore","freeze");
+      try
+      {
+         std::vector<gpstk::SatID> sats;
+         for (int prn = 0; prn <= 9; prn++)
+            sats.push_back(gpstk::SatID(prn, gpstk::SatID::systemGPS));
+         sats.push_back(gpstk::SatID(3, gpstk::SatID::systemGalileo));
+
+            // steadily increasing times, every key and the times around it
+         std::vector<gpstk::CommonTime> times;
+         gpstk::CommonTime t0 = gpstk::GPSWeekSecond(1917, 0);
+         for (double dt = -9000; dt < 7200. * 14; dt += 97.0)
+            times.push_back(t0 + dt);
+         for (int k = 0; k < 13; k++)
+            for (int prn = 1; prn <= 8; prn++)
+            {
+               gpstk::CommonTime key = t0 + 7200. * k - 7200 + 30 * prn;
+               times.push_back(key - 1e-9);
+               times.push_back(key);
+               times.push_back(key + 0.5);
+               times.push_back(t0 + 7200. * k);
+               times.push_back(t0 + 7200. * k + 7200);
+            }
+            // and some going backwards
+         for (int i = 0; i < 200; i++)
+            times.push_back(t0 + 7200. * 14 - i * 431.0);
+
+         for (int method = 0; method < 2; method++)
+         {
+            gpstk::OrbitEphStore store;
+            if (method == 1)
+               store.SearchNear();
+            fillStore(store);
+
+            std::vector<const gpstk::OrbitEph*> exp, got;
+            findAll(store, sats, times, exp);
+            TUASSERT(!store.isFrozen());
+            store.freeze();
+            TUASSERT(store.isFrozen());
+            findAll(store, sats, times, got);
+            TUASSERT(exp == got);
+            unsigned nfound = 0;
+            for (unsigned i = 0; i < exp.size(); i++)
+               nfound += (exp[i] != NULL);
+            TUASSERT(nfound > exp.size() / 2);
+            TUASSERT(nfound < exp.size());
+
+               // the same from several threads at once
+            std::vector< std::vector<const gpstk::OrbitEph*> > results(4);
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < results.size(); i++)
+               threads.push_back(std::thread(findAll, std::cref(store),
+                                             std::cref(sats),
+                                             std::cref(times),
+                                             std::ref(results[i])));
+            for (unsigned i = 0; i < threads.size(); i++)
+               threads[i].join();
+            for (unsigned i = 0; i < results.size(); i++)
+               TUASSERT(exp == results[i]);
+
+               // and through getXvt()
+            gpstk::Xvt xvt = store.getXvt(sats[1], t0 + 3600.);
+            TUASSERT(xvt.x.mag() > 2.0e7);
+
+               // a time in another system is rejected, frozen or not
+            gpstk::CommonTime galTime(t0 + 3600.);
+            galTime.setTimeSystem(gpstk::TimeSystem::GAL);
+            for (int frozen = 1; frozen >= 0; frozen--)
+            {
+               TUASSERTE(bool, frozen != 0, store.isFrozen());
+               bool threw = false;
+               try
+               {
+                  store.findOrbitEph(sats[1], galTime);
+               }
+               catch (gpstk::InvalidRequest&)
+               {
+                  threw = true;
+               }
+               TUASSERT(threw);
+                  // computeXvt() neither throws nor finds anything
+               TUASSERT(!store.computeXvt(sats[1], galTime, xvt));
+               store.unfreeze();
+            }
+            store.freeze();
+
+               // changing the store discards the index
+            gpstk::OrbitEph extra;
+            setElements(extra, 9, 0.);
+            store.addEphemeris(&extra);
+            TUASSERT(!store.isFrozen());
+            store.freeze();
+            TUASSERT(store.isFrozen());
+            TUASSERT(store.findOrbitEph(sats[9], extra.ctToe) != NULL);
+            store.edit(t0, t0 + 86400.);
+            TUASSERT(!store.isFrozen());
+            store.freeze();
+            store.clear();
+            TUASSERT(!store.isFrozen());
+            TUASSERT(store.findOrbitEph(sats[1], t0) == NULL);
+         }
+      }
+      catch (gpstk::Exception &exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
 };
 
 
@@ -119,6 +434,8 @@ int main(int argc, char *argv[])
    unsigned total = 0;
    OrbitEphStore_T testClass;
    total += testClass.doFindEphEmptyTests();
+   total += testClass.doBatchTests();
+   total += testClass.doFrozenTests();
 
    cout << "Total Failures for " << __FILE__ << ": " << total << endl;
    return total;
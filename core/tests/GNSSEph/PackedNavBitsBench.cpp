@@ -0,0 +1,245 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file PackedNavBitsBench.cpp
+ * Time the PackedNavBits operations used when decoding and filtering
+ * navigation messages: packing subframes, unpacking ephemeris
+ * fields, and the sort/match/hash done by the NavFilter classes.
+ * A bit-at-a-time decoder over std::vector<bool> is timed alongside
+ * as a reference.
+ *
+ * Usage: PackedNavBitsBench [-n subframes] [-r repeat]
+ */
+
+#include "PackedNavBits.hpp"
+#include "CivilTime.hpp"
+#include "SatID.hpp"
+#include "ObsID.hpp"
+#include "NavID.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// An ephemeris field as found in LNAV subframes 2 and 3
+struct Field
+{
+   int start, numBits, power2;
+   bool isSigned;
+};
+
+   /** Ephemeris fields of LNAV subframes 2 and 3, held back to back
+    * (with parity) in one 600-bit object.  The two pieces of each
+    * split field are listed separately. */
+static const Field fields[] =
+{
+   {  60,  8,   0, false }, // IODE
+   {  68, 16,  -5, true  }, // Crs
+   {  90, 16, -43, true  }, // delta n
+   { 106,  8, -31, true  }, // M0 msb
+   { 120, 24, -31, false }, // M0 lsb
+   { 150, 16, -29, true  }, // Cuc
+   { 166,  8, -33, false }, // ecc msb
+   { 180, 24, -33, false }, // ecc lsb
+   { 210, 16, -29, true  }, // Cus
+   { 226,  8, -19, false }, // sqrt A msb
+   { 240, 24, -19, false }, // sqrt A lsb
+   { 270, 16,   4, false }, // toe
+   { 360, 16, -29, true  }, // Cic
+   { 376,  8, -31, true  }, // OMEGA0 msb
+   { 390, 24, -31, false }, // OMEGA0 lsb
+   { 420, 16, -29, true  }, // Cis
+   { 436,  8, -31, true  }, // i0 msb
+   { 450, 24, -31, false }, // i0 lsb
+   { 480, 16,  -5, true  }, // Crc
+   { 496,  8, -31, true  }, // w msb
+   { 510, 24, -31, false }, // w lsb
+   { 540, 24, -43, true  }, // OMEGAdot
+   { 570,  8,   0, false }, // IODE
+   { 578, 14, -43, true  }, // idot
+};
+static const size_t numFields = sizeof(fields) / sizeof(fields[0]);
+static const int subframeBits = 600;
+
+typedef chrono::steady_clock Clock;
+
+static double since(const Clock::time_point& start)
+{
+   return chrono::duration<double>(Clock::now() - start).count();
+}
+
+   /// The pre-word-packing extraction loop, for reference
+static uint64_t refBits(const vector<bool>& bits, int start, int numBits)
+{
+   uint64_t temp = 0;
+   for (int i = start; i < start + numBits; i++)
+   {
+      temp <<= 1;
+      if (bits[i]) temp++;
+   }
+   return temp;
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned count = 2000, repeat = 20;
+   for (int i = 1; i < argc; i++)
+   {
+      if (!strcmp(argv[i], "-n") && i+1 < argc)
+         count = atoi(argv[++i]);
+      else if (!strcmp(argv[i], "-r") && i+1 < argc)
+         repeat = atoi(argv[++i]);
+   }
+
+   SatID sat(1, SatID::systemGPS);
+   ObsID obs(ObsID::otNavMsg, ObsID::cbL1, ObsID::tcCA);
+   NavID nav(sat, obs);
+   CommonTime ct = CivilTime(2015, 7, 19, 2, 0, 0.0, TimeSystem::GPS);
+
+      // raw subframes as 30-bit words; every fourth subframe is a
+      // repeat, as seen when several receivers track the same SV
+   vector<unsigned long> raw(count * subframeBits / 30);
+   unsigned long seed = 12345;
+   for (size_t i = 0; i < raw.size(); i++)
+   {
+      seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+      raw[i] = (seed >> 20) & 0x3FFFFFFF;
+   }
+   const size_t wordsPer = subframeBits / 30;
+   for (size_t s = 3; s < count; s += 4)
+      copy(raw.begin() + (s-3)*wordsPer, raw.begin() + (s-2)*wordsPer,
+           raw.begin() + s*wordsPer);
+
+   vector<PackedNavBits> msgs;
+   Clock::time_point start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      msgs.assign(count, PackedNavBits(sat, obs, nav, "rx1", ct));
+      for (unsigned s = 0; s < count; s++)
+      {
+         for (size_t w = 0; w < wordsPer; w++)
+            msgs[s].addUnsignedLong(raw[s*wordsPer + w], 30, 1);
+         msgs[s].trimsize();
+      }
+   }
+   double tPack = since(start);
+
+   double sum = 0;
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (unsigned s = 0; s < count; s++)
+         for (size_t f = 0; f < numFields; f++)
+         {
+            const Field& fd(fields[f]);
+            sum += fd.isSigned ?
+               msgs[s].asSignedDouble(fd.start, fd.numBits, fd.power2) :
+               msgs[s].asUnsignedDouble(fd.start, fd.numBits, fd.power2);
+         }
+   double tDecode = since(start);
+
+      // reference decode of the unsigned values
+   vector< vector<bool> > refMsgs(count, vector<bool>(subframeBits));
+   for (unsigned s = 0; s < count; s++)
+      for (int b = 0; b < subframeBits; b++)
+         refMsgs[s][b] = msgs[s].asBool(b);
+   uint64_t refSum = 0, newSum = 0;
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (unsigned s = 0; s < count; s++)
+         for (size_t f = 0; f < numFields; f++)
+            refSum += refBits(refMsgs[s], fields[f].start, fields[f].numBits);
+   double tRefDecode = since(start);
+   for (unsigned s = 0; s < count; s++)
+      for (size_t f = 0; f < numFields; f++)
+         newSum += msgs[s].asUnsignedLong(fields[f].start,
+                                          fields[f].numBits, 1);
+
+      // the cross-source filter sorts messages by their bits
+   vector<const PackedNavBits*> ptrs(count);
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      for (unsigned s = 0; s < count; s++)
+         ptrs[s] = &msgs[(s * 7919) % count];
+      sort(ptrs.begin(), ptrs.end(),
+           [](const PackedNavBits* l, const PackedNavBits* r)
+           { return *l < *r; });
+   }
+   double tSort = since(start);
+
+   unsigned matches = 0;
+   size_t hashes = 0;
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (unsigned s = 1; s < count; s++)
+      {
+         matches += ptrs[s]->matchBits(*ptrs[s-1]);
+         hashes += ptrs[s]->hashBits();
+      }
+   double tMatch = since(start);
+
+   double nsPer = 1e9 / (double(count) * repeat);
+   cout << fixed << setprecision(1)
+        << "subframes: " << count << " x " << subframeBits << " bits"
+        << "  passes: " << repeat << endl
+        << "pack:             " << setw(8) << tPack * nsPer
+        << " ns/subframe" << endl
+        << "decode " << setw(2) << numFields << " fields: "
+        << setw(8) << tDecode * nsPer << " ns/subframe" << endl
+        << "  bitwise ref:    " << setw(8) << tRefDecode * nsPer
+        << " ns/subframe" << endl
+        << "sort:             " << setw(8) << tSort * nsPer
+        << " ns/subframe" << endl
+        << "match + hash:     " << setw(8) << tMatch * nsPer
+        << " ns/subframe" << endl
+        << "(" << matches / repeat << " repeats, checksum " << sum
+        << " " << (hashes & 0xFFFF) << ")" << endl;
+
+   if (refSum != newSum * repeat)
+   {
+      cerr << "Reference decode differs" << endl;
+      return 1;
+   }
+   return 0;
+}
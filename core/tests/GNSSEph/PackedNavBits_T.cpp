@@ -62,6 +62,7 @@ public:
    unsigned realDataTest();
    unsigned equalityTest();
    unsigned ancillaryMethods();
+   unsigned wordBoundaryTest();
 
    double eps; 
 };
@@ -834,6 +835,116 @@ ancillaryMethods()
    TURETURN();
 }
 
+   // Fields that straddle the 64-bit storage words, checked against
+   // a bit-at-a-time reading of the same object.
+unsigned PackedNavBits_T::
+wordBoundaryTest()
+{
+   TUDEF("PackedNavBits", "asUnsignedLong");
+
+   SatID satID(1, SatID::systemGPS);
+   ObsID obsID( ObsID::otNavMsg, ObsID::cbL1, ObsID::tcCA );
+   NavID navID(satID,obsID);
+   CommonTime ct = CivilTime( 2011, 6, 2, 12, 14, 44.0, TimeSystem::GPS );
+
+      // Pack fields of every width from 1 to 32 bits, so that field
+      // boundaries fall at every offset within a word.
+   PackedNavBits pnb(satID,obsID,navID,"rx1",ct);
+   vector<unsigned long> values;
+   unsigned long seed = 0x12345678;
+   for (int n = 1; n <= 32; n++)
+   {
+      seed = seed * 1103515245 + 12345;
+      unsigned long value = (seed >> 3) & ((1UL << n) - 1);
+      values.push_back(value);
+      pnb.addUnsignedLong(value, n, 1);
+   }
+   pnb.trimsize();
+   TUASSERTE(size_t, 528, pnb.getNumBits());
+
+   bool allMatch = true;
+   int startBit = 0;
+   for (int n = 1; n <= 32; n++)
+   {
+      unsigned long bitwise = 0;
+      for (int i = 0; i < n; i++)
+         bitwise = (bitwise << 1) | (pnb.asBool(startBit+i) ? 1 : 0);
+      if (pnb.asUnsignedLong(startBit, n, 1) != values[n-1] ||
+          bitwise != values[n-1])
+         allMatch = false;
+      startBit += n;
+   }
+   TUASSERT(allMatch);
+
+      // 64-bit fields at every alignment
+   bool all64 = true;
+   for (int i = 0; i + 64 <= 528; i++)
+   {
+      unsigned long expected = 0;
+      for (int b = 0; b < 64; b++)
+         expected = (expected << 1) | (pnb.asBool(i+b) ? 1 : 0);
+      if (pnb.asUnsignedLong(i, 64, 1) != expected)
+         all64 = false;
+   }
+   TUASSERT(all64);
+
+      // Signed fields across a boundary
+   PackedNavBits sgn(satID,obsID,navID,"rx1",ct);
+   sgn.addUnsignedLong(0, 60, 1);
+   sgn.addLong(-12345, 20, 1);
+   sgn.addLong(54321, 20, 1);
+   sgn.trimsize();
+   TUASSERTE(long, -12345, sgn.asLong(60, 20, 1));
+   TUASSERTE(long, 54321, sgn.asLong(80, 20, 1));
+
+   TUCSM("insertUnsignedLong");
+   PackedNavBits ins(sgn);
+   ins.insertUnsignedLong(0xABCDE, 58, 20, 1);
+   TUASSERTE(unsigned long, 0xABCDE, ins.asUnsignedLong(58, 20, 1));
+   TUASSERTE(unsigned long, 0, ins.asUnsignedLong(0, 58, 1));
+   TUASSERTE(long, 54321, ins.asLong(80, 20, 1));
+
+   TUCSM("hashBits");
+      // Same bits, different metadata, same hash
+   PackedNavBits other(satID,obsID,navID,"rx2",ct+6.0);
+   for (int n = 1; n <= 32; n++)
+      other.addUnsignedLong(values[n-1], n, 1);
+   other.trimsize();
+   TUASSERT(pnb.matchBits(other));
+   TUASSERTE(size_t, pnb.hashBits(), other.hashBits());
+   TUASSERTE(bool, false, pnb < other);
+   TUASSERTE(bool, false, other < pnb);
+
+      // One bit changed
+   other.insertUnsignedLong(pnb.asBool(300) ? 0 : 1, 300, 1, 1);
+   TUASSERT(!pnb.matchBits(other));
+   TUASSERT(pnb.matchBits(other, 0, 299));
+   TUASSERT(pnb.matchBits(other, 301, 527));
+   TUASSERT(pnb.hashBits() != other.hashBits());
+   TUASSERT((pnb < other) != (other < pnb));
+
+   TUCSM("invert");
+      // Unused bits past the end must not affect comparisons
+   PackedNavBits ones(satID,obsID,navID,"rx1",ct);
+   ones.rawBitInput("035 0xFFFFFFFF 0xE0000000");
+   PackedNavBits zeros(satID,obsID,navID,"rx1",ct);
+   zeros.rawBitInput("035 0x00000000 0x00000000");
+   zeros.invert();
+   TUASSERT(zeros.matchBits(ones));
+   TUASSERTE(size_t, ones.hashBits(), zeros.hashBits());
+   TUASSERTE(bool, false, zeros < ones);
+
+   TUCSM("addPackedNavBits");
+   PackedNavBits joined(satID,obsID,navID,"rx1",ct);
+   joined.addUnsignedLong(5, 3, 1);
+   joined.addPackedNavBits(pnb);
+   TUASSERTE(size_t, 531, joined.getNumBits());
+   TUASSERTE(unsigned long, 5, joined.asUnsignedLong(0, 3, 1));
+   TUASSERTE(unsigned long, values[31], joined.asUnsignedLong(499, 32, 1));
+
+   TURETURN();
+}
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -844,6 +955,7 @@ int main()
    errorTotal += testClass.realDataTest();
    errorTotal += testClass.equalityTest();
    errorTotal += testClass.ancillaryMethods();
+   errorTotal += testClass.wordBoundaryTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
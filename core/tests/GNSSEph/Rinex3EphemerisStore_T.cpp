@@ -0,0 +1,205 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "Rinex3EphemerisStore.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class Rinex3EphemerisStore_T
+{
+public:
+      /** Load lists of navigation files one at a time with loadFile()
+       * and all at once with loadFiles(), and check that the
+       * resulting stores and return codes are the same. */
+   unsigned loadFilesTest()
+   {
+      TUDEF("Rinex3EphemerisStore", "loadFiles");
+
+      string dataPath = gpstk::getPathData() + "/";
+      vector< vector<string> > lists(4);
+         // RINEX 2 and 3, with overlapping files
+      lists[0].push_back(dataPath + "arlm2000.15n");
+      lists[0].push_back(dataPath + "arlm2001.15n");
+      lists[0].push_back(dataPath + "test_input_rinex3_76193040.14n");
+      lists[0].push_back(dataPath + "arlm200a.15n");
+      lists[0].push_back(dataPath + "arlm200b.15n");
+         // a file with a bad header part way through
+      lists[1].push_back(dataPath + "arlm2000.15n");
+      lists[1].push_back(dataPath + "test_input_rinex3_nav_BadHeader.15n");
+      lists[1].push_back(dataPath + "arlm2001.15n");
+         // a file that does not exist
+      lists[2].push_back(dataPath + "arlm2000.15n");
+      lists[2].push_back(dataPath + "NoSuchFile.15n");
+         // a repeated file, which FileStore rejects with an exception
+      lists[3].push_back(dataPath + "arlm2000.15n");
+      lists[3].push_back(dataPath + "arlm2001.15n");
+      lists[3].push_back(dataPath + "arlm2000.15n");
+
+      for (unsigned l = 0; l < lists.size(); l++)
+      {
+         for (unsigned nThreads = 1; nThreads <= 4; nThreads += 3)
+         {
+            gpstk::Rinex3EphemerisStore serial, parallel;
+            int serialRC = 0, parallelRC = 0, rc;
+            bool serialThrew = false, parallelThrew = false;
+            try
+            {
+               for (unsigned i = 0; i < lists[l].size(); i++)
+               {
+                  rc = serial.loadFile(lists[l][i]);
+                  if (rc < 0)
+                  {
+                     serialRC = rc;
+                     break;
+                  }
+                  serialRC += rc;
+               }
+            }
+            catch (gpstk::Exception& e)
+            {
+               serialThrew = true;
+            }
+            try
+            {
+               parallelRC = parallel.loadFiles(lists[l], nThreads);
+            }
+            catch (gpstk::Exception& e)
+            {
+               parallelThrew = true;
+            }
+
+            ostringstream serialDump, parallelDump;
+            serial.dump(serialDump, 2);
+            parallel.dump(parallelDump, 2);
+
+            ostringstream msg;
+            msg << "list " << l << ", " << nThreads << " threads";
+            testFramework.assert(serialThrew == parallelThrew,
+                                 "exception mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serialThrew || serialRC == parallelRC,
+                                 "return code mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serial.what == parallel.what,
+                                 "error text mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serial.size() == parallel.size(),
+                                 "size mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serialDump.str() == parallelDump.str(),
+                                 "store mismatch, " + msg.str(), __LINE__);
+         }
+      }
+      TURETURN();
+   }
+
+      /** Check that computeXvt() succeeds exactly where getXvt() does
+       * not throw, and that the two give the same result, for
+       * satellites in and out of the store and times in and out of
+       * its span. */
+   unsigned computeXvtTest()
+   {
+      TUDEF("Rinex3EphemerisStore", "computeXvt");
+
+      gpstk::Rinex3EphemerisStore store;
+      store.loadFile(gpstk::getPathData() + "/arlm200a.15n");
+
+      set<gpstk::SatID> sats(store.getIndexSet());
+      sats.insert(gpstk::SatID(32, gpstk::SatID::systemGPS));
+      sats.insert(gpstk::SatID(5, gpstk::SatID::systemGlonass));
+      sats.insert(gpstk::SatID(5, gpstk::SatID::systemTransit));
+
+      gpstk::CommonTime t0(store.getInitialTime());
+      gpstk::CommonTime t1(store.getFinalTime());
+      t0.setTimeSystem(gpstk::TimeSystem::GPS);
+      t1.setTimeSystem(gpstk::TimeSystem::GPS);
+      vector<gpstk::CommonTime> times;
+      times.push_back(t0 - 86400.);
+      times.push_back(t0);
+      times.push_back(t0 + (t1 - t0)/2);
+      times.push_back(t1);
+      times.push_back(t1 + 86400.);
+
+      unsigned hits = 0, misses = 0;
+      set<gpstk::SatID>::const_iterator it;
+      for (it = sats.begin(); it != sats.end(); ++it)
+      {
+         for (unsigned i = 0; i < times.size(); i++)
+         {
+            gpstk::Xvt ref, xvt;
+            bool threw = false;
+            try
+            {
+               ref = store.getXvt(*it, times[i]);
+            }
+            catch (gpstk::InvalidRequest& e)
+            {
+               threw = true;
+            }
+            bool found = store.computeXvt(*it, times[i], xvt);
+            TUASSERTE(bool, !threw, found);
+            if (found && !threw)
+            {
+               TUASSERTE(gpstk::Triple, ref.x, xvt.x);
+               TUASSERTE(gpstk::Triple, ref.v, xvt.v);
+               TUASSERTE(double, ref.clkbias, xvt.clkbias);
+               hits++;
+            }
+            else
+            {
+               misses++;
+            }
+         }
+      }
+         // the loop must exercise both outcomes
+      TUASSERT(hits > 0);
+      TUASSERT(misses > 0);
+      TURETURN();
+   }
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   Rinex3EphemerisStore_T testClass;
+   total += testClass.loadFilesTest();
+   total += testClass.computeXvtTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
@@ -270,6 +270,57 @@ public:
    }
 
 
+//=============================================================================
+// Test for computeXvt
+// Tests that computeXvt reports a missing satellite or epoch by returning
+// false, without throwing, and otherwise agrees with getXvt
+//=============================================================================
+   int computeXvtTest (void)
+   {
+      TUDEF( "SP3EphemerisStore", "computeXvt" );
+
+      try
+      {
+         SP3EphemerisStore store;
+         store.loadFile(inputSP3Data);
+
+         SatID sid0(0,SatID::systemGPS);   // Nonexistent in SP3 file
+         SatID sid1(1,SatID::systemGPS);
+         SatID sid32(32,SatID::systemGPS); // Nonexistent in SP3 file
+
+         CommonTime eTime = CivilTime(1997,4,6,6,15,0).convertToCommonTime();
+         CommonTime lateTime = CivilTime(1997,4,9,0,0,0).convertToCommonTime();
+
+         Xvt xvt, ref;
+         xvt.x = Triple(1.,2.,3.);
+         TUASSERT(!store.computeXvt(sid0,eTime,xvt));
+         TUASSERT(!store.computeXvt(sid32,eTime,xvt));
+         TUASSERT(!store.computeXvt(sid1,lateTime,xvt));
+            // a miss leaves the result untouched
+         TUASSERTE(Triple, Triple(1.,2.,3.), xvt.x);
+
+         TUASSERT(store.computeXvt(sid1,eTime,xvt));
+         ref = store.getXvt(sid1,eTime);
+         TUASSERTE(Triple, ref.x, xvt.x);
+         TUASSERTE(Triple, ref.v, xvt.v);
+         TUASSERTE(double, ref.clkbias, xvt.clkbias);
+         TUASSERTE(double, ref.relcorr, xvt.relcorr);
+
+            // the base class interface reaches the same implementation
+         const XvtStore<SatID>& base(store);
+         TUASSERT(!base.computeXvt(sid32,eTime,xvt));
+         TUASSERT(base.computeXvt(sid1,eTime,xvt));
+         TUASSERTE(Triple, ref.x, xvt.x);
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+
+      return testFramework.countFails();
+   }
+
+
 //=============================================================================
 // Test for getInitialTime
 // Tests getInitialTime method in SP3EphemerisStore by ensuring that
@@ -551,6 +602,93 @@ public:
       return testFramework.countFails();
    }
 
+
+//=============================================================================
+// Test for loadFiles
+// Loads the same lists of files one at a time with loadFile and all at
+// once with loadFiles, and checks that the resulting stores are the
+// same, including when a file fails part way through the list.
+//=============================================================================
+   int loadFilesTest (void)
+   {
+      TUDEF( "SP3EphemerisStore", "loadFiles" );
+
+      std::string dataFilePath = gpstk::getPathData() + "/";
+      std::string clockFile = dataFilePath +
+         "test_input_rinex3_clock_RinexClockExample.96c";
+      std::string badClockFile = dataFilePath +
+         "test_input_rinex3_clock_BadEpochLine.96c";
+
+      std::vector< std::vector<std::string> > lists(4);
+         // overlapping and repeated SP3 files
+      lists[0].push_back(inputSP3Data);
+      lists[0].push_back(inputAPCData);
+      lists[0].push_back(inputSP3Data);
+         // an unreadable file part way through
+      lists[1].push_back(inputAPCData);
+      lists[1].push_back(inputNotaFile);
+      lists[1].push_back(inputSP3Data);
+         // SP3 plus RINEX clock
+      lists[2].push_back(inputAPCData);
+      lists[2].push_back(clockFile);
+         // a RINEX clock file that fails while reading data
+      lists[3].push_back(clockFile);
+      lists[3].push_back(badClockFile);
+      lists[3].push_back(inputSP3Data);
+
+      for (unsigned l = 0; l < lists.size(); l++)
+      {
+         for (unsigned nThreads = 1; nThreads <= 4; nThreads += 3)
+         {
+            SP3EphemerisStore serial, parallel;
+            if (l >= 2)
+            {
+               serial.useRinexClockData();
+               parallel.useRinexClockData();
+            }
+
+            bool serialThrew = false, parallelThrew = false;
+            try
+            {
+               for (unsigned i = 0; i < lists[l].size(); i++)
+                  serial.loadFile(lists[l][i]);
+            }
+            catch (Exception& e)
+            {
+               serialThrew = true;
+            }
+            try
+            {
+               parallel.loadFiles(lists[l], nThreads);
+            }
+            catch (Exception& e)
+            {
+               parallelThrew = true;
+            }
+
+            std::ostringstream serialDump, parallelDump;
+            serial.dump(serialDump, 2);
+            parallel.dump(parallelDump, 2);
+
+            std::ostringstream msg;
+            msg << "list " << l << ", " << nThreads << " threads";
+            testFramework.assert(serialThrew == parallelThrew,
+                                 "exception mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serialDump.str() == parallelDump.str(),
+                                 "store mismatch, " + msg.str(), __LINE__);
+            testFramework.assert(serial.ndataPosition() ==
+                                 parallel.ndataPosition(),
+                                 "position count mismatch, " + msg.str(),
+                                 __LINE__);
+            testFramework.assert(serial.ndataClock() == parallel.ndataClock(),
+                                 "clock count mismatch, " + msg.str(),
+                                 __LINE__);
+         }
+      }
+
+      return testFramework.countFails();
+   }
+
 private:
    double epsilon; // Floating point error threshold
    std::string dataFilePath;
@@ -576,10 +714,12 @@ int main() // Main function to initialize and run all tests above
 
    errorTotal += testClass.SP3ESTest();
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.computeXvtTest();
    errorTotal += testClass.getInitialTimeTest();
    errorTotal += testClass.getFinalTimeTest();
    errorTotal += testClass.getPositionTest();
    errorTotal += testClass.getVelocityTest();
+   errorTotal += testClass.loadFilesTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
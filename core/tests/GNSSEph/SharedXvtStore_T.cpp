@@ -0,0 +1,268 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <atomic>
+#include <thread>
+
+#include "SharedXvtStore.hpp"
+#include "OrbitEphStore.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class SharedXvtStore_T
+{
+public:
+   SharedXvtStore_T()
+         : t0(gpstk::GPSWeekSecond(1917, 0))
+   {}
+
+      /// Make the ephemeris of satellite prn with Toe t0 + k*2h.
+   gpstk::OrbitEph makeEph(int prn, int k)
+   {
+      gpstk::OrbitEph eph;
+      eph.dataLoadedFlag = true;
+      eph.satID = gpstk::SatID(prn, gpstk::SatID::systemGPS);
+      eph.obsID = gpstk::ObsID(gpstk::ObsID::otNavMsg,
+                               gpstk::ObsID::cbL1,
+                               gpstk::ObsID::tcCA);
+      eph.ctToe = t0 + 7200. * k;
+      eph.ctToc = eph.ctToe;
+      eph.af0 = 1.e-5 * prn + 1.e-8 * k;
+      eph.af1 = 3.41060513165e-12;
+      eph.M0 = -2.4172396275 + prn * 0.1 + k * 0.01;
+      eph.dn = 4.70269045234e-09;
+      eph.ecc = 0.0105134742334;
+      eph.A = 5153.6572418 * 5153.6572418;
+      eph.OMEGA0 = 1.0368837265 + prn * 0.05;
+      eph.i0 = 0.966861158522;
+      eph.w = 0.639520025766;
+      eph.OMEGAdot = -8.30213439012e-09;
+      eph.beginValid = eph.ctToe - 7200;
+      eph.endValid = eph.ctToe + 7200;
+      return eph;
+   }
+
+      /// Add the ephemerides with Toe t0 + k*2h for all satellites.
+   void addSet(gpstk::OrbitEphStore& store, int k)
+   {
+      for (int prn = 1; prn <= nsat; prn++)
+      {
+         gpstk::OrbitEph eph(makeEph(prn, k));
+         store.addEphemeris(&eph);
+      }
+   }
+
+      /// Copies of a store must not share its OrbitEph.
+   unsigned copyTest()
+   {
+      TUDEF("OrbitEphStore", "OrbitEphStore(const OrbitEphStore&)");
+      try
+      {
+         gpstk::OrbitEphStore *orig = new gpstk::OrbitEphStore;
+         addSet(*orig, 0);
+         addSet(*orig, 1);
+         orig->freeze();
+         gpstk::SatID sat(3, gpstk::SatID::systemGPS);
+         gpstk::Xvt exp(orig->getXvt(sat, t0 + 4000.));
+
+         gpstk::OrbitEphStore copy(*orig);
+         gpstk::OrbitEphStore assigned;
+         assigned = *orig;
+         TUASSERT(copy.isFrozen());
+         TUASSERTE(unsigned, orig->size(), copy.size());
+         TUASSERT(copy.findOrbitEph(sat, t0) != orig->findOrbitEph(sat, t0));
+         delete orig;
+
+         TUASSERTE(gpstk::Triple, exp.x, copy.getXvt(sat, t0 + 4000.).x);
+         TUASSERTE(gpstk::Triple, exp.x, assigned.getXvt(sat, t0 + 4000.).x);
+      }
+      catch (gpstk::Exception& exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+      /** Many threads compute positions while another adds
+       * ephemerides. Every answer must equal the one from a store
+       * loaded with everything beforehand, and every snapshot must be
+       * complete. */
+   unsigned stressTest()
+   {
+      TUDEF("SharedXvtStore", "getXvt");
+      try
+      {
+         const int nsets = 40, nreaders = 6;
+         gpstk::OrbitEphStore full;
+         for (int k = 0; k < nsets; k++)
+            addSet(full, k);
+         full.freeze();
+
+         gpstk::SharedXvtStore<gpstk::OrbitEphStore> shared;
+            // Two sets to begin with, so that readers always have
+            // times before the latest Toe to query (at a Toe, the
+            // full store has the next set which is valid from there).
+         shared.update([&](gpstk::OrbitEphStore& store)
+                       { addSet(store, 0); addSet(store, 1); store.freeze(); });
+
+         std::atomic<bool> loading(true);
+         std::atomic<unsigned> queries(0), wrong(0), incomplete(0),
+            regressed(0);
+
+         std::vector<std::thread> readers;
+         for (int r = 0; r < nreaders; r++)
+         {
+            readers.push_back(std::thread([&, r]()
+            {
+               unsigned long seed(12345 + r), n(0), bad(0), partial(0);
+               double lastFinal(0.0);
+               bool more(true);
+               while (more)
+               {
+                  more = loading;
+                  gpstk::SharedXvtStore<gpstk::OrbitEphStore>::Snapshot
+                     snap(shared.snapshot());
+
+                     // a snapshot holds whole sets, and never goes back
+                  unsigned size = snap->size();
+                  if (size % nsat != 0)
+                     partial++;
+                  double final = snap->getFinalTime() - t0;
+                  if (final < lastFinal)
+                     regressed++;
+                  lastFinal = final;
+
+                     // times covered by the ephemerides published so far
+                  double span = final - 7200.;
+                  for (int i = 0; i < 50; i++)
+                  {
+                     seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+                     gpstk::SatID sat(1 + (seed >> 33) % nsat,
+                                      gpstk::SatID::systemGPS);
+                     gpstk::CommonTime t(t0 + (seed >> 40) % 1000000 *
+                                         span / 1000000.);
+                     gpstk::Xvt exp(full.getXvt(sat, t));
+                        // alternate between the snapshot and the wrapper
+                     gpstk::Xvt got(i % 2 ? snap->getXvt(sat, t)
+                                    : shared.getXvt(sat, t));
+                     if (!(exp.x == got.x) || exp.clkbias != got.clkbias)
+                        bad++;
+                     n++;
+                  }
+               }
+               queries += n;
+               wrong += bad;
+               incomplete += partial;
+            }));
+         }
+
+            // the loader: one set at a time, as a monitor would
+         for (int k = 2; k < nsets; k++)
+         {
+            shared.update([&](gpstk::OrbitEphStore& store)
+                          { addSet(store, k); store.freeze(); });
+            std::this_thread::yield();
+         }
+         loading = false;
+         for (unsigned r = 0; r < readers.size(); r++)
+            readers[r].join();
+
+         TUASSERT(queries > 0);
+         TUASSERTE(unsigned, 0, wrong);
+         TUASSERTE(unsigned, 0, incomplete);
+         TUASSERTE(unsigned, 0, regressed);
+         TUASSERTE(unsigned, full.size(), shared.snapshot()->size());
+
+            // the XvtStore interface
+         TUASSERTE(gpstk::CommonTime, full.getFinalTime(),
+                   shared.getFinalTime());
+         TUASSERT(shared.isPresent(gpstk::SatID(nsat, gpstk::SatID::systemGPS)));
+         TUASSERTE(size_t, nsat, shared.getIndexSet().size());
+         gpstk::SharedXvtStore<gpstk::OrbitEphStore>::Snapshot
+            old(shared.snapshot());
+         shared.clear();
+         TUASSERTE(unsigned, 0, shared.snapshot()->size());
+         TUASSERTE(unsigned, full.size(), old->size());
+
+            // a failed update leaves the store as it was
+         try
+         {
+            shared.update([&](gpstk::OrbitEphStore& store)
+                          {
+                             addSet(store, 0);
+                             GPSTK_THROW(gpstk::InvalidRequest("abandon"));
+                          });
+            TUFAIL("Expected InvalidRequest");
+         }
+         catch (gpstk::InvalidRequest&)
+         {
+            TUPASS("InvalidRequest");
+         }
+         TUASSERTE(unsigned, 0, shared.snapshot()->size());
+
+         std::shared_ptr<gpstk::OrbitEphStore> built(
+            std::make_shared<gpstk::OrbitEphStore>(full));
+         shared.publish(built);
+         TUASSERTE(unsigned, full.size(), shared.snapshot()->size());
+      }
+      catch (gpstk::Exception& exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      TURETURN();
+   }
+
+private:
+   static const int nsat = 12;
+   gpstk::CommonTime t0;
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SharedXvtStore_T testClass;
+
+   errorTotal += testClass.copyTest();
+   errorTotal += testClass.stressTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -0,0 +1,276 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FixedMatrix.hpp"
+#include "RACRotation.hpp"
+#include "Triple.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+class FixedMatrix_T
+{
+public:
+   FixedMatrix_T()
+   {
+         // a well-conditioned symmetric positive definite matrix
+      const double s[9] = { 4.0, 1.0, 0.5,
+                            1.0, 3.0, 0.2,
+                            0.5, 0.2, 2.0 };
+      const double g[6] = { 1.0, 2.0, 3.0,
+                            4.0, 5.0, 6.0 };
+      spd = FixedMatrix<double,3,3>(s);
+      gen = FixedMatrix<double,2,3>(g);
+      eps = 1e-14;
+   }
+
+
+   int constructorTest()
+   {
+      TUDEF("FixedMatrix", "FixedMatrix");
+
+      FixedMatrix<double,2,3> z(0.0);
+      TUASSERTE(size_t, 2, z.rows());
+      TUASSERTE(size_t, 3, z.cols());
+      TUASSERTE(size_t, 6, z.size());
+      for (size_t i = 0; i < z.size(); i++)
+         TUASSERTE(double, 0.0, z.data()[i]);
+
+         // row-major initialization
+      TUASSERTE(double, 2.0, gen(0,1));
+      TUASSERTE(double, 4.0, gen(1,0));
+      TUASSERTE(double, 6.0, gen(1,2));
+
+      FixedMatrix<double,3,3> I(FixedMatrix<double,3,3>::identity());
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTE(double, (i == j ? 1.0 : 0.0), I(i,j));
+
+         // from and to Matrix<T>
+      Matrix<double> M(gen);
+      TUASSERTE(size_t, 2, M.rows());
+      TUASSERTE(size_t, 3, M.cols());
+      FixedMatrix<double,2,3> F(M);
+      for (size_t i = 0; i < 2; i++)
+         for (size_t j = 0; j < 3; j++)
+         {
+            TUASSERTE(double, gen(i,j), M(i,j));
+            TUASSERTE(double, gen(i,j), F(i,j));
+         }
+
+      try
+      {
+         FixedMatrix<double,3,2> bad(M);
+         TUFAIL("Construction from a mis-sized Matrix should throw");
+      }
+      catch (MatrixException& e)
+      {
+         TUPASS("MatrixException");
+      }
+      try
+      {
+         FixedMatrix<double,3,2> bad;
+         bad = M;
+         TUFAIL("Assignment from a mis-sized Matrix should throw");
+      }
+      catch (MatrixException& e)
+      {
+         TUPASS("MatrixException");
+      }
+
+      TUCSM("FixedVector");
+      FixedVector<double,3> v(1.0, -2.0, 3.0);
+      TUASSERTE(size_t, 3, v.size());
+      TUASSERTE(double, -2.0, v[1]);
+      TUASSERTE(double, 3.0, v(2));
+      Vector<double> V(v);
+      TUASSERTE(size_t, 3, V.size());
+      TUASSERTE(double, 3.0, V[2]);
+      FixedVector<double,3> w(V);
+      TUASSERTE(double, 1.0, w[0]);
+      try
+      {
+         FixedVector<double,4> bad(V);
+         TUFAIL("Construction from a mis-sized Vector should throw");
+      }
+      catch (VectorException& e)
+      {
+         TUPASS("VectorException");
+      }
+
+      TURETURN();
+   }
+
+
+   int arithmeticTest()
+   {
+      TUDEF("FixedMatrix", "operator*");
+
+         // products agree with the dynamically sized implementation
+      Matrix<double> G(gen), S(spd);
+      FixedMatrix<double,2,3> fp(gen * spd);
+      Matrix<double> mp(G * S);
+      for (size_t i = 0; i < 2; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTFEPS(mp(i,j), fp(i,j), eps);
+
+      FixedVector<double,3> v(1.0, -2.0, 3.0);
+      Vector<double> V(v);
+      FixedVector<double,2> fmv(gen * v);
+      Vector<double> mmv(G * V);
+      TUASSERTFEPS(mmv(0), fmv(0), eps);
+      TUASSERTFEPS(mmv(1), fmv(1), eps);
+
+      FixedVector<double,2> u(1.0);
+      u[1] = -1.0;
+      FixedVector<double,3> fvm(u * gen);
+      TUASSERTFEPS(-3.0, fvm(0), eps);
+      TUASSERTFEPS(-3.0, fvm(1), eps);
+      TUASSERTFEPS(-3.0, fvm(2), eps);
+
+      TUCSM("operator+");
+      FixedMatrix<double,3,3> sum(spd + spd), diff(spd - spd),
+         twice(2.0 * spd), twice2(spd * 2.0);
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+         {
+            TUASSERTE(double, 2.0*spd(i,j), sum(i,j));
+            TUASSERTE(double, 0.0, diff(i,j));
+            TUASSERTE(double, 2.0*spd(i,j), twice(i,j));
+            TUASSERTE(double, 2.0*spd(i,j), twice2(i,j));
+         }
+
+      TUCSM("transpose");
+      FixedMatrix<double,3,2> t(transpose(gen));
+      for (size_t i = 0; i < 2; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTE(double, gen(i,j), t(j,i));
+
+      TUCSM("FixedVector");
+      FixedVector<double,3> a(1.0, 2.0, 3.0), b(4.0, 5.0, 6.0);
+      TUASSERTE(double, 32.0, dot(a,b));
+      FixedVector<double,3> c(cross(a,b));
+      TUASSERTE(double, -3.0, c[0]);
+      TUASSERTE(double, 6.0, c[1]);
+      TUASSERTE(double, -3.0, c[2]);
+      FixedVector<double,3> d((a + b) - 2.0 * a), e(b / 2.0), f(a * b);
+      TUASSERTE(double, 3.0, d[0]);
+      TUASSERTE(double, 2.5, e[1]);
+      TUASSERTE(double, 18.0, f[2]);
+         // the generic ConstVectorBase functions still apply
+      TUASSERTFEPS(::sqrt(14.0), norm(a), eps);
+
+      TURETURN();
+   }
+
+
+   int inverseTest()
+   {
+      TUDEF("FixedMatrix", "inverseSPD");
+
+      FixedMatrix<double,3,3> fi(inverseSPD(spd));
+      Matrix<double> mi(inverse(Matrix<double>(spd)));
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTFEPS(mi(i,j), fi(i,j), eps);
+
+      FixedMatrix<double,3,3> I(spd * fi);
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTFEPS((i == j ? 1.0 : 0.0), I(i,j), eps);
+
+      FixedMatrix<double,2,2> neg(0.0);
+      neg(0,0) = 1.0;
+      neg(1,1) = -1.0;
+      try
+      {
+         inverseSPD(neg);
+         TUFAIL("inverseSPD of an indefinite matrix should throw");
+      }
+      catch (SingularMatrixException& e)
+      {
+         TUPASS("SingularMatrixException");
+      }
+
+      TURETURN();
+   }
+
+
+   int racTest()
+   {
+      TUDEF("RACRotation", "convertToRAC");
+
+         // SV at 0N 0E heading north, as in RACRotation_T
+      RACRotation rot(Triple(26000000.0, 0.0, 0.0), Triple(0.0, 0.0, 4000.0));
+      FixedVector<double,3> xyz(1.0, 2.0, 3.0);
+      FixedVector<double,3> rac(rot * xyz);
+      Triple tr(rot.convertToRAC(Triple(1.0, 2.0, 3.0)));
+      Vector<double> vr(rot.convertToRAC(Vector<double>(xyz)));
+      TUASSERTE(double, 1.0, rac[0]);
+      TUASSERTE(double, 3.0, rac[1]);
+      TUASSERTE(double, -2.0, rac[2]);
+      for (size_t i = 0; i < 3; i++)
+      {
+         TUASSERTE(double, rac[i], tr[i]);
+         TUASSERTE(double, rac[i], vr[i]);
+      }
+
+      TURETURN();
+   }
+
+private:
+   FixedMatrix<double,3,3> spd;
+   FixedMatrix<double,2,3> gen;
+   double eps;
+};
+
+
+int main()
+{
+   int errorTotal = 0;
+   FixedMatrix_T testClass;
+
+   errorTotal += testClass.constructorTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.inverseTest();
+   errorTotal += testClass.racTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
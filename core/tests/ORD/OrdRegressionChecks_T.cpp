@@ -202,3 +202,114 @@ TEST(OrdTestRegression, TestRawRange4) {
     // Compare the new calculation to the old, for our contrived variables.
     ASSERT_EQ(resultRange, originalRange);
 }
+
+// Satellites on circular orbits, so that the light-time iterations and the
+// geometry differ from satellite to satellite. Satellite 13 has no
+// ephemeris.
+static Xvt circularOrbit(const gpstk::SatID& satId,
+        const gpstk::CommonTime& time) {
+    if (satId.id == 13) {
+        gpstk::InvalidRequest e("No ephemeris");
+        GPSTK_THROW(e);
+    }
+    const double radius = 26560.0e3;
+    const double rate = 1.4585e-4;
+    double dt = time - gpstk::CommonTime::BEGINNING_OF_TIME;
+    double phase = satId.id * 0.7 + rate * dt;
+    double incl = 0.96 + satId.id * 0.01;
+    Xvt xvt;
+    xvt.x = gpstk::Triple(radius * ::cos(phase),
+                          radius * ::sin(phase) * ::cos(incl),
+                          radius * ::sin(phase) * ::sin(incl));
+    xvt.v = gpstk::Triple(-radius * rate * ::sin(phase),
+                          radius * rate * ::cos(phase) * ::cos(incl),
+                          radius * rate * ::cos(phase) * ::sin(incl));
+    xvt.clkbias = 1.e-5 * satId.id;
+    xvt.clkdrift = 1.e-12;
+    xvt.relcorr = xvt.computeRelativityCorrection();
+    return xvt;
+}
+
+static double fakeTrop(double elevation) {
+    return 2.4 / ::sin(elevation * gpstk::DEG_TO_RAD);
+}
+
+static double fakeIono(const CommonTime& time, const Position& rxgeo,
+        double svel, double svaz, gpstk::IonoModel::Frequency freq) {
+    return 5.0 + svaz / 360.0 + svel / 90.0;
+}
+
+TEST(OrdTestRegression, TestCalculateOrds) {
+    MockXvtStore foo;
+    MockTropo tropo;
+    MockIono iono;
+    EXPECT_CALL(foo, getXvt(_, _)).WillRepeatedly(Invoke(circularOrbit));
+    EXPECT_CALL(tropo, correction_wrap(_)).WillRepeatedly(Invoke(fakeTrop));
+    EXPECT_CALL(iono, getCorrection_wrap(_, _, _, _, _))
+        .WillRepeatedly(Invoke(fakeIono));
+
+    std::vector<double> frequencies;
+    frequencies.push_back(L1_FREQ_GPS);
+    frequencies.push_back(L2_FREQ_GPS);
+
+    gpstk::ord::ReceiverEpoch epoch;
+    epoch.rxLoc = gpstk::Position(-740289.9, -5457071.7, 3207245.6);
+    epoch.receiveTime = gpstk::CommonTime::BEGINNING_OF_TIME + 3600.0;
+    for (int prn = 1; prn <= 16; prn++) {
+        epoch.satIds.push_back(gpstk::SatID(prn,
+                gpstk::SatID::systemUserDefined));
+        epoch.pseudoranges.push_back(2.1e7 + prn * 1.e5);
+        epoch.pseudoranges.push_back(2.1e7 + prn * 1.e5 + 3.0);
+        epoch.transmitTimes.push_back(epoch.receiveTime - 0.072);
+    }
+
+    gpstk::ord::EpochOrds result;
+    for (int method = 1; method <= 4; method++) {
+        gpstk::ord::calculate_ords(frequencies, epoch, iono, tropo, foo,
+                method, result);
+        ASSERT_EQ(epoch.satIds.size(), result.ords.size());
+
+        for (size_t i = 0; i < epoch.satIds.size(); i++) {
+            if (epoch.satIds[i].id == 13) {
+                ASSERT_FALSE(result.valid[i]);
+                ASSERT_THROW(gpstk::ord::calculate_ord(frequencies,
+                        std::vector<double>(2, 0.0), epoch.rxLoc,
+                        epoch.satIds[i], epoch.transmitTimes[i],
+                        epoch.receiveTime, iono, tropo, foo, method),
+                        gpstk::Exception);
+                continue;
+            }
+            std::vector<double> pseudoranges(&epoch.pseudoranges[2*i],
+                                             &epoch.pseudoranges[2*i+2]);
+            double ord = gpstk::ord::calculate_ord(frequencies, pseudoranges,
+                    epoch.rxLoc, epoch.satIds[i], epoch.transmitTimes[i],
+                    epoch.receiveTime, iono, tropo, foo, method);
+
+            // Compare the epoch calculation to the per-satellite one.
+            ASSERT_TRUE(result.valid[i]);
+            ASSERT_EQ(ord, result.ords[i]);
+        }
+    }
+
+    // Many receivers give the same results as one at a time.
+    std::vector<gpstk::ord::ReceiverEpoch> epochs(3, epoch);
+    epochs[1].rxLoc = gpstk::Position(4433469.9, 362672.7, 4556211.6);
+    epochs[2].satIds.resize(4);
+    epochs[2].pseudoranges.resize(8);
+    epochs[2].transmitTimes.resize(4);
+    std::vector<gpstk::ord::EpochOrds> results;
+    gpstk::ord::calculate_ords(frequencies, epochs, iono, tropo, foo, 1,
+            results);
+    ASSERT_EQ(3, results.size());
+    for (size_t k = 0; k < epochs.size(); k++) {
+        gpstk::ord::calculate_ords(frequencies, epochs[k], iono, tropo, foo,
+                1, result);
+        ASSERT_EQ(result.ords, results[k].ords);
+        ASSERT_EQ(result.valid, results[k].valid);
+    }
+
+    // Inconsistent observations fail the whole epoch.
+    epochs[2].pseudoranges.pop_back();
+    ASSERT_THROW(gpstk::ord::calculate_ords(frequencies, epochs[2], iono,
+            tropo, foo, 1, result), gpstk::Exception);
+}
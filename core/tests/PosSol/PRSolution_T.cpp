@@ -0,0 +1,322 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "PRSolution.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "TropModel.hpp"
+#include "CivilTime.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GNSSconstants.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class PRSolution_T
+{
+public:
+   PRSolution_T()
+   {
+      rx[0] = -740289.9;
+      rx[1] = -5457071.7;
+      rx[2] = 3207245.6;
+      clk = 123.456;
+      coldIterations = 0;
+      tr = gpstk::CivilTime(2015,7,19,1,0,0.0,gpstk::TimeSystem::GPS);
+      for (int prn = 1; prn <= 32; prn++)
+         allSats.push_back(gpstk::SatID(prn, gpstk::SatID::systemGPS));
+   }
+
+      /** Load the SP3 file and choose the visible satellites. */
+   bool initialize()
+   {
+      try
+      {
+         eph.loadFile(gpstk::getPathData() +
+                      "/test_input_sp3_nav_2015_200.sp3");
+      }
+      catch (gpstk::Exception& e)
+      {
+         cerr << e << endl;
+         return false;
+      }
+      gpstk::Position R(rx[0], rx[1], rx[2]);
+      for (int i = 0; i < allSats.size(); i++)
+      {
+         try
+         {
+            gpstk::Xvt xvt = eph.getXvt(allSats[i], tr);
+            gpstk::Position S(xvt.x[0], xvt.x[1], xvt.x[2]);
+            if (R.elevation(S) > 10.0)
+               sats.push_back(allSats[i]);
+         }
+         catch (gpstk::Exception& e)
+         {
+         }
+      }
+      return sats.size() >= 8;
+   }
+
+      /** Pseudoranges consistent with the receiver position rx and clock
+       * clk, as PRSolution will correct and model them, plus the given
+       * errors. */
+   vector<double> pseudoranges(const vector<double>& err)
+   {
+      vector<double> pr(sats.size());
+      for (int i = 0; i < sats.size(); i++)
+      {
+         gpstk::GPSEllipsoid ellip;
+         pr[i] = 0.0;
+         for (int k = 0; k < 4; k++)
+         {
+               // transmit time and corrections as in PreparePRSolution()
+            gpstk::CommonTime tx(tr);
+            tx -= pr[i] / gpstk::C_MPS;
+            gpstk::Xvt xvt = eph.getXvt(sats[i], tx);
+            tx -= xvt.clkbias + xvt.relcorr;
+            xvt = eph.getXvt(sats[i], tx);
+               // and the earth rotation as in SimplePRSolution()
+            double tau = ::sqrt((xvt.x[0]-rx[0])*(xvt.x[0]-rx[0])
+                                + (xvt.x[1]-rx[1])*(xvt.x[1]-rx[1])
+                                + (xvt.x[2]-rx[2])*(xvt.x[2]-rx[2]))
+               / ellip.c();
+            double wt = ellip.angVelocity() * tau;
+            double x =  ::cos(wt)*xvt.x[0] + ::sin(wt)*xvt.x[1] - rx[0];
+            double y = -::sin(wt)*xvt.x[0] + ::cos(wt)*xvt.x[1] - rx[1];
+            double z = xvt.x[2] - rx[2];
+            pr[i] = ::sqrt(x*x + y*y + z*z) + clk
+               - gpstk::C_MPS * (xvt.clkbias + xvt.relcorr) + err[i];
+         }
+      }
+      return pr;
+   }
+
+      /** Solve with RAIMCompute, and again with SimplePRSolution using
+       * only the satellites RAIM kept; the two must agree. Return the
+       * RAIM solution in prs. */
+   void checkRAIM(gpstk::TestUtil& testFramework, gpstk::PRSolution& prs,
+                  const vector<double>& pr, const gpstk::Matrix<double>& invMC,
+                  vector<gpstk::SatID>& used, int& iret)
+   {
+      gpstk::ZeroTropModel trop;
+      vector<gpstk::SatID::SatelliteSystem> syss(
+         1, gpstk::SatID::systemGPS);
+      used = sats;
+      iret = prs.RAIMCompute(tr, used, syss, pr, invMC, &eph, &trop);
+      TUASSERT(iret >= 0);
+      TUASSERT(prs.isValid());
+      if (iret < 0)
+         return;
+
+         // brute force on the same subset
+      gpstk::PRSolution simple;
+      simple.hasMemory = false;
+      vector<gpstk::SatID> subset(used);
+      gpstk::Matrix<double> SVP;
+      int n = simple.PreparePRSolution(tr, subset, syss, pr, &eph, SVP);
+      TUASSERTE(int, prs.Nsvs, n);
+      gpstk::Vector<double> resids, slopes;
+      TUCSM("SimplePRSolution");
+      int sret = simple.SimplePRSolution(tr, subset, SVP, invMC, &trop,
+                                         10, 3.e-7, syss, resids, slopes);
+      TUASSERTE(int, 0, sret);
+      TUASSERTE(unsigned, prs.Solution.size(), simple.Solution.size());
+      for (int i = 0; i < simple.Solution.size(); i++)
+         TUASSERTFEPS(prs.Solution(i), simple.Solution(i), 1.e-5);
+      TUASSERTFEPS(prs.RMSResidual, simple.RMSResidual, 1.e-6);
+      TUASSERTFEPS(prs.MaxSlope, simple.MaxSlope, 1.e-6);
+      for (int i = 0; i < 4; i++)
+         for (int j = 0; j < 4; j++)
+            TUASSERTFEPS(prs.Covariance(i,j), simple.Covariance(i,j), 1.e-8);
+      TUCSM("RAIMCompute");
+   }
+
+      /** Without outliers no satellite is rejected and the truth is
+       * recovered. */
+   unsigned cleanTest()
+   {
+      TUDEF("PRSolution", "RAIMCompute");
+      gpstk::PRSolution prs;
+      prs.hasMemory = false;
+      vector<gpstk::SatID> used;
+      int iret;
+      vector<double> pr = pseudoranges(vector<double>(sats.size(), 0.0));
+      checkRAIM(testFramework, prs, pr, gpstk::Matrix<double>(),
+                used, iret);
+      TUASSERTE(int, 0, iret);
+      for (int i = 0; i < used.size(); i++)
+         TUASSERT(used[i].id > 0);
+      for (int i = 0; i < 3; i++)
+         TUASSERTFEPS(rx[i], prs.Solution(i), 1.e-3);
+      TUASSERTFEPS(clk, prs.Solution(3), 1.e-3);
+      TUASSERTE(unsigned long, 1, prs.RAIMCounters.NCalls);
+      TUASSERTE(unsigned long, 1, prs.RAIMCounters.NSubsets);
+      TUASSERTE(unsigned long, 0, prs.RAIMCounters.NDowndates);
+      coldIterations = prs.NIterations;
+      TURETURN();
+   }
+
+      /** Outliers on one and then two satellites are rejected, and each
+       * subset is started from the downdated all-satellite solution. */
+   unsigned outlierTest()
+   {
+      TUDEF("PRSolution", "RAIMCompute");
+      gpstk::PRSolution prs;
+      prs.hasMemory = false;
+      vector<gpstk::SatID> used;
+      int iret;
+      const size_t N(sats.size());
+      const int bad1(2), bad2(N-3);
+
+      vector<double> err(N, 0.0);
+      err[bad1] = 200.0;
+      vector<double> pr = pseudoranges(err);
+      checkRAIM(testFramework, prs, pr, gpstk::Matrix<double>(),
+                used, iret);
+      for (int i = 0; i < used.size(); i++)
+         TUASSERTE(bool, (i != bad1), (used[i].id > 0));
+      for (int i = 0; i < 3; i++)
+         TUASSERTFEPS(rx[i], prs.Solution(i), 1.e-3);
+      TUASSERTE(unsigned long, 1, prs.RAIMCounters.NCalls);
+      TUASSERTE(unsigned long, 1+N, prs.RAIMCounters.NSubsets);
+      TUASSERTE(unsigned long, N, prs.RAIMCounters.NDowndates);
+
+      prs.RAIMCounters = gpstk::PRSolution::RAIMCounts();
+
+      err[bad2] = -150.0;
+      pr = pseudoranges(err);
+      checkRAIM(testFramework, prs, pr, gpstk::Matrix<double>(),
+                used, iret);
+      for (int i = 0; i < used.size(); i++)
+         TUASSERTE(bool, (i != bad1 && i != bad2), (used[i].id > 0));
+      for (int i = 0; i < 3; i++)
+         TUASSERTFEPS(rx[i], prs.Solution(i), 1.e-3);
+      TUASSERTE(unsigned long, 1 + N + N*(N-1)/2, prs.RAIMCounters.NSubsets);
+      TUASSERTE(unsigned long, N + N*(N-1)/2, prs.RAIMCounters.NDowndates);
+         // the warm start needs fewer iterations than the cold one
+      TUASSERT(prs.RAIMCounters.NIterations
+               < coldIterations * prs.RAIMCounters.NSubsets);
+      TURETURN();
+   }
+
+      /** A weight matrix with correlations can't be downdated by rows, so
+       * every subset is solved from the start. */
+   unsigned weightedTest()
+   {
+      TUDEF("PRSolution", "RAIMCompute");
+      gpstk::PRSolution prs;
+      prs.hasMemory = false;
+      vector<gpstk::SatID> used;
+      int iret;
+      const size_t N(sats.size());
+      gpstk::Matrix<double> invMC(N, N, 0.0);
+      for (int i = 0; i < N; i++)
+      {
+         invMC(i,i) = 1.0 + 0.1*i;
+         if (i > 0)
+            invMC(i,i-1) = invMC(i-1,i) = 0.05;
+      }
+      vector<double> err(N, 0.0);
+      err[1] = 100.0;
+      vector<double> pr = pseudoranges(err);
+      checkRAIM(testFramework, prs, pr, invMC, used, iret);
+      TUASSERT(used[1].id < 0);
+      TUASSERTE(unsigned long, 0, prs.RAIMCounters.NDowndates);
+
+         // diagonal weights are downdated
+      for (int i = 1; i < N; i++)
+         invMC(i,i-1) = invMC(i-1,i) = 0.0;
+      prs.RAIMCounters = gpstk::PRSolution::RAIMCounts();
+      checkRAIM(testFramework, prs, pr, invMC, used, iret);
+      TUASSERT(used[1].id < 0);
+      TUASSERTE(unsigned long, N, prs.RAIMCounters.NDowndates);
+      TURETURN();
+   }
+
+      /** All the satellites in one line of sight make the problem
+       * singular; no solution is stored and it is not valid. */
+   unsigned singularTest()
+   {
+      TUDEF("PRSolution", "SimplePRSolution");
+      gpstk::PRSolution prs;
+      prs.hasMemory = false;
+      gpstk::ZeroTropModel trop;
+      vector<gpstk::SatID::SatelliteSystem> syss(
+         1, gpstk::SatID::systemGPS);
+      vector<gpstk::SatID> line(allSats.begin(), allSats.begin()+5);
+         // on the earth's axis, so the earth rotation keeps them in line
+      gpstk::Matrix<double> SVP(line.size(), 4), invMC;
+      for (int i = 0; i < line.size(); i++)
+      {
+         SVP(i,0) = SVP(i,1) = 0.0;
+         SVP(i,2) = 2.0e7 + 1.0e6*i;
+         SVP(i,3) = SVP(i,2) + clk;
+      }
+      gpstk::Vector<double> resids, slopes;
+      int iret = prs.SimplePRSolution(tr, line, SVP, invMC, &trop,
+                                      10, 3.e-7, syss, resids, slopes);
+      TUASSERTE(int, -2, iret);
+      TUASSERT(!prs.isValid());
+      TUASSERTE(size_t, 0, prs.Covariance.rows());
+      TURETURN();
+   }
+
+   gpstk::SP3EphemerisStore eph;
+   vector<gpstk::SatID> allSats, sats;
+   gpstk::CommonTime tr;
+   double rx[3], clk;
+   int coldIterations;
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PRSolution_T testClass;
+   if (!testClass.initialize())
+   {
+      cerr << "PRSolution_T: unable to load test data" << endl;
+      return 1;
+   }
+   errorTotal += testClass.cleanTest();
+   errorTotal += testClass.outlierTest();
+   errorTotal += testClass.weightedTest();
+   errorTotal += testClass.singularTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -0,0 +1,68 @@
+# RinSum keeps no state from one input file to the next, and with --threads
+# summarizes several files at once, writing the output in file order. This
+# checks both: summarizing the files one at a time, all together, and all
+# together on several threads must give the same output.
+
+# Required variables
+# TEST_PROG: the program under test
+# SOURCEDIR: the directory holding the input files
+# TARGETDIR: the directory to store the outputs
+# TESTBASE: the name of the test, used to create the output files
+# ARGS: a space-separated argument list used for every run
+# FILES: a space-separated list of input files in SOURCEDIR
+# THREADS: the number of threads for the last run
+
+string(REPLACE " " ";" ARG_LIST ${ARGS})
+string(REPLACE " " ";" FILE_LIST ${FILES})
+
+set(each ${TARGETDIR}/${TESTBASE}-each.out)
+set(all ${TARGETDIR}/${TESTBASE}-all.out)
+set(threads ${TARGETDIR}/${TESTBASE}-threads.out)
+
+# one file at a time
+file(WRITE ${each} "")
+set(OBS_LIST)
+foreach(f ${FILE_LIST})
+    message(STATUS         "${TEST_PROG} ${ARGS} --obspath ${SOURCEDIR} --obs ${f}")
+    execute_process(COMMAND ${TEST_PROG} ${ARG_LIST} --obspath ${SOURCEDIR} --obs ${f}
+        OUTPUT_VARIABLE out
+        RESULT_VARIABLE RC)
+    if(NOT RC EQUAL 0)
+        message(FATAL_ERROR "Test failed, ${RC} != 0")
+    endif()
+    file(APPEND ${each} "${out}")
+    list(APPEND OBS_LIST --obs ${f})
+endforeach()
+
+# all the files in one run, serially and then on several threads
+message(STATUS         "${TEST_PROG} ${ARGS} --obspath ${SOURCEDIR} ${OBS_LIST}")
+execute_process(COMMAND ${TEST_PROG} ${ARG_LIST} --obspath ${SOURCEDIR} ${OBS_LIST}
+    OUTPUT_FILE ${all}
+    RESULT_VARIABLE RC)
+if(NOT RC EQUAL 0)
+    message(FATAL_ERROR "Test failed, ${RC} != 0")
+endif()
+
+message(STATUS         "${TEST_PROG} ${ARGS} --threads ${THREADS} --obspath ${SOURCEDIR} ${OBS_LIST}")
+execute_process(COMMAND ${TEST_PROG} ${ARG_LIST} --threads ${THREADS} --obspath ${SOURCEDIR} ${OBS_LIST}
+    OUTPUT_FILE ${threads}
+    RESULT_VARIABLE RC)
+if(NOT RC EQUAL 0)
+    message(FATAL_ERROR "Test failed, ${RC} != 0")
+endif()
+
+message(STATUS "diff ${all} ${each}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${all} ${each}
+    RESULT_VARIABLE RC)
+if(RC)
+    message(FATAL_ERROR "Test failed, summarizing the files together differs")
+endif()
+
+message(STATUS "diff ${threads} ${all}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${threads} ${all}
+    RESULT_VARIABLE RC)
+if(RC)
+    message(FATAL_ERROR "Test failed, summarizing on ${THREADS} threads differs")
+endif()
+
+message(STATUS "Test passed")
@@ -0,0 +1,193 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file CommonTimeBench.cpp
+ * Time CommonTime used as a container key: sorting, std::map insert
+ * and lookup, and the ephemeris store lookups that are keyed on it
+ * (Rinex3EphemerisStore, i.e. OrbitEphStore, and SP3EphemerisStore,
+ * i.e. TabularSatStore).
+ *
+ * Usage: CommonTimeBench [-n count] [-r repeat]
+ */
+
+#include "CommonTime.hpp"
+#include "CivilTime.hpp"
+#include "Rinex3EphemerisStore.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "build_config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+typedef chrono::steady_clock Clock;
+
+static double since(const Clock::time_point& start)
+{
+   return chrono::duration<double>(Clock::now() - start).count();
+}
+
+   /// Evaluate every satellite of store at count times over its span;
+   /// returns the time taken, and the number of evaluations in n.
+static double storeLookups(XvtStore<SatID>& store, unsigned count,
+                           unsigned repeat, unsigned& n, double& sum)
+{
+   CommonTime t0(store.getInitialTime()), t1(store.getFinalTime());
+   double span(t1 - t0);
+   vector<CommonTime> times;
+   for (unsigned i = 0; i < count; i++)
+   {
+      times.push_back(t0 + span * (0.05 + 0.9 * i / count));
+      times.back().setTimeSystem(TimeSystem::GPS);
+   }
+
+      // only the satellites that can be evaluated mid-span
+   vector<SatID> sats;
+   for (int prn = 1; prn <= 32; prn++)
+   {
+      SatID sat(prn, SatID::systemGPS);
+      try
+      {
+         store.getXvt(sat, times[count/2]);
+         sats.push_back(sat);
+      }
+      catch (Exception&) {}
+   }
+
+   n = 0;
+   Clock::time_point start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (unsigned i = 0; i < count; i++)
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            try
+            {
+               sum += store.getXvt(sats[s], times[i]).x[0];
+               n++;
+            }
+            catch (Exception&) {}
+         }
+   return since(start);
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned count = 200000, repeat = 5;
+   for (int i = 1; i < argc; i++)
+   {
+      if (!strcmp(argv[i], "-n") && i+1 < argc)
+         count = atoi(argv[++i]);
+      else if (!strcmp(argv[i], "-r") && i+1 < argc)
+         repeat = atoi(argv[++i]);
+   }
+
+      // epochs over ten days, 1 s apart with some fractional
+      // seconds, in a scrambled order
+   CommonTime t0 = CivilTime(2015, 7, 19, 0, 0, 0.0, TimeSystem::GPS);
+   vector<CommonTime> times(count);
+   for (unsigned i = 0; i < count; i++)
+   {
+      unsigned k = (i * 7919UL) % count;
+      times[i] = t0 + (864000.0 * k) / count + 0.25 * (k % 4);
+   }
+
+   vector<CommonTime> sorted;
+   Clock::time_point start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      sorted = times;
+      sort(sorted.begin(), sorted.end());
+   }
+   double tSort = since(start);
+
+   map<CommonTime, unsigned> timeMap;
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      timeMap.clear();
+      for (unsigned i = 0; i < count; i++)
+         timeMap[times[i]] = i;
+   }
+   double tInsert = since(start);
+
+   unsigned long found = 0;
+   start = Clock::now();
+   for (unsigned r = 0; r < repeat; r++)
+      for (unsigned i = 0; i < count; i++)
+      {
+         found += timeMap.find(times[i])->second;
+         found += timeMap.lower_bound(times[i] + 0.5)->second;
+      }
+   double tFind = since(start);
+
+   Rinex3EphemerisStore rinStore;
+   rinStore.loadFile(getPathData() + getFileSep() + "arlm200a.15n");
+   SP3EphemerisStore sp3Store;
+   sp3Store.loadFile(getPathData() + getFileSep() + "test_input_sp3_nav_ephemerisData.sp3");
+
+   double sum = 0;
+   unsigned nRin = 0, nSP3 = 0;
+   double tRin = storeLookups(rinStore, count/100, repeat, nRin, sum);
+   double tSP3 = storeLookups(sp3Store, count/100, repeat, nSP3, sum);
+
+   double nsPer = 1e9 / (double(count) * repeat);
+   cout << fixed << setprecision(1)
+        << "epochs: " << count << "  passes: " << repeat
+        << "  sizeof(CommonTime): " << sizeof(CommonTime) << endl
+        << "sort:                " << setw(8) << tSort * nsPer
+        << " ns/epoch" << endl
+        << "map insert:          " << setw(8) << tInsert * nsPer
+        << " ns/epoch" << endl
+        << "map find+lower_bound:" << setw(8) << tFind * nsPer
+        << " ns/epoch" << endl
+        << "OrbitEphStore getXvt:" << setw(8)
+        << (nRin ? 1e9 * tRin / nRin : 0.0) << " ns/call" << endl
+        << "SP3 store getXvt:    " << setw(8)
+        << (nSP3 ? 1e9 * tSP3 / nSP3 : 0.0) << " ns/call" << endl
+        << "(" << timeMap.size() << " keys, checksum " << found % 1000
+        << " " << sum << ")" << endl;
+
+   return 0;
+}
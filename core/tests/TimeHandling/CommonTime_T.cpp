@@ -824,6 +824,50 @@ public:
 
       return testFramework.countFails();
    }
+
+      //============================================================
+      // Test Suite: packedTimeTest()
+      //============================================================
+      //
+      // Test that packedTime() orders as the time does, that only
+      // fsod breaks ties, and that large additions of milliseconds
+      // roll into days
+      //
+      //============================================================
+   int packedTimeTest( void )
+   {
+      TestUtil testFramework( "CommonTime", "packedTime", __FILE__, __LINE__ );
+
+      CommonTime early; early.set( 1000, 86399, 0.9995, TimeSystem::GPS );
+      CommonTime day;     day.set( 1001, 0,     0.0,    TimeSystem::GPS );
+      CommonTime later(day); later.addSeconds( 0.0000001 );
+      CommonTime utc;     utc.set( 1001, 0,     0.0,    TimeSystem::UTC );
+
+      testFramework.assert( early.packedTime() < day.packedTime(), "Verify packedTime orders across a day boundary", __LINE__ );
+      testFramework.assert( early < day && !(day < early),         "Verify operator< across a day boundary",        __LINE__ );
+      testFramework.assert( day.packedTime() == later.packedTime(), "Verify sub-millisecond times share packedTime", __LINE__ );
+      testFramework.assert( day < later && !(later < day),         "Verify fsod breaks packedTime ties",             __LINE__ );
+      testFramework.assert( day <= later && later >= day && later > day, "Verify derived operators",                __LINE__ );
+
+      bool threw = false;
+      try { threw = (day < utc); threw = false; }
+      catch( InvalidRequest& ) { threw = true; }
+      testFramework.assert( threw, "Verify operator< throws for different time systems", __LINE__ );
+
+         // 40 days of milliseconds does not fit in 32 bits
+      testFramework.changeSourceMethod( "addMilliseconds" );
+      CommonTime big(day); big.addMilliseconds( 40L * MS_PER_DAY + 5 );
+      long bigDay, bigMsod;
+      double bigFsod;
+      big.getInternal( bigDay, bigMsod, bigFsod );
+      testFramework.assert( bigDay == 1041 && bigMsod == 5, "Verify large millisecond additions roll into days", __LINE__ );
+
+         //----------------------------------------
+         // The End!
+         //----------------------------------------
+      return testFramework.countFails();
+   }
+
 private:
 
    double eps;
@@ -866,6 +910,9 @@ int main( void )
    errorCounter += check;
 
    check = testClass.printfTest();
+   errorCounter += check;
+
+   check = testClass.packedTimeTest();
    errorCounter += check;
 
       //----------------------------------------
@@ -0,0 +1,128 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "TextSpan.hpp"
+#include "StringUtils.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+
+using namespace gpstk;
+
+class TextSpan_T
+{
+public:
+   TextSpan_T() {}
+   ~TextSpan_T() {}
+
+   int columnTest(void)
+   {
+      TUDEF("TextSpan", "sub");
+
+      std::string line("G01  20123456.789 7   1.5");
+      TextSpan span(line);
+
+      TUASSERTE(std::size_t, line.size(), span.size());
+      TUASSERTE(std::string, "G01", span.sub(0,3).toString());
+         // clipped at the end of the line
+      TUASSERTE(std::string, "1.5", span.sub(22,16).toString());
+      TUASSERTE(std::size_t, 0, span.sub(100,16).size());
+
+      TUCSM("at");
+      TUASSERTE(char, 'G', span.at(0));
+      TUASSERTE(char, ' ', span.at(line.size()));
+      TUASSERTE(char, ' ', span.at(1000));
+
+      TUCSM("isBlank");
+      TUASSERT(span.sub(3,2).isBlank());
+      TUASSERT(span.sub(100,2).isBlank());
+      TUASSERT(!span.sub(0,3).isBlank());
+
+      TUCSM("stripTrailing");
+      std::string padded("abc   ");
+      TextSpan ps(padded);
+      ps.stripTrailing();
+      TUASSERTE(std::string, "abc", ps.toString());
+
+      TURETURN();
+   }
+
+      /// Every conversion must agree bit-for-bit with StringUtils.
+   int conversionTest(void)
+   {
+      TUDEF("TextSpan", "asDouble");
+
+      const char *dblFields[] =
+         { "  20123456.789", "   -123456.789", "         0.000", "        -0.000",
+           "     1.5", "1.5", "  +2.25", "   .5", "   5.", "1.5E3",
+           " 1.5D3", "  12 34", "", "    ", "-", "abc",
+           "123456789012.345", "1234567890123456789.5", "0.1", "\t7.25",
+           "  0.30000000000000004" };
+      for (unsigned i = 0; i < sizeof(dblFields)/sizeof(dblFields[0]); i++)
+      {
+         std::string s(dblFields[i]);
+         double expect = StringUtils::asDouble(s);
+         double got = TextSpan(s).asDouble();
+         testFramework.assert(expect == got, "asDouble(\"" + s + "\")",
+                              __LINE__);
+      }
+
+      TUCSM("asInt");
+      const char *intFields[] =
+         { "2015", "  7", " -3", "+12", "5x", "", " ", "x", "\t9",
+           "1234567890123456789012" };
+      for (unsigned i = 0; i < sizeof(intFields)/sizeof(intFields[0]); i++)
+      {
+         std::string s(intFields[i]);
+         TUASSERTE(long, StringUtils::asInt(s), TextSpan(s).asInt());
+      }
+
+      TURETURN();
+   }
+};
+
+int main() //Main function to initialize and run all tests above
+{
+   int errorTotal = 0;
+   TextSpan_T testClass;
+
+   errorTotal += testClass.columnTest();
+   errorTotal += testClass.conversionTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal << std::endl;
+
+   return errorTotal; //Return the total number of errors
+}
@@ -55,6 +55,8 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <exception>
+#include <sstream>
 // gpstk
 #include "MathBase.hpp"
 #include "RinexSatID.hpp"
@@ -68,6 +70,7 @@
 #include "Epoch.hpp"
 #include "TimeString.hpp"
 #include "StringUtils.hpp"
+#include "ThreadPool.hpp"
 // geomatics
 #include "logstream.hpp"
 #include "stl_helpers.hpp"
@@ -122,6 +125,7 @@ typedef struct configuration {
    bool smoothPR,smoothPH,smooth;
    int debug;
    bool verbose,DChelp;
+   int nThreads;                 // number of threads processing passes
    vector<string> DCcmds;        // all the --DC... on the cmd line
       // estimate dt from data
    double estdt[9];
@@ -154,6 +158,15 @@ typedef struct configuration {
    GDCconfiguration GDConfig;       // the discontinuity corrector configuration
 } DFConfig;
 
+// results of processing one pass, kept until they are written out in pass order
+typedef struct passResults {
+   int iret;                     // return value of the GDC
+   Epoch first,last;             // first good and last times, if iret is 0
+   vector<string> EditCmds;      // editing commands from the GDC
+   string log;                   // log and GDC debug output
+   exception_ptr error;          // exception thrown while processing, if any
+} PassResults;
+
 // declare (one only) global configuration object
 DFConfig cfg;
 
@@ -165,6 +178,7 @@ void DumpConfiguration(void) throw(Exception);
 int Initialize(void) throw(Exception);
 int ShallowCheck(void) throw(Exception);  // called by Initialize()
 int WriteToRINEX(void) throw(Exception);
+void ProcessPass(const int npass, PassResults& results);
 void PrintSPList(ostream&, string, vector<SatPass>&);
 
 //------------------------------------------------------------------------------------
@@ -175,8 +189,6 @@ int main(int argc, char **argv)
       clock_t totaltime = clock();
       int i,nread,npass,iret;
       Epoch ttag;
-      string msg;
-      vector<string> EditCmds;
 
       // Title and description
       cfg.Title = PrgmName+", part of the GPS ToolKit, Ver "+DiscFixVersion+", Run ";
@@ -311,43 +323,35 @@ int main(int argc, char **argv)
          LOG(INFO) << "";
 
          // -------------------------------- call the GDC, output results and smooth
-         for(npass=0; npass<cfg.SPList.size(); npass++) {
-
-            LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << cfg.SPList[npass];
-            //cfg.SPList[npass].dump(*pLOGstrm,"RAW");      // temp
-
-            msg = "";
-            iret=DiscontinuityCorrector(cfg.SPList[npass],cfg.GDConfig,EditCmds,msg);
-            if(iret != 0) {
-               cfg.SPList[npass].status() = -1;         // failed
-               LOG(ERROR) << "GDC failed (" << iret << " "
-                  << (iret==-1 ? "Singularity":
-                     (iret==-3 ? "DT not set, or memory":
-                     (iret==-4 ? "No data":"Bad input")))
-                  << ") for pass "
-                  << npass+1 << " :\n" << msg;
-               continue;
-            }
-            //if(cfg.verbose && LOGlevel < ConfigureLOG::Level("VERBOSE"))
-            LOG(INFO) << msg;
-
-            ttag = cfg.SPList[npass].getFirstGoodTime();
-            if(ttag < cfg.FirstEpoch) cfg.FirstEpoch = ttag;
-            ttag = cfg.SPList[npass].getLastTime();
-            if(ttag > cfg.LastEpoch) cfg.LastEpoch = ttag;
-
-            // output editing commands
-            for(i=0; i<EditCmds.size(); i++)
-               cfg.ofout << EditCmds[i] << " # pass " << npass+1 << endl;
-            EditCmds.clear();
-
-            // smooth pseudorange and debias phase
-            if(cfg.smooth) {
-               cfg.SPList[npass].smooth(cfg.smoothPR, cfg.smoothPH, msg);
-               LOG(INFO) << msg;
+         // Passes are independent, so with --threads they are processed
+         // concurrently, a block at a time; the results of each block are then
+         // written in pass order, so output does not depend on the thread count.
+         {
+            ThreadPool pool(cfg.nThreads);
+            if(pool.size() > 1)
+               LOG(VERBOSE) << "Process passes using " << pool.size() << " threads";
+            const int blockSize(4*pool.size());
+            vector<PassResults> results(blockSize);
+            for(int beg=0; beg<cfg.SPList.size(); beg+=blockSize) {
+               const int n(min(blockSize,int(cfg.SPList.size())-beg));
+               pool.run(n, [&](size_t k) { ProcessPass(beg+k, results[k]); });
+
+               for(int k=0; k<n; k++) {
+                  PassResults& res(results[k]);
+                  npass = beg+k;
+                  if(!res.log.empty()) ConfigureLOGstream::Output(res.log);
+                  if(res.error) rethrow_exception(res.error);
+                  if(res.iret != 0) continue;
+
+                  if(res.first < cfg.FirstEpoch) cfg.FirstEpoch = res.first;
+                  if(res.last > cfg.LastEpoch) cfg.LastEpoch = res.last;
+
+                  // output editing commands
+                  for(i=0; i<res.EditCmds.size(); i++)
+                     cfg.ofout << res.EditCmds[i] << " # pass " << npass+1 << endl;
+               }
             }
-
-         }  // end for() loop over passes
+         }
 
          // -------------------------------- write to RINEX
          iret = WriteToRINEX();
@@ -385,6 +389,51 @@ int main(int argc, char **argv)
 
 }   // end main()
 
+//------------------------------------------------------------------------------------
+// Call the GDC on one pass, and smooth it; this may run in any thread, so it only
+// reads cfg, apart from this pass, and saves its output in results.
+void ProcessPass(const int npass, PassResults& results)
+{
+   results.log.clear();
+   LogCapture capture(results.log);                  // capture the LOG output
+   results.EditCmds.clear();
+   results.error = exception_ptr();
+   try {
+      SatPass& SP(cfg.SPList[npass]);
+      string msg;
+
+      LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << SP;
+      //SP.dump(*pLOGstrm,"RAW");      // temp
+
+      results.iret = DiscontinuityCorrector(SP, cfg.GDConfig, npass+1,
+                                            capture.stream(),
+                                            results.EditCmds, msg);
+      if(results.iret != 0) {
+         SP.status() = -1;         // failed
+         LOG(ERROR) << "GDC failed (" << results.iret << " "
+            << (results.iret==-1 ? "Singularity":
+               (results.iret==-3 ? "DT not set, or memory":
+               (results.iret==-4 ? "No data":"Bad input")))
+            << ") for pass "
+            << npass+1 << " :\n" << msg;
+      }
+      else {
+         //if(cfg.verbose && LOGlevel < ConfigureLOG::Level("VERBOSE"))
+         LOG(INFO) << msg;
+
+         results.first = SP.getFirstGoodTime();
+         results.last = SP.getLastTime();
+
+         // smooth pseudorange and debias phase
+         if(cfg.smooth) {
+            SP.smooth(cfg.smoothPR, cfg.smoothPH, msg);
+            LOG(INFO) << msg;
+         }
+      }
+   }
+   catch(...) { results.error = current_exception(); }
+}
+
 //------------------------------------------------------------------------------------
 int Initialize(void) throw(Exception)
 {
@@ -819,6 +868,7 @@ try {
    cfg.doGLO = false;      // if true, process GLONASS sats
 
    cfg.dt = -1.0;
+   cfg.nThreads = 1;
    
    cfg.HDPrgm = PrgmName + string(" v.") + DiscFixVersion.substr(0,4);
    cfg.HDRunby = string("ARL:UT/SGL/GPSTk");
@@ -900,6 +950,8 @@ try {
             "Process GLONASS satellites as well as GPS");
    opts.Add(0, "GLOfreq", "sat:n", true, false, &GLOfreqStrs, "",
             "GLO channel #s for each sat [e.g. R17:-4]");
+   opts.Add(0, "threads", "n", false, false, &cfg.nThreads, "",
+            "Number of threads used to process passes [0 for one per core]");
 
    opts.Add(0, "smoothPR", "", false, false, &cfg.smoothPR,
    "# Smoothing: [NB smoothed pseudorange and debiased phase are not identical.]",
@@ -1011,6 +1063,9 @@ try {
       }
    }
 
+   if(cfg.nThreads < 0)
+      oss << "Error - --threads must not be negative: " << cfg.nThreads << endl;
+
    if(cfg.noCA1) cfg.useCA1 = false;
    if(cfg.noCA2) cfg.useCA2 = false;
 
@@ -1137,6 +1192,10 @@ try {
    if(cfg.smoothPR) LOG(INFO) << " 'Smoothed range' option is on\n";
    if(cfg.smoothPH) LOG(INFO) << " 'Smoothed phase' option is on\n";
    if(!cfg.smooth) LOG(INFO) << " No smoothing.\n";
+   if(cfg.nThreads == 0)
+      LOG(INFO) << " Process passes using one thread per core";
+   else if(cfg.nThreads > 1)
+      LOG(INFO) << " Process passes using " << cfg.nThreads << " threads";
 
 } // end try
 catch(Exception& e) { GPSTK_RETHROW(e); }
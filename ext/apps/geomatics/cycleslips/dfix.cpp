@@ -963,6 +963,7 @@ try {
    //for(i=0; i<GD.exSats.size(); i++)   // excluded sats (not systems)
    //   rofl.excludeSat(GD.exSats[i]);
    rofl.saveTheData(true);             // no sense to have wantedObsIDs without save
+   rofl.saveColumns(true);             // compact store, only WriteSatPassList
    if(GD.decdt > 0.0)                  // decimate
       rofl.setDecimation(GD.decdt);
    rofl.setStartTime(GD.startTime);    // start and stop times
@@ -0,0 +1,105 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/*********************************************************************
+*
+*  Throughput of the P-code generators in gpstk/ext/lib/CodeGen.
+*
+*  PCodeRate [numPRN [seconds]]
+*
+*  Generates seconds (default 6) of P-code for PRNs 1 to numPRN
+*  (default 37) with MultiPCodeGen, and six seconds for one PRN with
+*  SVPCodeGen, and reports the chips generated per second of CPU time.
+*  Real time is 10.23e6 chips per second per PRN.
+*
+*********************************************************************/
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include "MultiPCodeGen.hpp"
+#include "SVPCodeGen.hpp"
+#include "GPSWeekZcount.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main( int argc, char * argv[] )
+{
+   int numPRN = argc > 1 ? atoi(argv[1]) : 37;
+   double seconds = argc > 2 ? atof(argv[2]) : 6;
+   if (numPRN < 1 || numPRN > MAX_PRN_CODE || seconds <= 0)
+   {
+      cerr << "Usage: PCodeRate [numPRN [seconds]]" << endl;
+      return(1);
+   }
+
+   X1Sequence::allocateMemory();
+   X2Sequence::allocateMemory();
+
+      // MultiPCodeGen, 0.1 s per call
+   const long wordsPerCall = 31969;
+   long calls = long(seconds * 10 + 0.5);
+   vector<int> prns;
+   for (int prn=1;prn<=numPRN;++prn) prns.push_back(prn);
+   vector< vector<uint32_t> > code(numPRN, vector<uint32_t>(wordsPerCall));
+   vector<uint32_t*> out;
+   for (int k=0;k<numPRN;++k) out.push_back(&code[k][0]);
+
+   MultiPCodeGen gen(prns, GPSZcount(1950, 1234));
+   clock_t start = clock();
+   for (long i=0;i<calls;++i)
+      gen.getChips(&out[0], wordsPerCall);
+   double cpu = double(clock() - start) / CLOCKS_PER_SEC;
+   double chips = 32.0 * wordsPerCall * calls * numPRN;
+   cout << "MultiPCodeGen: " << numPRN << " PRNs, " << chips << " chips in "
+        << cpu << " s: " << chips / cpu << " chips/s, "
+        << chips / cpu / 10.23e6 << " times real time for one PRN" << endl;
+
+      // SVPCodeGen, six seconds of one PRN
+   CodeBuffer pcb(1);
+   SVPCodeGen svGen(1, GPSWeekZcount(1950, 1232));
+   start = clock();
+   svGen.getCurrentSixSeconds(pcb);
+   cpu = double(clock() - start) / CLOCKS_PER_SEC;
+   chips = double(CHIPS_PER_6SEC);
+   cout << "SVPCodeGen:    1 PRN, " << chips << " chips in "
+        << cpu << " s: " << chips / cpu << " chips/s, "
+        << chips / cpu / 10.23e6 << " times real time for one PRN" << endl;
+
+   X1Sequence::deAllocateMemory();
+   X2Sequence::deAllocateMemory();
+   return(0);
+}
@@ -0,0 +1,304 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <algorithm>
+#include "MultiPCodeGen.hpp"
+#include "mergePCodeWords.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+   (defined(__x86_64__) || defined(__i386__))
+#define PCODE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace gpstk
+{
+   const long LAST_6SEC_X1COUNT_OF_WEEK = 403200 - 4;
+
+      /*
+         out[i] = X1 word i ^ X2 word i for i < n, where the X1 word i is
+         the 32 bits starting s1 bits into x1[i] and likewise for X2.
+         x1[n] and x2[n] must be readable.  (w >> 1) >> (31 - s) is
+         w >> (32 - s) without the undefined shift by 32 when s is 0.
+      */
+   static void mergeXorWords( uint32_t *out,
+                              const uint32_t *x1, int s1,
+                              const uint32_t *x2, int s2,
+                              long n )
+   {
+      for (long i=0;i<n;++i)
+      {
+         out[i] = ((x1[i] << s1) | ((x1[i+1] >> 1) >> (MAX_BIT-1-s1))) ^
+                  ((x2[i] << s2) | ((x2[i+1] >> 1) >> (MAX_BIT-1-s2)));
+      }
+   }
+
+#ifdef PCODE_AVX2
+      // mergeXorWords() eight words at a time.  Vector shifts by 32
+      // give zero, so no special case is needed for s == 0.
+   __attribute__((target("avx2")))
+   static void mergeXorAVX2( uint32_t *out,
+                             const uint32_t *x1, int s1,
+                             const uint32_t *x2, int s2,
+                             long n )
+   {
+      const __m128i left1 = _mm_cvtsi32_si128(s1);
+      const __m128i right1 = _mm_cvtsi32_si128(MAX_BIT-s1);
+      const __m128i left2 = _mm_cvtsi32_si128(s2);
+      const __m128i right2 = _mm_cvtsi32_si128(MAX_BIT-s2);
+      long i = 0;
+      for (;i+8<=n;i+=8)
+      {
+         __m256i a = _mm256_loadu_si256((const __m256i *)(x1+i));
+         __m256i b = _mm256_loadu_si256((const __m256i *)(x1+i+1));
+         __m256i c = _mm256_loadu_si256((const __m256i *)(x2+i));
+         __m256i d = _mm256_loadu_si256((const __m256i *)(x2+i+1));
+         a = _mm256_or_si256(_mm256_sll_epi32(a, left1),
+                             _mm256_srl_epi32(b, right1));
+         c = _mm256_or_si256(_mm256_sll_epi32(c, left2),
+                             _mm256_srl_epi32(d, right2));
+         _mm256_storeu_si256((__m256i *)(out+i), _mm256_xor_si256(a, c));
+      }
+      mergeXorWords(out+i, x1+i, s1, x2+i, s2, n-i);
+   }
+#endif
+
+   static void mergeXor( uint32_t *out,
+                         const uint32_t *x1, int s1,
+                         const uint32_t *x2, int s2,
+                         long n )
+   {
+#ifdef PCODE_AVX2
+      static const bool haveAVX2 = __builtin_cpu_supports("avx2");
+      if (haveAVX2)
+      {
+         mergeXorAVX2(out, x1, s1, x2, s2, n);
+         return;
+      }
+#endif
+      mergeXorWords(out, x1, s1, x2, s2, n);
+   }
+
+      /*
+         The 32 X2 chips starting at chip X2count (-37 to MAX_X2_TEST-1),
+         wrapping from the end of the sequence to chip 0 (bit 37 of the
+         array, after the beginning of week delay).
+      */
+   static uint32_t X2Word( const uint32_t *bits, long X2count )
+   {
+      long adjustedCount = X2count + X2A_EPOCH_DELAY;
+      long ndx = adjustedCount / MAX_BIT;
+      int offset = adjustedCount - ndx * MAX_BIT;
+      if (adjustedCount + MAX_BIT <= MAX_X2_COUNT)
+         return(merge(bits[ndx], bits[ndx+1], offset));
+
+      int numRemaining = MAX_X2_COUNT - adjustedCount;
+      uint32_t last = bits[ndx] << offset;
+      if (offset + numRemaining > MAX_BIT)
+         last |= bits[ndx+1] >> (MAX_BIT - offset);
+      last &= ~(0xFFFFFFFF >> numRemaining);
+      uint32_t first = merge(bits[1], bits[2], X2A_EPOCH_DELAY - MAX_BIT);
+      return(last | (first >> numRemaining));
+   }
+
+   MultiPCodeGen::MultiPCodeGen( const std::vector<int>& SVPRNIDs,
+                                 const gpstk::GPSZcount& z )
+         : PRNIDs(SVPRNIDs)
+   {
+      for (size_t k=0;k<PRNIDs.size();++k)
+      {
+         if (PRNIDs[k] < 1 || PRNIDs[k] > MAX_PRN_CODE)
+         {
+            gpstk::Exception e("Must provide prns between 1 and 210");
+            GPSTK_THROW(e);
+         }
+            // PRNs above 37 are the codes of lower PRNs, days later.
+         dayAdvance.push_back(int64_t((PRNIDs[k] - 1) / 37) *
+                              X1_PER_DAY * CHIPS_PER_ZCOUNT);
+      }
+      X2SeqEOW.setEOWX2Epoch(true);
+      setCurrentZCount(z);
+   }
+
+   void MultiPCodeGen::getChips( uint32_t* const buffers[], long numWords )
+   {
+         // 8 kB of X1 words per block, which stay in cache while the
+         // block is done for each PRN.
+      const long blockWords = 2048;
+      for (long block=0;block<numWords;block+=blockWords)
+      {
+         long n = std::min(blockWords, numWords - block);
+         for (size_t k=0;k<PRNIDs.size();++k)
+            generate(k, chipOfWeek + int64_t(block) * MAX_BIT,
+                     buffers[k] + block, n);
+      }
+      chipOfWeek += int64_t(numWords) * MAX_BIT;
+      while (chipOfWeek >= CHIPS_PER_WEEK)
+      {
+         chipOfWeek -= CHIPS_PER_WEEK;
+         ++week;
+      }
+   }
+
+   void MultiPCodeGen::setCurrentChip( const gpstk::GPSZcount& z,
+                                       int64_t chip )
+   {
+      week = z.getWeek();
+      chipOfWeek = int64_t(z.getZcount()) * CHIPS_PER_ZCOUNT + chip;
+      while (chipOfWeek >= CHIPS_PER_WEEK)
+      {
+         chipOfWeek -= CHIPS_PER_WEEK;
+         ++week;
+      }
+      while (chipOfWeek < 0)
+      {
+         chipOfWeek += CHIPS_PER_WEEK;
+         --week;
+      }
+   }
+
+   gpstk::GPSZcount MultiPCodeGen::getCurrentZCount() const
+   {
+      return(GPSZcount(week, long(chipOfWeek / CHIPS_PER_ZCOUNT)));
+   }
+
+   void MultiPCodeGen::generate( size_t k, int64_t chip,
+                                 uint32_t *out, long numWords )
+   {
+      chip = (chip + dayAdvance[k]) % CHIPS_PER_WEEK;
+      while (numWords > 0)
+      {
+         long interval = long(chip / CHIPS_PER_6SEC);
+         long X1count = interval * 4;
+         long offset = long(chip - int64_t(interval) * CHIPS_PER_6SEC);
+
+            // The whole words left in this interval, ...
+         long n = std::min(numWords, (CHIPS_PER_6SEC - offset) / MAX_BIT);
+         generateInterval(k, X1count, offset, out, n);
+         out += n;
+         numWords -= n;
+         chip += int64_t(n) * MAX_BIT;
+         offset += n * MAX_BIT;
+
+            // ... then the word that runs into the next one.
+         if (numWords > 0 && offset < CHIPS_PER_6SEC)
+         {
+            *out++ = chipWord(k, X1count, offset);
+            --numWords;
+            chip += MAX_BIT;
+         }
+         if (chip >= CHIPS_PER_WEEK)
+            chip -= CHIPS_PER_WEEK;
+      }
+   }
+
+   void MultiPCodeGen::generateInterval( size_t k, long X1count, long offset,
+                                         uint32_t *out, long numWords )
+   {
+      const uint32_t *X1Bits = &X1Seq[0];
+      const uint32_t *X2Bits = (X1count == LAST_6SEC_X1COUNT_OF_WEEK ?
+                                X2SeqEOW.getBits() : X2Seq.getBits());
+      long X2count = X2Start(k, X1count) + offset;
+      if (X2count >= MAX_X2_TEST) X2count -= MAX_X2_TEST;
+
+      while (numWords > 0)
+      {
+            // Words whose X1 and X2 bits (and the word after each) lie
+            // within the arrays can be done in bulk.
+         long X1word = offset / MAX_BIT;
+         long adjustedCount = X2count + X2A_EPOCH_DELAY;
+         long n = std::min(numWords, NUM_6SEC_WORDS - 1 - X1word);
+         if (adjustedCount + MAX_BIT > MAX_X2_COUNT)
+            n = 0;
+         else
+            n = std::min(n, (MAX_X2_COUNT - adjustedCount) / MAX_BIT);
+         if (n > 0)
+         {
+            mergeXor(out, X1Bits + X1word, offset - X1word * MAX_BIT,
+                     X2Bits + adjustedCount / MAX_BIT,
+                     adjustedCount % MAX_BIT, n);
+            out += n;
+            numWords -= n;
+            offset += n * MAX_BIT;
+            X2count += n * MAX_BIT;
+            if (X2count >= MAX_X2_TEST) X2count -= MAX_X2_TEST;
+         }
+
+            // The word at the end of either sequence
+         if (numWords > 0)
+         {
+            X1word = offset / MAX_BIT;
+            int X1bit = offset - X1word * MAX_BIT;
+            uint32_t X1 = X1bit ? merge(X1Bits[X1word], X1Bits[X1word+1], X1bit)
+                                : X1Bits[X1word];
+            *out++ = X1 ^ X2Word(X2Bits, X2count);
+            --numWords;
+            offset += MAX_BIT;
+            X2count += MAX_BIT;
+            if (X2count >= MAX_X2_TEST) X2count -= MAX_X2_TEST;
+         }
+      }
+   }
+
+   uint32_t MultiPCodeGen::chipWord( size_t k, long X1count, long offset )
+   {
+      uint32_t word;
+      int numInInterval = CHIPS_PER_6SEC - offset;
+      if (numInInterval >= MAX_BIT)
+      {
+         generateInterval(k, X1count, offset, &word, 1);
+         return(word);
+      }
+      long nextX1count = X1count + 4;
+      if (nextX1count >= 403200) nextX1count = 0;
+      uint32_t next;
+      generateInterval(k, X1count, CHIPS_PER_6SEC - MAX_BIT, &word, 1);
+      generateInterval(k, nextX1count, 0, &next, 1);
+      return((word << (MAX_BIT - numInInterval)) | (next >> numInInterval));
+   }
+
+   long MultiPCodeGen::X2Start( size_t k, long X1count ) const
+   {
+         // As in SVPCodeGen::getCurrentSixSeconds()
+      int PRNID = PRNIDs[k];
+      int EffPRNID = PRNID - (PRNID - 1) / 37 * 37;
+      if (X1count==0 && PRNID <= 37) return(-PRNID);
+      long cumulativeX2Delay = X1count * X2A_EPOCH_DELAY + EffPRNID;
+      long X2count = MAX_X2_TEST - cumulativeX2Delay;
+      if (X2count<0) X2count += MAX_X2_TEST;
+      return(X2count);
+   }
+}     // end of namespace
@@ -0,0 +1,166 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#ifndef MULTIPCODEGEN_HPP
+#define MULTIPCODEGEN_HPP
+
+#include <vector>
+#include "gpstkplatform.h"
+#include "PCodeConst.hpp"
+#include "X1Sequence.hpp"
+#include "X2Sequence.hpp"
+#include "GPSZcount.hpp"
+
+namespace gpstk
+{
+/// @ingroup code
+//@{
+      /// Number of P-code chips in one Z-count (1.5 s)
+   const long CHIPS_PER_ZCOUNT = 15345000;
+
+      /// Number of P-code chips in four Z-counts (6 s)
+   const long CHIPS_PER_6SEC = NUM_6SEC_WORDS * MAX_BIT;
+
+      /// Number of P-code chips in a GPS week
+   const int64_t CHIPS_PER_WEEK = int64_t(CHIPS_PER_ZCOUNT) * 403200;
+
+      /**
+       *  P-code generator for several SVs at once.
+       *
+       *  MultiPCodeGen produces the same chips as SVPCodeGen, 32 chips
+       *  to a word with the earliest chip in the MSB, but for a set of
+       *  PRNs and from any chip of the week.  The code is produced in
+       *  blocks of any number of words rather than in six second
+       *  CodeBuffers, and setCurrentZCount() moves directly to any
+       *  Z-count (not just every fourth one) without generating the
+       *  code in between.
+       *
+       *  Each word is the X1 word xor the X2 word, and over a run of
+       *  words both are read from their sequences at a fixed bit
+       *  offset.  The inner loop therefore combines whole words with
+       *  two constant shifts and no branches; on x86 processors that
+       *  support AVX2 it handles eight words (256 chips) per
+       *  instruction, elsewhere the compiler vectorizes it as it can.
+       *  Only the word that straddles the end of the X2 sequence or of
+       *  a six second interval is assembled separately.  The output is
+       *  produced in blocks small enough that the X1 words, which are
+       *  the same for every PRN, are read from cache for all but the
+       *  first PRN.
+       *
+       *  As with SVPCodeGen, X1Sequence::allocateMemory() and
+       *  X2Sequence::allocateMemory() must have been called first.
+       *
+       *  @code
+       *  std::vector<int> prns;
+       *  for (int prn = 1; prn <= 37; prn++)
+       *     prns.push_back(prn);
+       *  MultiPCodeGen gen(prns, GPSZcount(1950, 1234));
+       *  std::vector< std::vector<uint32_t> > code(37,
+       *     std::vector<uint32_t>(1000));
+       *  std::vector<uint32_t*> out;
+       *  for (int i = 0; i < 37; i++)
+       *     out.push_back(&code[i][0]);
+       *  gen.getChips(&out[0], 1000);    // 32000 chips for each PRN
+       *  @endcode
+       */
+   class MultiPCodeGen
+   {
+   public:
+         /**
+          * Initialize the generator for the given PRNs, positioned at
+          * the start of Z-count z.
+          * @throw Exception if a PRN is not between 1 and MAX_PRN_CODE,
+          *   or the X1/X2 sequences have not been allocated.
+          */
+      MultiPCodeGen( const std::vector<int>& SVPRNIDs,
+                     const gpstk::GPSZcount& z );
+
+         /**
+          * Fill numWords words of code for each PRN, and advance the
+          * current position by 32*numWords chips.
+          * @param[out] buffers one array of at least numWords words per
+          *   PRN, in the order the PRNs were given.
+          */
+      void getChips( uint32_t* const buffers[], long numWords );
+
+         /// Move to the start of Z-count z.
+      void setCurrentZCount( const gpstk::GPSZcount& z )
+      { setCurrentChip(z, 0); }
+
+         /// Move to chip number chip after the start of Z-count z.
+      void setCurrentChip( const gpstk::GPSZcount& z, int64_t chip );
+
+         /// Return the Z-count containing the next chip to be generated.
+      gpstk::GPSZcount getCurrentZCount() const;
+
+         /// Return the number of the next chip within its Z-count.
+      long getChipOfZCount() const
+      { return(long(chipOfWeek % CHIPS_PER_ZCOUNT)); }
+
+         /// Return the PRNs, in the order of the output buffers.
+      const std::vector<int>& getPRNIDs() const { return(PRNIDs); }
+
+   private:
+         /** Fill numWords words for PRN index k starting at the given
+          * chip of the week (before the PRN's day advance). */
+      void generate( size_t k, int64_t chip, uint32_t *out, long numWords );
+
+         /** Fill numWords words for PRN index k, all within the six
+          * second interval beginning at Z-count X1count, starting at
+          * chip offset of that interval. */
+      void generateInterval( size_t k, long X1count, long offset,
+                             uint32_t *out, long numWords );
+
+         /** Return the 32 chips of PRN index k that begin at offset in
+          * the interval at X1count, where they may run into the next
+          * interval. */
+      uint32_t chipWord( size_t k, long X1count, long offset );
+
+         /// Return the X2 chip count at the start of an interval.
+      long X2Start( size_t k, long X1count ) const;
+
+      gpstk::X1Sequence X1Seq;
+      gpstk::X2Sequence X2Seq;
+      gpstk::X2Sequence X2SeqEOW;
+      std::vector<int> PRNIDs;
+         /// Chips each PRN's code leads the week by (whole days)
+      std::vector<int64_t> dayAdvance;
+      short week;
+      int64_t chipOfWeek;
+   };
+   //@}
+}     // end of namespace
+#endif // MULTIPCODEGEN_HPP
@@ -181,6 +181,12 @@ namespace gpstk
              */
          void setEOWX2Epoch( const bool tf );
 
+            /**  Return the words of the X2 buffer currently in use (see
+             *   setEOWX2Epoch()), in the layout described above: bit 37
+             *   of the array is X2 chip 0.
+             */
+         const uint32_t* getBits( ) const { return(bitsP); }
+
       private:
          uint32_t *bitsP;
          static uint32_t* X2Bits;
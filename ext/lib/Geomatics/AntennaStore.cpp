@@ -67,8 +67,10 @@ namespace gpstk
       if(it != antennaMap.end())       // erase it
          antennaMap.erase(it);
 
-      // add the new data
-      antennaMap[name] = antdata;
+      // add the new data, with its PCVs copied onto grids for fast lookup
+      AntexData& stored(antennaMap[name]);
+      stored = antdata;
+      stored.buildPCVGrids();
    }
 
    // Get the antenna data for the given name from the store.
@@ -84,6 +86,28 @@ namespace gpstk
       return false;
    }
 
+   // Compute the phase center variations of the named antenna at many angles,
+   // using the stored object directly.
+   // return false if the name was not found in the store
+   bool AntennaStore::getPhaseCenterVariations(const string& name,
+                                               const string& freq,
+                                               const vector<double>& azimuths,
+                                               const vector<double>& elev_nadirs,
+                                               vector<double>& pcvs) const
+      throw(Exception)
+   {
+      map<string, AntexData>::const_iterator it;
+      it = antennaMap.find(name);
+      if(it == antennaMap.end())
+         return false;
+
+      try {
+         it->second.getPhaseCenterVariations(freq, azimuths, elev_nadirs, pcvs);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+      return true;
+   }
+
    // Get the antenna data for the given satellite from the store.
    // Satellites are identified by two things:
    // system character: G or blank GPS, R GLONASS, E GALILEO, M MIXED
@@ -97,7 +97,9 @@ namespace gpstk
       ~AntennaStore() {}
 
       /// Add the given name, AntexData pair. If the name already exists in the store,
-      /// replace the data for it with the input object.
+      /// replace the data for it with the input object. The PCV tables of the
+      /// stored copy are put on regular grids (AntexData::buildPCVGrids()), which
+      /// makes its getPhaseCenterVariation() faster.
       /// @throw if the AntexData is invalid.
       void addAntenna(std::string name, AntexData& antdata) throw(Exception);
 
@@ -105,6 +107,19 @@ namespace gpstk
       /// @return true if successful, false if input name was not found in the store
       bool getAntenna(std::string name, AntexData& antdata) throw();
 
+      /// Compute the phase center variations of the named antenna at many
+      /// azimuth, elevation/nadir pairs; see
+      /// AntexData::getPhaseCenterVariations(). The stored object is used
+      /// directly, without the copy made by getAntenna().
+      /// @return true if successful, false if input name was not found in the store
+      /// @throw as AntexData::getPhaseCenterVariations()
+      bool getPhaseCenterVariations(const std::string& name,
+                                    const std::string& freq,
+                                    const std::vector<double>& azimuths,
+                                    const std::vector<double>& elev_nadirs,
+                                    std::vector<double>& pcvs) const
+         throw(Exception);
+
       /// Get the antenna data for the given satellite from the store.
       /// Satellites are identified by two things:
       /// system character: G or blank GPS, R GLONASS, E GALILEO, M MIXED
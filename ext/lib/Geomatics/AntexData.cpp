@@ -237,6 +237,9 @@ namespace gpstk
       }
 
       const antennaPCOandPCVData& antpco = it->second;
+      if(!antpco.PCVgrid.empty())
+         return antpco.PCVgrid.evaluate(azim, zen);
+
       const azimZenMap& azzenmap = antpco.PCVvalue;      // map<double, zenOffsetMap>
 
       if(!antpco.hasAzimuth) {
@@ -309,6 +312,190 @@ namespace gpstk
       return retpco;
    }
 
+   // Compute the phase center variations (only) at many azimuth and elevation
+   // (receiver) or nadir (satellite) angles
+   void AntexData::getPhaseCenterVariations(const string freq,
+                                            const vector<double>& azimuths,
+                                            const vector<double>& elev_nadirs,
+                                            vector<double>& pcvs) const
+      throw(Exception)
+   {
+      if(!isValid()) {
+         Exception e("Invalid AntexData object");
+         GPSTK_THROW(e);
+      }
+      if(azimuths.size() != elev_nadirs.size()) {
+         Exception e("Azimuth and elevation/nadir arrays differ in length");
+         GPSTK_THROW(e);
+      }
+
+      map<string, antennaPCOandPCVData>::const_iterator it;
+      it = freqPCVmap.find(freq);
+      if(it == freqPCVmap.end()) {
+         Exception e("Frequency " + freq
+               + " not found! System not supported or data corrupted.");
+         GPSTK_THROW(e);
+      }
+      const PCVGrid& grid(it->second.PCVgrid);
+
+      const size_t n(azimuths.size());
+      pcvs.resize(n);
+      for(size_t i=0; i<n; i++) {
+         if(grid.empty()) {                  // no grid, search the maps
+            pcvs[i] = getPhaseCenterVariation(freq, azimuths[i], elev_nadirs[i]);
+            continue;
+         }
+
+         // same angle handling as getPhaseCenterVariation()
+         const double elev_nadir(elev_nadirs[i]);
+         if(elev_nadir < 0.0 || elev_nadir > 90.0) {
+            Exception e("Invalid elevation/nadir angle");
+            GPSTK_THROW(e);
+         }
+         double zen(isRxAntenna ? 90. - elev_nadir : elev_nadir);
+         double azim(azimuths[i]);
+         while(azim < 0.0) azim += 360.0;
+         while(azim >= 360.0) azim -= 360.0;
+
+         pcvs[i] = grid.evaluate(azim, zen);
+      }
+   }
+
+   // Copy the PCV tables of every frequency onto regular grids
+   void AntexData::buildPCVGrids(void)
+   {
+      map<string, antennaPCOandPCVData>::iterator it;
+      for(it = freqPCVmap.begin(); it != freqPCVmap.end(); ++it)
+         it->second.PCVgrid.build(it->second.PCVvalue, it->second.hasAzimuth);
+   }
+
+   // ----------------------------------------------------------------------------
+   // class PCVGrid
+   //
+   // Copy the PCV tables onto the grid, if they are evenly spaced.
+   bool AntexData::PCVGrid::build(const azimZenMap& pcv, const bool hasAzimuth)
+   {
+      // tolerance (deg) on the spacing of the grid
+      static const double tol(1.e-9);
+
+      clear();
+      if(pcv.empty()) return false;
+
+      // without azimuth dependence only the first table is used (cf.
+      // getPhaseCenterVariation()); with it, every table, including NOAZI (-1),
+      // since the map interpolation may wrap onto that table
+      azimuthDependent = hasAzimuth;
+      azimZenMap::const_iterator jt, jtEnd(pcv.end());
+      if(!azimuthDependent) { jtEnd = pcv.begin(); ++jtEnd; }
+
+      const zenOffsetMap& first(pcv.begin()->second);
+      if(first.empty()) return false;
+      zenOffsetMap::const_iterator kt;
+      for(kt = first.begin(); kt != first.end(); ++kt)
+         zens.push_back(kt->first);
+
+      // the zenith angles must be evenly spaced
+      dZen = (zens.size() > 1 ? zens[1] - zens[0] : 1.0);
+      for(size_t j=1; j<zens.size(); j++)
+         if(::fabs(zens[j] - (zens[0] + j*dZen)) > tol) { clear(); return false; }
+
+      for(jt = pcv.begin(); jt != jtEnd; ++jt) {
+         // every table must have the same zenith angles
+         if(jt->second.size() != zens.size()) { clear(); return false; }
+         size_t j(0);
+         for(kt = jt->second.begin(); kt != jt->second.end(); ++kt, ++j) {
+            if(kt->first != zens[j]) { clear(); return false; }
+            values.push_back(kt->second);
+         }
+         azims.push_back(jt->first);
+      }
+
+      // the azimuths after NOAZI must be evenly spaced
+      firstRegular = 0;
+      dAz = 1.0;
+      if(azimuthDependent) {
+         if(azims[0] < 0.0) firstRegular = 1;
+         if(azims.size() < firstRegular + 2) { clear(); return false; }
+         dAz = azims[firstRegular+1] - azims[firstRegular];
+         for(size_t i=firstRegular+1; i<azims.size(); i++)
+            if(::fabs(azims[i] - (azims[firstRegular] + (i-firstRegular)*dAz)) > tol)
+               { clear(); return false; }
+      }
+
+      return true;
+   }
+
+   // Interpolate the grid exactly as getPhaseCenterVariation() interpolates the
+   // maps; see the diagram there for the naming of the four corners.
+   double AntexData::PCVGrid::evaluate(const double azim, const double zen) const
+      throw()
+   {
+      const size_t nz(zens.size()), na(azims.size());
+
+      // bracket the zenith angle; jlo == jhi when zen is on the grid, or beyond
+      // either end of it, where the end value is used (cf. evaluateZenithMap())
+      size_t jlo, jhi;
+      if(zen <= zens[0])
+         jlo = jhi = 0;
+      else if(zen >= zens[nz-1])
+         jlo = jhi = nz-1;
+      else {
+         jlo = static_cast<size_t>((zen - zens[0]) / dZen);
+         if(jlo > nz-2) jlo = nz-2;
+         if(zen < zens[jlo]) jlo--;                   // guard against rounding
+         else if(zen >= zens[jlo+1]) jlo++;
+         jhi = (zen == zens[jlo] ? jlo : jlo+1);
+      }
+
+      // bracket the azimuth, wrapping around 360 as the map search does
+      size_t ilo(0), ihi(0);
+      double az_lo(0.0), az_hi(0.0);
+      if(azimuthDependent) {
+         if(azim < azims[0]) {                        // before the first value
+            ihi = 0;    az_hi = azims[0];
+            ilo = na-1; az_lo = azims[na-1] - 360.;
+         }
+         else if(azim > azims[na-1]) {                // beyond the last value
+            ilo = na-1; az_lo = azims[na-1];
+            ihi = 0;    az_hi = azims[0] + 360.;
+         }
+         else {
+            if(azim < azims[firstRegular])            // between NOAZI and first
+               ilo = firstRegular-1;
+            else {
+               ilo = firstRegular
+                   + static_cast<size_t>((azim - azims[firstRegular]) / dAz);
+               if(ilo > na-1) ilo = na-1;
+               if(azim < azims[ilo]) ilo--;           // guard against rounding
+               else if(ilo < na-1 && azim >= azims[ilo+1]) ilo++;
+            }
+            ihi = (azim == azims[ilo] ? ilo : ilo+1);
+            az_lo = azims[ilo];
+            az_hi = azims[ihi];
+         }
+      }
+
+      const double *row_lo(&values[ilo*nz]), *row_hi(&values[ihi*nz]);
+
+      if(ilo == ihi) {                       // no azimuth, or an exact match
+         if(jlo == jhi)
+            return row_lo[jlo];
+         return (row_lo[jhi]*(zen - zens[jlo]) + row_lo[jlo]*(zens[jhi] - zen))
+                  / (zens[jhi] - zens[jlo]);
+      }
+
+      if(jlo == jhi)                         // linear interpolation in azimuth
+         return (row_lo[jlo]*(az_hi - azim) + row_hi[jlo]*(azim - az_lo))
+                  / (az_hi - az_lo);
+
+      // bi-linear interpolation
+      return ( row_lo[jhi] * (az_hi - azim)*(zen - zens[jlo])
+             + row_hi[jhi] * (azim - az_lo)*(zen - zens[jlo])
+             + row_lo[jlo] * (az_hi - azim)*(zens[jhi] - zen)
+             + row_hi[jlo] * (azim - az_lo)*(zens[jhi] - zen) )
+                  / ( (az_hi - az_lo)*(zens[jhi] - zens[jlo]) );
+   }
+
    void AntexData::dump(ostream& s, int detail) const
    {
       map<string, antennaPCOandPCVData>::const_iterator it;
@@ -165,6 +165,47 @@ namespace gpstk
       /// azimZenMap[-1.0] (this may be the only entry)
       typedef std::map<double, zenOffsetMap> azimZenMap;
 
+      /// Dense copy of the PCV tables (azimZenMap) of one frequency, on the
+      /// regular azimuth and zenith grid of the ANTEX record, so that a PCV can
+      /// be found by indexing instead of searching nested maps. It is built by
+      /// AntexData::buildPCVGrids(); evaluate() reproduces, case for case, the
+      /// map interpolation of getPhaseCenterVariation().
+      class PCVGrid {
+      public:
+         /// Constructor; the grid is empty
+         PCVGrid() : azimuthDependent(false), firstRegular(0), dAz(0.0), dZen(0.0)
+         {}
+
+         /// @return true if no grid has been built (the maps are used)
+         bool empty(void) const { return values.empty(); }
+
+         /// remove the grid
+         void clear(void)
+         { azims.clear(); zens.clear(); values.clear(); }
+
+         /// Copy the given PCV tables into the grid. Nothing is built unless
+         /// the azimuths and zenith angles are evenly spaced and every azimuth
+         /// has the same zenith angles, as they are in a valid ANTEX file.
+         /// @param pcv the PCV tables (cf. antennaPCOandPCVData::PCVvalue)
+         /// @param hasAzimuth if false, only the first (NOAZI) table is used
+         /// @return true if the grid was built
+         bool build(const azimZenMap& pcv, const bool hasAzimuth);
+
+         /// Interpolate the grid at the given angles.
+         /// @param azim azimuth in degrees, 0 <= azim < 360
+         /// @param zen zenith (or nadir) angle in degrees
+         /// @return PCV in millimeters
+         double evaluate(const double azim, const double zen) const throw();
+
+      private:
+         bool azimuthDependent;        ///< false if only the NOAZI table is kept
+         std::vector<double> azims;    ///< azimuth of each row (deg)
+         std::vector<double> zens;     ///< zenith angle of each column (deg)
+         size_t firstRegular;          ///< first row of the evenly spaced azims
+         double dAz, dZen;             ///< grid spacings (deg)
+         std::vector<double> values;   ///< PCVs (mm), row-major by azimuth
+      }; // end of class PCVGrid
+
       /// class encapsulating the PCOs and PCVs of the antenna. See the ANTEX
       /// documentation for discussion of how the PCO/Vs are defined, sign conventions
       /// and how to apply the PCOs.
@@ -188,6 +229,9 @@ namespace gpstk
          /// RMS values are OPTIONAL
          azimZenMap PCVvalue, PCVrms;
 
+         /// PCVvalue on a regular grid; empty until buildPCVGrids() is called
+         PCVGrid PCVgrid;
+
       }; // end of class antennaPCOandPCVData
 
       // member data
@@ -321,6 +365,30 @@ namespace gpstk
                                      const double elev_nadir) const
          throw(Exception);
 
+      /// Compute the phase center variations at many azimuths and elev_nadirs,
+      /// as getPhaseCenterVariation() would for each pair, with the checks on the
+      /// object and frequency made only once.
+      /// @param freq frequency (usually G01 or G02)
+      /// @param azimuths the azimuth angles in degrees (cf. above)
+      /// @param elev_nadirs the elevation or nadir angles in degrees (cf. above),
+      ///        one for each azimuth
+      /// @param pcvs output phase center variations in millimeters, resized
+      /// @throw  if this object is invalid
+      ///         if frequency does not exist for this data
+      ///         if an elevation/nadir angle is out of range
+      ///         if azimuths and elev_nadirs differ in length
+      void getPhaseCenterVariations(const std::string freq,
+                                    const std::vector<double>& azimuths,
+                                    const std::vector<double>& elev_nadirs,
+                                    std::vector<double>& pcvs) const
+         throw(Exception);
+
+      /// Copy the PCV tables of every frequency onto regular grids (PCVGrid),
+      /// after which getPhaseCenterVariation() indexes the grids instead of
+      /// searching the maps; the results are the same. Call again if PCVvalue
+      /// is changed. AntennaStore does this for every antenna it stores.
+      void buildPCVGrids(void);
+
       /// Dump AntexData. Set detail = 0 for type, serial no., sat codes only;
       /// = 1 for all information except phase center offsets, = 2 for all data.
 #pragma clang diagnostic push
@@ -49,6 +49,7 @@
 #include <deque>
 #include <list>
 #include <algorithm>
+#include <atomic>
 // gpstk
 #include "StringUtils.hpp"
 #include "Stats.hpp"
@@ -506,7 +507,7 @@ static const int P1 = 2;
 static const int P2 = 3;
 static const int A1 = 4;
 static const int A2 = 5;
-vector<string> DCobstypes; // indexes into both data and this vector are L1,L2,etc...
+thread_local vector<string> DCobstypes; // indexes into both data and this vector are L1,L2,etc...
 
 //------------------------------------------------------------------------------------
 // Return values (used by all routines within this module):
@@ -520,17 +521,19 @@ static const int ReturnOK=0;
 
 //------------------------------------------------------------------------------------
 // these are used only to associate a unique number in the log file with each pass
-static int GDCUnique=0;     // unique number for each call
-static int GDCUniqueFix;    // unique for each (WL,GF) fix
+static std::atomic<int> GDCUniqueCount(0); // number of calls, unless reset
+static thread_local int GDCUnique;         // unique number for each call
+static thread_local int GDCUniqueFix;      // unique for each (WL,GF) fix
 static string GDCtag="GDC"; // begin each line of return message
 
 //------------------------------------------------------------------------------------
 // wavelength and other frequency-dependent quantities, determined early in DC()
 // constants used in linear combinations
-int GLOn;
-double wl1,wl2,wlwl,wlgf;        // wavelengths: L1,L2,widelane,narrowlane
-double wl1r,wl2r,wl1p,wl2p;      // coefficients in widelane linear combinations
-double gf1r,gf2r,gf1p,gf2p;      // coefficients in geometry-free linear combinations
+// these, like DCobstypes and GDCUnique, belong to the call in progress on each thread
+thread_local int GLOn;
+thread_local double wl1,wl2,wlwl,wlgf;   // wavelengths: L1,L2,widelane,narrowlane
+thread_local double wl1r,wl2r,wl1p,wl2p; // coefficients in widelane linear combinations
+thread_local double gf1r,gf2r,gf1p,gf2p; // coefficients in geometry-free linear combinations
 
 //------------------------------------------------------------------------------------
 // Flags - constants used to mark slips, etc. using the SatPass flag:
@@ -574,13 +577,33 @@ int gpstk::DiscontinuityCorrector(SatPass& svp,
                                   int GLOn_in)
    throw(Exception)
 {
+try {
+   if(gdc.getParameter("ResetUnique") != 0)
+      { GDCUniqueCount=0; gdc.setParameter("ResetUnique=0"); }
+
+   return DiscontinuityCorrector(svp, gdc, ++GDCUniqueCount, gdc.getDebugStream(),
+                                 editCmds, retMessage, GLOn_in);
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// The discontinuity corrector function, for concurrent use
+//------------------------------------------------------------------------------------
+int gpstk::DiscontinuityCorrector(SatPass& svp,
+                                  const GDCconfiguration& gdc,
+                                  int unique,
+                                  ostream& debugLog,
+                                  vector<string>& editCmds,
+                                  string& retMessage,
+                                  int GLOn_in)
+   throw(Exception)
+{
 try {
    unsigned int i,j;
    int iret;
 
-   if(gdc.getParameter("ResetUnique") != 0)
-      { GDCUnique=0; gdc.setParameter("ResetUnique=0"); }
-   GDCUnique++;
+   GDCUnique = unique;
 
    //if(!retMessage.empty()) { GDCtag = retMessage; }
    retMessage = "";
@@ -635,6 +658,7 @@ try {
    // --------------------------------------------------------------------------------
    // create a GDCPass from the input SatPass (modified) and GDC configuration
    GDCPass gp(nsvp,gdc);
+   gp.setDebugStream(debugLog);
 
    // --------------------------------------------------------------------------------
    // if the satellite is Glonass, compute the frequency channel, if necessary,
@@ -81,10 +81,11 @@ namespace gpstk {
       void setParameter(std::string label, double value) throw(gpstk::Exception);
 
          /// Get the parameter in the configuration corresponding to label
-      double getParameter(std::string label) throw()
+      double getParameter(std::string label) const throw()
       {
-         if(CFG.find(label) == CFG.end()) return 0.0;    // TD throw?
-         return CFG[label];
+         std::map<std::string,double>::const_iterator it(CFG.find(label));
+         if(it == CFG.end()) return 0.0;    // TD throw?
+         return it->second;
       }
 
          /// Get the description of a parameter
@@ -98,6 +99,9 @@ namespace gpstk {
          /// Tell GDCconfiguration to which stream to send debugging output.
       void setDebugStream(std::ostream& os) { p_oflog = &os; }
 
+         /// Get the stream to which debugging output is sent.
+      std::ostream& getDebugStream(void) const { return *p_oflog; }
+
          /// Print help page, including descriptions and current values of all
          /// the parameters, to the ostream. If 'advanced' is true, also print
          /// advanced parameters.
@@ -265,6 +269,32 @@ namespace gpstk {
                               int GLOn=-99)
       throw(Exception);
 
+   /// GPSTK Discontinuity Corrector for processing several passes at once, in
+   /// separate threads. This is DiscontinuityCorrector() above, except that
+   /// the configuration is only read, so one object may be shared by all the
+   /// threads; the number that identifies the pass in retMsg and in the debug
+   /// output is given by the caller (the config parameter ResetUnique is not
+   /// used); and debug output is written to DebugLog rather than to the
+   /// configuration's stream. Calls with different SatPass objects and
+   /// different DebugLog streams may run concurrently.
+   ///
+   /// @param SP       SatPass object containing the input data.
+   /// @param config   GDCconfiguration object, not modified.
+   /// @param unique   number identifying this pass in output, e.g. its index+1.
+   /// @param DebugLog stream for debug output, e.g. an ostringstream per thread.
+   /// @param EditCmds vector<string> (output) containing RinexEditor commands.
+   /// @param retMsg   string summary of results: see 'GDC' in output, class GDCreturn
+   /// @param GLOn     GLONASS frequency channel (-7<=n<7), -99 means UNKNOWN
+   /// @return 0 for success, otherwise return an Error code (see above)
+   int DiscontinuityCorrector(SatPass& SP,
+                              const GDCconfiguration& config,
+                              int unique,
+                              std::ostream& DebugLog,
+                              std::vector<std::string>& EditCmds,
+                              std::string& retMsg,
+                              int GLOn=-99)
+      throw(Exception);
+
    //@}
 
 }  // end namespace gpstk
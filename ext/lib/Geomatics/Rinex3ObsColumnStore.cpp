@@ -0,0 +1,176 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Rinex3ObsColumnStore.cpp  Columnar in-memory store of RINEX3 obs data,
+/// filled by Rinex3ObsFileLoader and scanned per epoch or per satellite.
+
+//------------------------------------------------------------------------------------
+// geomatics
+#include "Rinex3ObsColumnStore.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+//------------------------------------------------------------------------------------
+void Rinex3ObsColumnStore::clear(void)
+{
+   times.clear();
+   clocks.clear();
+   flags.clear();
+   epochStart.clear();
+   recSat.clear();
+   recEpoch.clear();
+   obsTypes.clear();
+   data.clear();
+   lli.clear();
+   ssi.clear();
+   valid.clear();
+   sats.clear();
+   satIndexMap.clear();
+   recordsForSat.clear();
+   inEpoch = false;
+}
+
+//------------------------------------------------------------------------------------
+unsigned int Rinex3ObsColumnStore::addObsType(const string& srot)
+{
+   int k(obsTypeIndex(srot));
+   if(k >= 0) return k;
+
+   // earlier records have no data of this type
+   const unsigned int n(recSat.size());
+   obsTypes.push_back(srot);
+   data.push_back(vector<double>(n,0.0));
+   lli.push_back(vector<unsigned char>(n,0));
+   ssi.push_back(vector<unsigned char>(n,0));
+   valid.push_back(vector<uint64_t>((n+63)/64,0));
+
+   return obsTypes.size()-1;
+}
+
+//------------------------------------------------------------------------------------
+void Rinex3ObsColumnStore::startEpoch(const CommonTime& tt, double clk,
+                                      short flag)
+{
+   if(inEpoch) endEpoch();
+   times.push_back(tt);
+   clocks.push_back(clk);
+   flags.push_back(static_cast<unsigned char>(flag));
+   epochStart.push_back(recSat.size());
+   inEpoch = true;
+}
+
+//------------------------------------------------------------------------------------
+unsigned int Rinex3ObsColumnStore::addRecord(const RinexSatID& sat)
+   throw(Exception)
+{
+   if(!inEpoch) {
+      Exception e("Rinex3ObsColumnStore::addRecord() called outside an epoch");
+      GPSTK_THROW(e);
+   }
+
+   // find the sat in the dictionary, or add it
+   unsigned short isat;
+   map<RinexSatID, unsigned short>::const_iterator it(satIndexMap.find(sat));
+   if(it == satIndexMap.end()) {
+      isat = sats.size();
+      sats.push_back(sat);
+      satIndexMap[sat] = isat;
+      recordsForSat.push_back(vector<unsigned int>());
+   }
+   else
+      isat = it->second;
+
+   const unsigned int rec(recSat.size());
+   recSat.push_back(isat);
+   recEpoch.push_back(times.size()-1);
+   recordsForSat[isat].push_back(rec);
+
+   // extend the obs type columns with an empty entry
+   const bool newword((rec & 63) == 0);
+   for(unsigned int k=0; k<obsTypes.size(); k++) {
+      data[k].push_back(0.0);
+      lli[k].push_back(0);
+      ssi[k].push_back(0);
+      if(newword) valid[k].push_back(0);
+   }
+
+   return rec;
+}
+
+//------------------------------------------------------------------------------------
+void Rinex3ObsColumnStore::endEpoch(void) throw()
+{
+   if(!inEpoch) return;
+   inEpoch = false;
+   if(epochStart.back() == recSat.size()) {     // no records - remove the epoch
+      times.pop_back();
+      clocks.pop_back();
+      flags.pop_back();
+      epochStart.pop_back();
+   }
+}
+
+//------------------------------------------------------------------------------------
+RinexDatum Rinex3ObsColumnStore::datum(unsigned int k, unsigned int rec) const
+   throw()
+{
+   RinexDatum rd;
+   rd.data = data[k][rec];
+   rd.lli = lli[k][rec];
+   rd.ssi = ssi[k][rec];
+   return rd;
+}
+
+//------------------------------------------------------------------------------------
+int Rinex3ObsColumnStore::obsTypeIndex(const string& srot) const throw()
+{
+   for(unsigned int k=0; k<obsTypes.size(); k++)
+      if(obsTypes[k] == srot) return k;
+   return -1;
+}
+
+//------------------------------------------------------------------------------------
+int Rinex3ObsColumnStore::satIndex(const RinexSatID& sat) const throw()
+{
+   map<RinexSatID, unsigned short>::const_iterator it(satIndexMap.find(sat));
+   return (it == satIndexMap.end() ? -1 : it->second);
+}
+
+//------------------------------------------------------------------------------------
+} // end namespace gpstk
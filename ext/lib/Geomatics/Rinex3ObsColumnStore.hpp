@@ -0,0 +1,215 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Rinex3ObsColumnStore.hpp  Columnar in-memory store of RINEX3 obs data,
+/// filled by Rinex3ObsFileLoader and scanned per epoch or per satellite.
+
+#ifndef GPSTK_RINEX3_OBS_COLUMN_STORE_INCLUDE
+#define GPSTK_RINEX3_OBS_COLUMN_STORE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+// GPSTk
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "RinexSatID.hpp"
+#include "RinexDatum.hpp"
+
+namespace gpstk {
+
+//--------------------------------------------------------------------------------
+/// Columnar store of RINEX observation data, the alternative to a vector of
+/// Rinex3ObsData (a map of vectors of RinexDatum for each epoch) that is used by
+/// Rinex3ObsFileLoader when configured with saveColumns(true).
+/// The data is a table of records, one record per satellite per epoch, in time
+/// order, stored as columns:
+///   - per epoch: time, clock offset and epoch flag, and the index of the epoch's first record
+///     (the records of epoch e are epochBegin(e) <= r < epochEnd(e));
+///   - per record: the satellite, as an index into a dictionary of satellites,
+///     and the epoch;
+///   - per obs type: the data (double), LLI and SSI (one byte each), and a bitmap
+///     that is set where the data is present (and non-zero);
+/// plus, for each satellite, the list of its records in time order.
+/// Scanning one obs type is thus a pass over one contiguous array, and there is
+/// no allocation per epoch or per record once the columns have grown.
+/// The store is filled with startEpoch(), addRecord() and setDatum(), then
+/// endEpoch(); obs types may be added (addObsType()) at any time, the earlier
+/// records then have no data for that type.
+class Rinex3ObsColumnStore
+{
+public:
+   /// constructor - empty store
+   Rinex3ObsColumnStore(void) : inEpoch(false) {}
+
+   /// remove all data and obs types
+   void clear(void);
+
+   // build ----------------------------------------------------------------
+   /// add an obs type column
+   /// @param[in] srot 4-char RINEX 3 ObsID (system + 3-char id)
+   /// @return index of the new column, or of the existing one for srot
+   unsigned int addObsType(const std::string& srot);
+
+   /// start a new epoch; records added until endEpoch() belong to it
+   /// @param[in] tt   time tag of the epoch
+   /// @param[in] clk  receiver clock offset
+   /// @param[in] flag RINEX epoch flag
+   void startEpoch(const CommonTime& tt, double clk=0.0, short flag=0);
+
+   /// add a record for a satellite in the current epoch, with no data
+   /// @param[in] sat the satellite
+   /// @return index of the record
+   /// @throw Exception if there is no current epoch
+   unsigned int addRecord(const RinexSatID& sat) throw(Exception);
+
+   /// set the datum of one obs type in one record
+   /// @param[in] rec index of the record
+   /// @param[in] k   index of the obs type column
+   /// @param[in] rd  datum; it is valid only if rd.data is non-zero
+   void setDatum(unsigned int rec, unsigned int k, const RinexDatum& rd) throw()
+   {
+      data[k][rec] = rd.data;
+      lli[k][rec] = static_cast<unsigned char>(rd.lli);
+      ssi[k][rec] = static_cast<unsigned char>(rd.ssi);
+      if(rd.data != 0.0) valid[k][rec>>6] |= (uint64_t(1) << (rec&63));
+   }
+
+   /// end the current epoch; an epoch without records is removed
+   void endEpoch(void) throw();
+
+   // sizes ----------------------------------------------------------------
+   /// @return number of epochs in the store
+   unsigned int numEpochs(void) const throw() { return times.size(); }
+   /// @return number of records (satellite-epochs) in the store
+   unsigned int numRecords(void) const throw() { return recSat.size(); }
+   /// @return number of obs type columns
+   unsigned int numObsTypes(void) const throw() { return obsTypes.size(); }
+   /// @return number of satellites in the dictionary
+   unsigned int numSats(void) const throw() { return sats.size(); }
+
+   // access per epoch -----------------------------------------------------
+   /// @return time tag of epoch e
+   const CommonTime& time(unsigned int e) const throw() { return times[e]; }
+   /// @return receiver clock offset of epoch e
+   double clockOffset(unsigned int e) const throw() { return clocks[e]; }
+   /// @return RINEX epoch flag of epoch e
+   short epochFlag(unsigned int e) const throw() { return flags[e]; }
+   /// @return index of the first record of epoch e
+   unsigned int epochBegin(unsigned int e) const throw() { return epochStart[e]; }
+   /// @return one past the index of the last record of epoch e
+   unsigned int epochEnd(unsigned int e) const throw()
+      { return (e+1 < epochStart.size() ? epochStart[e+1] : recSat.size()); }
+
+   // access per record ----------------------------------------------------
+   /// @return index in the satellite dictionary of record rec
+   unsigned short satIndex(unsigned int rec) const throw() { return recSat[rec]; }
+   /// @return satellite of record rec
+   const RinexSatID& sat(unsigned int rec) const throw()
+      { return sats[recSat[rec]]; }
+   /// @return index of the epoch of record rec
+   unsigned int epoch(unsigned int rec) const throw() { return recEpoch[rec]; }
+   /// @return true if obs type k has data in record rec
+   bool isValid(unsigned int k, unsigned int rec) const throw()
+      { return (valid[k][rec>>6] >> (rec&63)) & 1; }
+   /// @return data of obs type k in record rec (0.0 if not valid)
+   double value(unsigned int k, unsigned int rec) const throw()
+      { return data[k][rec]; }
+   /// @return LLI of obs type k in record rec
+   unsigned short LLI(unsigned int k, unsigned int rec) const throw()
+      { return lli[k][rec]; }
+   /// @return SSI of obs type k in record rec
+   unsigned short SSI(unsigned int k, unsigned int rec) const throw()
+      { return ssi[k][rec]; }
+   /// @return obs type k of record rec as a RinexDatum
+   RinexDatum datum(unsigned int k, unsigned int rec) const throw();
+
+   // access per obs type --------------------------------------------------
+   /// @return the 4-char ObsIDs of the columns
+   const std::vector<std::string>& getObsTypes(void) const throw()
+      { return obsTypes; }
+   /// @return index of the column for 4-char ObsID srot, or -1 if not found
+   int obsTypeIndex(const std::string& srot) const throw();
+   /// @return the data column of obs type k, parallel to the records
+   const std::vector<double>& dataColumn(unsigned int k) const throw()
+      { return data[k]; }
+   /// @return the validity bitmap of obs type k: bit (rec%64) of word rec/64
+   const std::vector<uint64_t>& validColumn(unsigned int k) const throw()
+      { return valid[k]; }
+
+   // access per satellite -------------------------------------------------
+   /// @return the satellite dictionary
+   const std::vector<RinexSatID>& getSats(void) const throw() { return sats; }
+   /// @return index of sat in the dictionary, or -1 if not found
+   int satIndex(const RinexSatID& sat) const throw();
+   /// @return the records of satellite index s, in time order
+   const std::vector<unsigned int>& satRecords(unsigned int s) const throw()
+      { return recordsForSat[s]; }
+
+private:
+   // per epoch
+   std::vector<CommonTime> times;                ///< time tag of each epoch
+   std::vector<double> clocks;                   ///< clock offset of each epoch
+   std::vector<unsigned char> flags;             ///< epoch flag of each epoch
+   std::vector<unsigned int> epochStart;         ///< first record of each epoch
+
+   // per record
+   std::vector<unsigned short> recSat;           ///< index into sats
+   std::vector<unsigned int> recEpoch;           ///< index into times
+
+   // per obs type, parallel to obsTypes
+   std::vector<std::string> obsTypes;            ///< 4-char ObsIDs
+   std::vector< std::vector<double> > data;      ///< data, 0 where not valid
+   std::vector< std::vector<unsigned char> > lli;///< LLI
+   std::vector< std::vector<unsigned char> > ssi;///< SSI
+   std::vector< std::vector<uint64_t> > valid;   ///< bitmap, set where valid
+
+   // satellite dictionary
+   std::vector<RinexSatID> sats;                 ///< satellites, in order found
+   std::map<RinexSatID, unsigned short> satIndexMap; ///< sats[satIndexMap[s]]==s
+   std::vector< std::vector<unsigned int> > recordsForSat; ///< parallel to sats
+
+   bool inEpoch;                                 ///< between start/endEpoch()
+
+}; // end class Rinex3ObsColumnStore
+
+} // end namespace gpstk
+
+#endif      // GPSTK_RINEX3_OBS_COLUMN_STORE_INCLUDE
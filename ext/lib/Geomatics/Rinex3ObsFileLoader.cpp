@@ -40,6 +40,7 @@
 //------------------------------------------------------------------------------------
 // system includes
 #include <iostream>
+#include <functional>
 
 // GPSTk
 #include "Exception.hpp"
@@ -140,6 +141,8 @@ try {
                         wantedObsTypes.push_back(srot);  // add it
                         // the number of observations for each observation type
                         countWantedObsTypes.push_back(0);
+                        // keep the column store parallel to wantedObsTypes
+                        if(saveData && saveCols) colstore.addObsType(srot);
                         
                         ossx << " Add obs type " << srot
                            << " =~ " << inputWantedObsTypes[j]
@@ -233,13 +236,17 @@ try {
             nepochs++;
             if(nepochsToRead > -1 && nepochs >= nepochsToRead) break;
 
-            // prepare output rod
-            outrod.time = rod.time;
-            outrod.clockOffset = rod.clockOffset;
-            outrod.epochFlag = rod.epochFlag;
-            // outrod.auxHeader.clear();
-            outrod.numSVs = 0;
-            outrod.obs.clear();
+            // prepare output rod, or epoch in the column store
+            if(saveData && saveCols)
+               colstore.startEpoch(rod.time, rod.clockOffset, rod.epochFlag);
+            else {
+               outrod.time = rod.time;
+               outrod.clockOffset = rod.clockOffset;
+               outrod.epochFlag = rod.epochFlag;
+               // outrod.auxHeader.clear();
+               outrod.numSVs = 0;
+               outrod.obs.clear();
+            }
 
             // loop over satellites, counting data per ObsID
             Rinex3ObsData::DataMap::const_iterator it;
@@ -253,7 +260,8 @@ try {
 
                // 1-char string = system
                string sys(sat.toString().substr(0,1));
-               const vector<RinexObsID> types(roh.mapObsTypes[sys]);
+               const vector<RinexObsID>& types(roh.mapObsTypes[sys]);
+               int rec(-1);                        // record in the column store
 
                // loop over obs
                for(i=0; i<it->second.size(); i++) {
@@ -276,8 +284,13 @@ try {
                   SatObsCountMap[sat][nint]++;
                   countWantedObsTypes[nint]++;
 
+                  // add it to the column store
+                  if(saveData && saveCols) {
+                     if(rec == -1) rec = colstore.addRecord(sat);
+                     colstore.setDatum(rec, nint, it->second[i]);
+                  }
                   // add it to outrod
-                  if(saveData) {
+                  else if(saveData) {
                      if(outrod.obs.find(sat) == outrod.obs.end()) {
                         vector<RinexDatum> v(wantedObsTypes.size());
                         outrod.obs[sat] = v;
@@ -288,7 +301,8 @@ try {
                }
             }
 
-            if(saveData && outrod.obs.size() > 0) datastore.push_back(outrod);
+            if(saveData && saveCols) colstore.endEpoch();
+            else if(saveData && outrod.obs.size() > 0) datastore.push_back(outrod);
 
             if(nepochsToRead > -1 && nepochs >= nepochsToRead) break;
 
@@ -348,7 +362,7 @@ string Rinex3ObsFileLoader::asString(void)
          << filenames[i] << endl;
    oss << " Interval " << fixed << setprecision(2) << getDT() << "sec, obs types";
    for(i=0; i<wantedObsTypes.size(); i++) oss << " " << wantedObsTypes[i];
-   oss << ", store size " << datastore.size();
+   oss << ", store size " << getStoreSize();
    oss << "\n";
    oss << " Time limits: begin  " << printTime(begDataTime,longfmt) << "\n"
        << "                end  " << printTime(endDataTime,longfmt) << "\n";
@@ -381,13 +395,10 @@ int Rinex3ObsFileLoader::WriteSatPassList(const map<char, vector<string> >& sysS
 {
 try {
    if(!dataSaved()) return -3;
-   if(datastore.size() == 0) return -4;
+   if(getStoreSize() == 0) return -4;
 
-   char sys;
    int npass(0);
    unsigned int i;
-   unsigned short flag;
-   GSatID sat;
    map<GSatID,unsigned int> indexForSat;
    map<GSatID,unsigned int>::const_iterator satit;
    map<char,vector<string> >::const_iterator obsit;
@@ -408,44 +419,58 @@ try {
    vector<double> data(nobs,0.0);
    vector<unsigned short> ssi(nobs,0), lli(nobs,0);
 
-   // loop over the data store
-   for(unsigned int nds=0; nds<datastore.size(); nds++) {
-
-      // loop over satellites
-      Rinex3ObsData::DataMap::const_iterator it;
-      map<char, vector<int> >::const_iterator jt;
-      for(it = datastore[nds].obs.begin(); it != datastore[nds].obs.end(); ++it) {
-         sys = it->first.systemChar();
-         jt = indexLoadOT.find(sys);
-         if(jt == indexLoadOT.end())      // skip unwanted system
-            continue;
-         sat = GSatID(it->first);         // converts from RinexSatID
-
-         // get obstypes for this sys
-         obsit = sysSPOT.find(sys);
-         if(obsit == sysSPOT.end())       // sysSPOT not found for system sys
-            return -5;
-
-         // pull data out of store and put in arrays
-         flag = SatPass::OK;
-         for(i=0; i<jt->second.size(); i++) {
-            int ind = jt->second[i];
-            if(ind < 0) {
-               data[i] = 0.0;
-               ssi[i] = lli[i] = 0;
-               // don't flag BAD as there may be empty obs types in this SatPass
-            }
-            else {
-               data[i] = it->second[ind].data;
-               ssi[i] = it->second[ind].ssi;
-               lli[i] = it->second[ind].lli;
-               if(::fabs(data[i]) < 1.e-8) flag = SatPass::BAD;
-            }
+   // add the data of one satellite at one epoch to SPList; datum(ind) returns
+   // the datum of the loader's ObsID ind, from either store
+   // return 0 ok, or -5 if obstypes are not provided for the satellite's system
+   auto addSatData = [&](const CommonTime& ttag, const RinexSatID& rsat,
+                         const std::function<RinexDatum(int)>& datum) -> int
+   {
+      char sys(rsat.systemChar());
+      map<char, vector<int> >::const_iterator jt(indexLoadOT.find(sys));
+      if(jt == indexLoadOT.end())         // skip unwanted system
+         return 0;
+      GSatID sat(rsat);                   // converts from RinexSatID
+
+      // get obstypes for this sys
+      obsit = sysSPOT.find(sys);
+      if(obsit == sysSPOT.end())          // sysSPOT not found for system sys
+         return -5;
+
+      // pull data out of store and put in arrays
+      unsigned short flag(SatPass::OK);
+      for(unsigned int k=0; k<jt->second.size(); k++) {
+         int ind = jt->second[k];
+         if(ind < 0) {
+            data[k] = 0.0;
+            ssi[k] = lli[k] = 0;
+            // don't flag BAD as there may be empty obs types in this SatPass
+         }
+         else {
+            RinexDatum rd(datum(ind));
+            data[k] = rd.data;
+            ssi[k] = rd.ssi;
+            lli[k] = rd.lli;
+            if(::fabs(data[k]) < 1.e-8) flag = SatPass::BAD;
          }
+      }
 
-         // find the current SatPass for this sat
+      // find the current SatPass for this sat
+      satit = indexForSat.find(sat);
+      if(satit == indexForSat.end()) {       // create a new one
+         SatPass newSP(sat,nominalDT,obsit->second);
+         SPList.push_back(newSP);
+         npass++;
+         indexForSat[sat] = SPList.size()-1;
          satit = indexForSat.find(sat);
-         if(satit == indexForSat.end()) {       // create a new one
+      }
+
+      // add the data to the SatPass
+      int iret;
+      do {
+         iret = SPList[satit->second].addData(
+                  ttag, obsit->second, data, lli, ssi, flag);
+
+         if(iret == -1) {     // there was a gap - break into two passes
             SatPass newSP(sat,nominalDT,obsit->second);
             SPList.push_back(newSP);
             npass++;
@@ -453,21 +478,35 @@ try {
             satit = indexForSat.find(sat);
          }
 
-         // add the data to the SatPass
-         do {
-            i = SPList[satit->second].addData(
-                  datastore[nds].time, obsit->second, data, lli, ssi, flag);
-
-            if(i == -1) {        // there was a gap - break into two passes
-               SatPass newSP(sat,nominalDT,obsit->second);
-               SPList.push_back(newSP);
-               npass++;
-               indexForSat[sat] = SPList.size()-1;
-               satit = indexForSat.find(sat);
-            }
+      } while(iret == -1);    // will iterate only once, if there is a gap
+
+      return 0;
+   };
+
+   // loop over the column store
+   if(saveCols) {
+      for(unsigned int e=0; e<colstore.numEpochs(); e++) {
+         // loop over satellites
+         for(unsigned int rec=colstore.epochBegin(e); rec<colstore.epochEnd(e);
+                                                                        ++rec) {
+            if(addSatData(colstore.time(e), colstore.sat(rec),
+                  [&](int ind) { return colstore.datum(ind,rec); }) == -5)
+               return -5;
+         }
+      }
+      return npass;
+   }
 
-         } while(i == -1);       // will iterate only once, if there is a gap
+   // loop over the data store
+   for(unsigned int nds=0; nds<datastore.size(); nds++) {
 
+      // loop over satellites
+      Rinex3ObsData::DataMap::const_iterator it;
+      for(it = datastore[nds].obs.begin(); it != datastore[nds].obs.end(); ++it) {
+         const vector<RinexDatum>& rdv(it->second);
+         if(addSatData(datastore[nds].time, it->first,
+               [&](int ind) { return rdv[ind]; }) == -5)
+            return -5;
       }  // end loop over satellites
 
    }  // end loop over data store
@@ -511,6 +550,30 @@ void Rinex3ObsFileLoader::dumpSatObsTable(ostream& s) const
 // param ostream s to which to write the table
 void Rinex3ObsFileLoader::dumpStoreData(ostream& s) const
 {
+   if(saveCols) {
+      s << "\nDump the ROFL data(" << colstore.numEpochs() << "):" << endl;
+      for(unsigned int e=0; e<colstore.numEpochs(); e++) {
+         s << "Dump of Rinex3ObsData" << " at "
+            << printTime(colstore.time(e),timefmt)
+            << " epochFlag = " << colstore.epochFlag(e)
+            << " numSVs = " << colstore.epochEnd(e)-colstore.epochBegin(e)
+            << fixed << setprecision(9)
+            << " clk offset = " << colstore.clockOffset(e) << endl;
+         for(unsigned int rec=colstore.epochBegin(e); rec<colstore.epochEnd(e);
+                                                                        ++rec) {
+            s << " " << colstore.sat(rec).toString() << ":"
+               << fixed << setprecision(3);
+            for(unsigned int k=0; k<colstore.numObsTypes(); k++) {
+               s << " " << setw(13) << colstore.value(k,rec)
+                        << "/" << colstore.LLI(k,rec) << "/" << colstore.SSI(k,rec)
+                        << "/" << wantedObsTypes[k];
+            }
+            s << endl;
+         }
+      }
+      return;
+   }
+
    s << "\nDump the ROFL data(" << datastore.size() << "):" << endl;
    for(unsigned int i=0; i<datastore.size(); i++) {
       const Rinex3ObsData& rod(datastore[i]);
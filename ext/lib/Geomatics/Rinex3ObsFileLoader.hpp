@@ -55,6 +55,7 @@
 
 // gpstk-geomatics
 #include "SatPass.hpp"
+#include "Rinex3ObsColumnStore.hpp"
 
 namespace gpstk {
 
@@ -68,6 +69,7 @@ namespace gpstk {
 /// 1. Declare an object, and give it a list of (Rinex Obs) files
 ///    [cf. ctor(filename) or ctor(filenames) or member files(filenames)].
 /// 2. Configure the object, using e.g. saveTheData(true), excludeSat(sat), etc
+///    [saveColumns(true) to save the data in a Rinex3ObsColumnStore]
 /// 3. Specify which ObsIDs to save - e.g. GC1* GC2* GL1* GL2*
 /// 4. Run loadFiles(msg) to read the files (any error messages output in msg)
 /// 5. Read the output: dumpSatObsTable() or dumpData() [if saved], and access output
@@ -82,6 +84,7 @@ private:
    std::vector<std::string> filenames;    ///< input RINEX obs file names
    int nepochsToRead;                     ///< number of epochs to read (default:all)
    bool saveData;                         ///< if true save the data (F)
+   bool saveCols;                         ///< if true save in column store (F)
    std::string timefmt;                   ///< format for time tags in output
    // editing
    double dtdec;                          ///< decimate to this time step
@@ -118,13 +121,18 @@ private:
    std::vector<std::string> obstypes;     ///< RINEX obs types found in data
    std::vector<Rinex3ObsHeader> headers;  ///< headers from reading filenames
 
-   /// vector of all input data - filled only if saveData is true.
+   /// vector of all input data - filled only if saveData is true and saveCols
+   /// is false.
    std::vector<Rinex3ObsData> datastore;
 
+   /// all input data in columns - filled only if saveData and saveCols are true.
+   Rinex3ObsColumnStore colstore;
+
    /// initialization used by the constructors
    void init(void)
    {
       saveData = false;
+      saveCols = false;
       nepochsToRead = -1;
       timefmt = std::string("%04Y/%02m/%02d %02H:%02M:%02S");
       reset();
@@ -177,6 +185,7 @@ public:
       obstypes.clear();
       mcv.reset();
       datastore.clear();
+      colstore.clear();
       exSats.clear();
       headers.clear();
       inputWantedObsTypes.clear();
@@ -236,6 +245,16 @@ public:
    /// @return bool if true, then save the data, otherwise just the headers
    inline bool dataSaved(void) { return saveData; }
 
+   /// set the column store flag; if true (and saveTheData(true)) the data is
+   /// saved in a Rinex3ObsColumnStore (getColumnStore()) rather than in a vector
+   /// of Rinex3ObsData (getStore()). The column store is much smaller, and much
+   /// faster to scan, particularly one obs type or one satellite at a time.
+   /// @param b bool if true, then save the data in columns
+   inline void saveColumns(bool b) { saveCols = b; }
+   /// access column store flag
+   /// @return bool if true, then the data is saved in columns
+   inline bool columnsSaved(void) { return saveCols; }
+
    /// set the start time
    /// @param[in] tt start time, ignore data before this time
    inline void setStartTime(const CommonTime& tt) { startTime = tt; }
@@ -297,15 +316,22 @@ public:
    inline Rinex3ObsHeader getFullHeader(unsigned int i) const
       { return headers[i]; }
 
-   /// get the size of the data store
+   /// get the size of the data store, or of the column store if saveColumns()
    /// @return size (number of epochs) in the store
-   inline const int getStoreSize(void) const { return datastore.size(); }
+   inline const int getStoreSize(void) const
+      { return (saveCols ? colstore.numEpochs() : datastore.size()); }
 
-   /// access the data store
+   /// access the data store; empty if saveColumns(true)
    /// @return const ref to the datastore: vector<Rinex3ObsData>
    inline const std::vector<Rinex3ObsData>& getStore(void) const
       { return datastore; }
 
+   /// access the column store; empty unless saveColumns(true)
+   /// @return const ref to the column store; its obs types are the same, and in
+   ///    the same order, as getWantedObsTypes()
+   inline const Rinex3ObsColumnStore& getColumnStore(void) const
+      { return colstore; }
+
    // Read the files ----------------------------------------------------
 
    /// Read the files already defined
@@ -184,6 +184,26 @@ using namespace StringUtils;
       }
    }
 
+   // --------------------------------------------------------------------------------
+   // Fill-reducing ordering of the states: names sorted by the number of non-zero
+   // partials in each column of the input, fewest first.
+   Namelist SRI::sparseOrdering(const SparseMatrix<double>& Partials) const
+      throw(MatrixException)
+   {
+      if(Partials.cols() != names.size()) {
+         MatrixException me("Invalid input dimension: SRI has dimension "
+               + asString<int>(names.size()) + " while Partials has "
+               + asString<int>(Partials.cols()) + " columns");
+         GPSTK_THROW(me);
+      }
+
+      std::vector<unsigned int> P(columnOrdering(Partials));
+      Namelist NL;
+      for(unsigned int i=0; i<P.size(); i++)
+         NL += names.getName(P[i]);
+      return NL;
+   }
+
    // --------------------------------------------------------------------------------
    // Split this SRI (call it S) into two others, S1 and Sleft, where S1 has
    // a Namelist identical to the input Namelist (NL); set *this = S1 at the
@@ -214,6 +214,16 @@ public:
    void permute(const Namelist& NL)
       throw(MatrixException,VectorException);
 
+      /// Fill-reducing ordering of the states for sparse updates: the names,
+      /// sorted so that states with the fewest non-zero partials in the given
+      /// SparseMatrix come first (see columnOrdering() in SparseMatrix.hpp).
+      /// Pass the result to permute() and build later partials in the new order.
+      /// @param Partials matrix, columns in the order of names
+      /// @return the permuted Namelist
+      /// @throw if the number of columns of Partials is not the dimension
+   Namelist sparseOrdering(const SparseMatrix<double>& Partials) const
+      throw(MatrixException);
+
       /// split an SRI into two others, this one matching the input Namelist, the
       /// other containing whatever is left. The input Namelist must be a non-trivial
       /// subset of this->names; throw MatrixException if it is not. NB. Interpreting
@@ -416,15 +426,16 @@ public:
    }
 
       /// SRIF (Kalman) measurement update, or least squares update, Sparse version.
-      /// Call the SRI measurement update for this SRI and the given input. See doc.
-      /// for SrifMU().
+      /// Call the Givens rotation SRI measurement update, which skips the zeros
+      /// of the partials, for this SRI and the given input. See doc.
+      /// for SrifMUGivens().
       /// @param Partials matrix
       /// @param Data vector
    void measurementUpdate(SparseMatrix<double>& Partials, Vector<double>& Data)
       throw(Exception)
    {
       try {
-         SrifMU(R, Z, Partials, Data);
+         SrifMUGivens(R, Z, Partials, Data);
       }
       catch(MatrixException& me) { GPSTK_RETHROW(me); }
    }
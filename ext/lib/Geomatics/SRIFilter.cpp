@@ -194,8 +194,8 @@ void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>&
          A = L * A;
       }
 
-         // update *this with the whitened information
-      SrifMU(R, Z, A);
+         // update *this with the whitened information, one row at a time
+      SrifMUGivens(R, Z, A);
 
          // copy out D and un-whiten residuals
       D = Vector<double>(A.colCopy(A.cols()-1));
@@ -135,7 +135,8 @@ public:
    throw(MatrixException,VectorException);
 
       /// SRIF (Kalman) simple linear measurement update with optional weight matrix
-      /// SparseMatrix version
+      /// SparseMatrix version; uses Givens rotations (SrifMUGivens()) so that the
+      /// work follows the non-zeros of H; see also SRI::sparseOrdering().
       /// @param H  Partials matrix, dimension MxN.
       /// @param D  Data vector, length M; on output D is post-fit residuals.
       /// @param CM Measurement covariance matrix, dimension MxM.
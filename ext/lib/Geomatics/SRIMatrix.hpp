@@ -44,6 +44,8 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <sstream>
+#include <vector>
 // GPSTk
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -112,33 +114,86 @@ namespace gpstk
    //
    // Ref: Bierman, G.J. "Factorization Methods for Discrete Sequential
    //      Estimation," Academic Press, 1977.
-   
-   /// Square root information measurement update, with new data in the form of a
-   /// single matrix concatenation of H and D: A = H || D.
-   /// See doc for the overloaded SrifMU().
+   //
+   //    For large problems the work is dominated by the updates of the columns to
+   // the right of column k, and each transformation streams all of them through
+   // memory. SrifMU therefore groups nb columns into a block (the 'compact WY'
+   // form, Schreiber and Van Loan 1989): the block's transformations are found
+   // one column at a time, updating only the block's own columns, then applied
+   // together to the remaining columns as x += V*T*(V^T*x), where the columns of
+   // V are the vectors u, and T is a small lower triangular matrix. Each remaining
+   // column is then read once per block rather than once per transformation.
+   // Only row k of R enters transformation k, so V needs no storage beyond A
+   // and the values u(0). All loops run down contiguous columns (Matrix is stored
+   // in column-major order) and are written so the compiler can vectorize them.
+
+   /// Block size used by SrifMU() when none is given; smaller problems
+   /// (fewer than 2*SrifMUBlockSize states) use the unblocked algorithm.
+   const unsigned int SrifMUBlockSize = 32;
+
+   /// Dot product of contiguous arrays x and y of length m, for SrifMU().
+   /// Four partial sums let the compiler vectorize without reordering flags.
    template <class T>
-   void SrifMU(Matrix<T>& R, Vector<T>& Z, Matrix<T>& A, unsigned int M=0)
-      throw(MatrixException)
+   inline T SrifMUDot(const T *x, const T *y, const unsigned int m)
    {
-      if(A.cols() <= 1 || A.cols() != R.cols()+1 || Z.size() < R.rows()) {
-         if(A.cols() > 1 && R.rows() == 0 && Z.size() == 0) {
-            // create R and Z
-            R = Matrix<double>(A.cols()-1,A.cols()-1,0.0);
-            Z = Vector<double>(A.cols()-1,0.0);
-         }
-         else {
-            std::ostringstream oss;
-            oss << "Invalid input dimensions:\n  R has dimension "
-               << R.rows() << "x" << R.cols() << ",\n  Z has length "
-               << Z.size() << ",\n  and A has dimension "
-               << A.rows() << "x" << A.cols();
-            GPSTK_THROW(MatrixException(oss.str()));
-         }
+      T s0(0), s1(0), s2(0), s3(0);
+      unsigned int i=0;
+      for( ; i+4<=m; i+=4) {
+         s0 += x[i]*y[i];     s1 += x[i+1]*y[i+1];
+         s2 += x[i+2]*y[i+2]; s3 += x[i+3]*y[i+3];
       }
-   
+      for( ; i<m; i++) s0 += x[i]*y[i];
+      return (s0+s1)+(s2+s3);
+   }
+
+   /// y += a*x for contiguous arrays x and y of length m, for SrifMU().
+   template <class T>
+   inline void SrifMUAxpy(const T a, const T *x, T *y, const unsigned int m)
+   {
+      for(unsigned int i=0; i<m; i++) y[i] += a*x[i];
+   }
+
+   /// w[c] = x . y[c] for four contiguous arrays y[c], for SrifMU();
+   /// each element of x is loaded once for all four.
+   template <class T>
+   inline void SrifMUDot4(const T *x, T *const y[4], const unsigned int m, T *w)
+   {
+      const T *y0(y[0]), *y1(y[1]), *y2(y[2]), *y3(y[3]);
+      T s0(0), s1(0), s2(0), s3(0), t0(0), t1(0), t2(0), t3(0);
+      unsigned int i=0;
+      for( ; i+2<=m; i+=2) {
+         s0 += x[i]*y0[i]; t0 += x[i+1]*y0[i+1];
+         s1 += x[i]*y1[i]; t1 += x[i+1]*y1[i+1];
+         s2 += x[i]*y2[i]; t2 += x[i+1]*y2[i+1];
+         s3 += x[i]*y3[i]; t3 += x[i+1]*y3[i+1];
+      }
+      if(i < m) {
+         s0 += x[i]*y0[i]; s1 += x[i]*y1[i]; s2 += x[i]*y2[i]; s3 += x[i]*y3[i];
+      }
+      w[0] = s0+t0; w[1] = s1+t1; w[2] = s2+t2; w[3] = s3+t3;
+   }
+
+   /// y[c] += a[c]*x for four contiguous arrays y[c], for SrifMU().
+   template <class T>
+   inline void SrifMUAxpy4(const T *a, const T *x, T *const y[4],
+                           const unsigned int m)
+   {
+      T *y0(y[0]), *y1(y[1]), *y2(y[2]), *y3(y[3]);
+      const T a0(a[0]), a1(a[1]), a2(a[2]), a3(a[3]);
+      for(unsigned int i=0; i<m; i++) {
+         const T xi(x[i]);
+         y0[i] += a0*xi; y1[i] += a1*xi; y2[i] += a2*xi; y3[i] += a3*xi;
+      }
+   }
+
+   /// Unblocked SrifMU kernel: apply the transformations one column at a time.
+   /// Dimensions are not checked; call SrifMU().
+   template <class T>
+   void SrifMUUnblocked(Matrix<T>& R, Vector<T>& Z, Matrix<T>& A,
+                        const unsigned int m)
+   {
       const T EPS=-T(1.e-200);
-      unsigned int m=M, n=R.rows();
-      if(m==0 || m > A.rows()) m=A.rows();
+      unsigned int n=R.rows();
       unsigned int np1=n+1;         // if np1 = n, state vector Z is not updated
       unsigned int i,j,k;
       T dum, delta, beta;
@@ -175,6 +230,146 @@ namespace gpstk
                A(i,k) += sum * A(i,j);
          }
       }
+   }  // end SrifMUUnblocked
+
+   /// Blocked (compact WY) SrifMU kernel, with nb columns per block.
+   /// Dimensions are not checked; call SrifMU().
+   template <class T>
+   void SrifMUBlocked(Matrix<T>& R, Vector<T>& Z, Matrix<T>& A,
+                      const unsigned int m, const unsigned int nb)
+   {
+      const T EPS=-T(1.e-200);
+      const unsigned int n=R.rows(), lda=A.rows();
+      if(m == 0 || n == 0) return;
+
+      // columns of R, Z and A are contiguous; column n of R is Z
+      T *a = &A(0,0), *r = &R(0,0), *z = &Z(0);
+      std::vector<T> delta(nb), beta(nb), W(4*nb), TT(nb*nb);
+      unsigned int i,j,k,jj,kk,j0,j1,nbj;
+      T sum, dum;
+
+      for(j0=0; j0<n; j0+=nb) {
+         j1 = (j0+nb < n ? j0+nb : n);
+         nbj = j1-j0;
+
+         // find the block's transformations, updating only the block's columns;
+         // beta(jj)=0 marks a column that is skipped
+         for(j=j0; j<j1; j++) {
+            jj = j-j0;
+            beta[jj] = T(0);
+            const T *aj = a + j*lda;
+            sum = SrifMUDot(aj, aj, m);   // sum squares of elements below diagonal
+            if(sum <= T(0)) continue;
+
+            dum = r[j+j*n];
+            sum += dum * dum;             // add diagonal element
+            sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
+            delta[jj] = dum - sum;
+            r[j+j*n] = sum;
+
+            dum = sum*delta[jj];          // beta must be negative
+            if(dum > EPS) continue;
+            beta[jj] = T(1)/dum;
+
+            for(k=j+1; k<j1; k++) {
+               T *ak = a + k*lda;
+               sum = beta[jj] * (delta[jj]*r[j+k*n] + SrifMUDot(aj, ak, m));
+               r[j+k*n] += sum*delta[jj];
+               SrifMUAxpy(sum, aj, ak, m);
+            }
+         }
+
+         // T, stored by rows: applying the transformations in order to x adds
+         // V*s where s(jj) = beta(jj)*(u(jj)*x + sum[kk<jj] (u(jj)*u(kk))*s(kk)),
+         // so s = T*(V^T*x). The u share no rows of R, so u(jj)*u(kk) uses A only.
+         for(jj=0; jj<nbj; jj++) {
+            T *tj = &TT[jj*nb];
+            for(kk=0; kk<nbj; kk++) tj[kk] = T(0);
+            if(beta[jj] == T(0)) continue;
+            const T *aj = a + (j0+jj)*lda;
+            for(kk=0; kk<jj; kk++) {
+               if(beta[kk] == T(0)) continue;
+               dum = SrifMUDot(aj, a+(j0+kk)*lda, m);
+               const T *tk = &TT[kk*nb];
+               for(i=0; i<=kk; i++) tj[i] += dum*tk[i];
+            }
+            for(i=0; i<jj; i++) tj[i] *= beta[jj];
+            tj[jj] = beta[jj];
+         }
+
+         // apply the block to the remaining columns, and Z, four at a time
+         for(k=j1; k<=n; k+=4) {
+            const unsigned int nc = (k+4 <= n+1 ? 4 : n+1-k);
+            unsigned int c;
+            T *xr[4], *ak[4];
+            for(c=0; c<4; c++) {          // unused slots repeat the last column
+               kk = k + (c < nc ? c : nc-1);
+               xr[c] = (kk==n ? z : r + kk*n);
+               ak[c] = a + kk*lda;
+            }
+
+            for(jj=0; jj<nbj; jj++) {     // W = V^T*X
+               if(beta[jj] == T(0)) {
+                  for(c=0; c<4; c++) W[4*jj+c] = T(0);
+                  continue;
+               }
+               SrifMUDot4(a+(j0+jj)*lda, ak, m, &W[4*jj]);
+               for(c=0; c<4; c++) W[4*jj+c] += delta[jj]*xr[c][j0+jj];
+            }
+            for(jj=nbj; jj-- > 0; ) {     // W = T*W, T lower triangular
+               const T *tj = &TT[jj*nb];
+               for(c=0; c<4; c++) {
+                  sum = T(0);
+                  for(i=0; i<=jj; i++) sum += tj[i]*W[4*i+c];
+                  W[4*jj+c] = sum;
+               }
+            }
+            for(jj=0; jj<nbj; jj++) {     // X += V*W
+               if(beta[jj] == T(0)) continue;
+               for(c=0; c<nc; c++) xr[c][j0+jj] += W[4*jj+c]*delta[jj];
+               if(nc == 4)
+                  SrifMUAxpy4(&W[4*jj], a+(j0+jj)*lda, ak, m);
+               else for(c=0; c<nc; c++)
+                  SrifMUAxpy(W[4*jj+c], a+(j0+jj)*lda, ak[c], m);
+            }
+         }
+      }
+   }  // end SrifMUBlocked
+
+   /// Square root information measurement update, with new data in the form of a
+   /// single matrix concatenation of H and D: A = H || D.
+   /// See doc for the overloaded SrifMU().
+   /// @param nb number of columns per block; 0 (the default) chooses one, using
+   ///        the unblocked algorithm for small R, and 1 forces the unblocked one.
+   template <class T>
+   void SrifMU(Matrix<T>& R, Vector<T>& Z, Matrix<T>& A, unsigned int M=0,
+               unsigned int nb=0)
+      throw(MatrixException)
+   {
+      if(A.cols() <= 1 || A.cols() != R.cols()+1 || Z.size() < R.rows()) {
+         if(A.cols() > 1 && R.rows() == 0 && Z.size() == 0) {
+            // create R and Z
+            R = Matrix<double>(A.cols()-1,A.cols()-1,0.0);
+            Z = Vector<double>(A.cols()-1,0.0);
+         }
+         else {
+            std::ostringstream oss;
+            oss << "Invalid input dimensions:\n  R has dimension "
+               << R.rows() << "x" << R.cols() << ",\n  Z has length "
+               << Z.size() << ",\n  and A has dimension "
+               << A.rows() << "x" << A.cols();
+            GPSTK_THROW(MatrixException(oss.str()));
+         }
+      }
+   
+      unsigned int m=M;
+      if(m==0 || m > A.rows()) m=A.rows();
+
+      if(nb == 0) nb = (R.rows() < 2*SrifMUBlockSize ? 1 : SrifMUBlockSize);
+      if(nb == 1)
+         SrifMUUnblocked(R, Z, A, m);
+      else
+         SrifMUBlocked(R, Z, A, m, nb);
    }  // end SrifMU
     
 
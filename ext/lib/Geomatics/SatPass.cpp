@@ -102,6 +102,7 @@ void SatPass::init(RinexSatID insat, double indt, vector<string> obstypes) throw
       indexForLabel[obstypes[i]] = i;
       labelForIndex[i] = obstypes[i];
    }
+   spdvector.setNumTypes(obstypes.size());
 }
 
 SatPass& SatPass::operator=(const SatPass& right) throw()
@@ -115,9 +116,7 @@ SatPass& SatPass::operator=(const SatPass& right) throw()
       firstTime = right.firstTime;
       lastTime = right.lastTime;
       ngood = right.ngood;
-      spdvector.resize(right.spdvector.size());
-      for(int i=0; i<right.spdvector.size(); i++)
-         spdvector[i] = right.spdvector[i];
+      spdvector = right.spdvector;
    }
 
    return *this;
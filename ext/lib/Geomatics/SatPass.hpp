@@ -117,6 +117,173 @@ protected:
       }
    }; // end struct SatPassData
 
+   // --------------- SatPassDataStore for internal use only -----------------
+   // Storage for all the epochs of one pass as a structure of arrays: one
+   // contiguous array for each member of SatPassData, and for data, lli and ssi
+   // one contiguous array per obs type. This costs a few bytes per epoch per obs
+   // type, where a vector of SatPassData costs three heap blocks per epoch.
+   // operator[] returns a proxy with the members of SatPassData, as references
+   // into the arrays, so spdvector[i].data[k] etc. work as before; like
+   // references into a std::vector, a proxy is invalidated by push_back/resize.
+   class SatPassDataStore {
+   public:
+      typedef std::vector< std::vector<double> > DataColumns;
+      typedef std::vector< std::vector<unsigned short> > IndColumns;
+
+      /// the values of all obs types at one epoch, T is e.g. const double
+      template <class T, class Cols> struct EpochSlice {
+         EpochSlice(Cols& c, unsigned int ii) throw() : cols(c), i(ii) {}
+         T& operator[](unsigned int k) const throw() { return cols[k][i]; }
+         size_t size(void) const throw() { return cols.size(); }
+         Cols& cols;
+         const unsigned int i;
+      };
+
+      /// one epoch of the store, with the members of SatPassData
+      struct Row {
+         Row(SatPassDataStore& s, unsigned int i) throw()
+            : flag(s.flag[i]), userflag(s.userflag[i]), ndt(s.ndt[i]),
+              toffset(s.toffset[i]), data(s.data,i), lli(s.lli,i), ssi(s.ssi,i)
+         {}
+
+         /// copy the values (not the references) of another epoch
+         Row& operator=(const Row& right) throw()
+         {
+            flag = right.flag; userflag = right.userflag;
+            ndt = right.ndt; toffset = right.toffset;
+            for(size_t k=0; k<data.size(); k++) {
+               data[k] = right.data[k];
+               lli[k] = right.lli[k];
+               ssi[k] = right.ssi[k];
+            }
+            return *this;
+         }
+
+         /// copy this epoch out to a SatPassData
+         operator SatPassData() const throw()
+         {
+            SatPassData spd(data.size());
+            spd.flag = flag; spd.userflag = userflag;
+            spd.ndt = ndt; spd.toffset = toffset;
+            for(size_t k=0; k<data.size(); k++) {
+               spd.data[k] = data[k];
+               spd.lli[k] = lli[k];
+               spd.ssi[k] = ssi[k];
+            }
+            return spd;
+         }
+
+         unsigned short& flag;
+         unsigned int& userflag;
+         unsigned int& ndt;
+         double& toffset;
+         EpochSlice<double, DataColumns> data;
+         EpochSlice<unsigned short, IndColumns> lli, ssi;
+      };
+
+      /// one epoch of a const store
+      struct ConstRow {
+         ConstRow(const SatPassDataStore& s, unsigned int i) throw()
+            : flag(s.flag[i]), userflag(s.userflag[i]), ndt(s.ndt[i]),
+              toffset(s.toffset[i]), data(s.data,i), lli(s.lli,i), ssi(s.ssi,i)
+         {}
+
+         /// copy this epoch out to a SatPassData
+         operator SatPassData() const throw()
+         {
+            SatPassData spd(data.size());
+            spd.flag = flag; spd.userflag = userflag;
+            spd.ndt = ndt; spd.toffset = toffset;
+            for(size_t k=0; k<data.size(); k++) {
+               spd.data[k] = data[k];
+               spd.lli[k] = lli[k];
+               spd.ssi[k] = ssi[k];
+            }
+            return spd;
+         }
+
+         const unsigned short& flag;
+         const unsigned int& userflag;
+         const unsigned int& ndt;
+         const double& toffset;
+         EpochSlice<const double, const DataColumns> data;
+         EpochSlice<const unsigned short, const IndColumns> lli, ssi;
+      };
+
+      /// constructor
+      /// @param n the number of data types to be stored
+      SatPassDataStore(unsigned int n=0) throw() { setNumTypes(n); }
+
+      /// number of epochs
+      size_t size(void) const throw() { return flag.size(); }
+
+      /// number of data types; may be changed only while the store is empty
+      size_t numTypes(void) const throw() { return data.size(); }
+      void setNumTypes(unsigned int n) throw()
+      {
+         data.resize(n); lli.resize(n); ssi.resize(n);
+      }
+
+      Row operator[](unsigned int i) throw() { return Row(*this,i); }
+      ConstRow operator[](unsigned int i) const throw()
+         { return ConstRow(*this,i); }
+
+      /// append one epoch; if the store is empty, it takes on the number of
+      /// data types of spd
+      void push_back(const SatPassData& spd) throw()
+      {
+         if(size() == 0 && spd.data.size() != numTypes())
+            setNumTypes(spd.data.size());
+         flag.push_back(spd.flag);
+         userflag.push_back(spd.userflag);
+         ndt.push_back(spd.ndt);
+         toffset.push_back(spd.toffset);
+         for(size_t k=0; k<numTypes(); k++) {
+            data[k].push_back(k < spd.data.size() ? spd.data[k] : 0.0);
+            lli[k].push_back(k < spd.lli.size() ? spd.lli[k] : 0);
+            ssi[k].push_back(k < spd.ssi.size() ? spd.ssi[k] : 0);
+         }
+      }
+
+      /// change the number of epochs; new epochs are zero, with flag OK
+      void resize(size_t n) throw()
+      {
+         flag.resize(n,SatPass::OK);
+         userflag.resize(n,0);
+         ndt.resize(n,0);
+         toffset.resize(n,0.0);
+         for(size_t k=0; k<numTypes(); k++) {
+            data[k].resize(n,0.0);
+            lli[k].resize(n,0);
+            ssi[k].resize(n,0);
+         }
+      }
+
+      /// reserve space for n epochs in every array
+      void reserve(size_t n) throw()
+      {
+         flag.reserve(n); userflag.reserve(n); ndt.reserve(n); toffset.reserve(n);
+         for(size_t k=0; k<numTypes(); k++) {
+            data[k].reserve(n); lli[k].reserve(n); ssi[k].reserve(n);
+         }
+      }
+
+      /// remove all epochs, but not the data types
+      void clear(void) throw() { resize(0); }
+
+      /// contiguous array of data type k, e.g. for vectorized processing
+      const std::vector<double>& column(unsigned int k) const throw()
+         { return data[k]; }
+
+   private:
+      std::vector<unsigned short> flag;
+      std::vector<unsigned int> userflag;
+      std::vector<unsigned int> ndt;
+      std::vector<double> toffset;
+      DataColumns data;
+      IndColumns lli, ssi;
+   }; // end class SatPassDataStore
+
    // --------------- private member data -----------------------------
    /// Status flag for use exclusively by the caller. It is set to 0
    /// by the constructors, but otherwise ignored by class SatPass and
@@ -142,8 +309,8 @@ protected:
    /// number of timetags with good data in the data arrays.
    unsigned int ngood;
 
-   /// ALL data in the pass, stored in SatPassData objects, in time order
-   std::vector<SatPassData> spdvector;
+   /// ALL data in the pass, in time order, stored as one array per obs type
+   SatPassDataStore spdvector;
 
    // --------------- private member functions ------------------------
 
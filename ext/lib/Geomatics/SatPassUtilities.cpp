@@ -213,14 +213,17 @@ catch(Exception& e) { GPSTK_RETHROW(e); }
 }  // end RemoveMilliseconds()
 
 // -------------------------------------------------------------------------------
-// prototype is in SatPass.hpp as a friend
-int SatPassFromRinexFiles(vector<string>& filenames,
-                          vector<string>& obstypes,
-                          double dtin,
-                          vector<SatPass>& SPList,
-                          vector<RinexSatID> exSats,
-                          bool lenient,
-                          Epoch beginTime, Epoch endTime)
+// Read the files for both versions of SatPassFromRinexFiles(). If handler is NULL,
+// fill SPList with all the passes; otherwise SPList holds only the passes in
+// progress, and each completed pass is passed to the handler.
+static int ReadSatPassRinexFiles(vector<string>& filenames,
+                                 vector<string>& obstypes,
+                                 double dtin,
+                                 vector<SatPass>& SPList,
+                                 const SatPassHandler *handler,
+                                 vector<RinexSatID> exSats,
+                                 bool lenient,
+                                 Epoch beginTime, Epoch endTime)
    throw(Exception)
 {
 try {
@@ -425,7 +428,11 @@ try {
             do {
                i = SPList[satit->second].addData(obsdata.time,obstypes,
                                                  data,lli,ssi,flag);
-               if(i == -1) {        // gap
+               if(i == -1 && handler) {      // gap - the pass is complete
+                  (*handler)(SPList[satit->second]);
+                  SPList[satit->second] = SatPass(sat,dtin,obstypes);
+               }
+               else if(i == -1) {   // gap
                   SatPass newSP(sat,dtin,obstypes);
                   SPList.push_back(newSP);
                   indexForSat[sat] = SPList.size()-1;
@@ -449,6 +456,16 @@ try {
          } // end loop over satellites
          nepochs++;
 
+         // hand out passes that can no longer be extended; the extra dt makes
+         // certain that SatPass::addData() would find a gap
+         if(handler) for(i=0; i<SPList.size(); i++) {
+            if(SPList[i].size() == 0) continue;
+            if(obsdata.time - SPList[i].getLastTime() > SatPass::maxGap + dtin) {
+               (*handler)(SPList[i]);
+               SPList[i] = SatPass(SPList[i].getSat(),dtin,obstypes);
+            }
+         }
+
          if(timeShort.size() > 50 && timeShort.size() > nepochs/2) {
             for(i=0; i<timeOrder.size(); i++)
                LOG(WARNING) << "Warning - " << setw(4) << nOrder[i]
@@ -493,11 +510,57 @@ try {
             << " are out of time order";
    }
 
+   // hand out the passes still in progress, in time order
+   if(handler) {
+      vector<SatPass> inprogress;
+      for(i=0; i<SPList.size(); i++)
+         if(SPList[i].size() > 0) inprogress.push_back(SPList[i]);
+      SPList.clear();
+      std::sort(inprogress.begin(), inprogress.end());
+      for(i=0; i<inprogress.size(); i++) (*handler)(inprogress[i]);
+   }
+
    return nfiles;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
 
+// -------------------------------------------------------------------------------
+// prototype is in SatPass.hpp as a friend
+int SatPassFromRinexFiles(vector<string>& filenames,
+                          vector<string>& obstypes,
+                          double dtin,
+                          vector<SatPass>& SPList,
+                          vector<RinexSatID> exSats,
+                          bool lenient,
+                          Epoch beginTime, Epoch endTime)
+   throw(Exception)
+{
+   try {
+      return ReadSatPassRinexFiles(filenames, obstypes, dtin, SPList, NULL,
+                                   exSats, lenient, beginTime, endTime);
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+// -------------------------------------------------------------------------------
+int SatPassFromRinexFiles(vector<string>& filenames,
+                          vector<string>& obstypes,
+                          double dtin,
+                          const SatPassHandler& handler,
+                          vector<RinexSatID> exSats,
+                          bool lenient,
+                          Epoch beginTime, Epoch endTime)
+   throw(Exception)
+{
+   try {
+      vector<SatPass> active;          // passes in progress, one per satellite
+      return ReadSatPassRinexFiles(filenames, obstypes, dtin, active, &handler,
+                                   exSats, lenient, beginTime, endTime);
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
 // -------------------------------------------------------------------------------
 // TD note this only works if the passes all have the same OTs in the same order....
 int SatPassToRinex2File(string filename,
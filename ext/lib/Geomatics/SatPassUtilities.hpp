@@ -40,6 +40,8 @@
 #ifndef GPSTK_SATELLITE_PASS_UTILS_INCLUDE
 #define GPSTK_SATELLITE_PASS_UTILS_INCLUDE
 
+#include <functional>
+
 #include "SatPassIterator.hpp"
 
 #include "RinexObsHeader.hpp"
@@ -88,6 +90,45 @@ int SatPassFromRinexFiles(
             gpstk::Epoch beginTime=gpstk::CommonTime::BEGINNING_OF_TIME,
             gpstk::Epoch endTime=gpstk::CommonTime::END_OF_TIME) throw(Exception);
 
+// -------------------------------------------------------------------------------
+/// Function called by the streaming SatPassFromRinexFiles() with each completed
+/// SatPass; it may modify the SatPass, which is discarded when it returns.
+typedef std::function<void(SatPass&)> SatPassHandler;
+
+// -------------------------------------------------------------------------------
+/// Streaming version of SatPassFromRinexFiles(): read a set of RINEX observation
+/// files and hand each SatPass to the handler as soon as it is complete, rather
+/// than keeping every pass in memory. A pass is complete when a gap larger than
+/// SatPass::maxGap is found in the data of its satellite, or when the data has
+/// been read past its end by more than maxGap (plus one timestep), and all
+/// remaining passes are completed, in time order, at the end of the data.
+/// Thus only the passes currently in view are held in memory. Passes are
+/// passed to the handler in the order they are completed, which is NOT the
+/// order of their begin times; otherwise the passes are identical to those
+/// produced by the vector version, with the same parameters.
+/// @param filenames vector of input RINEX observation file names
+/// @param obstypes  vector of observation types to include in SatPass (may
+///                   be empty: include all)
+/// @param dt        data interval of the input files
+/// @param handler   function called with each completed SatPass
+/// @param exSats    vector of satellites to exclude
+/// @param lenient   if true (default), be lenient in reading the RINEX format
+/// @param beginTime reject data before this time (BEGINNING_OF_TIME)
+/// @param endTime   reject data after this time (END_OF TIME)
+/// @return -1 if the filenames list is empty, otherwise return the number of
+///                files successfully read (may be less than the number input).
+/// @throw gpstk Exceptions as the vector version; passes completed before the
+///              exception have already been passed to the handler.
+int SatPassFromRinexFiles(
+            std::vector<std::string>& filenames,
+            std::vector<std::string>& obstypes,
+            double dt,
+            const SatPassHandler& handler,
+            std::vector<RinexSatID> exSats=std::vector<RinexSatID>(),
+            bool lenient=true,
+            gpstk::Epoch beginTime=gpstk::CommonTime::BEGINNING_OF_TIME,
+            gpstk::Epoch endTime=gpstk::CommonTime::END_OF_TIME) throw(Exception);
+
 // -------------------------------------------------------------------------------
 /// deprecated - use SatPassToRinex3File for both 3 and 2.
 /// Iterate over the input vector of SatPass objects (sorted to be in time
@@ -257,6 +257,10 @@ namespace gpstk
                                   const unsigned int M) throw(Exception);
    template <class T> void SrifMU(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& P,
                              Vector<T>& D, const unsigned int M) throw(Exception);
+   template <class T> void SrifMUGivens(Matrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M) throw(Exception);
+   template <class T> void SrifMUGivens(SparseMatrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M) throw(Exception);
 
    //---------------------------------------------------------------------------
    /// Class SparseMatrix. This class is designed to present an interface nearly
@@ -362,6 +366,10 @@ namespace gpstk
                                     const unsigned int M) throw(Exception);
       friend void SrifMU<T>(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& P,
                             Vector<T>& D, const unsigned int M) throw(Exception);
+      friend void SrifMUGivens<T>(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& A,
+                                  const unsigned int M) throw(Exception);
+      friend void SrifMUGivens<T>(SparseMatrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M) throw(Exception);
 
       /// empty constructor
       SparseMatrix(void) : nrows(0), ncols(0) { }
@@ -617,9 +625,9 @@ namespace gpstk
       typename std::map< unsigned int, SparseVector<T> >::const_iterator it;
       for(it = SM.rowsMap.begin(); it != SM.rowsMap.end(); ++it) {
          if(it->first < rind) continue;               // skip rows before rind
-         if(it->first > rind+rnum) break;             // done with rows
+         if(it->first >= rind+rnum) break;            // done with rows
          SparseVector<T> SV(it->second,cind,cnum);    // get sub-vector
-         if(!SV.isEmpty()) rowsMap[it->first] = SV;   // add it
+         if(!SV.isEmpty()) rowsMap[it->first-rind] = SV; // add it
       }
    }
 
@@ -2112,6 +2120,529 @@ namespace gpstk
       catch(Exception& e) { GPSTK_RETHROW(e); }
    }
 
+   //---------------------------------------------------------------------------
+   /// Class CompressedSparseMatrix. A read-only, compressed copy of a SparseMatrix,
+   /// stored either by row (CSR, compressed sparse row) or by column (CSC,
+   /// compressed sparse column) in three arrays: for each row (column) i,
+   /// indexes[pointers[i]..pointers[i+1]-1] are the columns (rows) of the non-zero
+   /// elements and values[] the elements themselves, in increasing index order.
+   /// The SparseMatrix map of maps is convenient for building a matrix; this form
+   /// is compact and cache-friendly, and is the one to use once a matrix is built
+   /// and only has to be read, e.g. to stream the rows of a large partials matrix
+   /// through SrifMUGivens(). Transposing a CSR matrix gives a CSC one with the
+   /// same arrays.
+   template <class T> class CompressedSparseMatrix
+   {
+   public:
+      /// storage order of the compressed arrays
+      enum Storage { CSR=0, CSC };
+
+      /// empty constructor
+      CompressedSparseMatrix(void) : nrows(0), ncols(0), storage(CSR)
+         { pointers.push_back(0); }
+
+      /// constructor from a SparseMatrix, with the given storage order
+      CompressedSparseMatrix(const SparseMatrix<T>& SM, Storage s=CSR);
+
+      /// copy back into a SparseMatrix
+      SparseMatrix<T> toSparseMatrix(void) const;
+
+      /// cast to Matrix
+      operator Matrix<T>() const;
+
+      /// get number of rows
+      inline unsigned int rows(void) const { return nrows; }
+
+      /// get number of columns
+      inline unsigned int cols(void) const { return ncols; }
+
+      /// size of matrix = rows()*cols()
+      inline unsigned int size(void) const { return nrows*ncols; }
+
+      /// datasize - number of non-zero data
+      inline unsigned int datasize(void) const { return values.size(); }
+
+      /// storage order, CSR or CSC
+      inline Storage getStorage(void) const { return storage; }
+
+      /// number of rows (CSR) or columns (CSC), i.e. of compressed lines
+      inline unsigned int lines(void) const { return pointers.size()-1; }
+
+      /// index into indexes() and values() of the first element of line i;
+      /// line i ends at begin(i+1)
+      inline unsigned int begin(const unsigned int i) const { return pointers[i]; }
+
+      /// column (CSR) or row (CSC) indexes of the data
+      inline const std::vector<unsigned int>& indexes(void) const { return idx; }
+
+      /// the non-zero data
+      inline const std::vector<T>& data(void) const { return values; }
+
+      /// element (i,j), found by binary search within its line
+      T operator()(const unsigned int i, const unsigned int j) const;
+
+      /// transpose - swaps dimensions and storage order, data is not moved
+      CompressedSparseMatrix<T> transpose(void) const
+      {
+         CompressedSparseMatrix<T> toRet(*this);
+         std::swap(toRet.nrows, toRet.ncols);
+         toRet.storage = (storage == CSR ? CSC : CSR);
+         return toRet;
+      }
+
+      /// copy with the other storage order, same matrix
+      CompressedSparseMatrix<T> convert(void) const;
+
+      /// multiply by a Vector: returns this * V
+      Vector<T> operator*(const Vector<T>& V) const throw(Exception);
+
+      /// multiply the transpose by a Vector: returns transpose(this) * V
+      Vector<T> transposeTimes(const Vector<T>& V) const throw(Exception);
+
+   private:
+      /// dimensions of the real matrix
+      unsigned int nrows, ncols;
+
+      /// storage order
+      Storage storage;
+
+      /// lines()+1 offsets into idx and values
+      std::vector<unsigned int> pointers;
+
+      /// column (CSR) or row (CSC) index of each element
+      std::vector<unsigned int> idx;
+
+      /// non-zero elements
+      std::vector<T> values;
+
+   }; // end class CompressedSparseMatrix
+
+   //---------------------------------------------------------------------------
+   // implementation of CompressedSparseMatrix
+   //---------------------------------------------------------------------------
+   template <class T>
+   CompressedSparseMatrix<T>::CompressedSparseMatrix(const SparseMatrix<T>& SM,
+                                                     Storage s)
+      : nrows(SM.rows()), ncols(SM.cols()), storage(s)
+   {
+      // flatten is ordered by row, then column, i.e. already CSR
+      std::vector<unsigned int> r, c;
+      std::vector<T> v;
+      SM.flatten(r, c, v);
+
+      unsigned int i, n(storage == CSR ? nrows : ncols);
+      pointers = std::vector<unsigned int>(n+1, 0);
+      if(storage == CSR) {
+         for(i=0; i<r.size(); i++) pointers[r[i]+1]++;
+         for(i=0; i<n; i++) pointers[i+1] += pointers[i];
+         idx.swap(c);
+         values.swap(v);
+         return;
+      }
+
+      // CSC: counting sort by column; rows stay in order within each column
+      for(i=0; i<c.size(); i++) pointers[c[i]+1]++;
+      for(i=0; i<n; i++) pointers[i+1] += pointers[i];
+      idx.resize(v.size());
+      values.resize(v.size());
+      std::vector<unsigned int> next(pointers.begin(), pointers.end()-1);
+      for(i=0; i<v.size(); i++) {
+         unsigned int k(next[c[i]]++);
+         idx[k] = r[i];
+         values[k] = v[i];
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   SparseMatrix<T> CompressedSparseMatrix<T>::toSparseMatrix(void) const
+   {
+      SparseMatrix<T> toRet(nrows, ncols);
+      for(unsigned int i=0; i<lines(); i++)
+         for(unsigned int k=pointers[i]; k<pointers[i+1]; k++) {
+            if(storage == CSR) toRet(i,idx[k]) = values[k];
+            else               toRet(idx[k],i) = values[k];
+         }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   CompressedSparseMatrix<T>::operator Matrix<T>() const
+   {
+      Matrix<T> toRet(nrows, ncols, T(0));
+      for(unsigned int i=0; i<lines(); i++)
+         for(unsigned int k=pointers[i]; k<pointers[i+1]; k++) {
+            if(storage == CSR) toRet(i,idx[k]) = values[k];
+            else               toRet(idx[k],i) = values[k];
+         }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   T CompressedSparseMatrix<T>::operator()(const unsigned int i,
+                                           const unsigned int j) const
+   {
+      const unsigned int line(storage == CSR ? i : j), k(storage == CSR ? j : i);
+      if(line >= lines()) return T();
+      typename std::vector<unsigned int>::const_iterator b(idx.begin()), it;
+      it = std::lower_bound(b+pointers[line], b+pointers[line+1], k);
+      if(it == b+pointers[line+1] || *it != k) return T();
+      return values[it-b];
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   CompressedSparseMatrix<T> CompressedSparseMatrix<T>::convert(void) const
+   {
+      // same matrix, re-compressed the other way by a counting sort
+      CompressedSparseMatrix<T> toRet(*this);
+      unsigned int i, k, n(storage == CSR ? ncols : nrows);
+      toRet.storage = (storage == CSR ? CSC : CSR);
+      toRet.pointers = std::vector<unsigned int>(n+1, 0);
+      for(k=0; k<idx.size(); k++) toRet.pointers[idx[k]+1]++;
+      for(i=0; i<n; i++) toRet.pointers[i+1] += toRet.pointers[i];
+      std::vector<unsigned int> next(toRet.pointers.begin(),toRet.pointers.end()-1);
+      for(i=0; i<lines(); i++)
+         for(k=pointers[i]; k<pointers[i+1]; k++) {
+            unsigned int kk(next[idx[k]]++);
+            toRet.idx[kk] = i;
+            toRet.values[kk] = values[k];
+         }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   Vector<T> CompressedSparseMatrix<T>::operator*(const Vector<T>& V) const
+      throw(Exception)
+   {
+      if(V.size() != ncols) {
+         Exception e("Incompatible dimensions op*(CSM,V)");
+         GPSTK_THROW(e);
+      }
+      if(storage == CSC) return transpose().transposeTimes(V);
+
+      Vector<T> toRet(nrows, T(0));
+      for(unsigned int i=0; i<nrows; i++) {
+         T sum(0);
+         for(unsigned int k=pointers[i]; k<pointers[i+1]; k++)
+            sum += values[k] * V(idx[k]);
+         toRet(i) = sum;
+      }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   template <class T>
+   Vector<T> CompressedSparseMatrix<T>::transposeTimes(const Vector<T>& V) const
+      throw(Exception)
+   {
+      if(V.size() != nrows) {
+         Exception e("Incompatible dimensions transposeTimes(CSM,V)");
+         GPSTK_THROW(e);
+      }
+      if(storage == CSC) return transpose() * V;
+
+      Vector<T> toRet(ncols, T(0));
+      for(unsigned int i=0; i<nrows; i++) {
+         if(V(i) == T(0)) continue;
+         for(unsigned int k=pointers[i]; k<pointers[i+1]; k++)
+            toRet(idx[k]) += values[k] * V(i);
+      }
+      return toRet;
+   }
+
+   //---------------------------------------------------------------------------
+   /// Fill-reducing column ordering for the partials matrix H of a sparse SRI
+   /// update. Returns the permutation P, of length H.cols(), such that column i of
+   /// the reordered problem is column P[i] of H: columns are sorted by increasing
+   /// number of non-zero elements, ties keeping their original order.
+   /// Each row processed by SrifMUGivens() fills row j of R with every state to
+   /// the right of j that it touches, so states common to many measurements (e.g.
+   /// positions, clocks) belong last and states seen by few (e.g. double
+   /// difference ambiguities) first; R then keeps an arrowhead-like structure
+   /// instead of filling in. Apply P to an SRI using a permuted Namelist, see
+   /// SRI::sparseOrdering().
+   template <class T>
+   std::vector<unsigned int> columnOrdering(const SparseMatrix<T>& H)
+   {
+      std::vector<unsigned int> r, c;
+      std::vector<T> v;
+      H.flatten(r, c, v);
+
+      std::vector< std::pair<unsigned int, unsigned int> > count(H.cols());
+      unsigned int i;
+      for(i=0; i<H.cols(); i++) count[i] = std::make_pair(0U, i);
+      for(i=0; i<c.size(); i++) count[c[i]].first++;
+      std::sort(count.begin(), count.end());
+
+      std::vector<unsigned int> P(H.cols());
+      for(i=0; i<H.cols(); i++) P[i] = count[i].second;
+      return P;
+   }
+
+   //---------------------------------------------------------------------------
+   /// Rotate the working row w (length n+1, last element the data) into the
+   /// dense SRI R,Z with Givens rotations, starting at column jb. For use by
+   /// SrifMUGivens(); r points to the column-major storage of R (dimension n).
+   /// On return w is zero except w[n], the residual.
+   template <class T>
+   void SrifMUGivensRow(T *r, Vector<T>& Z, T *w, const unsigned int n,
+                        const unsigned int jb)
+   {
+      for(unsigned int j=jb; j<n; j++) {
+         const T b(w[j]);
+         if(b == T(0)) continue;
+         T *rj = r + j;                // R(j,k) = rj[k*n]
+         const T a(rj[j*n]);
+         const T rr(SQRT(a*a + b*b)), c(a/rr), s(b/rr);
+         rj[j*n] = rr;
+         w[j] = T(0);
+         for(unsigned int k=j+1; k<n; k++) {
+            const T rk(rj[k*n]), wk(w[k]);
+            if(wk == T(0)) {
+               if(rk == T(0)) continue;
+               rj[k*n] = c*rk;
+               w[k] = -s*rk;
+            }
+            else {
+               rj[k*n] = c*rk + s*wk;
+               w[k] = c*wk - s*rk;
+            }
+         }
+         const T zj(Z(j));
+         Z(j) = c*zj + s*w[n];
+         w[n] = c*w[n] - s*zj;
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   // Sparse SRI measurement update using Givens rotations.
+   // Input and output are those of SrifMU(R,Z,A,M): R,Z the a priori SRI, and
+   //    A = H || D the whitened partials and data, M x (N+1); rows of A beyond M
+   //    are ignored. On output R and Z are updated and A holds only the
+   //    residuals, in its last column.
+   // Rather than zeroing A one column at a time with Householder transformations,
+   // which touches every row of A for every state, each row of A is rotated into
+   // R by itself, with one Givens rotation for each of its non-zero elements
+   // (Golub and Van Loan, "Matrix Computations," 5.2.5). Zeros in the row, and
+   // in the rows of R it meets, are skipped, so the cost of a row depends on its
+   // non-zeros and the fill they bring from R, not on the total number of
+   // states. A double difference, which touches a handful of states, costs
+   // little; the ordering of the states (see columnOrdering()) controls the fill.
+   // The result is the same information (R^T*R and R^T*Z) and the same residual
+   // sum of squares as SrifMU(), although rows of R may differ in sign.
+   //
+   /// Square root information measurement update using Givens rotations, with
+   /// new data in the form of a single SparseMatrix concatenation of H and D:
+   /// A = H || D. See the doc above and for the overloaded SrifMU().
+   template <class T>
+   void SrifMUGivens(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& A,
+                     const unsigned int M) throw(Exception)
+   {
+      // if necessary, create R and Z
+      if(A.cols() > 1 && R.rows() == 0 && Z.size() == 0) {
+         R = Matrix<T>(A.cols()-1,A.cols()-1,T(0));
+         Z = Vector<T>(A.cols()-1,T(0));
+      }
+
+      if(A.cols() <= 1 || A.cols() != R.cols()+1 || R.rows() != R.cols()
+                       || Z.size() < R.rows()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  R has dimension "
+            << R.rows() << "x" << R.cols() << ",\n  Z has length "
+            << Z.size() << ",\n  and A has dimension "
+            << A.rows() << "x" << A.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const unsigned int m(M==0 || M>A.rows() ? A.rows() : M), n(R.rows());
+      std::vector<T> w(n+1, T(0));
+      typename std::map< unsigned int, SparseVector<T> >::iterator it;
+      typename std::map< unsigned int, T >::iterator vt;
+
+      it = A.rowsMap.begin();
+      while(it != A.rowsMap.end() && it->first < m) {
+         std::map<unsigned int, T>& row(it->second.vecMap);
+         if(row.empty()) { A.rowsMap.erase(it++); continue; }
+
+         for(vt=row.begin(); vt!=row.end(); ++vt) w[vt->first] = vt->second;
+         SrifMUGivensRow(&R(0,0), Z, &w[0], n, row.begin()->first);
+
+         // only the residual is left
+         row.clear();
+         if(w[n] != T(0)) {
+            row[n] = w[n];
+            w[n] = T(0);
+            ++it;
+         }
+         else
+            A.rowsMap.erase(it++);
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   /// Square root information measurement update using Givens rotations, with a
+   /// sparse SRI matrix R, so that storage and work both follow the non-zeros of
+   /// R as well as those of A = H || D. R must be upper triangular (as produced by
+   /// this routine); if R and Z are empty they are created. See the other
+   /// SrifMUGivens() for the doc.
+   template <class T>
+   void SrifMUGivens(SparseMatrix<T>& R, Vector<T>& Z, SparseMatrix<T>& A,
+                     const unsigned int M) throw(Exception)
+   {
+      // if necessary, create R and Z
+      if(A.cols() > 1 && R.rows() == 0 && Z.size() == 0) {
+         R = SparseMatrix<T>(A.cols()-1,A.cols()-1);
+         Z = Vector<T>(A.cols()-1,T(0));
+      }
+
+      if(A.cols() <= 1 || A.cols() != R.cols()+1 || R.rows() != R.cols()
+                       || Z.size() < R.rows()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  R has dimension "
+            << R.rows() << "x" << R.cols() << ",\n  Z has length "
+            << Z.size() << ",\n  and A has dimension "
+            << A.rows() << "x" << A.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const unsigned int m(M==0 || M>A.rows() ? A.rows() : M), n(R.rows());
+      typename std::map< unsigned int, SparseVector<T> >::iterator it, jt;
+      typename std::map< unsigned int, T >::iterator vt, wt;
+
+      it = A.rowsMap.begin();
+      while(it != A.rowsMap.end() && it->first < m) {
+         // working row: partials in w, data in wz
+         std::map<unsigned int, T> w, neww, newr;
+         T wz(0);
+         w.swap(it->second.vecMap);
+         vt = w.find(n);
+         if(vt != w.end()) { wz = vt->second; w.erase(vt); }
+
+         while(!w.empty()) {
+            const unsigned int j(w.begin()->first);
+            const T b(w.begin()->second);
+            w.erase(w.begin());
+            if(b == T(0)) continue;
+
+            jt = R.rowsMap.find(j);
+            if(jt == R.rowsMap.end())
+               jt = R.rowsMap.insert(std::make_pair(j, SparseVector<T>(n))).first;
+            std::map<unsigned int, T>& rj(jt->second.vecMap);
+
+            // R is upper triangular, so row j starts at (j,j)
+            vt = rj.begin();
+            T a(0);
+            if(vt != rj.end() && vt->first == j) { a = vt->second; ++vt; }
+            const T rr(SQRT(a*a + b*b)), c(a/rr), s(b/rr);
+
+            // rotate the rest of row j of R and the working row, which
+            // both have indexes > j; merge the two sorted maps
+            newr.clear();
+            neww.clear();
+            newr.insert(newr.end(), std::make_pair(j, rr));
+            wt = w.begin();
+            while(vt != rj.end() || wt != w.end()) {
+               unsigned int k;
+               T rk(0), wk(0);
+               if(wt == w.end() || (vt != rj.end() && vt->first < wt->first)) {
+                  k = vt->first; rk = vt->second; ++vt;
+               }
+               else if(vt == rj.end() || wt->first < vt->first) {
+                  k = wt->first; wk = wt->second; ++wt;
+               }
+               else {
+                  k = vt->first; rk = vt->second; wk = wt->second; ++vt; ++wt;
+               }
+               const T x(c*rk + s*wk), y(c*wk - s*rk);
+               if(x != T(0)) newr.insert(newr.end(), std::make_pair(k, x));
+               if(y != T(0)) neww.insert(neww.end(), std::make_pair(k, y));
+            }
+            rj.swap(newr);
+            w.swap(neww);
+
+            const T zj(Z(j));
+            Z(j) = c*zj + s*wz;
+            wz = c*wz - s*zj;
+         }
+
+         // only the residual is left
+         if(wz != T(0)) {
+            it->second.vecMap[n] = wz;
+            ++it;
+         }
+         else
+            A.rowsMap.erase(it++);
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   /// Square root information measurement update using Givens rotations, with
+   /// partials H and data D separate; on output D holds the residuals.
+   /// See the doc for SrifMUGivens(R,Z,A,M).
+   template <class T>
+   void SrifMUGivens(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& P,
+                     Vector<T>& D, const unsigned int M=0) throw(Exception)
+   {
+      try {
+         SparseMatrix<T> A(P||D);
+         SrifMUGivens(R,Z,A,M);
+         // copy residuals out of A into D
+         D = Vector<T>(A.colCopy(A.cols()-1));
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------
+   /// Square root information measurement update using Givens rotations, with
+   /// partials H in compressed (CSR) form and data D; H is streamed one row at a
+   /// time without building H || D. On output D holds the residuals.
+   /// See the doc for SrifMUGivens(R,Z,A,M).
+   template <class T>
+   void SrifMUGivens(Matrix<T>& R, Vector<T>& Z, const CompressedSparseMatrix<T>& H,
+                     Vector<T>& D, const unsigned int M=0) throw(Exception)
+   {
+      if(H.getStorage() != CompressedSparseMatrix<T>::CSR) {
+         try { SrifMUGivens(R, Z, H.convert(), D, M); }
+         catch(Exception& e) { GPSTK_RETHROW(e); }
+         return;
+      }
+
+      // if necessary, create R and Z
+      if(H.cols() > 0 && R.rows() == 0 && Z.size() == 0) {
+         R = Matrix<T>(H.cols(),H.cols(),T(0));
+         Z = Vector<T>(H.cols(),T(0));
+      }
+
+      if(H.cols() == 0 || H.cols() != R.cols() || R.rows() != R.cols()
+                       || Z.size() < R.rows() || D.size() != H.rows()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  R has dimension "
+            << R.rows() << "x" << R.cols() << ",\n  Z has length "
+            << Z.size() << ",\n  H has dimension "
+            << H.rows() << "x" << H.cols() << ",\n  and D has length "
+            << D.size();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const unsigned int m(M==0 || M>H.rows() ? H.rows() : M), n(R.rows());
+      const std::vector<unsigned int>& idx(H.indexes());
+      const std::vector<T>& val(H.data());
+      std::vector<T> w(n+1, T(0));
+
+      for(unsigned int i=0; i<m; i++) {
+         const unsigned int kb(H.begin(i)), ke(H.begin(i+1));
+         for(unsigned int k=kb; k<ke; k++) w[idx[k]] = val[k];
+         w[n] = D(i);
+         SrifMUGivensRow(&R(0,0), Z, &w[0], n, (kb < ke ? idx[kb] : n));
+         D(i) = w[n];
+         w[n] = T(0);
+      }
+   }
+
    //---------------------------------------------------------------------------
    //---------------------------------------------------------------------------
 
@@ -189,6 +189,11 @@ namespace gpstk
                                   const unsigned int M=0) throw(Exception);
    template <class T> void SrifMU(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& P,
                              Vector<T>& D, const unsigned int M=0) throw(Exception);
+   // Givens
+   template <class T> void SrifMUGivens(Matrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M=0) throw(Exception);
+   template <class T> void SrifMUGivens(SparseMatrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M=0) throw(Exception);
 
    //---------------------------------------------------------------------------
    /// Class SparseVector. This class is designed to present an interface nearly
@@ -270,6 +275,11 @@ namespace gpstk
                                   const unsigned int M) throw(Exception);
       friend void SrifMU<T>(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& P,
                             Vector<T>& D, const unsigned int M) throw(Exception);
+      // Givens
+      friend void SrifMUGivens<T>(Matrix<T>& R, Vector<T>& Z, SparseMatrix<T>& A,
+                                  const unsigned int M) throw(Exception);
+      friend void SrifMUGivens<T>(SparseMatrix<T>& R, Vector<T>& Z,
+                        SparseMatrix<T>& A, const unsigned int M) throw(Exception);
 
       /// tolerance in considering element to be zero is std::abs(elem) < tolerance
       /// see zeroize(), where this is the default input value
@@ -504,7 +514,7 @@ namespace gpstk
       typename std::map<unsigned int, T>::const_iterator it;
       for(it = SV.vecMap.begin(); it != SV.vecMap.end(); ++it) {
          if(it->first < ind) continue;       // skip ones before ind
-         if(it->first > ind+n) break;
+         if(it->first >= ind+n) break;
          vecMap[it->first-ind] = it->second;
       }
    }
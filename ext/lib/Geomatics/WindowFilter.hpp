@@ -82,6 +82,9 @@
 /// Filter object, run filter(), then use the results to modify flags[] and try to
 /// call filter() again, it does not see the changes to flags[]. Instead you need to
 /// call the constructor again.
+///    OnlineWindowFilter applies the window filter to a stream of data, one point
+/// at a time, without storing the data; it reports slips as soon as the analysis
+/// can decide them, with the same tests as WindowFilter::analyze().
 
 #include <vector>
 #include <deque>
@@ -326,8 +329,8 @@ public:
    inline void setWidth(int w) { width = w; }
    inline void setBufferSize(int b) { buffsize = b; }
    inline void setTwoSample(bool b) { twoSample=b; }
-   inline bool setBalanced(bool b) { balanced = b; }
-   inline bool setFullWindows(bool b) { fullwindows = b; }
+   inline void setBalanced(bool b) { balanced = b; }
+   inline void setFullWindows(bool b) { fullwindows = b; }
    inline int getWidth(void) { return width; }
    inline int getBufferSize(void) { return buffsize; }
    inline bool isTwoSample(void) { return twoSample; }
@@ -436,6 +439,56 @@ public:
 
 }; // end class WindowFilter
 
+//------------------------------------------------------------------------------------
+/// The sliding deques (ratio, sigma and future-minus-past sigma, over halfwidth
+/// points on either side) and the tests of WindowFilter::analyze(), applied one
+/// analysis point at a time. Kept separate from WindowFilter so that
+/// OnlineWindowFilter applies exactly the same tests as the batch filter.
+template <class T> class WindowFilterAnalyzer
+{
+public:
+   typedef typename WindowFilter<T>::Analysis Analysis;
+
+   /// constructor, with the analysis configuration of WindowFilter
+   WindowFilterAnalyzer(unsigned int hw, T mratio, T mstep, T mmargin,
+                        bool twoSamp, bool dbg=false, int w=8, int p=3)
+      : halfwidth(hw), minratio(mratio), minstep(mstep), minmargin(mmargin),
+        twoSample(twoSamp), debug(dbg), osw(w), osp(p), tmp(0.0)
+   { }
+
+   /// 'prime the pump' with the first (up to halfwidth+1) analysis points;
+   /// call before testing the first point. C is any indexable container.
+   template <class C> void prime(const C& avec);
+
+   /// update the deques with the point halfwidth beyond the next one to test
+   void push(const Analysis& A);
+
+   /// apply the tests to A, the i-th analysis point, setting A.score and A.msg
+   /// @param first true for the first point, which is never a slip
+   /// @param last true for the last point, which is never a slip
+   /// @param x,d the data at A.index, used only in the debug print
+   /// @param maybe return true if A is a near miss
+   /// @return true if A is a slip
+   bool test(Analysis& A, size_t i, bool first, bool last, T x, T d, bool& maybe);
+
+private:
+   unsigned int halfwidth;       ///< number of points on either side of slip analyzed
+   T minratio;                   ///< ratio=|step/sig| < this is not a slip
+   T minstep;                    ///< |step|(=fut ave - past ave) < this is not slip
+   T minmargin;                  ///< limit on step/minstep+ratio/minratio-2
+   bool twoSample;               ///< if true, two-sample statistics are used
+   bool debug;                   ///< if true, print debug messages in test()
+   int osw,osp;                  ///< width and precision for debug print
+
+   double tmp;                   ///< last sigma before the latest push()
+
+   /// ratio(step/sigma), its 1st diff, sigma, its 1st diff, future minus past sigma
+   std::deque<double> rat,rat1d,sig,sig1d,fminusp;
+   /// messages added to Analysis::msg
+   std::string ratmsg,sigmsg,fmpmsg,wtmsg;
+
+}; // end class WindowFilterAnalyzer
+
 //------------------------------------------------------------------------------------
 // return number of analyzed points, else -1 too little data, -2 two sample w/o x,
 //    -3 too little x or flag data.
@@ -786,6 +839,226 @@ template<class T> int WindowFilter<T>::filter(const size_t i0, int dsize)
 
 }  // end WindowFilter::filter()
 
+//------------------------------------------------------------------------------------
+template<class T> template<class C>
+void WindowFilterAnalyzer<T>::prime(const C& avec)
+{
+   size_t j;
+   rat.clear(); rat1d.clear(); sig.clear(); sig1d.clear(); fminusp.clear();
+
+   for(j=0; j<halfwidth; j++) {
+      rat.push_back(0.0); sig.push_back(0.0); fminusp.push_back(0.0);
+   }
+   for(j=0; (j<=halfwidth && j<avec.size()); j++) {
+      rat.push_back(::fabs(avec[j].step/avec[j].sigma));   // ratio
+      sig.push_back(avec[j].sigma);                         // sigma
+      fminusp.push_back(avec[j].fsig - avec[j].psig);       // fsig - psig
+   }
+   for(j=0; j<2*halfwidth; j++) { rat1d.push_back(0.0); sig1d.push_back(0.0); }
+}
+
+//------------------------------------------------------------------------------------
+template<class T> void WindowFilterAnalyzer<T>::push(const Analysis& A)
+{
+   // fill deques
+   tmp = rat.back();                      // ratio
+   rat.push_back(::fabs(A.step/A.sigma));
+   rat1d.push_back(rat.back()-tmp);       // and its first diff
+   tmp = sig.back();                      // sigma
+   sig.push_back(A.sigma);
+   sig1d.push_back(sig.back()-tmp);       // and sig first diff
+   // fsig - psig .. no first diff
+   fminusp.push_back(A.fsig - A.psig);
+
+   // keep deques size 2*half+1
+   while(rat.size() > 2*halfwidth+1) {
+      rat.pop_front(); sig.pop_front(); fminusp.pop_front();
+   }
+   // keep 1st difference deques size 2*half
+   while(rat1d.size() > 2*halfwidth) { rat1d.pop_front(); sig1d.pop_front(); }
+}
+
+//------------------------------------------------------------------------------------
+template<class T> bool WindowFilterAnalyzer<T>::test(Analysis& A, size_t i,
+                                  bool first, bool last, T x, T d, bool& maybe)
+{
+   size_t j;
+   bool isslip(false);
+
+   // test min/max in ratio, sig and fmp of the form +,+,+,any,-,-,-
+   bool rmax=true, smin=true, fmp=true;
+   int fmpcount(2*halfwidth);
+   double fmp0(fminusp[halfwidth]);
+   double rat0(::fabs(rat[halfwidth]));
+   for(j=0; j<halfwidth; j++) {
+      // test is that ratio is at maximum - so 1st dif is +,+,+,-,-,-
+      //                                              j=  0 1 2 h h+1 h+2
+      if(j == halfwidth-1) {
+         if(rat1d[j] < 0.0) rmax=false;
+         if(rat1d[j+halfwidth] > 0.0) rmax=false;
+      }
+      else {
+         if(rat1d[j] < -rat0/10.0) rmax=false;
+         if(rat1d[j+halfwidth] > rat0/10.0) rmax=false;
+      }
+
+      //if(rat1d[j] > 0.0) rmin=false; else
+      //if(rat1d[j+halfwidth] < 0.0) rmin=false; else
+
+      if(fminusp[j]-fmp0 < 0.0)             { fmp=false; fmpcount--; }
+      if(fminusp[j+halfwidth+1]-fmp0 > 0.0) { fmp=false; fmpcount--; }
+   }
+
+   // if(twoSample) same as 1-samp when there's no gap, but with gap its different
+   //       - see toy.gf.gap - looks like 2 limp clotheslines on big poles
+   //       +small,+verysmall,-big,(slim),+big,-verysmall,-small
+   //  sig1d[] 0     1         h-1         h      h+1      h+2
+   double slim(0.04*A.sigma);    // 5/16, was 0.02   // why 0.04?
+   if(twoSample) {
+      smin = true;
+      if(-sig1d[halfwidth-1]/slim < 2.0) smin=false;
+      else if(sig1d[halfwidth]/slim < 2.0) smin=false;
+      else for(j=0; j<halfwidth-1; j++) {
+         if(::fabs(sig1d[j]/sig1d[halfwidth-1]) > 0.5) smin=false;
+         if(::fabs(sig1d[halfwidth+1+j]/sig1d[halfwidth]) > 0.5) smin=false;
+      }
+   }
+   else {
+      for(j=0; j<halfwidth; j++) {
+         // for 1-sample, test is sigma is at minimum - so 1st dif is -,-,-,*,+,+,+
+         if(sig1d[j] > slim) smin=false;
+         if(sig1d[j+halfwidth] < -slim) smin=false;
+      }
+   }
+
+   // make this configurable?
+   if(2*halfwidth-fmpcount <= halfwidth/3) fmp=true;
+
+   // define a weight [0,1], used in score but only if it passes first tests
+   double weight=(rmax ? 0.25:0)+(smin ? 0.25:0)+0.5*fmpcount/double(2*halfwidth);
+
+   // dump all the deque to a string, for debug and dumpAnalMsg (verbose) output
+   {
+      std::ostringstream oss;
+      oss << " F-P" << std::fixed << std::setprecision(3);
+      for(j=0; j<fminusp.size(); j++) oss << "," << fminusp[j]-fmp0;
+      oss << ",cnt=" << fmpcount << "/" << 2*halfwidth;
+      fmpmsg = oss.str();
+      oss.str("");
+      oss << " RAT1d" << std::fixed << std::setprecision(3);
+      for(j=0; j<rat1d.size(); j++) oss << "," << rat1d[j];
+      ratmsg = oss.str();
+      oss.str("");
+      oss << " SIG1d" << std::scientific << std::setprecision(1);
+      for(j=0; j<sig1d.size(); j++) oss << "," << sig1d[j];
+      oss << ",(" << slim << ")";
+      sigmsg = oss.str();
+      oss.str("");
+      if(weight > 0) {
+         if(tmp)
+            oss << " changeF-P " << std::scientific << std::setprecision(2) << tmp;
+         oss << " wt=" << std::fixed << std::setprecision(3) << weight;
+      }
+      wtmsg = oss.str();
+   }
+
+   // debug print - also see single line below near end of routine
+   if(debug) std::cout << "WF:ANL"
+      << " " << std::setw(3) << i << " " << std::setw(3) << A.index
+      << std::fixed << std::setprecision(osp) << std::setw(osw)
+         << " " << x
+      << " " << std::setw(osw) << d
+      << " " << std::setw(osw) << A.step
+      << " " << std::setw(osw) << A.sigma
+      << " " << std::setw(3) << A.pN
+      << " " << std::setw(osw) << A.pave
+      << " " << std::setw(osw) << A.psig
+      << " " << std::setw(3) << A.fN
+      << " " << std::setw(osw) << A.fave
+      << " " << std::setw(osw) << A.fsig
+      << " " << std::setw(osw) << ::fabs(A.step/A.sigma)
+      << ratmsg << sigmsg << fmpmsg << wtmsg
+      << std::flush;
+
+   // ---------------------- do the tests ----------------------
+   // test 1a. ratio must be > minratio(2)
+   if(::fabs(A.step/A.sigma) <= minratio) {
+      if(debug) std::cout << " small ratio" << std::flush;
+      A.score = -3;                                   // failure
+      A.msg = " small_ratio";
+   }
+
+   // test 1b. step must be > 0.8
+   else if(::fabs(A.step) < minstep) {
+      if(debug) std::cout << " small step" << std::flush;
+      A.score = -2;                                   // failure
+      A.msg = " small_step";
+   }
+   
+   // its too early - before we can compute score
+   // usually ratio|step will be small, so not reach here
+   else if(first) {
+      if(debug) std::cout << " begin" << std::flush;
+      A.score = -1;                                   // failure
+      A.msg = " i=0_no_tests";
+   }
+
+   // approaching the end
+   else if(last) {
+      if(debug) std::cout << " end" << std::flush;
+      A.score = -1;                                   // failure
+      A.msg = " i=end_no_tests";
+   }
+
+   // test 1c. exclude case where step AND ratio are very close to limit
+   else if(::fabs(A.step/A.sigma) / minratio
+      + ::fabs(A.step) / minstep - 2. < minmargin) {
+      if(debug) std::cout << " marginal" << std::flush;
+      A.score = -4;                                   // failure
+      A.msg = " marginal_step+ratio";
+   }
+
+   // test 2. ratio is a local max
+   // test 3. sigma is a local min
+   // test 4. fsig > psig before and psig > fsig after
+   else if(!rmax || !smin || !fmp) {                           // maybe a slip
+      std::string msg;
+      if(!rmax) {
+         msg = "; no-ratio-max";
+         A.msg += msg + ratmsg;
+         if(debug) std::cout << msg;
+      }
+      if(!smin) {
+         msg = "; no-sig-min";
+         A.msg += msg + sigmsg;
+         if(debug) std::cout << msg;
+      }
+      if(!fmp) {
+         msg = "; no-f-p";
+         A.msg += msg + fmpmsg;
+         if(debug) std::cout << msg;
+      }
+      A.score = int(100.*weight+0.5);
+      A.msg += wtmsg;
+      if(debug) std::cout << std::flush;
+   }
+
+   else {                                                      // its a slip
+      A.msg = ";" + ratmsg + ";" + sigmsg + ";" + fmpmsg + wtmsg;
+      A.score = int(100.*weight+0.5);
+      isslip = true;
+   }
+
+   // near miss - "almost slip"
+   maybe = (!rmax || !smin || !fmp || A.score == -4);
+
+   // also see several lines above
+   if(debug) std::cout << " " << A.msg << std::endl;
+
+   return isslip;
+
+}  // end WindowFilterAnalyzer::test()
+
 //------------------------------------------------------------------------------------
 // analysis, with debug print
 // test 1a. ratio must be > minratio (2)
@@ -809,214 +1082,30 @@ template<class T> int WindowFilter<T>::analyze(void)
       results.push_back(fe);
    }
    int curr(0);
-   size_t i,j;
-   double tmp;
+   size_t i;
+   bool maybe;
 
-   // ratio(step/sigma), its 1st diff, sigma, its 1st diff, future minus past sigma
-   std::deque<double> rat,rat1d,sig,sig1d,fminusp;
-   // messages added to analvec[i].msg;
-   std::string ratmsg,sigmsg,fmpmsg,wtmsg;
+   // the deques of ratio, sigma and f-p, and the tests on them
+   WindowFilterAnalyzer<T> anal(halfwidth, minratio, minstep, minmargin,
+                                twoSample, debug, osw, osp);
 
    if(debug) std::cout << "WF:ANL size is " << analvec.size() << std::endl;
    for(i=0; i<analvec.size(); i++) {    // loop over arrays
 
       // 'prime the pump' for the deques
-      if(i==0) {
-         for(j=0; j<halfwidth; j++) {
-            rat.push_back(0.0); sig.push_back(0.0); fminusp.push_back(0.0);
-         }
-         for(j=0; (j<=halfwidth && j<analvec.size()); j++) {
-            rat.push_back(::fabs(analvec[j].step/analvec[j].sigma)); // ratio
-            sig.push_back(analvec[j].sigma);                         // sigma
-            fminusp.push_back(analvec[j].fsig - analvec[j].psig);    // fsig - psig
-         }
-         for(j=0; j<2*halfwidth; j++) { rat1d.push_back(0.0); sig1d.push_back(0.0); }
-      }
+      if(i==0) anal.prime(analvec);
 
       // update the deques
-      else if(i+halfwidth < analvec.size()) {
-         // fill deques
-         tmp = rat.back();                      // ratio
-         rat.push_back(::fabs(analvec[i+halfwidth].step/analvec[i+halfwidth].sigma));
-         rat1d.push_back(rat.back()-tmp);       // and its first diff
-         tmp = sig.back();                      // sigma
-         sig.push_back(analvec[i+halfwidth].sigma);
-         sig1d.push_back(sig.back()-tmp);       // and sig first diff
-         // fsig - psig .. no first diff
-         fminusp.push_back(analvec[i+halfwidth].fsig - analvec[i+halfwidth].psig);
-      }
-
-      // keep deques size 2*half+1
-      while(rat.size() > 2*halfwidth+1) {
-         rat.pop_front(); sig.pop_front(); fminusp.pop_front();
-      }
-      // keep 1st difference deques size 2*half
-      while(rat1d.size() > 2*halfwidth) { rat1d.pop_front(); sig1d.pop_front(); }
-
-      // test min/max in ratio, sig and fmp of the form +,+,+,any,-,-,-
-      bool rmax=true, smin=true, fmp=true;
-      int fmpcount(2*halfwidth);
-      double fmp0(fminusp[halfwidth]);
-      double rat0(::fabs(rat[halfwidth]));
-      for(j=0; j<halfwidth; j++) {
-         // test is that ratio is at maximum - so 1st dif is +,+,+,-,-,-
-         //                                              j=  0 1 2 h h+1 h+2
-         if(j == halfwidth-1) {
-            if(rat1d[j] < 0.0) rmax=false;
-            if(rat1d[j+halfwidth] > 0.0) rmax=false;
-         }
-         else {
-            if(rat1d[j] < -rat0/10.0) rmax=false;
-            if(rat1d[j+halfwidth] > rat0/10.0) rmax=false;
-         }
-
-         //if(rat1d[j] > 0.0) rmin=false; else
-         //if(rat1d[j+halfwidth] < 0.0) rmin=false; else
-
-         if(fminusp[j]-fmp0 < 0.0)             { fmp=false; fmpcount--; }
-         if(fminusp[j+halfwidth+1]-fmp0 > 0.0) { fmp=false; fmpcount--; }
-      }
-
-      // if(twoSample) same as 1-samp when there's no gap, but with gap its different
-      //       - see toy.gf.gap - looks like 2 limp clotheslines on big poles
-      //       +small,+verysmall,-big,(slim),+big,-verysmall,-small
-      //  sig1d[] 0     1         h-1         h      h+1      h+2
-      double slim(0.04*analvec[i].sigma);    // 5/16, was 0.02   // why 0.04?
-      if(twoSample) {
-         smin = true;
-         if(-sig1d[halfwidth-1]/slim < 2.0) smin=false;
-         else if(sig1d[halfwidth]/slim < 2.0) smin=false;
-         else for(j=0; j<halfwidth-1; j++) {
-            if(::fabs(sig1d[j]/sig1d[halfwidth-1]) > 0.5) smin=false;
-            if(::fabs(sig1d[halfwidth+1+j]/sig1d[halfwidth]) > 0.5) smin=false;
-         }
-      }
-      else {
-         for(j=0; j<halfwidth; j++) {
-            // for 1-sample, test is sigma is at minimum - so 1st dif is -,-,-,*,+,+,+
-            if(sig1d[j] > slim) smin=false;
-            if(sig1d[j+halfwidth] < -slim) smin=false;
-         }
-      }
-
-      // make this configurable?
-      if(2*halfwidth-fmpcount <= halfwidth/3) fmp=true;
-
-      // define a weight [0,1], used in score but only if it passes first tests
-      double weight=(rmax ? 0.25:0)+(smin ? 0.25:0)+0.5*fmpcount/double(2*halfwidth);
-
-      // dump all the deque to a string, for debug and dumpAnalMsg (verbose) output
-      {
-         std::ostringstream oss;
-         oss << " F-P" << std::fixed << std::setprecision(3);
-         for(j=0; j<fminusp.size(); j++) oss << "," << fminusp[j]-fmp0;
-         oss << ",cnt=" << fmpcount << "/" << 2*halfwidth;
-         fmpmsg = oss.str();
-         oss.str("");
-         oss << " RAT1d" << std::fixed << std::setprecision(3);
-         for(j=0; j<rat1d.size(); j++) oss << "," << rat1d[j];
-         ratmsg = oss.str();
-         oss.str("");
-         oss << " SIG1d" << std::scientific << std::setprecision(1);
-         for(j=0; j<sig1d.size(); j++) oss << "," << sig1d[j];
-         oss << ",(" << slim << ")";
-         sigmsg = oss.str();
-         oss.str("");
-         if(weight > 0) {
-            if(tmp)
-               oss << " changeF-P " << std::scientific << std::setprecision(2) << tmp;
-            oss << " wt=" << std::fixed << std::setprecision(3) << weight;
-         }
-         wtmsg = oss.str();
-      }
+      else if(i+halfwidth < analvec.size()) anal.push(analvec[i+halfwidth]);
 
       // count it; only good data gets into analvec
       results[curr].ngood++;
 
-      // debug print - also see single line below near end of routine
-      if(debug) std::cout << "WF:ANL"
-         << " " << std::setw(3) << i << " " << std::setw(3) << analvec[i].index
-         << std::fixed << std::setprecision(osp) << std::setw(osw)
-            << " " << (noxdata ? T(analvec[i].index) : xdata[analvec[i].index])
-         << " " << std::setw(osw) << data[analvec[i].index]
-         << " " << std::setw(osw) << analvec[i].step
-         << " " << std::setw(osw) << analvec[i].sigma
-         << " " << std::setw(3) << analvec[i].pN
-         << " " << std::setw(osw) << analvec[i].pave
-         << " " << std::setw(osw) << analvec[i].psig
-         << " " << std::setw(3) << analvec[i].fN
-         << " " << std::setw(osw) << analvec[i].fave
-         << " " << std::setw(osw) << analvec[i].fsig
-         << " " << std::setw(osw) << ::fabs(analvec[i].step/analvec[i].sigma)
-         << ratmsg << sigmsg << fmpmsg << wtmsg
-         << std::flush;
-
-      // ---------------------- do the tests ----------------------
-      // test 1a. ratio must be > minratio(2)
-      if(::fabs(analvec[i].step/analvec[i].sigma) <= minratio) {
-         if(debug) std::cout << " small ratio" << std::flush;
-         analvec[i].score = -3;                                   // failure
-         analvec[i].msg = " small_ratio";
-      }
-
-      // test 1b. step must be > 0.8
-      else if(::fabs(analvec[i].step) < minstep) {
-         if(debug) std::cout << " small step" << std::flush;
-         analvec[i].score = -2;                                   // failure
-         analvec[i].msg = " small_step";
-      }
-      
-      // its too early - before we can compute score
-      // usually ratio|step will be small, so not reach here
-      else if(i==0) {
-         if(debug) std::cout << " begin" << std::flush;
-         analvec[i].score = -1;                                   // failure
-         analvec[i].msg = " i=0_no_tests";
-      }
-
-      // approaching the end
-      else if(i==analvec.size()-1) {
-         if(debug) std::cout << " end" << std::flush;
-         analvec[i].score = -1;                                   // failure
-         analvec[i].msg = " i=end_no_tests";
-      }
-
-      // test 1c. exclude case where step AND ratio are very close to limit
-      else if(::fabs(analvec[i].step/analvec[i].sigma) / minratio
-         + ::fabs(analvec[i].step) / minstep - 2. < minmargin) {
-         if(debug) std::cout << " marginal" << std::flush;
-         analvec[i].score = -4;                                   // failure
-         analvec[i].msg = " marginal_step+ratio";
-      }
-
-      // test 2. ratio is a local max
-      // test 3. sigma is a local min
-      // test 4. fsig > psig before and psig > fsig after
-      else if(!rmax || !smin || !fmp) {                           // maybe a slip
-         std::string msg;
-         if(!rmax) {
-            msg = "; no-ratio-max";
-            analvec[i].msg += msg + ratmsg;
-            if(debug) std::cout << msg;
-         }
-         if(!smin) {
-            msg = "; no-sig-min";
-            analvec[i].msg += msg + sigmsg;
-            if(debug) std::cout << msg;
-         }
-         if(!fmp) {
-            msg = "; no-f-p";
-            analvec[i].msg += msg + fmpmsg;
-            if(debug) std::cout << msg;
-         }
-         analvec[i].score = int(100.*weight+0.5);
-         analvec[i].msg += wtmsg;
-         if(debug) std::cout << std::flush;
-      }
-
-      else {                                                      // its a slip
-         analvec[i].msg = ";" + ratmsg + ";" + sigmsg + ";" + fmpmsg + wtmsg;
-         analvec[i].score = int(100.*weight+0.5);
+      // do the tests
+      if(anal.test(analvec[i], i, i==0, i==analvec.size()-1,
+                   (noxdata ? T(analvec[i].index) : xdata[analvec[i].index]),
+                   data[analvec[i].index], maybe))
+      {                                                           // its a slip
          results[curr].ngood--;
          results[curr].npts = analvec[i].index - results[curr].index;
          FilterHit<T> fe;
@@ -1030,7 +1119,7 @@ template<class T> int WindowFilter<T>::analyze(void)
          results.push_back(fe); curr++;
       }
 
-      if(!rmax || !smin || !fmp || analvec[i].score == -4) {   // maybe a slip
+      if(maybe) {                                                 // maybe a slip
          // save the "almost slip" - TD add flag to turn this on
          FilterNearMiss<T> fnm;
          fnm.index = analvec[i].index;
@@ -1041,9 +1130,6 @@ template<class T> int WindowFilter<T>::analyze(void)
          maybes.push_back(fnm);
       }
 
-      // also see several lines above
-      if(debug) std::cout << " " << analvec[i].msg << std::endl;
-
    }  // end loop over analvec array
 
    // define npts for the last segment
@@ -1176,3 +1262,275 @@ void WindowFilter<T>::getStats(FilterHit<T>& sg, bool skip)
 
 // end template <class T> class WindowFilter
 
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+/// An online (streaming) version of WindowFilter: data are added one point at a time
+/// and slips are reported as soon as they can be decided, without storing the
+/// timeseries. The past and future panes are slid with StatsFilterBase::Add() and
+/// Subtract(), and the analysis tests are those of WindowFilter::analyze() (see
+/// WindowFilterAnalyzer), so each point costs O(1) (O(halfwidth) for the tests).
+///    The windows are always full, as in WindowFilter with setFullWindows(true).
+/// A point is analyzed once width points at and after it have been added, and it
+/// is tested once halfwidth more points have been analyzed; thus a slip is
+/// reported width+halfwidth-1 points after it occurs. Call flush() at the end of
+/// the data to test the remaining analyzed points.
+///    Points are numbered by the order in which they are added; call skip() for a
+/// point that is not to be filtered (e.g. flagged) to keep this numbering parallel
+/// to the caller's arrays. Indexes in the FilterHit are these numbers.
+/// Memory use is 2*width+buffsize+halfwidth points, independent of the data length.
+template <class T> class OnlineWindowFilter
+{
+public:
+   typedef typename WindowFilter<T>::Analysis Analysis;
+
+   /// constructor
+   /// @param w width, the number of points in each pane of the window
+   /// @param two if true use two-sample statistics, else one-sample
+   /// @param b buffer size, number of points ignored between past and future
+   OnlineWindowFilter(unsigned int w=20, bool two=false, unsigned int b=0)
+      : width(w), twoSample(two), buffsize(b)
+   {
+      minratio = T(2.0);
+      minstep = T(0.8);
+      minmargin = T(0.5);
+      halfwidth = 3;
+      if(twoSample) {
+         ptrPast = new TwoSampleStatsFilter<T>();
+         ptrFuture = new TwoSampleStatsFilter<T>();
+      }
+      else {
+         ptrPast = new OneSampleStatsFilter<T>();
+         ptrFuture = new OneSampleStatsFilter<T>();
+      }
+      anal = NULL;
+      reset();
+   }
+
+   /// destructor
+   ~OnlineWindowFilter()
+   {
+      delete ptrPast;
+      delete ptrFuture;
+      delete anal;
+   }
+
+   /// get and set analysis configuration; set these before adding data
+   inline void setMinRatio(T val) { minratio=val; }
+   inline void setMinStep(T val) { minstep=val; }
+   inline void setMinMargin(T val) { minmargin=val; }
+   inline void setHalfWidth(int hw) { halfwidth=hw; }
+   inline T getMinRatio(void) { return minratio; }
+   inline T getMinStep(void) { return minstep; }
+   inline T getMinMargin(void) { return minmargin; }
+   inline int getHalfWidth(void) { return halfwidth; }
+   inline int getWidth(void) { return width; }
+   inline int getBufferSize(void) { return buffsize; }
+   inline bool isTwoSample(void) { return twoSample; }
+
+   /// clear all data and results, and start again with point number 0
+   void reset(void)
+   {
+      ptrPast->Reset();
+      ptrFuture->Reset();
+      window.clear();
+      pending.clear();
+      pendingxd.clear();
+      hits.clear();
+      count = ntested = nbuff = 0;
+      primed = false;
+      delete anal;
+      anal = NULL;
+   }
+
+   /// add the next point
+   /// @param x 'time' value, required for two-sample stats, else used only in debug
+   /// @param d data value
+   /// @return the number of FilterHit waiting in getHits()
+   int add(const T& x, const T& d);
+
+   /// skip the next point; it is counted but not filtered
+   inline void skip(void) { count++; }
+
+   /// test the remaining analyzed points; call at the end of data
+   /// @return the number of FilterHit waiting in getHits()
+   int flush(void);
+
+   /// get the slips found since the last call; each has type slip, ngood 1,
+   /// and npts 0 (the segment length is not known until the next slip).
+   std::vector< FilterHit<T> > getHits(void)
+   {
+      std::vector< FilterHit<T> > ret(hits.begin(),hits.end());
+      hits.clear();
+      return ret;
+   }
+
+   /// number of points added or skipped
+   inline unsigned int getCount(void) { return count; }
+   /// number of points analyzed and tested
+   inline unsigned int getNumberTested(void) { return ntested; }
+
+private:
+
+   /// one point in the sliding window
+   struct Point {
+      T x,d;
+      unsigned int index;
+   };
+
+   /// not copyable, it owns the stats filters
+   OnlineWindowFilter(const OnlineWindowFilter&);
+   OnlineWindowFilter& operator=(const OnlineWindowFilter&);
+
+   /// compute the Analysis at the first point of the future window
+   void analyzePoint(void);
+
+   /// test the first pending point
+   void testPoint(bool last);
+
+   // configuration
+   unsigned int width;           ///< width or number of points in (1 pane of) window
+   bool twoSample;               ///< if true, use two-sample statistics
+   unsigned int buffsize;        ///< number of good points ignored btwn past, future
+   unsigned int halfwidth;       ///< number of points on either side of slip analyzed
+   T minratio;                   ///< ratio=|step/sig| < this is not a slip
+   T minstep;                    ///< |step|(=fut ave - past ave) < this is not slip
+   T minmargin;                  ///< limit on step/minstep+ratio/minratio-2
+
+   // state
+   StatsFilterBase<T> *ptrPast, *ptrFuture;  ///< stats on the two panes
+   std::deque<Point> window;     ///< points in past, buffer and future, in order
+   unsigned int nbuff;           ///< number of points in the buffer
+   unsigned int count;           ///< number of points added or skipped
+   unsigned int ntested;         ///< number of points tested
+   bool primed;                  ///< true once the analyzer deques are primed
+   WindowFilterAnalyzer<T> *anal;///< deques and tests, created on first analysis
+   std::deque<Analysis> pending; ///< analyzed points not yet tested, in order
+   std::deque< std::pair<T,T> > pendingxd;   ///< (x,d) parallel to pending
+   std::deque< FilterHit<T> > hits;          ///< slips not yet returned
+
+}; // end class OnlineWindowFilter
+
+//------------------------------------------------------------------------------------
+template<class T> int OnlineWindowFilter<T>::add(const T& x, const T& d)
+{
+   // --------------------------------------------------------------------------
+   // window: (past, width pts)(buffer, buffsize pts)(future, width pts)
+   // add to the future; when it overflows move its first point to the buffer,
+   // the buffer's first to the past, and drop the oldest point from the past.
+   // --------------------------------------------------------------------------
+   Point pt;
+   pt.x = x; pt.d = d; pt.index = count++;
+   window.push_back(pt);
+   ptrFuture->Add(x,d);
+
+   if(ptrFuture->N() > width) {
+      const Point& f(window[window.size()-1-width]);
+      ptrFuture->Subtract(f.x,f.d);
+      if(++nbuff > buffsize) {
+         const Point& p(window[window.size()-width-buffsize-1]);
+         ptrPast->Add(p.x,p.d);
+         nbuff--;
+         if(ptrPast->N() > width) {
+            ptrPast->Subtract(window.front().x,window.front().d);
+            window.pop_front();
+         }
+      }
+   }
+
+   // analyze the first point in the future when both panes are full
+   if(ptrPast->N() == width && ptrFuture->N() == width) analyzePoint();
+
+   return hits.size();
+}
+
+//------------------------------------------------------------------------------------
+template<class T> void OnlineWindowFilter<T>::analyzePoint(void)
+{
+   const Point& curr(window[width+nbuff]);
+   const Point& prev(window[width+nbuff-1]);
+
+   Analysis A;
+   A.index = curr.index;
+   A.pN = ptrPast->N();
+   A.fN = ptrFuture->N();
+   // assume slip happens at midpt of interval (this can matter with gaps)
+   T xmid(prev.x + 0.5*(curr.x-prev.x));
+   A.pave = ptrPast->Evaluate(xmid);
+   A.fave = ptrFuture->Evaluate(xmid);
+   A.step = A.fave - A.pave;
+
+   // sigmas, as in WindowFilter::filter()
+   A.psig = ptrPast->Variance();
+   A.fsig = ptrFuture->Variance();
+   if(A.psig <= T(0) && A.fsig <= T(0))
+      A.psig = A.fsig = T(1);
+   else if(A.psig <= T(0))
+      A.psig = A.fsig = ::sqrt(A.fsig);
+   else if(A.fsig <= T(0))
+      A.psig = A.fsig = ::sqrt(A.psig);
+   else {
+      A.psig = ::sqrt(A.psig);
+      A.fsig = ::sqrt(A.fsig);
+   }
+   A.sigma = ::sqrt((ptrFuture->Variance()+ptrPast->Variance())/T(2.0));
+
+   pending.push_back(A);
+   pendingxd.push_back(std::make_pair(curr.x,curr.d));
+
+   // test the point halfwidth before this one
+   if(!primed) {
+      if(pending.size() < halfwidth+1) return;
+      anal = new WindowFilterAnalyzer<T>(halfwidth, minratio, minstep, minmargin,
+                                         twoSample);
+      anal->prime(pending);
+      primed = true;
+   }
+   else
+      anal->push(A);
+
+   testPoint(false);
+}
+
+//------------------------------------------------------------------------------------
+template<class T> void OnlineWindowFilter<T>::testPoint(bool last)
+{
+   bool maybe;
+   Analysis& A(pending.front());
+   if(anal->test(A, ntested, ntested==0, last,
+                 pendingxd.front().first, pendingxd.front().second, maybe))
+   {
+      FilterHit<T> fe;
+      fe.type = FilterHit<T>::slip;
+      fe.index = A.index;
+      fe.npts = 0;
+      fe.ngood = 1;
+      fe.step = A.step;
+      fe.sigma = A.sigma;
+      fe.score = A.score;
+      fe.msg = A.msg;
+      hits.push_back(fe);
+   }
+   ntested++;
+   pending.pop_front();
+   pendingxd.pop_front();
+}
+
+//------------------------------------------------------------------------------------
+template<class T> int OnlineWindowFilter<T>::flush(void)
+{
+   if(pending.empty()) return hits.size();
+
+   if(!primed) {
+      anal = new WindowFilterAnalyzer<T>(halfwidth, minratio, minstep, minmargin,
+                                         twoSample);
+      anal->prime(pending);
+      primed = true;
+   }
+
+   // as at the end in WindowFilter::analyze(), the deques are not updated
+   while(!pending.empty()) testPoint(pending.size() == 1);
+
+   return hits.size();
+}
+
+// end template <class T> class OnlineWindowFilter
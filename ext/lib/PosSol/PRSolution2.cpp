@@ -547,16 +547,12 @@ namespace gpstk
          tx = Tr;
          tx -= Pseudorange[i]/C_MPS;
             // get ephemeris range, etc
-         try
-         {
-            PVT = Eph.getXvt(Satellite[i], tx);
-         }
-         catch(InvalidRequest& e)
+         if(!Eph.computeXvt(Satellite[i], tx, PVT))
          {
-            ///Negate SatID because getXvt failed.
+            ///Negate SatID because there is no ephemeris.
             #ifdef DEBUG_PRINT_WARNINGS
-               cout << "Eph.getXvt(Satellite[" << i << "], tx); threw InvalidRequest:" << endl;
-               cout << e << endl << endl;
+               cout << "Eph.computeXvt(Satellite[" << i << "], tx) failed"
+                    << endl << endl;
             #endif
             Satellite[i].id = -::abs(Satellite[i].id);
                if(pDebugStream) *pDebugStream
@@ -567,13 +563,9 @@ namespace gpstk
          
             // update transmit time and get ephemeris range again
          tx -= PVT.clkbias + PVT.relcorr;     // clk+rel
-         try
-         {
-            PVT = Eph.getXvt(Satellite[i], tx);
-         }
-         catch(InvalidRequest& e)
+         if(!Eph.computeXvt(Satellite[i], tx, PVT))
          {
-            ///Negate SatID because getXvt failed.
+            ///Negate SatID because there is no ephemeris.
             Satellite[i].id = -::abs(Satellite[i].id);
             continue;
          }
@@ -0,0 +1,213 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <vector>
+
+#include "MultiPCodeGen.hpp"
+#include "SVPCodeGen.hpp"
+#include "GPSWeekZcount.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class MultiPCodeGen_T
+{
+public:
+   MultiPCodeGen_T()
+         : week(1950)
+   {
+      gpstk::X1Sequence::allocateMemory();
+      gpstk::X2Sequence::allocateMemory();
+      prns.push_back(1);
+      prns.push_back(24);
+      prns.push_back(37);
+      prns.push_back(38);
+      prns.push_back(210);
+   }
+
+   ~MultiPCodeGen_T()
+   {
+      gpstk::X1Sequence::deAllocateMemory();
+      gpstk::X2Sequence::deAllocateMemory();
+   }
+
+      /// Six seconds of code from SVPCodeGen for each PRN.
+   void reference(long zcount, vector< vector<uint32_t> >& ref)
+   {
+      ref.resize(prns.size());
+      gpstk::CodeBuffer pcb(1);
+      for (size_t k = 0; k < prns.size(); k++)
+      {
+         gpstk::SVPCodeGen gen(prns[k], gpstk::GPSWeekZcount(week, zcount));
+         gen.getCurrentSixSeconds(pcb);
+         ref[k].resize(gpstk::NUM_6SEC_WORDS + 1);
+         for (long i = 0; i < gpstk::NUM_6SEC_WORDS; i++)
+            ref[k][i] = pcb[i];
+      }
+   }
+
+      /// The 32 chips starting at chip of a stream of words.
+   static uint32_t wordAt(const vector<uint32_t>& stream, long chip)
+   {
+      long ndx = chip / 32;
+      int bit = chip % 32;
+      return bit ? merge(stream[ndx], stream[ndx+1], bit) : stream[ndx];
+   }
+
+      /// Generate numWords words for every PRN.
+   void generate(gpstk::MultiPCodeGen& gen, long numWords,
+                 vector< vector<uint32_t> >& code)
+   {
+      code.assign(prns.size(), vector<uint32_t>(numWords));
+      vector<uint32_t*> out;
+      for (size_t k = 0; k < prns.size(); k++)
+         out.push_back(&code[k][0]);
+      gen.getChips(&out[0], numWords);
+   }
+
+      /// Whole six second intervals must match SVPCodeGen.
+   unsigned sixSecondTest()
+   {
+      TUDEF("MultiPCodeGen", "getChips");
+         // beginning of week, mid-week and end of week
+      long zcounts[] = { 0, 4000, 403196 };
+      for (int z = 0; z < 3; z++)
+      {
+         vector< vector<uint32_t> > ref, code;
+         reference(zcounts[z], ref);
+         gpstk::MultiPCodeGen gen(prns, gpstk::GPSZcount(week, zcounts[z]));
+         generate(gen, gpstk::NUM_6SEC_WORDS, code);
+         for (size_t k = 0; k < prns.size(); k++)
+         {
+            long bad = 0;
+            for (long i = 0; i < gpstk::NUM_6SEC_WORDS; i++)
+               if (code[k][i] != ref[k][i])
+                  bad++;
+            TUASSERTE(long, 0, bad);
+         }
+      }
+      TURETURN();
+   }
+
+      /** Code generated from any Z-count or chip must be the code
+       * generated from the previous four Z-count boundary, including
+       * across the end of an interval and of the week. */
+   unsigned seekTest()
+   {
+      TUDEF("MultiPCodeGen", "setCurrentChip");
+      vector< vector<uint32_t> > ref, refNext, code;
+      reference(403196, ref);
+      week++;
+      reference(0, refNext);
+      week--;
+         // the last six seconds of the week, then the first
+      for (size_t k = 0; k < prns.size(); k++)
+      {
+         ref[k].pop_back();
+         ref[k].insert(ref[k].end(), refNext[k].begin(), refNext[k].end());
+      }
+
+      gpstk::MultiPCodeGen gen(prns, gpstk::GPSZcount(week, 4000));
+      long starts[] = { 1, 2, 3 };
+      for (int z = 0; z < 3; z++)
+      {
+         gen.setCurrentZCount(gpstk::GPSZcount(week, 403196 + starts[z]));
+         TUASSERTE(long, 403196 + starts[z],
+                   gen.getCurrentZCount().getZcount());
+            // through the end of the week and 1000 words beyond
+         long numWords = (4 - starts[z]) * gpstk::CHIPS_PER_ZCOUNT / 32 + 1000;
+         generate(gen, numWords, code);
+         long bad = 0;
+         for (size_t k = 0; k < prns.size(); k++)
+            for (long i = 0; i < numWords; i++)
+               if (code[k][i] != wordAt(ref[k], starts[z] *
+                                        gpstk::CHIPS_PER_ZCOUNT + 32 * i))
+                  bad++;
+         TUASSERTE(long, 0, bad);
+      }
+      TUASSERTE(short, week + 1, gen.getCurrentZCount().getWeek());
+
+         // arbitrary chips, in pieces of odd sizes
+      long chips[] = { 5, 12345677, 61379990 };
+      for (int c = 0; c < 3; c++)
+      {
+         gen.setCurrentChip(gpstk::GPSZcount(week, 403196), chips[c]);
+         TUASSERTE(long, chips[c] % gpstk::CHIPS_PER_ZCOUNT,
+                   gen.getChipOfZCount());
+         long bad = 0;
+         long chip = chips[c];
+         for (long numWords = 1; numWords < 5000; numWords += 777)
+         {
+            generate(gen, numWords, code);
+            for (size_t k = 0; k < prns.size(); k++)
+               for (long i = 0; i < numWords; i++)
+                  if (code[k][i] != wordAt(ref[k], chip + 32 * i))
+                     bad++;
+            chip += 32 * numWords;
+         }
+         TUASSERTE(long, 0, bad);
+      }
+
+      try
+      {
+         vector<int> bad(1, 211);
+         gpstk::MultiPCodeGen badGen(bad, gpstk::GPSZcount(week, 0));
+         TUFAIL("Expected an exception for PRN 211");
+      }
+      catch (gpstk::Exception&)
+      {
+         TUPASS("PRN 211");
+      }
+      TURETURN();
+   }
+
+private:
+   short week;
+   vector<int> prns;
+};
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   MultiPCodeGen_T testClass;
+
+   errorTotal += testClass.sixSecondTest();
+   errorTotal += testClass.seekTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
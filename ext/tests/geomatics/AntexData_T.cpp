@@ -0,0 +1,208 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file AntexData_T.cpp  Test the gridded PCV interpolation of AntexData
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "AntexData.hpp"
+#include "AntennaStore.hpp"
+#include "TestUtil.hpp"
+#include "GeomaticsTestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class AntexData_T
+{
+public:
+   AntexData_T() : rng(4321) {}
+
+      /// Build a valid antenna with random PCVs on the ANTEX grid: zenith
+      /// angles zen1 to zen2 by dzen; if dazi > 0, azimuths 0 to lastAzim
+      /// by dazi as well as the NOAZI table.
+   AntexData makeAntenna(bool isRx, double zen1, double zen2, double dzen,
+                         double dazi, double lastAzim)
+   {
+      AntexData ant;
+      ant.valid = AntexData::allValid13;
+      ant.isRxAntenna = isRx;
+      ant.type = (isRx ? "TESTANT" : "BLOCK IIR-M");
+      ant.azimDelta = dazi;
+      ant.zenRange[0] = zen1;
+      ant.zenRange[1] = zen2;
+      ant.zenRange[2] = dzen;
+      ant.nFreq = 2;
+      const char *freqs[2] = { "G01", "G02" };
+      for(int f=0; f<2; f++) {
+         AntexData::antennaPCOandPCVData& pcv(ant.freqPCVmap[freqs[f]]);
+         for(int i=0; i<3; i++) pcv.PCOvalue[i] = pcv.PCOrms[i] = 0.0;
+         pcv.hasAzimuth = (dazi > 0.0);
+         int nzen(1 + int((zen2-zen1)/dzen));
+         for(int j=0; j<nzen; j++)
+            pcv.PCVvalue[-1.0][zen1 + j*dzen] = 20.*rng.next() - 10.;
+         if(dazi > 0.0)
+            for(int k=0; k <= int(lastAzim/dazi); k++)
+               for(int j=0; j<nzen; j++)
+                  pcv.PCVvalue[k*dazi][zen1 + j*dzen] = 20.*rng.next() - 10.;
+      }
+      return ant;
+   }
+
+      /// Compare getPhaseCenterVariation() with and without the grids, and
+      /// getPhaseCenterVariations() with both, at random angles and on the
+      /// grid points of both axes.
+   void compare(TestUtil& testFramework, const AntexData& ant,
+                const string& what)
+   {
+      AntexData gridded(ant);
+      gridded.buildPCVGrids();
+
+      vector<double> az, el;
+      for(int i=0; i<2000; i++) {
+         az.push_back(720.*rng.next() - 360.);
+         el.push_back(90.*rng.next());
+      }
+      for(double a=-10.; a<=370.; a+=2.5)
+         for(double e=0.; e<=90.; e+=2.5) {
+            az.push_back(a);
+            el.push_back(e);
+         }
+
+      const char *freqs[2] = { "G01", "G02" };
+      for(int f=0; f<2; f++) {
+         vector<double> batch, batchMap;
+         gridded.getPhaseCenterVariations(freqs[f], az, el, batch);
+         ant.getPhaseCenterVariations(freqs[f], az, el, batchMap);
+         testFramework.assert(batch.size() == az.size(),
+                              what + " batch size", __LINE__);
+         double diff(0.0), bdiff(0.0);
+         for(size_t i=0; i<az.size(); i++) {
+            double pcv(ant.getPhaseCenterVariation(freqs[f], az[i], el[i]));
+            diff = max(diff, ::fabs(pcv -
+                        gridded.getPhaseCenterVariation(freqs[f], az[i], el[i])));
+            bdiff = max(bdiff, ::fabs(pcv - batch[i]));
+            bdiff = max(bdiff, ::fabs(pcv - batchMap[i]));
+         }
+         testFramework.assert(diff < 1.e-12, what + " grid differs from map",
+                              __LINE__);
+         testFramework.assert(bdiff < 1.e-12, what + " batch differs from map",
+                              __LINE__);
+      }
+   }
+
+   unsigned gridTest()
+   {
+      TUDEF("AntexData", "PCVGrid");
+
+         // receiver, azimuth dependent, ANTEX azimuths 0 to 360
+      compare(testFramework, makeAntenna(true, 0., 90., 5., 5., 360.),
+              "receiver 0-360");
+         // azimuths that stop short of 360, so the search wraps around
+      compare(testFramework, makeAntenna(true, 0., 90., 5., 5., 355.),
+              "receiver 0-355");
+         // receiver, NOAZI only
+      compare(testFramework, makeAntenna(true, 0., 90., 5., 0., 0.),
+              "receiver NOAZI");
+         // satellite, nadir angles 0 to 14, beyond which the end value is used
+      compare(testFramework, makeAntenna(false, 0., 14., 1., 0., 0.),
+              "satellite NOAZI");
+      compare(testFramework, makeAntenna(false, 0., 17., 1., 10., 360.),
+              "satellite azimuth");
+
+      TURETURN();
+   }
+
+   unsigned storeTest()
+   {
+      TUDEF("AntennaStore", "getPhaseCenterVariations");
+
+      AntexData ant(makeAntenna(true, 0., 90., 5., 5., 360.));
+      AntennaStore store;
+      store.addAntenna(ant.name(), ant);
+
+      vector<double> az, el, pcv;
+      for(int i=0; i<100; i++) {
+         az.push_back(360.*rng.next());
+         el.push_back(90.*rng.next());
+      }
+      TUASSERT(store.getPhaseCenterVariations(ant.name(), "G02", az, el, pcv));
+      TUASSERTE(size_t, az.size(), pcv.size());
+      double diff(0.0);
+      for(size_t i=0; i<az.size(); i++)
+         diff = max(diff,
+                    ::fabs(pcv[i] - ant.getPhaseCenterVariation("G02",az[i],el[i])));
+      TUASSERT(diff < 1.e-12);
+
+      TUASSERT(!store.getPhaseCenterVariations("NO SUCH ANTENNA", "G02",
+                                               az, el, pcv));
+
+         // the checks of getPhaseCenterVariation() still apply
+      el[50] = 91.;
+      try {
+         store.getPhaseCenterVariations(ant.name(), "G02", az, el, pcv);
+         TUFAIL("No exception for an elevation out of range");
+      }
+      catch(Exception& e) {
+         TUPASS("Exception for an elevation out of range");
+      }
+      try {
+         store.getPhaseCenterVariations(ant.name(), "G05", az, el, pcv);
+         TUFAIL("No exception for a missing frequency");
+      }
+      catch(Exception& e) {
+         TUPASS("Exception for a missing frequency");
+      }
+
+      TURETURN();
+   }
+
+private:
+   TestRandom rng;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   AntexData_T testClass;
+   total += testClass.gridTest();
+   total += testClass.storeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
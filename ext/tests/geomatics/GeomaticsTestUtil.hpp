@@ -0,0 +1,78 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file GeomaticsTestUtil.hpp  Helpers shared by the geomatics tests
+
+#ifndef GPSTK_GEOMATICS_TEST_UTIL_HPP
+#define GPSTK_GEOMATICS_TEST_UTIL_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "Matrix.hpp"
+
+   /// A linear congruential generator, so test data are the same on every
+   /// platform, unlike std::rand().
+class TestRandom
+{
+public:
+   TestRandom(unsigned long s) : seed(s) {}
+
+      /// uniform in [0,1)
+   double next()
+   {
+      seed = (seed*1103515245UL + 12345UL) % 2147483648UL;
+      return double(seed)/2147483648.0;
+   }
+
+      /// uniform in [-1,1)
+   double nextSigned()
+   { return 2.0*next() - 1.0; }
+
+   unsigned long seed;
+};
+
+   /// largest absolute difference between two matrices of the same size
+inline double maxdiff(const gpstk::Matrix<double>& X,
+                      const gpstk::Matrix<double>& Y)
+{
+   double d(0.0);
+   for(unsigned i=0; i<X.rows(); i++)
+      for(unsigned j=0; j<X.cols(); j++)
+         d = std::max(d, std::fabs(X(i,j)-Y(i,j)));
+   return d;
+}
+
+#endif // GPSTK_GEOMATICS_TEST_UTIL_HPP
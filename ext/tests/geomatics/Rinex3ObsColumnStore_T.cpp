@@ -0,0 +1,217 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Rinex3ObsColumnStore_T.cpp  Test the columnar store of Rinex3ObsFileLoader
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+
+#include "Rinex3ObsColumnStore.hpp"
+#include "Rinex3ObsFileLoader.hpp"
+#include "CivilTime.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class Rinex3ObsColumnStore_T
+{
+public:
+   Rinex3ObsColumnStore_T()
+   {
+      filename = getPathData() + "/test_dfix_karr0880.ed.10o";
+   }
+
+      /// Fill a store by hand.
+   unsigned buildTest()
+   {
+      TUDEF("Rinex3ObsColumnStore", "addRecord");
+      Rinex3ObsColumnStore cs;
+      RinexSatID g1(1,SatID::systemGPS), g2(2,SatID::systemGPS);
+      CommonTime t0 = CivilTime(2010,3,29,0,0,0.0).convertToCommonTime();
+      RinexDatum rd;
+
+      TUASSERTE(unsigned, 0, cs.addObsType("GC1C"));
+      TUASSERTE(unsigned, 1, cs.addObsType("GL1C"));
+      TUASSERTE(unsigned, 0, cs.addObsType("GC1C"));
+      try {
+         cs.addRecord(g1);
+         TUFAIL("addRecord() outside an epoch did not throw");
+      }
+      catch(Exception& e) { TUPASS("addRecord() outside an epoch"); }
+
+         // 100 epochs, g1 in all, g2 (with L1 only) in the odd ones
+      for(int e=0; e<100; e++) {
+         cs.startEpoch(t0 + 30.0*e, 1.e-9*e);
+         unsigned int rec = cs.addRecord(g1);
+         rd.data = 1000.0 + e; rd.lli = 1; rd.ssi = 7;
+         cs.setDatum(rec, 0, rd);
+         rd.data = 2000.0 + e; rd.lli = 0; rd.ssi = 8;
+         cs.setDatum(rec, 1, rd);
+         if(e % 2) {
+            rec = cs.addRecord(g2);
+            rd.data = 3000.0 + e;
+            cs.setDatum(rec, 1, rd);
+         }
+         cs.endEpoch();
+      }
+         // an epoch without records is dropped
+      cs.startEpoch(t0 + 3000.0);
+      cs.endEpoch();
+
+      TUASSERTE(unsigned, 100, cs.numEpochs());
+      TUASSERTE(unsigned, 150, cs.numRecords());
+      TUASSERTE(unsigned, 2, cs.numSats());
+      TUASSERTE(unsigned, 4, cs.epochBegin(3));
+      TUASSERTE(unsigned, 6, cs.epochEnd(3));
+      TUASSERT(cs.sat(5) == g2);
+      TUASSERTE(unsigned, 3, cs.epoch(5));
+      TUASSERTE(CommonTime, t0 + 30.0*99, cs.time(99));
+      TUASSERTE(double, 1.e-9*7, cs.clockOffset(7));
+      TUASSERTE(double, 2003.0, cs.value(1,4));
+      TUASSERTE(double, 3003.0, cs.value(1,5));
+      TUASSERT(!cs.isValid(0,5));
+      TUASSERT(cs.isValid(1,5));
+      TUASSERTE(unsigned short, 8, cs.SSI(1,4));
+      TUASSERTE(unsigned short, 1, cs.LLI(0,4));
+
+      TUCSM("satRecords");
+      int s2 = cs.satIndex(g2);
+      TUASSERTE(int, 1, s2);
+      TUASSERTE(int, -1, cs.satIndex(RinexSatID(3,SatID::systemGPS)));
+      const vector<unsigned int>& recs(cs.satRecords(s2));
+      TUASSERTE(size_t, 50, recs.size());
+      int nbad(0);
+      for(size_t i=0; i<recs.size(); i++)
+         if(cs.value(1,recs[i]) != 3000.0 + 2*i+1) nbad++;
+      TUASSERTE(int, 0, nbad);
+
+      TUCSM("addObsType");
+      TUASSERTE(unsigned, 2, cs.addObsType("GL2W"));
+      unsigned int nvalid(0);
+      for(unsigned int rec=0; rec<cs.numRecords(); rec++)
+         if(cs.isValid(2,rec)) nvalid++;
+      TUASSERTE(unsigned, 0, nvalid);
+      TUASSERTE(size_t, 150, cs.dataColumn(2).size());
+      TUASSERTE(size_t, 3, cs.validColumn(2).size());
+
+      TURETURN();
+   }
+
+      /// The column store must hold the same data as the Rinex3ObsData store.
+   unsigned loaderTest()
+   {
+      TUDEF("Rinex3ObsFileLoader", "saveColumns");
+      Rinex3ObsFileLoader rows(filename), cols(filename);
+      const char *ids[4] = { "GC1*", "GL1*", "GL2*", "GP2*" };
+      for(int i=0; i<4; i++) {
+         rows.loadObsID(ids[i]);
+         cols.loadObsID(ids[i]);
+      }
+      rows.saveTheData(true);
+      cols.saveTheData(true);
+      cols.saveColumns(true);
+      string errs, msg;
+      TUASSERTE(int, 1, rows.loadFiles(errs,msg));
+      TUASSERTE(int, 1, cols.loadFiles(errs,msg));
+
+      TUASSERT(rows.getStoreSize() > 100);
+      TUASSERTE(int, rows.getStoreSize(), cols.getStoreSize());
+      TUASSERTE(size_t, 0, cols.getStore().size());
+
+      ostringstream oss1, oss2;
+      rows.dumpStoreData(oss1);
+      cols.dumpStoreData(oss2);
+      TUASSERTE(string, oss1.str(), oss2.str());
+
+         // valid bits agree with the counts
+      const Rinex3ObsColumnStore& cs(cols.getColumnStore());
+      const vector<int> counts(cols.getTotalObsCounts());
+      TUASSERTE(unsigned, counts.size(), cs.numObsTypes());
+      for(unsigned int k=0; k<cs.numObsTypes(); k++) {
+         int n(0);
+         for(unsigned int rec=0; rec<cs.numRecords(); rec++)
+            if(cs.isValid(k,rec)) n++;
+         TUASSERTE(int, counts[k], n);
+      }
+
+      TUCSM("WriteSatPassList");
+      map<char, vector<string> > sysSPOT;
+      map<char, vector<int> > indexLoadOT;
+      const char *ots[4] = { "C1", "L1", "L2", "P2" };
+      for(int i=0; i<4; i++) {
+         sysSPOT['G'].push_back(ots[i]);
+         indexLoadOT['G'].push_back(i);
+      }
+      vector<SatPass> splRows, splCols;
+      int n = rows.WriteSatPassList(sysSPOT, indexLoadOT, splRows);
+      TUASSERT(n > 0);
+      TUASSERTE(int, n, cols.WriteSatPassList(sysSPOT, indexLoadOT, splCols));
+      int ndiff(0);
+      for(size_t i=0; i<splRows.size() && i<splCols.size(); i++) {
+         if(splRows[i].getSat() != splCols[i].getSat() ||
+            splRows[i].size() != splCols[i].size() ||
+            splRows[i].getFirstTime() != splCols[i].getFirstTime()) {
+            ndiff++; continue;
+         }
+         for(unsigned int j=0; j<splRows[i].size(); j++)
+            for(int k=0; k<4; k++)
+               if(splRows[i].data(j,ots[k]) != splCols[i].data(j,ots[k]))
+                  ndiff++;
+      }
+      TUASSERTE(int, 0, ndiff);
+
+      TURETURN();
+   }
+
+private:
+   string filename;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   Rinex3ObsColumnStore_T testClass;
+   total += testClass.buildTest();
+   total += testClass.loaderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
@@ -0,0 +1,133 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file SRIMatrixBench.cpp
+ * Compare the time taken by SrifMU with the unblocked and the blocked
+ * (compact WY) Householder kernels, for a range of state sizes N; the
+ * update uses N+N/2 measurements.
+ *
+ * Usage: SRIMatrixBench [-b blocksize] [N ...]
+ * With no N, sizes 10 to 2000 are timed.
+ */
+
+#include "SRIMatrix.hpp"
+#include "GeomaticsTestUtil.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+static TestRandom rng(1234);
+
+
+   /// Time one SrifMU of an n-state SRI with m measurements, returning
+   /// seconds; R, Z and A are overwritten.
+static double timeMU(Matrix<double>& R, Vector<double>& Z, Matrix<double>& A,
+                     unsigned nb)
+{
+   typedef chrono::steady_clock Clock;
+   Clock::time_point start = Clock::now();
+   SrifMU(R, Z, A, 0, nb);
+   return chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned nb = SrifMUBlockSize;
+   vector<unsigned> sizes;
+   for (int i = 1; i < argc; i++)
+   {
+      if (!strcmp(argv[i], "-b") && i+1 < argc)
+         nb = atoi(argv[++i]);
+      else
+         sizes.push_back(atoi(argv[i]));
+   }
+   if (sizes.empty())
+   {
+      const unsigned def[] = { 10, 20, 50, 100, 200, 500, 1000, 2000 };
+      sizes.assign(def, def + sizeof(def)/sizeof(def[0]));
+   }
+
+   cout << "block size " << nb << endl
+        << "     N     M  repeat   unblocked(s)     blocked(s)  speedup"
+        << "    max|dR|" << endl;
+   for (size_t s = 0; s < sizes.size(); s++)
+   {
+      unsigned n = sizes[s], m = n + n/2;
+      Matrix<double> R0(n, n, 0.0), A0(m, n+1);
+      Vector<double> Z0(n);
+      for (unsigned i = 0; i < n; i++)
+      {
+         R0(i,i) = 2.0 + rng.nextSigned();
+         for (unsigned j = i+1; j < n; j++)
+            R0(i,j) = rng.nextSigned();
+         Z0(i) = rng.nextSigned();
+      }
+      for (unsigned i = 0; i < m; i++)
+         for (unsigned j = 0; j <= n; j++)
+            A0(i,j) = rng.nextSigned();
+
+         // repeat small problems so the times are measurable
+      unsigned repeat = (n >= 500 ? 1 : 200000/(n*n) + 1);
+      double tu = 0.0, tb = 0.0, dR = 0.0;
+      for (unsigned r = 0; r < repeat; r++)
+      {
+         Matrix<double> Ru(R0), Au(A0), Rb(R0), Ab(A0);
+         Vector<double> Zu(Z0), Zb(Z0);
+         tu += timeMU(Ru, Zu, Au, 1);
+         tb += timeMU(Rb, Zb, Ab, nb);
+         if (r == 0)
+            for (unsigned i = 0; i < n; i++)
+               for (unsigned j = i; j < n; j++)
+                  dR = max(dR, ::fabs(Ru(i,j) - Rb(i,j)));
+      }
+      cout << setw(6) << n << setw(6) << m << setw(8) << repeat
+           << fixed << setprecision(6)
+           << setw(15) << tu/repeat << setw(15) << tb/repeat
+           << setprecision(2) << setw(9) << tu/tb
+           << scientific << setprecision(2) << setw(11) << dR << endl;
+   }
+   return 0;
+}
@@ -0,0 +1,145 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file SRIMatrix_T.cpp  Test the blocked SrifMU against the unblocked one
+
+#include <iostream>
+#include <cmath>
+
+#include "SRIMatrix.hpp"
+#include "TestUtil.hpp"
+#include "GeomaticsTestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class SRIMatrix_T
+{
+public:
+   SRIMatrix_T() : rng(4321) {}
+
+      /// random upper triangular R, Z, and A = H || D of dimension m x (n+1)
+   void problem(unsigned n, unsigned m, Matrix<double>& R, Vector<double>& Z,
+                Matrix<double>& A)
+   {
+      R = Matrix<double>(n,n,0.0);
+      Z = Vector<double>(n,0.0);
+      A = Matrix<double>(m,n+1,0.0);
+      for(unsigned i=0; i<n; i++) {
+         R(i,i) = 2.0 + rng.nextSigned();
+         for(unsigned j=i+1; j<n; j++) R(i,j) = rng.nextSigned();
+         Z(i) = rng.nextSigned();
+      }
+      for(unsigned i=0; i<m; i++)
+         for(unsigned j=0; j<=n; j++) A(i,j) = rng.nextSigned();
+   }
+
+      /// Blocked and unblocked give the same R, Z and residuals.
+   unsigned blockTest()
+   {
+      TUDEF("SRIMatrix", "SrifMU");
+      const unsigned ns[] = { 5, 40, 64, 97, 150 };
+      const unsigned nbs[] = { 0, 2, 7, 32 };
+      for(unsigned t=0; t<5; t++) {
+         unsigned n(ns[t]), m(n+3);
+         Matrix<double> R0, A0;
+         Vector<double> Z0;
+         problem(n, m, R0, Z0, A0);
+            // a column already zero below the diagonal is skipped
+         for(unsigned i=0; i<m; i++) A0(i,n/2) = 0.0;
+
+         Matrix<double> Ru(R0), Au(A0);
+         Vector<double> Zu(Z0);
+         SrifMU(Ru, Zu, Au, 0, 1);
+         for(unsigned b=0; b<4; b++) {
+            Matrix<double> Rb(R0), Ab(A0);
+            Vector<double> Zb(Z0);
+            SrifMU(Rb, Zb, Ab, 0, nbs[b]);
+            TUASSERT(maxdiff(Ru, Rb) < 1.e-10);
+            TUASSERTFEPS(0.0, max(norm(Zu-Zb), norm(Au.colCopy(n)-Ab.colCopy(n))),
+                         1.e-10);
+            TUASSERTFE(0.0, Rb(1,0));
+         }
+      }
+      TURETURN();
+   }
+
+      /// Only M rows are used; R and Z are created when empty.
+   unsigned rowsTest()
+   {
+      TUDEF("SRIMatrix", "SrifMU");
+      const unsigned n(80), m(100), M(70);
+      Matrix<double> R0, A0;
+      Vector<double> Z0;
+      problem(n, m, R0, Z0, A0);
+      Matrix<double> Ru, Au(A0), Rb, Ab(A0);
+      Vector<double> Zu, Zb;
+      SrifMU(Ru, Zu, Au, M, 1);
+      SrifMU(Rb, Zb, Ab, M);
+      TUASSERTE(size_t, n, Rb.rows());
+      TUASSERT(maxdiff(Ru, Rb) < 1.e-10);
+      TUASSERTFEPS(0.0, norm(Zu-Zb), 1.e-10);
+         // rows below M are untouched
+      for(unsigned i=M; i<m; i++)
+         TUASSERTFE(A0(i,n), Ab(i,n));
+
+         // a second update, unblocked with A = H || D, and with the H,D overload
+      Matrix<double> H(m,n), Au2(m,n+1);
+      Vector<double> D(m);
+      for(unsigned i=0; i<m; i++) {
+         for(unsigned j=0; j<n; j++) Au2(i,j) = H(i,j) = rng.nextSigned();
+         Au2(i,n) = D(i) = rng.nextSigned();
+      }
+      SrifMU(Ru, Zu, Au2, 0, 1);
+      Vector<double> Du(Au2.colCopy(n)), Db(D);
+      SrifMU(Rb, Zb, H, Db);
+      TUASSERT(maxdiff(Ru, Rb) < 1.e-10);
+      TUASSERTFEPS(0.0, norm(Du-Db), 1.e-10);
+      TURETURN();
+   }
+
+   TestRandom rng;
+};
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   SRIMatrix_T testClass;
+   total += testClass.blockTest();
+   total += testClass.rowsTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
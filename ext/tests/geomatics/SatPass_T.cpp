@@ -0,0 +1,191 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SatPass_T.cpp  Test SatPass storage and streaming construction from RINEX
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "SatPass.hpp"
+#include "SatPassUtilities.hpp"
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class SatPass_T
+{
+public:
+   SatPass_T()
+   {
+      filenames.push_back(getPathData() + "/arlm200a.15o");
+      filenames.push_back(getPathData() + "/arlm200b.15o");
+   }
+
+      /// Add, modify, split and decimate data in one pass.
+   unsigned storeTest()
+   {
+      TUDEF("SatPass", "addData");
+      vector<string> ots;
+      ots.push_back("L1"); ots.push_back("L2"); ots.push_back("C1");
+      SatPass sp(RinexSatID(5,SatID::systemGPS), 30.0, ots);
+      Epoch t0(CivilTime(2015,7,19,0,0,0.0));
+      for(int i=0; i<20; i++) {
+         vector<double> data(3);
+         vector<unsigned short> lli(3,0), ssi(3,i%10);
+         data[0] = 1000.+i; data[1] = 2000.+i; data[2] = 3000.+i;
+         if(i == 7) lli[1] = 1;
+         TUASSERTE(int, i, sp.addData(t0 + 30.0*i, ots, data, lli, ssi,
+                                      (i == 3 ? SatPass::BAD : SatPass::OK)));
+      }
+         // out of order and gap are rejected
+      vector<double> data(3,1.0);
+      vector<unsigned short> ind(3,0);
+      TUASSERTE(int, -2, sp.addData(t0, ots, data, ind, ind));
+      TUASSERTE(int, -1, sp.addData(t0 + 30.0*19 + SatPass::maxGap + 60.0,
+                                    ots, data, ind, ind));
+      TUASSERTE(unsigned, 20, sp.size());
+      TUASSERTE(int, 19, sp.getNgood());
+      TUASSERTE(double, 1007., sp.data(7,"L1"));
+      TUASSERTE(double, 3012., sp.data(12,"C1"));
+      TUASSERTE(unsigned short, 1, sp.LLI(7,"L2"));
+      TUASSERTE(unsigned short, 0, sp.LLI(7,"L1"));
+      TUASSERTE(unsigned short, 5, sp.SSI(15,"C1"));
+      TUASSERTE(unsigned short, SatPass::BAD, sp.getFlag(3));
+      TUASSERTE(Epoch, t0 + 30.0*19, sp.getLastTime());
+
+      TUCSM("data");
+      sp.data(4,"L2") = -1.0;
+      TUASSERTE(double, -1.0, sp.data(4,"L2"));
+      TUASSERTE(double, 2005., sp.data(5,"L2"));
+      TUASSERTE(double, 1004., sp.data(4,"L1"));
+
+      TUCSM("operator=");
+      SatPass cp(RinexSatID(1,SatID::systemGPS), 30.0);
+      cp = sp;
+      sp.data(4,"L2") = -2.0;
+      TUASSERTE(double, -1.0, cp.data(4,"L2"));
+      TUASSERTE(unsigned, 20, cp.size());
+
+      TUCSM("split");
+      SatPass tail(RinexSatID(1,SatID::systemGPS), 30.0);
+      TUASSERT(cp.split(12, tail));
+      TUASSERTE(unsigned, 12, cp.size());
+      TUASSERTE(unsigned, 8, tail.size());
+      TUASSERTE(double, 2012., tail.data(0,"L2"));
+      TUASSERTE(double, 3019., tail.data(7,"C1"));
+      TUASSERTE(unsigned, 7, tail.getCount(7));
+      TUASSERTE(Epoch, t0 + 30.0*12, tail.getFirstTime());
+
+      TUCSM("decimate");
+      sp.decimate(4);
+      TUASSERTE(unsigned, 5, sp.size());
+      TUASSERTE(double, 120.0, sp.getDT());
+      TUASSERTE(double, 1008., sp.data(2,"L1"));
+      TUASSERTE(unsigned short, 6, sp.SSI(4,"L2"));
+      TUASSERTE(Epoch, t0 + 30.0*16, sp.getLastTime());
+
+      TURETURN();
+   }
+
+      /// The streaming reader must produce the same passes as the vector reader.
+   unsigned streamTest()
+   {
+      TUDEF("SatPassUtilities", "SatPassFromRinexFiles");
+      const double saveGap(SatPass::maxGap);
+         // a small maximum gap breaks up the passes and exercises the gap logic
+      const double gaps[2] = { saveGap, 40.0 };
+      for(int g=0; g<2; g++) {
+         SatPass::setMaxGap(gaps[g]);
+         vector<string> ots1, ots2;
+         vector<SatPass> list, streamed;
+         TUASSERTE(int, 2, SatPassFromRinexFiles(filenames, ots1, 30.0, list));
+
+         SatPassHandler handler = [&](SatPass& sp)
+         {
+            streamed.push_back(sp);
+         };
+         TUASSERTE(int, 2, SatPassFromRinexFiles(filenames, ots2, 30.0, handler));
+         TUASSERT(ots1 == ots2);
+
+         std::sort(list.begin(), list.end());
+         std::sort(streamed.begin(), streamed.end());
+         TUASSERT(list.size() > (g == 0 ? 10 : 15));
+         TUASSERTE(size_t, list.size(), streamed.size());
+         if(list.size() != streamed.size()) continue;
+
+         int ndiff(0);
+         for(size_t i=0; i<list.size(); i++) {
+            SatPass& a(list[i]);
+            SatPass& b(streamed[i]);
+            if(a.getSat() != b.getSat() || a.size() != b.size() ||
+               a.getNgood() != b.getNgood() ||
+               a.getFirstTime() != b.getFirstTime() ||
+               a.getLastTime() != b.getLastTime()) { ndiff++; continue; }
+            for(unsigned j=0; j<a.size(); j++) {
+               if(a.getFlag(j) != b.getFlag(j) || a.getCount(j) != b.getCount(j))
+                  ndiff++;
+               for(size_t k=0; k<ots1.size(); k++)
+                  if(a.data(j,ots1[k]) != b.data(j,ots1[k]) ||
+                     a.LLI(j,ots1[k]) != b.LLI(j,ots1[k]) ||
+                     a.SSI(j,ots1[k]) != b.SSI(j,ots1[k]))
+                     ndiff++;
+            }
+         }
+         TUASSERTE(int, 0, ndiff);
+      }
+      SatPass::setMaxGap(saveGap);
+
+      TURETURN();
+   }
+
+private:
+   vector<string> filenames;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   SatPass_T testClass;
+   total += testClass.storeTest();
+   total += testClass.streamTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
@@ -0,0 +1,250 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file SparseMatrix_T.cpp  Test CompressedSparseMatrix and SrifMUGivens
+
+#include <iostream>
+#include <cmath>
+
+#include "SparseMatrix.hpp"
+#include "SRIMatrix.hpp"
+#include "SRI.hpp"
+#include "TestUtil.hpp"
+#include "GeomaticsTestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class SparseMatrix_T
+{
+public:
+   SparseMatrix_T() : rng(1234) {}
+
+      /// double-difference-like partials || data, m x (n+1): each row touches
+      /// the last np (position) states and two of the others (ambiguities)
+   SparseMatrix<double> ddProblem(unsigned n, unsigned m, unsigned np)
+   {
+      SparseMatrix<double> A(m, n+1);
+      for(unsigned i=0; i<m; i++) {
+         for(unsigned j=n-np; j<n; j++) A(i,j) = rng.nextSigned();
+         unsigned k((i*7) % (n-np)), l((i*3+1) % (n-np));
+         A(i,k) = 1.0;
+         if(l != k) A(i,l) = -1.0;
+         A(i,n) = rng.nextSigned();
+      }
+      return A;
+   }
+
+      /// information R^T*R and R^T*Z, which are independent of row signs of R
+   static void info(const Matrix<double>& R, const Vector<double>& Z,
+                    Matrix<double>& I, Vector<double>& IZ)
+   {
+      I = transpose(R) * R;
+      IZ = transpose(R) * Z;
+   }
+
+      /// CSR and CSC agree with the SparseMatrix they came from.
+   unsigned compressedTest()
+   {
+      TUDEF("CompressedSparseMatrix", "CompressedSparseMatrix");
+      const unsigned m(30), n(20);
+      SparseMatrix<double> S(m, n);
+      for(unsigned i=0; i<m; i++)
+         for(unsigned j=0; j<n; j++)
+            if(rng.nextSigned() > 0.7) S(i,j) = rng.nextSigned();
+      Matrix<double> D(S);
+      Vector<double> V(n), U(m);
+      for(unsigned j=0; j<n; j++) V(j) = rng.nextSigned();
+      for(unsigned i=0; i<m; i++) U(i) = rng.nextSigned();
+
+      CompressedSparseMatrix<double> CR(S), CC(S, CompressedSparseMatrix<double>::CSC);
+      TUASSERTE(unsigned, S.datasize(), CR.datasize());
+      TUASSERTE(unsigned, S.datasize(), CC.datasize());
+      TUASSERTE(unsigned, m, CR.lines());
+      TUASSERTE(unsigned, n, CC.lines());
+
+      bool same(true);
+      for(unsigned i=0; i<m; i++)
+         for(unsigned j=0; j<n; j++)
+            if(CR(i,j) != D(i,j) || CC(i,j) != D(i,j)
+               || CR.transpose()(j,i) != D(i,j)) same = false;
+      TUASSERT(same);
+
+      TUASSERTFE(0.0, maxdiff(D, Matrix<double>(CR)));
+      TUASSERTFE(0.0, maxdiff(D, Matrix<double>(CC)));
+      TUASSERTFE(0.0, maxdiff(D, Matrix<double>(CC.toSparseMatrix())));
+      TUASSERTFE(0.0, maxdiff(D, Matrix<double>(CR.convert())));
+      TUASSERTFE(0.0, maxdiff(D, Matrix<double>(CC.convert())));
+      TUASSERT(CR.convert().getStorage() == CompressedSparseMatrix<double>::CSC);
+
+      TUASSERTFEPS(0.0, norm(D*V - CR*V), 1.e-12);
+      TUASSERTFEPS(0.0, norm(D*V - CC*V), 1.e-12);
+      TUASSERTFEPS(0.0, norm(transpose(D)*U - CR.transposeTimes(U)), 1.e-12);
+      TUASSERTFEPS(0.0, norm(transpose(D)*U - CC.transposeTimes(U)), 1.e-12);
+      TURETURN();
+   }
+
+      /// All forms of the Givens update give the same information and residual
+      /// sum of squares as the Householder SrifMU, over several updates.
+   unsigned givensTest()
+   {
+      TUDEF("SparseMatrix", "SrifMUGivens");
+      const unsigned n(40), m(50), np(4);
+         // a priori information makes the problem non-singular
+      Matrix<double> Rh(n,n,0.0);
+      Vector<double> Zh(n);
+      for(unsigned i=0; i<n; i++) { Rh(i,i) = 0.5; Zh(i) = rng.nextSigned(); }
+      Matrix<double> Rg(Rh), Rc(Rh);
+      Vector<double> Zg(Zh), Zc(Zh), Zs(Zh);
+      SparseMatrix<double> Rs(Rh);
+
+      for(unsigned t=0; t<4; t++) {
+         SparseMatrix<double> A(ddProblem(n, m, np)), As(A);
+         Matrix<double> Ad(A);
+         SparseMatrix<double> H(A, 0, 0, m, n);
+         Vector<double> Dc(Ad.colCopy(n));
+
+         SrifMU(Rh, Zh, Ad);
+         SrifMUGivens(Rg, Zg, A);
+         SrifMUGivens(Rs, Zs, As);
+         SrifMUGivens(Rc, Zc, CompressedSparseMatrix<double>(H), Dc);
+
+         Matrix<double> Ih, I;
+         Vector<double> IZh, IZ;
+         info(Rh, Zh, Ih, IZh);
+         info(Rg, Zg, I, IZ);
+         TUASSERT(maxdiff(Ih, I) < 1.e-9);
+         TUASSERTFEPS(0.0, norm(IZh-IZ), 1.e-9);
+         info(Matrix<double>(Rs), Zs, I, IZ);
+         TUASSERT(maxdiff(Ih, I) < 1.e-9);
+         TUASSERTFEPS(0.0, norm(IZh-IZ), 1.e-9);
+         info(Rc, Zc, I, IZ);
+         TUASSERT(maxdiff(Ih, I) < 1.e-9);
+         TUASSERTFEPS(0.0, norm(IZh-IZ), 1.e-9);
+
+            // Givens R is upper triangular with a positive diagonal
+         bool upper(true);
+         for(unsigned i=0; i<n; i++) {
+            if(Rg(i,i) < 0.0) upper = false;
+            for(unsigned j=0; j<i; j++)
+               if(Rg(i,j) != 0.0 || Rs(i,j) != 0.0) upper = false;
+         }
+         TUASSERT(upper);
+
+            // residuals differ row by row, but not in their sum of squares
+         Vector<double> rh(Ad.colCopy(n)), rg(A.colCopy(n)), rs(As.colCopy(n));
+         TUASSERTFEPS(dot(rh,rh), dot(rg,rg), 1.e-9);
+         TUASSERTFEPS(dot(rh,rh), dot(rs,rs), 1.e-9);
+         TUASSERTFEPS(dot(rh,rh), dot(Dc,Dc), 1.e-9);
+            // and only the residuals are left in A
+         TUASSERTE(unsigned, 0, SparseMatrix<double>(A,0,0,m,n).datasize());
+         TUASSERTE(unsigned, 0, SparseMatrix<double>(As,0,0,m,n).datasize());
+      }
+      TURETURN();
+   }
+
+      /// The fill-reducing ordering keeps the sparse R much sparser.
+   unsigned orderingTest()
+   {
+      TUDEF("SparseMatrix", "columnOrdering");
+      const unsigned n(60), m(200), np(4);
+         // natural order puts the positions first; reverse the columns
+      SparseMatrix<double> A0(ddProblem(n, m, np)), A(m, n+1);
+      for(unsigned i=0; i<m; i++)
+         for(unsigned j=0; j<=n; j++) {
+            double a(A0(i,j));
+            if(a != 0.0) A(i, j<n ? n-1-j : n) = a;
+         }
+
+      SparseMatrix<double> H(A, 0, 0, m, n);
+      vector<unsigned int> P(columnOrdering(H));
+      TUASSERTE(size_t, n, P.size());
+         // the positions are the most common, so they go last
+      for(unsigned j=0; j<np; j++)
+         TUASSERT(P[n-np+j] < np);
+
+      SparseMatrix<double> Ap(m, n+1);
+      for(unsigned i=0; i<m; i++)
+         for(unsigned j=0; j<n; j++) {
+            double a(A(i,P[j]));
+            if(a != 0.0) Ap(i,j) = a;
+         }
+      for(unsigned i=0; i<m; i++) Ap(i,n) = double(A(i,n));
+
+      SparseMatrix<double> R(n,n);
+      Vector<double> Z(n,0.0), Zp(Z);
+      for(unsigned i=0; i<n; i++) R(i,i) = 0.5;
+      SparseMatrix<double> Rp(R);
+      SrifMUGivens(R, Z, A);
+      SrifMUGivens(Rp, Zp, Ap);
+      TUASSERT(Rp.datasize() < R.datasize());
+
+         // the permuted SRI is the same problem
+      Matrix<double> C(inverse(transpose(Matrix<double>(R))*Matrix<double>(R)));
+      Matrix<double> Cp(inverse(transpose(Matrix<double>(Rp))*Matrix<double>(Rp)));
+      double d(0.0);
+      for(unsigned i=0; i<n; i++)
+         for(unsigned j=0; j<n; j++)
+            d = max(d, ::fabs(C(P[i],P[j]) - Cp(i,j)));
+      TUASSERT(d < 1.e-8);
+
+         // and SRI gives the same order as a Namelist
+      Namelist NL;
+      for(unsigned j=0; j<n; j++) NL += string("S") + StringUtils::asString(j);
+      SRI S(NL);
+      Namelist NLp(S.sparseOrdering(H));
+      bool same(true);
+      for(unsigned j=0; j<n; j++)
+         if(NLp.getName(j) != NL.getName(P[j])) same = false;
+      TUASSERT(same);
+      S.permute(NLp);
+      TUASSERT(S.getNames() == NLp);
+      TURETURN();
+   }
+
+   TestRandom rng;
+};
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   SparseMatrix_T testClass;
+   total += testClass.compressedTest();
+   total += testClass.givensTest();
+   total += testClass.orderingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}
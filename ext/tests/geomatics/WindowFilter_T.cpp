@@ -0,0 +1,162 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004-2019, The University of Texas at Austin
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software developed by Applied Research Laboratories at the University of
+//  Texas at Austin, under contract to an agency or agencies within the U.S. 
+//  Department of Defense. The U.S. Government retains all rights to use,
+//  duplicate, distribute, disclose, or release this software. 
+//
+//  Pursuant to DoD Directive 523024 
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/// @file WindowFilter_T.cpp  Test the online WindowFilter against the batch filter
+
+#include <iostream>
+#include <vector>
+
+#include "WindowFilter.hpp"
+#include "TestUtil.hpp"
+#include "GeomaticsTestUtil.hpp"
+
+using namespace std;
+
+class WindowFilter_T
+{
+public:
+   WindowFilter_T() : N(600)
+   {
+      TestRandom rng(12345);
+      double step(0.0);
+      for(unsigned i=0; i<N; i++) {
+         double noise(0.0);
+         for(int k=0; k<4; k++)
+            noise += rng.next() - 0.5;
+         if(i == 150) step += 5.0;
+         if(i == 300) step -= 3.0;
+         if(i == 450) step += 4.0;
+         xdata.push_back(30.0*i);
+         data.push_back(step + 0.2*noise);
+         tdata.push_back(step + 0.2*noise + 0.01*i);
+      }
+   }
+
+      /// Run both filters with the given stats and check the slips agree.
+   unsigned compare(const vector<double>& d, bool two, const string& sub)
+   {
+      TUDEF("OnlineWindowFilter", sub);
+      const unsigned width(20);
+
+         // batch; the online filter analyzes one more point at the end
+         // because the batch filter never puts the last point in the future
+      vector<int> flags;
+      WindowFilter<double> wf(xdata, d, flags);
+      wf.setWidth(width);
+      wf.setTwoSample(two);
+      wf.setFullWindows(true);
+      TUASSERT(wf.filter() > 0);
+      wf.analyze();
+      vector< FilterHit<double> > batch(wf.getResults());
+
+      OnlineWindowFilter<double> owf(width, two);
+      vector< FilterHit<double> > online;
+      for(unsigned i=0; i<N-1; i++) {
+         if(owf.add(xdata[i], d[i]) > 0) {
+            vector< FilterHit<double> > hits(owf.getHits());
+            for(unsigned j=0; j<hits.size(); j++) {
+                  // reported within width+halfwidth-1 points of the slip
+               TUASSERTE(unsigned, i, hits[j].index+width+owf.getHalfWidth()-1);
+               online.push_back(hits[j]);
+            }
+         }
+      }
+      owf.flush();
+      vector< FilterHit<double> > hits(owf.getHits());
+      online.insert(online.end(), hits.begin(), hits.end());
+
+      TUASSERTE(unsigned, N-1, owf.getCount());
+      TUASSERTE(unsigned, N-2*width, owf.getNumberTested());
+         // batch results start with BOD; sums are accumulated in another order
+      TUASSERTE(size_t, batch.size()-1, online.size());
+      TUASSERTE(size_t, 4, batch.size());
+      for(unsigned j=0; j<online.size() && j+1<batch.size(); j++) {
+         TUASSERTE(unsigned, batch[j+1].index, online[j].index);
+         TUASSERTFEPS(batch[j+1].step, online[j].step, 1.e-10);
+         TUASSERTFEPS(batch[j+1].sigma, online[j].sigma, 1.e-10);
+         TUASSERTE(int, batch[j+1].score, online[j].score);
+      }
+      TURETURN();
+   }
+
+   unsigned oneSampleTest()
+   { return compare(data, false, "add one-sample"); }
+
+   unsigned twoSampleTest()
+   { return compare(tdata, true, "add two-sample"); }
+
+      /// skip() keeps indexes parallel to the caller's data; reset() restarts
+   unsigned skipTest()
+   {
+      TUDEF("OnlineWindowFilter", "skip");
+      OnlineWindowFilter<double> owf(20);
+      vector< FilterHit<double> > online;
+      for(int pass=0; pass<2; pass++) {
+         owf.reset();
+         online.clear();
+         for(unsigned i=0; i<N; i++) {
+            if(i % 7 == 5) { owf.skip(); continue; }
+            owf.add(xdata[i], data[i]);
+            vector< FilterHit<double> > hits(owf.getHits());
+            online.insert(online.end(), hits.begin(), hits.end());
+         }
+         owf.flush();
+         TUASSERTE(unsigned, N, owf.getCount());
+         TUASSERTE(size_t, 3, online.size());
+         if(online.size() == 3) {
+            TUASSERTE(unsigned, 150, online[0].index);
+            TUASSERTE(unsigned, 300, online[1].index);
+            TUASSERTE(unsigned, 450, online[2].index);
+            TUASSERT(online[1].step < -2.5 && online[1].step > -3.5);
+         }
+      }
+      TURETURN();
+   }
+
+   unsigned N;
+   vector<double> xdata, data, tdata;
+};
+
+int main(int argc, char *argv[])
+{
+   unsigned total = 0;
+   WindowFilter_T testClass;
+   total += testClass.oneSampleTest();
+   total += testClass.twoSampleTest();
+   total += testClass.skipTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << total << endl;
+   return total;
+}